@@ -20,6 +20,7 @@
 #include <fstream>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <set>
 
@@ -69,6 +70,12 @@ constexpr auto kLifeStart = "life_start";
 constexpr auto kLifeEnd = "life_end";
 constexpr auto kOffset = "offset";
 constexpr auto kCachedResultThreshold = 2000;
+constexpr size_t kMaxInProcessCachedResultNum = 64;
+
+// The somas results solved in the process are keyed by the model hash, so the graph which has the same model as a
+// solved one reuses the result, even if it is compiled again with a new graph id.
+std::mutex in_process_result_mutex;
+mindspore::HashMap<std::string, nlohmann::json> in_process_results;
 
 std::map<TensorType, std::string> tensor_type_name_map = {{kCommon, "Common"},
                                                           {kOutputOnly, "OutputOnly"},
@@ -123,14 +130,17 @@ bool Somas::LoadSomasCache(const session::KernelGraph *graph) {
   MS_LOG(DEBUG) << "Somas LoadSomasCache start...";
   if (tensors_list_.size() < kCachedResultThreshold) {
     MS_LOG(DEBUG) << "Tensors size (" << tensors_list_.size() << ") less than " << kCachedResultThreshold
-                  << ", no need to load cached";
-    return false;
+                  << ", only load the result cached in process";
+    hash_id_ = std::to_string(std::hash<std::string>()(SomasInfo(true)));
+    return LoadSomasResultInProcess(graph);
   }
 
   bool ret = CalcSomasModelHash(graph);
+  if (ret && LoadSomasResultInProcess(graph)) {
+    return true;
+  }
   if (ret) {
-    std::string filename = Common::GetCompilerCachePath() + "/somas_meta/somas_graph_" +
-                           std::to_string(graph->graph_id()) + "_" + hash_id_ + ".json";
+    std::string filename = Common::GetCompilerCachePath() + "/somas_meta/somas_" + hash_id_ + ".json";
     ret = LoadSomasResult(graph, filename);
     if (ret) {
       MS_LOG(INFO) << "Load Somas Cache file " << filename << " Successfully.";
@@ -147,18 +157,12 @@ bool Somas::CalcSomasModelHash(const session::KernelGraph *graph) {
   auto model_str = SomasInfo(true);
   hash_id_ = std::to_string(std::hash<std::string>()(model_str));
   MS_LOG(INFO) << "Graph " << graph->graph_id() << "'s SOMAS Model hash id is " << hash_id_;
-  std::string filename = Common::GetCompilerCachePath() + "/somas_meta/somas_graph_" +
-                         std::to_string(graph->graph_id()) + "_" + hash_id_ + ".info";
+  std::string filename = Common::GetCompilerCachePath() + "/somas_meta/somas_" + hash_id_ + ".info";
   return Common::SaveStringToFile(filename, model_str);
 }
 
 bool Somas::SaveSomasResult(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
-  if (tensors_list_.size() < kCachedResultThreshold) {
-    MS_LOG(DEBUG) << "Tensors size (" << tensors_list_.size() << ") less than " << kCachedResultThreshold
-                  << ", no need to save result";
-    return false;
-  }
   nlohmann::json somas_json;
   somas_json[kGraphId] = graph->graph_id();
   somas_json[kHashId] = hash_id_;
@@ -183,9 +187,20 @@ bool Somas::SaveSomasResult(const session::KernelGraph *graph) {
     tensors_json.emplace_back(tensor_json);
   }
   somas_json[kTensors] = tensors_json;
+  {
+    std::lock_guard<std::mutex> lock(in_process_result_mutex);
+    if (in_process_results.size() >= kMaxInProcessCachedResultNum) {
+      in_process_results.clear();
+    }
+    in_process_results[hash_id_] = somas_json;
+  }
 
-  std::string filename = Common::GetCompilerCachePath() + "/somas_meta/somas_graph_" +
-                         std::to_string(graph->graph_id()) + "_" + hash_id_ + ".json";
+  if (tensors_list_.size() < kCachedResultThreshold) {
+    MS_LOG(DEBUG) << "Tensors size (" << tensors_list_.size() << ") less than " << kCachedResultThreshold
+                  << ", no need to save result file";
+    return true;
+  }
+  std::string filename = Common::GetCompilerCachePath() + "/somas_meta/somas_" + hash_id_ + ".json";
   (void)Common::SaveStringToFile(filename, somas_json.dump());
   return true;
 }
@@ -224,6 +239,29 @@ bool Somas::LoadSomasResult(const session::KernelGraph *graph, const string &fil
   return ret;
 }
 
+bool Somas::LoadSomasResultInProcess(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  nlohmann::json somas_json;
+  {
+    std::lock_guard<std::mutex> lock(in_process_result_mutex);
+    auto iter = in_process_results.find(hash_id_);
+    if (iter == in_process_results.end()) {
+      return false;
+    }
+    somas_json = iter->second;
+  }
+  if (!VerifySomasResult(graph, somas_json)) {
+    MS_LOG(INFO) << "Verify Somas Result in process Failed.";
+    return false;
+  }
+  mem_offset_ = somas_json[kMemOffset];
+  if (!UpdateTensorsOffset(somas_json[kTensors])) {
+    return false;
+  }
+  MS_LOG(INFO) << "Load Somas Result in process of hash id " << hash_id_ << " Successfully.";
+  return true;
+}
+
 bool Somas::VerifySomasResult(const session::KernelGraph *graph, const nlohmann::json &somas_json) const {
   MS_EXCEPTION_IF_NULL(graph);
   auto graph_id = somas_json[kGraphId];
@@ -235,9 +273,9 @@ bool Somas::VerifySomasResult(const session::KernelGraph *graph, const nlohmann:
   auto stream_size = somas_json[kStreamSize];
   auto stream_group_size = somas_json[kStreamGroupSize];
 
+  // The result is keyed by the model hash, so it may be solved for another graph with the same model.
   if (graph_id != graph->graph_id()) {
-    MS_LOG(WARNING) << "Mismatch graph id " << graph_id << " vs " << graph->graph_id();
-    return false;
+    MS_LOG(INFO) << "Reuse the somas result of graph " << graph_id << " for graph " << graph->graph_id();
   }
 
   if (hash_id != hash_id_) {
@@ -397,9 +435,10 @@ void Somas::InitSomasStreamAndNode(const session::KernelGraph *graph) {
     auto kernel = kernel_cnodes[i];
     MS_EXCEPTION_IF_NULL(kernel);
     SomasStreamPtr stream;
-    auto stream_id = AnfAlgo::GetStreamId(kernel);
-    auto it = find_if(streams_list_.begin(), streams_list_.end(),
-                      [stream_id](const SomasStreamPtr &s) { return s->GetId() == stream_id; });
+    int64_t stream_id = only_data_dependency_ ? SizeToLong(node_index) : AnfAlgo::GetStreamId(kernel);
+    auto it = only_data_dependency_ ? streams_list_.end()
+                                    : find_if(streams_list_.begin(), streams_list_.end(),
+                                              [stream_id](const SomasStreamPtr &s) { return s->GetId() == stream_id; });
     if (it == streams_list_.end()) {
       stream = std::make_shared<SomasStream>(stream_id);
       streams_list_.push_back(stream);
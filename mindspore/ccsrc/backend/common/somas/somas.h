@@ -50,6 +50,9 @@ class Somas {
   bool Allocate(const session::KernelGraph *graph);
   size_t GetTotalMemSize() { return mem_offset_; }
   void set_mem_base_addr(uint8_t *mem_base_addr) { mem_base_addr_ = mem_base_addr; }
+  // The kernels may not be launched in the execution order, such as the CPU kernels in the actor runtime, then the
+  // memory can only be reused by the data dependency.
+  void set_only_data_dependency(bool only_data_dependency) { only_data_dependency_ = only_data_dependency; }
   uint8_t *GetNodeOutputPtr(const AnfNodePtr &node, size_t index) const;
   uint8_t *GetNodeWorkSpacePtr(const AnfNodePtr &node, size_t index) const;
 
@@ -101,6 +104,9 @@ class Somas {
   // Memory base addr
   uint8_t *mem_base_addr_{nullptr};
 
+  // Each node is in its own stream if the memory is reused only by the data dependency.
+  bool only_data_dependency_{false};
+
   // Save debug info
   bool save_graphs_{false};
   std::string save_graphs_path_;
@@ -166,6 +172,7 @@ class Somas {
   bool SaveSomasResult(const session::KernelGraph *graph);
   bool VerifySomasResult(const session::KernelGraph *graph, const nlohmann::json &somas_json) const;
   bool LoadSomasResult(const session::KernelGraph *graph, const string &filename);
+  bool LoadSomasResultInProcess(const session::KernelGraph *graph);
   bool UpdateTensorsOffset(const std::vector<nlohmann::json> &tensors_json);
   bool CalcSomasModelHash(const session::KernelGraph *graph);
   void UpdateInputTensor(SomasNodePtr node, SomasNodePtr pre_somas_node, SomasTensorPtr input_somas_tensor) const;
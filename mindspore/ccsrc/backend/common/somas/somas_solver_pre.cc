@@ -23,11 +23,35 @@
 
 #include "backend/common/somas/somas_solver_core.h"
 #include "backend/common/somas/somas_solver_pre.h"
+#include "backend/common/somas/somas_solver_search.h"
 #include "debug/common.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace somas {
 constexpr auto kSolNumThresholdMultiThread = 8;
+namespace {
+constexpr int64_t kDefaultSearchTimeMs = 0;
+
+// The time budget of the search solver in milliseconds, which is set by the env MS_DEV_SOMAS_SEARCH_TIME. The search
+// solver is disabled by default because it lengthens the compiling, and the solved result is cached by the model hash.
+int64_t GetSearchTimeBudget() {
+  static const int64_t search_time = []() {
+    auto env = common::GetEnv("MS_DEV_SOMAS_SEARCH_TIME");
+    if (env.empty()) {
+      return kDefaultSearchTimeMs;
+    }
+    try {
+      return static_cast<int64_t>(std::stoll(env));
+    } catch (const std::exception &e) {
+      MS_LOG(WARNING) << "Invalid MS_DEV_SOMAS_SEARCH_TIME: " << env << ", use the default " << kDefaultSearchTimeMs;
+      return kDefaultSearchTimeMs;
+    }
+  }();
+  return search_time;
+}
+}  // namespace
+
 Status SomasSolverPre::CheckTensors(const TensorsDescMap *pTensors, uint32_t index1, uint32_t index2) {
   auto tensors = *pTensors;
   if (tensors[index1] == nullptr) {
@@ -124,7 +148,7 @@ Status SomasSolverPre::Solving(const session::KernelGraph *graph, TensorsDescMap
           for (size_t branching_strategy = 0; branching_strategy < numFittingTypes; branching_strategy++) {
             std::shared_ptr<SomasSolverCore> pSolver =
               std::make_shared<SomasSolverCore>(vecTensorsMap[sol], pConstraints, sol);
-            pSolver->SetAlgorithmStrategy(AlgorithmType(algorithm));
+            pSolver->SetAlgorithmStrategy(AlgorithmType(algorithm_strategy));
             pSolver->SetSortingStrategy(SortingType(sort_strategy));
             pSolver->SetFittingStrategy(FittingType(branching_strategy));
             pSolver->SetAllStrategies(false);
@@ -188,6 +212,17 @@ Status SomasSolverPre::Solving(const session::KernelGraph *graph, TensorsDescMap
         MS_LOG(INFO) << "SomasSolver::Solving RESULT: " << max_offset_ << " (" << max_offset_ / (giga) << " GB)";
       }
     }
+    // Improve the best solution of the heuristics by the search solver in the time budget.
+    auto search_time = GetSearchTimeBudget();
+    if (ball && search_time > 0 && max_offset_ > 0) {
+      SomasSolverSearch search_solver(tensors, pConstraints);
+      auto search_offset = search_solver.Search(max_offset_, search_time);
+      if (search_offset < max_offset_) {
+        MS_LOG(INFO) << "SomasSolver::Solving search RESULT: " << search_offset << " (" << search_offset / (giga)
+                     << " GB), reduced " << (max_offset_ - search_offset) << " bytes";
+        max_offset_ = search_offset;
+      }
+    }
     Log(graph, tensors, pConstraints, continuous_v);
   } catch (const std::exception &e) {
     MS_LOG(EXCEPTION) << "SomasSolver::Solving FAILED: " << e.what();
@@ -0,0 +1,320 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/common/somas/somas_solver_search.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include "include/common/thread_pool.h"
+
+namespace mindspore {
+namespace somas {
+namespace {
+constexpr size_t kLookaheadWidth = 3;
+constexpr size_t kMaxSearchWorkers = 8;
+constexpr size_t kMaxNoImprovementMoves = 512;
+constexpr size_t kDeadlineCheckInterval = 32;
+constexpr size_t kSwapMoveRatio = 4;
+constexpr double kOrderNoiseMin = 0.8;
+constexpr double kOrderNoiseMax = 1.2;
+}  // namespace
+
+SomasSolverSearch::SomasSolverSearch(const TensorsDescMap &tensors, const std::vector<DynamicBitSet> *constraints)
+    : tensors_(tensors), constraints_(*constraints) {
+  BuildBlocks();
+}
+
+void SomasSolverSearch::BuildBlocks() {
+  std::vector<size_t> indexes;
+  indexes.reserve(tensors_.size());
+  for (const auto &tensor : tensors_) {
+    (void)indexes.emplace_back(tensor.first);
+  }
+  std::sort(indexes.begin(), indexes.end());
+
+  bool has_contiguous_lifelong = false;
+  for (auto index : indexes) {
+    const auto &tensor = tensors_.at(index);
+    MS_EXCEPTION_IF_NULL(tensor);
+    if (tensor->lifelong_) {
+      has_contiguous_lifelong = has_contiguous_lifelong || (tensor->left_ != nullptr) || (tensor->right_ != nullptr);
+      (void)lifelong_tensors_.emplace_back(tensor);
+      lifelong_memory_ += tensor->size_;
+      continue;
+    }
+    // The block starts from the leftmost tensor of contiguous tensors.
+    if (tensor->left_ != nullptr) {
+      continue;
+    }
+    SearchBlock block;
+    for (auto block_tensor = tensor; block_tensor != nullptr; block_tensor = block_tensor->right_) {
+      const auto &block_tensor_desc = tensors_.at(block_tensor->index_);
+      MS_EXCEPTION_IF_NULL(block_tensor_desc);
+      (void)block.tensors_.emplace_back(block_tensor_desc->index_);
+      (void)block.offsets_.emplace_back(block.size_);
+      (void)block.sizes_.emplace_back(block_tensor_desc->size_);
+      block.size_ += block_tensor_desc->size_;
+    }
+    (void)blocks_.emplace_back(std::move(block));
+  }
+  // The lifelong tensors are appended after the other tensors, which can't keep them contiguous with others.
+  if (has_contiguous_lifelong) {
+    MS_LOG(INFO) << "Skip the somas search solver for the contiguous lifelong tensors.";
+    blocks_.clear();
+  }
+}
+
+std::vector<size_t> SomasSolverSearch::InitialOrder(size_t worker_id, std::mt19937 *random) const {
+  MS_EXCEPTION_IF_NULL(random);
+  std::vector<double> keys(blocks_.size());
+  std::uniform_real_distribution<double> noise(kOrderNoiseMin, kOrderNoiseMax);
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    const auto &block = blocks_[i];
+    auto size = static_cast<double>(block.size_);
+    if (worker_id == 0) {
+      // The same order as the fast heuristics.
+      keys[i] = size;
+    } else if (worker_id == 1) {
+      // The blocks which conflict with more tensors are placed earlier.
+      size_t conflicts = 0;
+      for (auto tensor : block.tensors_) {
+        conflicts += tensors_.size() - std::min(tensors_.size(), constraints_[tensor].CountOnesNum());
+      }
+      keys[i] = size * static_cast<double>(conflicts + 1);
+    } else {
+      keys[i] = size * noise(*random);
+    }
+  }
+  std::vector<size_t> order(blocks_.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&keys](size_t a, size_t b) { return keys[a] > keys[b]; });
+  return order;
+}
+
+void SomasSolverSearch::AddForbiddenIntervals(const SearchBlock &block, const SearchBlock &placed_block,
+                                              size_t placed_start, Intervals *intervals) const {
+  MS_EXCEPTION_IF_NULL(intervals);
+  for (size_t i = 0; i < block.tensors_.size(); ++i) {
+    const auto &constraint = constraints_[block.tensors_[i]];
+    auto offset = SizeToLong(block.offsets_[i]);
+    auto size = SizeToLong(block.sizes_[i]);
+    for (size_t j = 0; j < placed_block.tensors_.size(); ++j) {
+      if (constraint.IsBitTrue(placed_block.tensors_[j])) {
+        continue;
+      }
+      // The tensor can't overlap with the placed tensor which it conflicts with.
+      auto placed_offset = SizeToLong(placed_start + placed_block.offsets_[j]);
+      auto placed_size = SizeToLong(placed_block.sizes_[j]);
+      auto lb = placed_offset - offset - size + 1;
+      auto ub = placed_offset + placed_size - offset;
+      if (ub > 0) {
+        (void)intervals->emplace_back(std::max(lb, static_cast<int64_t>(0)), ub);
+      }
+    }
+  }
+}
+
+void SomasSolverSearch::FindCandidates(Intervals *intervals, size_t block_size, size_t peak,
+                                       std::vector<std::pair<size_t, size_t>> *candidates) const {
+  MS_EXCEPTION_IF_NULL(intervals);
+  MS_EXCEPTION_IF_NULL(candidates);
+  candidates->clear();
+  std::sort(intervals->begin(), intervals->end());
+  // The candidate is the lowest start offset of each free gap, and the gap of the top is unlimited.
+  std::vector<std::pair<size_t, size_t>> gaps;
+  int64_t start = 0;
+  for (const auto &interval : *intervals) {
+    if (interval.first > start) {
+      (void)gaps.emplace_back(LongToSize(start), LongToSize(interval.first - start));
+    }
+    start = std::max(start, interval.second);
+  }
+  (void)gaps.emplace_back(LongToSize(start), std::numeric_limits<size_t>::max());
+
+  // Sort the gaps by the peak after placing the block, then by the best fit.
+  auto new_peak = [block_size, peak](const std::pair<size_t, size_t> &gap) {
+    return std::max(peak, gap.first + block_size);
+  };
+  auto count = std::min(kLookaheadWidth, gaps.size());
+  std::partial_sort(gaps.begin(), gaps.begin() + SizeToLong(count), gaps.end(),
+                    [&new_peak](const std::pair<size_t, size_t> &a, const std::pair<size_t, size_t> &b) {
+                      auto peak_a = new_peak(a);
+                      auto peak_b = new_peak(b);
+                      return (peak_a < peak_b) || (peak_a == peak_b && a.second < b.second) ||
+                             (peak_a == peak_b && a.second == b.second && a.first < b.first);
+                    });
+  candidates->assign(gaps.begin(), gaps.begin() + SizeToLong(count));
+}
+
+bool SomasSolverSearch::Decode(const std::vector<size_t> &order, const Clock::time_point &deadline,
+                               std::vector<size_t> *starts, size_t *peak) const {
+  MS_EXCEPTION_IF_NULL(starts);
+  MS_EXCEPTION_IF_NULL(peak);
+  starts->assign(blocks_.size(), 0);
+  *peak = 0;
+  std::vector<size_t> placed_blocks;
+  placed_blocks.reserve(order.size());
+  Intervals intervals;
+  Intervals next_intervals;
+  Intervals lookahead_intervals;
+  std::vector<std::pair<size_t, size_t>> candidates;
+  std::vector<std::pair<size_t, size_t>> next_candidates;
+
+  for (size_t i = 0; i < order.size(); ++i) {
+    if ((i % kDeadlineCheckInterval == 0) && (Clock::now() > deadline)) {
+      return false;
+    }
+    const auto &block = blocks_[order[i]];
+    // The intervals of the current block are collected in the lookahead of the previous block.
+    FindCandidates(&intervals, block.size_, *peak, &candidates);
+    auto chosen = candidates.front().first;
+
+    next_intervals.clear();
+    if (i + 1 < order.size()) {
+      const auto &next_block = blocks_[order[i + 1]];
+      for (auto placed_block : placed_blocks) {
+        AddForbiddenIntervals(next_block, blocks_[placed_block], (*starts)[placed_block], &next_intervals);
+      }
+      // Look ahead one block, choose the candidate with which the next block has the smallest peak.
+      if (candidates.size() > 1) {
+        size_t best_next_peak = std::numeric_limits<size_t>::max();
+        for (const auto &candidate : candidates) {
+          lookahead_intervals = next_intervals;
+          AddForbiddenIntervals(next_block, block, candidate.first, &lookahead_intervals);
+          auto candidate_peak = std::max(*peak, candidate.first + block.size_);
+          FindCandidates(&lookahead_intervals, next_block.size_, candidate_peak, &next_candidates);
+          auto next_peak = std::max(candidate_peak, next_candidates.front().first + next_block.size_);
+          if (next_peak < best_next_peak) {
+            best_next_peak = next_peak;
+            chosen = candidate.first;
+          }
+        }
+      }
+      AddForbiddenIntervals(next_block, block, chosen, &next_intervals);
+    }
+
+    (*starts)[order[i]] = chosen;
+    *peak = std::max(*peak, chosen + block.size_);
+    (void)placed_blocks.emplace_back(order[i]);
+    intervals.swap(next_intervals);
+  }
+  return true;
+}
+
+void SomasSolverSearch::LocalSearch(size_t worker_id, const Clock::time_point &deadline,
+                                    std::vector<size_t> *best_starts, size_t *best_peak) const {
+  MS_EXCEPTION_IF_NULL(best_starts);
+  MS_EXCEPTION_IF_NULL(best_peak);
+  *best_peak = std::numeric_limits<size_t>::max();
+  std::mt19937 random(static_cast<uint32_t>(worker_id + 1));
+  auto order = InitialOrder(worker_id, &random);
+  if (!Decode(order, deadline, best_starts, best_peak)) {
+    *best_peak = std::numeric_limits<size_t>::max();
+    return;
+  }
+  if (order.size() < 2) {
+    return;
+  }
+
+  std::vector<size_t> new_order;
+  std::vector<size_t> new_starts;
+  std::vector<size_t> peak_positions;
+  size_t new_peak = 0;
+  size_t no_improvement_moves = 0;
+  while ((no_improvement_moves < kMaxNoImprovementMoves) && (Clock::now() < deadline)) {
+    new_order = order;
+    peak_positions.clear();
+    for (size_t i = 0; i < order.size(); ++i) {
+      if ((*best_starts)[order[i]] + blocks_[order[i]].size_ == *best_peak) {
+        (void)peak_positions.emplace_back(i);
+      }
+    }
+    // Move a block on the peak to an earlier position, or swap two random blocks.
+    auto position = peak_positions[random() % peak_positions.size()];
+    if ((position == 0) || (random() % kSwapMoveRatio == 0)) {
+      std::swap(new_order[random() % new_order.size()], new_order[random() % new_order.size()]);
+    } else {
+      auto new_position = random() % position;
+      std::rotate(new_order.begin() + SizeToLong(new_position), new_order.begin() + SizeToLong(position),
+                  new_order.begin() + SizeToLong(position) + 1);
+    }
+
+    if (!Decode(new_order, deadline, &new_starts, &new_peak)) {
+      break;
+    }
+    // Accept the equal peak to walk on the plateau.
+    ++no_improvement_moves;
+    if (new_peak <= *best_peak) {
+      if (new_peak < *best_peak) {
+        no_improvement_moves = 0;
+      }
+      order.swap(new_order);
+      best_starts->swap(new_starts);
+      *best_peak = new_peak;
+    }
+  }
+}
+
+size_t SomasSolverSearch::Search(size_t upperbound, int64_t time_budget_ms) {
+  if (blocks_.empty() || (time_budget_ms <= 0)) {
+    return upperbound;
+  }
+  auto start = Clock::now();
+  auto deadline = start + std::chrono::milliseconds(time_budget_ms);
+  auto thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  size_t worker_num = std::max(static_cast<size_t>(1), std::min(thread_num, kMaxSearchWorkers));
+  std::vector<std::vector<size_t>> worker_starts(worker_num);
+  std::vector<size_t> worker_peaks(worker_num, std::numeric_limits<size_t>::max());
+  std::vector<common::Task> tasks;
+  for (size_t i = 0; i < worker_num; ++i) {
+    auto task = [this, i, &deadline, &worker_starts, &worker_peaks]() {
+      LocalSearch(i, deadline, &worker_starts[i], &worker_peaks[i]);
+      return common::SUCCESS;
+    };
+    (void)tasks.emplace_back(task);
+  }
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+
+  auto best_worker = std::min_element(worker_peaks.begin(), worker_peaks.end()) - worker_peaks.begin();
+  auto best_peak = worker_peaks[best_worker];
+  MS_LOG(INFO) << "Somas search solver result: "
+               << (best_peak == std::numeric_limits<size_t>::max() ? 0 : best_peak + lifelong_memory_)
+               << ", heuristic result: " << upperbound << ", workers: " << worker_num << ", time elapsed: "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count() << " ms";
+  if ((best_peak == std::numeric_limits<size_t>::max()) || (best_peak + lifelong_memory_ >= upperbound)) {
+    return upperbound;
+  }
+
+  // Update the offsets of tensors, and the lifelong tensors are appended after the other tensors.
+  const auto &best_starts = worker_starts[best_worker];
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    const auto &block = blocks_[i];
+    for (size_t j = 0; j < block.tensors_.size(); ++j) {
+      tensors_.at(block.tensors_[j])->offset_ = best_starts[i] + block.offsets_[j];
+    }
+  }
+  size_t offset = best_peak;
+  for (const auto &tensor : lifelong_tensors_) {
+    tensor->offset_ = offset;
+    offset += tensor->size_;
+  }
+  return offset;
+}
+}  // namespace somas
+}  // namespace mindspore
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_SOMAS_SOMAS_SOLVER_SEARCH_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_SOMAS_SOMAS_SOLVER_SEARCH_H_
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "backend/common/somas/somas_solver_pre.h"
+
+namespace mindspore {
+namespace somas {
+// The search solver improves the solution of the fast heuristics. A solution is decoded from an order of the blocks
+// by placing each block at the best fit offset with one block of lookahead, and the order is improved by the local
+// search which moves the blocks on the peak forward. Several searches with different initial orders run in parallel
+// until the time budget is used up or none of them improves for a while.
+class SomasSolverSearch {
+ public:
+  SomasSolverSearch(const TensorsDescMap &tensors, const std::vector<DynamicBitSet> *constraints);
+  ~SomasSolverSearch() = default;
+
+  // Search a solution smaller than the upper bound, which includes the lifelong tensors. Return the size of the found
+  // solution and update the offsets of tensors, or return the upper bound if no better solution is found.
+  size_t Search(size_t upperbound, int64_t time_budget_ms);
+
+ private:
+  // The contiguous tensors are placed together as one block.
+  struct SearchBlock {
+    std::vector<size_t> tensors_;
+    std::vector<size_t> offsets_;
+    std::vector<size_t> sizes_;
+    size_t size_{0};
+  };
+  // The offsets which can't be the start of a block, in [lb, ub).
+  using Intervals = std::vector<std::pair<int64_t, int64_t>>;
+  using Clock = std::chrono::steady_clock;
+
+  void BuildBlocks();
+  std::vector<size_t> InitialOrder(size_t worker_id, std::mt19937 *random) const;
+  // Place the blocks in the order, return false if the deadline is reached.
+  bool Decode(const std::vector<size_t> &order, const Clock::time_point &deadline, std::vector<size_t> *starts,
+              size_t *peak) const;
+  // Collect the start offsets of block which conflict with the block placed at the start offset.
+  void AddForbiddenIntervals(const SearchBlock &block, const SearchBlock &placed_block, size_t placed_start,
+                             Intervals *intervals) const;
+  // Pick the start offset with the smallest peak and the best fit, and return the peak and the gap of other candidates.
+  void FindCandidates(Intervals *intervals, size_t block_size, size_t peak,
+                      std::vector<std::pair<size_t, size_t>> *candidates) const;
+  // Run the local search from an initial order until the deadline, return the best starts and the peak.
+  void LocalSearch(size_t worker_id, const Clock::time_point &deadline, std::vector<size_t> *best_starts,
+                   size_t *best_peak) const;
+
+  const TensorsDescMap &tensors_;
+  const std::vector<DynamicBitSet> &constraints_;
+  std::vector<SearchBlock> blocks_;
+  std::vector<SomasSolverTensorDescPtr> lifelong_tensors_;
+  size_t lifelong_memory_{0};
+};
+}  // namespace somas
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_SOMAS_SOMAS_SOLVER_SEARCH_H_
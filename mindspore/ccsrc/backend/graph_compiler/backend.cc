@@ -846,6 +846,8 @@ void MindRTBackend::RunGraphBySingleOp(const std::vector<KernelGraphPtr> &graphs
   SyncLazyTasks();
   MS_EXCEPTION_IF_NULL(graph_compiler_);
   auto &op_lazy_builder = runtime::OpLazyBuilder::GetInstance();
+  // The graph compiler is used by the ops of graph, lock the backend against the tasks launched in the async thread.
+  auto backend_lock = op_lazy_builder.LockBackend();
   op_lazy_builder.Register([this]() { LazyExecuteTaskCallback(); });
   for (size_t graph_index = 0; graph_index < graphs.size(); ++graph_index) {
     const auto &graph = graphs[graph_index];
@@ -1325,52 +1327,56 @@ void MindRTBackend::CompileSingleOpGraphs(const std::vector<std::shared_ptr<runt
 
 void MindRTBackend::LazyExecuteTaskCallback() {
   auto &op_lazy_builder = runtime::OpLazyBuilder::GetInstance();
-  if (op_lazy_builder.QueueEmpty()) {
-    return;
-  }
-
   try {
     MS_LOG(DEBUG) << "Start";
     auto ms_context = MsContext::GetInstance();
     MS_EXCEPTION_IF_NULL(ms_context);
-    auto infer_flag = ms_context->get_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER);
 
-    CompileSingleOpGraphs(op_lazy_builder.GetOpBuildTasks());
-    op_lazy_builder.ClearOpBuildTasks();
+    // Run op one by one, the backend is locked for each op, so the tasks can be pushed by the frontend in the meantime
+    // if they are executed in the async thread.
+    while (true) {
+      auto backend_lock = op_lazy_builder.LockBackend();
+      if (op_lazy_builder.QueueEmpty()) {
+        break;
+      }
+      auto infer_flag = ms_context->get_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER);
+      if (!op_lazy_builder.GetOpBuildTasks().empty()) {
+        CompileSingleOpGraphs(op_lazy_builder.GetOpBuildTasks());
+        op_lazy_builder.ClearOpBuildTasks();
+      }
 
-    // Run op one by one
-    auto &op_run_tasks = op_lazy_builder.GetOpRunTasks();
-    while (!op_run_tasks.empty()) {
-      auto &op_run_task = op_run_tasks.front();
-      const auto &context = op_run_task->context();
-      ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, context->is_pynative_infer());
-      RunSingleOpGraph(context->graph(), context->op_run_info(), context->graph_compiler_info());
-      ClearGraphDeviceAddress(context->graph(), context->device_context(), context->op_run_info().is_gradient_out);
+      auto &op_run_tasks = op_lazy_builder.GetOpRunTasks();
+      if (!op_run_tasks.empty()) {
+        auto &op_run_task = op_run_tasks.front();
+        const auto &context = op_run_task->context();
+        ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, context->is_pynative_infer());
+        RunSingleOpGraph(context->graph(), context->op_run_info(), context->graph_compiler_info());
+        ClearGraphDeviceAddress(context->graph(), context->device_context(), context->op_run_info().is_gradient_out);
 
-      UpdateInputDeviceAddress(context->graph());
+        UpdateInputDeviceAddress(context->graph());
 
-      op_lazy_builder.PopOpRunTask();
+        op_lazy_builder.PopOpRunTask();
+      }
+      ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, infer_flag);
     }
-
-    ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, infer_flag);
     MS_LOG(DEBUG) << "End";
   } catch (const py::type_error &ex) {
-    op_lazy_builder.Reset();
+    op_lazy_builder.ResetAfterFailure();
     throw py::type_error(ex);
   } catch (const py::value_error &ex) {
-    op_lazy_builder.Reset();
+    op_lazy_builder.ResetAfterFailure();
     throw py::value_error(ex);
   } catch (const py::index_error &ex) {
-    op_lazy_builder.Reset();
+    op_lazy_builder.ResetAfterFailure();
     throw py::index_error(ex);
   } catch (const py::name_error &ex) {
-    op_lazy_builder.Reset();
+    op_lazy_builder.ResetAfterFailure();
     throw py::name_error(ex);
   } catch (const std::exception &ex) {
-    op_lazy_builder.Reset();
+    op_lazy_builder.ResetAfterFailure();
     throw(std::runtime_error(ex.what()));
   } catch (...) {
-    op_lazy_builder.Reset();
+    op_lazy_builder.ResetAfterFailure();
     std::string exName(abi::__cxa_current_exception_type()->name());
     MS_LOG(EXCEPTION) << "Error occurred when execute task in queue. Exception name: " << exName;
   }
@@ -1425,6 +1431,8 @@ void MindRTBackend::RunOpInternal(bool single_op_cache_hit, GraphCompilerInfo *g
     op_lazy_builder.Register([this]() { LazyExecuteTaskCallback(); });
     if (op_lazy_builder.QueueFull()) {
       op_lazy_builder.ExecuteRemainingTasks();
+    } else if (op_lazy_builder.async_launch()) {
+      op_lazy_builder.ExecuteRemainingTasksAsync();
     }
   }
 }
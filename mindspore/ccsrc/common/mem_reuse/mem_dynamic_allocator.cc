@@ -28,6 +28,26 @@ constexpr size_t kGBToByte = 1024 << 20;
 // The smallest memory request size, if it is smaller than this size, the device memory request may fail
 // Set experience value to 10M
 const size_t kMinimumAllocMem = 10 << 20;
+// The memory bufs not larger than 64K are cached by the thread caches.
+constexpr size_t kThreadCacheMaxBufSize = 64 << 10;
+constexpr size_t kThreadCacheSizeClassNum = kThreadCacheMaxBufSize / DYNAMIC_MEM_ALIGN_SIZE;
+constexpr size_t kThreadCacheNum = 16;
+constexpr size_t kThreadCacheMaxBufNumPerClass = 64;
+constexpr size_t kThreadCacheMaxMemSize = 8 << 20;
+constexpr double kPercent = 100.0;
+
+namespace {
+// The threads are assigned to the thread caches in turn.
+size_t GetThreadCacheIndex() {
+  static std::atomic<size_t> thread_count{0};
+  static thread_local size_t thread_cache_index = thread_count.fetch_add(1) % kThreadCacheNum;
+  return thread_cache_index;
+}
+
+size_t GetThreadCacheMemRecordIndex(const DeviceMemPtr &device_addr) {
+  return (reinterpret_cast<uintptr_t>(device_addr) / DYNAMIC_MEM_ALIGN_SIZE) % kThreadCacheNum;
+}
+}  // namespace
 
 thread_local AllocatorDebugInfo DynamicMemAllocatorDebugInfo::debug_info_;
 
@@ -43,11 +63,34 @@ DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
 
 DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persistent_mem) {
   size_t align_size = AlignMemorySize(size);
+  if (!IsThreadCacheSize(align_size, from_persistent_mem)) {
+    return AllocTensorMemFromPool(align_size, from_persistent_mem);
+  }
+  auto device_addr = AllocFromThreadCache(align_size);
+  if (device_addr != nullptr) {
+    return device_addr;
+  }
+  device_addr = AllocTensorMemFromPool(align_size, from_persistent_mem);
+  if (device_addr != nullptr) {
+    RecordThreadCacheMem(device_addr, align_size);
+  }
+  return device_addr;
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMemFromPool(size_t size, bool from_persistent_mem) {
   std::lock_guard<std::mutex> locker(mutex_);
   // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
-  DeviceMemPtr device_addr = FindIdleMemBuf(align_size, from_persistent_mem);
+  DeviceMemPtr device_addr = FindIdleMemBuf(size, from_persistent_mem);
   if (!device_addr) {
-    device_addr = AddMemBlockAndMemBuf(align_size, from_persistent_mem);
+    device_addr = AddMemBlockAndMemBuf(size, from_persistent_mem);
+  }
+  // Return the memory bufs held by the thread caches to the pool and try again.
+  if (!device_addr && thread_cache_mem_size_ > 0) {
+    FlushThreadCaches();
+    device_addr = FindIdleMemBuf(size, from_persistent_mem);
+    if (!device_addr) {
+      device_addr = AddMemBlockAndMemBuf(size, from_persistent_mem);
+    }
   }
 
   // Alloc memory failed and dump the info.
@@ -61,8 +104,8 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persis
 std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(size_t total_size,
                                                                           const std::vector<size_t> &size_list) {
   std::vector<DeviceMemPtr> device_addr_list;
-  // Pre-alloc the one whole piece memory.
-  auto device_addr = AllocTensorMem(total_size, false);
+  // Pre-alloc the one whole piece memory, which is split later and can't be cached by the thread caches.
+  auto device_addr = AllocTensorMemFromPool(AlignMemorySize(total_size), false);
   if (!device_addr) {
     return device_addr_list;
   }
@@ -295,7 +338,15 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr &devic
 
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
   MS_EXCEPTION_IF_NULL(device_addr);
+  if (enable_thread_cache_ && FreeToThreadCache(device_addr)) {
+    return;
+  }
   std::lock_guard<std::mutex> locker(mutex_);
+  FreeTensorMemToPool(device_addr);
+}
+
+void DynamicMemPoolBestFit::FreeTensorMemToPool(const DeviceMemPtr &device_addr) {
+  MS_EXCEPTION_IF_NULL(device_addr);
   auto fn = [this](const MemStatusManagerPtr &mem_mng, const DeviceMemPtr &device_addr) -> DynamicMemBlockPtr {
     auto mem_block = FindMemBlock(device_addr, mem_mng);
     if (mem_block != nullptr) {
@@ -389,8 +440,118 @@ void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr &dev
   MS_LOG(ERROR) << "Can't find the size[" << size << "] and device address[" << device_addr << "] in the idle mem_buf.";
 }
 
+void DynamicMemPoolBestFit::InitThreadCaches() {
+  enable_thread_cache_ = (common::GetEnv("MS_DEV_MEM_THREAD_CACHE") == "1");
+  if (!enable_thread_cache_) {
+    return;
+  }
+  for (size_t i = 0; i < kThreadCacheNum; ++i) {
+    auto thread_cache = std::make_unique<ThreadMemCache>();
+    thread_cache->free_mem_bufs_.resize(kThreadCacheSizeClassNum);
+    (void)thread_caches_.emplace_back(std::move(thread_cache));
+    (void)thread_cache_mem_records_.emplace_back(std::make_unique<ThreadCacheMemRecord>());
+  }
+}
+
+bool DynamicMemPoolBestFit::IsThreadCacheSize(size_t size, bool from_persistent_mem) const {
+  return enable_thread_cache_ && !from_persistent_mem && size <= kThreadCacheMaxBufSize;
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocFromThreadCache(size_t size) {
+  auto &thread_cache = thread_caches_[GetThreadCacheIndex()];
+  MS_EXCEPTION_IF_NULL(thread_cache);
+  std::lock_guard<std::mutex> locker(thread_cache->mutex_);
+  auto &free_mem_bufs = thread_cache->free_mem_bufs_[size / DYNAMIC_MEM_ALIGN_SIZE - 1];
+  if (free_mem_bufs.empty()) {
+    ++thread_cache_miss_count_;
+    return nullptr;
+  }
+  auto device_addr = free_mem_bufs.back();
+  free_mem_bufs.pop_back();
+  thread_cache->cached_mem_size_ -= size;
+  thread_cache_mem_size_ -= size;
+  ++thread_cache_hit_count_;
+  return device_addr;
+}
+
+void DynamicMemPoolBestFit::RecordThreadCacheMem(const DeviceMemPtr &device_addr, size_t size) {
+  auto &mem_record = thread_cache_mem_records_[GetThreadCacheMemRecordIndex(device_addr)];
+  MS_EXCEPTION_IF_NULL(mem_record);
+  std::lock_guard<std::mutex> locker(mem_record->mutex_);
+  mem_record->mem_buf_sizes_[device_addr] = size;
+}
+
+bool DynamicMemPoolBestFit::FreeToThreadCache(const DeviceMemPtr &device_addr) {
+  auto &mem_record = thread_cache_mem_records_[GetThreadCacheMemRecordIndex(device_addr)];
+  MS_EXCEPTION_IF_NULL(mem_record);
+  size_t size = 0;
+  {
+    std::lock_guard<std::mutex> locker(mem_record->mutex_);
+    const auto &iter = mem_record->mem_buf_sizes_.find(device_addr);
+    if (iter == mem_record->mem_buf_sizes_.end()) {
+      return false;
+    }
+    size = iter->second;
+  }
+
+  auto &thread_cache = thread_caches_[GetThreadCacheIndex()];
+  MS_EXCEPTION_IF_NULL(thread_cache);
+  {
+    std::lock_guard<std::mutex> locker(thread_cache->mutex_);
+    auto &free_mem_bufs = thread_cache->free_mem_bufs_[size / DYNAMIC_MEM_ALIGN_SIZE - 1];
+    if (free_mem_bufs.size() < kThreadCacheMaxBufNumPerClass &&
+        thread_cache->cached_mem_size_ + size <= kThreadCacheMaxMemSize) {
+      free_mem_bufs.emplace_back(device_addr);
+      thread_cache->cached_mem_size_ += size;
+      thread_cache_mem_size_ += size;
+      return true;
+    }
+  }
+
+  // The thread cache is full, the memory buf is returned to the pool.
+  std::lock_guard<std::mutex> locker(mem_record->mutex_);
+  (void)mem_record->mem_buf_sizes_.erase(device_addr);
+  return false;
+}
+
+void DynamicMemPoolBestFit::FlushThreadCaches() {
+  size_t flushed_size = 0;
+  for (auto &thread_cache : thread_caches_) {
+    MS_EXCEPTION_IF_NULL(thread_cache);
+    std::lock_guard<std::mutex> locker(thread_cache->mutex_);
+    for (auto &free_mem_bufs : thread_cache->free_mem_bufs_) {
+      for (auto &device_addr : free_mem_bufs) {
+        auto &mem_record = thread_cache_mem_records_[GetThreadCacheMemRecordIndex(device_addr)];
+        {
+          std::lock_guard<std::mutex> record_locker(mem_record->mutex_);
+          (void)mem_record->mem_buf_sizes_.erase(device_addr);
+        }
+        FreeTensorMemToPool(device_addr);
+      }
+      free_mem_bufs.clear();
+    }
+    flushed_size += thread_cache->cached_mem_size_;
+    thread_cache_mem_size_ -= thread_cache->cached_mem_size_;
+    thread_cache->cached_mem_size_ = 0;
+  }
+  MS_LOG(INFO) << "Flush the thread caches of memory pool, size: " << flushed_size;
+}
+
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
   std::lock_guard<std::mutex> locker(mutex_);
+  // The memory bufs held by the thread caches are released with the memory blocks.
+  for (auto &thread_cache : thread_caches_) {
+    std::lock_guard<std::mutex> cache_locker(thread_cache->mutex_);
+    for (auto &free_mem_bufs : thread_cache->free_mem_bufs_) {
+      free_mem_bufs.clear();
+    }
+    thread_cache->cached_mem_size_ = 0;
+  }
+  for (auto &mem_record : thread_cache_mem_records_) {
+    std::lock_guard<std::mutex> record_locker(mem_record->mutex_);
+    mem_record->mem_buf_sizes_.clear();
+  }
+  thread_cache_mem_size_ = 0;
   auto fn = [this](const MemStatusManagerPtr &mem_mng) {
     for (auto &iter : mem_mng->mem_block_list_) {
       auto &device_addr = iter->device_addr_base_;
@@ -414,6 +575,7 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
       return;
     }
     std::ostringstream buf;
+    size_t total_idle_size = 0;
     for (size_t i = 0; i < mem_mng->mem_block_list_.size(); ++i) {
       size_t idle_size = 0;
       for (auto mb = mem_mng->mem_block_list_[i]->block_all_mem_buf_map_.begin();
@@ -422,19 +584,33 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
           idle_size += mb->second->size_;
         }
       }
+      total_idle_size += idle_size;
       buf << ", block[" << i << "] block size:" << mem_mng->mem_block_list_[i]->mem_block_size_
           << " idle size:" << idle_size;
     }
+    // The fragmentation is the part of idle memory which is not in the largest idle memory buf.
+    size_t max_idle_size = mem_mng->idle_mem_buf_map_.empty() ? 0 : mem_mng->idle_mem_buf_map_.rbegin()->first;
+    double fragmentation =
+      total_idle_size == 0 ? 0 : kPercent * (total_idle_size - max_idle_size) / static_cast<double>(total_idle_size);
     // Dump all the memory buf info
     MS_LOG(WARNING) << mem_type << " pool info: block size " << mem_mng->unit_size_ << ", block counts "
                     << mem_mng->mem_block_list_.size() << buf.str() << ". Total allocated mem "
                     << mem_mng->mps_.total_mem_size_ << ", peak used mem " << mem_mng->mps_.used_mem_peak_size_
                     << ", in used mem " << mem_mng->mps_.total_used_mem_size_ << ", total idle mem "
-                    << mem_mng->mps_.total_mem_size_ - mem_mng->mps_.total_used_mem_size_;
+                    << mem_mng->mps_.total_mem_size_ - mem_mng->mps_.total_used_mem_size_
+                    << ", idle mem fragmentation " << fragmentation << "%";
   };
 
   fn(common_mem_, std::string(kCommonMem));
   fn(persistent_mem_, std::string(kPersistentParamMem));
+  if (enable_thread_cache_) {
+    size_t hit_count = thread_cache_hit_count_;
+    size_t miss_count = thread_cache_miss_count_;
+    double hit_rate =
+      hit_count + miss_count == 0 ? 0 : kPercent * hit_count / static_cast<double>(hit_count + miss_count);
+    MS_LOG(WARNING) << "Thread cache info: hit counts " << hit_count << ", miss counts " << miss_count
+                    << ", hit rate " << hit_rate << "%, cached mem " << thread_cache_mem_size_;
+  }
 }
 
 void DynamicMemPoolBestFit::DumpDynamicMemPoolDebugInfo() {
@@ -21,10 +21,12 @@
 #include <map>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #include <utility>
 #include <thread>
 #include <mutex>
 #include <string>
+#include "utils/hash_map.h"
 #include "utils/ms_utils.h"
 
 namespace mindspore {
@@ -131,11 +133,29 @@ struct MemStatusManager {
 };
 using MemStatusManagerPtr = std::shared_ptr<MemStatusManager>;
 
+// The thread cache holds the freed small memory bufs by the size class, which are still used in the memory pool.
+struct ThreadMemCache {
+  std::mutex mutex_;
+  // The free memory bufs indexed by the size class.
+  std::vector<std::vector<DeviceMemPtr>> free_mem_bufs_;
+  size_t cached_mem_size_{0};
+};
+using ThreadMemCachePtr = std::unique_ptr<ThreadMemCache>;
+
+// The size class of memory bufs allocated by the thread cache, which is striped by the device address.
+struct ThreadCacheMemRecord {
+  std::mutex mutex_;
+  mindspore::HashMap<DeviceMemPtr, size_t> mem_buf_sizes_;
+};
+using ThreadCacheMemRecordPtr = std::unique_ptr<ThreadCacheMemRecord>;
+
 // The main class of dynamic memory pool.
 class DynamicMemPoolBestFit {
  public:
   DynamicMemPoolBestFit()
-      : persistent_mem_(std::make_shared<MemStatusManager>()), common_mem_(std::make_shared<MemStatusManager>()) {}
+      : persistent_mem_(std::make_shared<MemStatusManager>()), common_mem_(std::make_shared<MemStatusManager>()) {
+    InitThreadCaches();
+  }
   virtual ~DynamicMemPoolBestFit();
 
   // The main program entry of memory alloc.
@@ -159,8 +179,10 @@ class DynamicMemPoolBestFit {
   size_t TotalMemStatistics() const {
     return common_mem_->mps_.total_mem_size_ + persistent_mem_->mps_.total_mem_size_;
   }
+  // The memory bufs held by the thread caches are not in use.
   size_t TotalUsedMemStatistics() const {
-    return common_mem_->mps_.total_used_mem_size_ + persistent_mem_->mps_.total_used_mem_size_;
+    return common_mem_->mps_.total_used_mem_size_ + persistent_mem_->mps_.total_used_mem_size_ -
+           thread_cache_mem_size_.load();
   }
   size_t UsedMemPeakStatistics() const {
     return common_mem_->mps_.used_mem_peak_size_ + persistent_mem_->mps_.used_mem_peak_size_;
@@ -185,6 +207,10 @@ class DynamicMemPoolBestFit {
   virtual size_t CalMemBlockAllocSize(size_t size, bool from_persistent_mem);
 
  private:
+  // Alloc memory from the best fit pool by aligned size.
+  DeviceMemPtr AllocTensorMemFromPool(size_t size, bool from_persistent_mem);
+  // Free memory to the best fit pool, needs to hold the mutex.
+  void FreeTensorMemToPool(const DeviceMemPtr &device_addr);
   // Find the idle memory buf by aligned size when memory alloc.
   DeviceMemPtr FindIdleMemBuf(size_t size, bool from_persistent_mem);
   // Add the memory block and memory buf when memory alloc not find the idle memory buf.
@@ -203,6 +229,17 @@ class DynamicMemPoolBestFit {
   // Erase the idle memory buf by size and device address when idle memory buf is combined.
   void EraseIdleMemBuf(size_t size, const DeviceMemPtr &device_addr, const MemStatusManagerPtr &mem_mng);
 
+  // The small memory bufs of common memory are allocated and freed by the thread caches without the mutex of pool
+  // when the thread cache is enabled by the env MS_DEV_MEM_THREAD_CACHE.
+  void InitThreadCaches();
+  bool IsThreadCacheSize(size_t size, bool from_persistent_mem) const;
+  DeviceMemPtr AllocFromThreadCache(size_t size);
+  void RecordThreadCacheMem(const DeviceMemPtr &device_addr, size_t size);
+  // Return false if the memory buf is not allocated by the thread cache or the thread cache is full.
+  bool FreeToThreadCache(const DeviceMemPtr &device_addr);
+  // Return the memory bufs held by the thread caches to the pool, needs to hold the mutex.
+  void FlushThreadCaches();
+
   // Support multi-thread.
   std::mutex mutex_;
   MemStatusManagerPtr persistent_mem_{nullptr};
@@ -210,6 +247,13 @@ class DynamicMemPoolBestFit {
   // In the graph mode, the unit size set in the context will be modified through the FetchMemUnitSize function, so it
   // needs to be changed back after that
   size_t config_unit_size_{DYNAMIC_MEM_ALLOC_UNIT_SIZE};
+
+  bool enable_thread_cache_{false};
+  std::vector<ThreadMemCachePtr> thread_caches_;
+  std::vector<ThreadCacheMemRecordPtr> thread_cache_mem_records_;
+  std::atomic<size_t> thread_cache_mem_size_{0};
+  std::atomic<size_t> thread_cache_hit_count_{0};
+  std::atomic<size_t> thread_cache_miss_count_{0};
 };
 }  // namespace device
 }  // namespace mindspore
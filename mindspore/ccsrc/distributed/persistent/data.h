@@ -79,6 +79,13 @@ class PersistentData : public Data<T> {
   // In disaster recovery mode, memory of tensor need to be saved into disk file periodically.
   void Persist(const storage::DirtyInfo &dirty_info) const;
 
+  // Copy the dirty part of the tensor to a snapshot in memory, which is quick, so the tensor can be modified again after
+  // it returns. The snapshot is written to disk file by PersistSnapshot, eg. in a background thread.
+  void Snapshot(const storage::DirtyInfo &dirty_info) const;
+
+  // Write the snapshot taken by Snapshot to disk file.
+  void PersistSnapshot() const;
+
   // In disaster recovery mode, server node or worker node need to restore persistent data when restart.
   void Restore() const;
 
@@ -103,6 +110,19 @@ void PersistentData<T>::Persist(const storage::DirtyInfo &dirty_info) const {
   storage_->Write(input, dirty_info);
 }
 
+template <typename T>
+void PersistentData<T>::Snapshot(const storage::DirtyInfo &dirty_info) const {
+  MS_EXCEPTION_IF_NULL(storage_);
+  storage::InputData input = std::make_tuple(*Data<T>::shape_, Data<T>::data(), Data<T>::size() * sizeof(T));
+  storage_->Snapshot(input, dirty_info);
+}
+
+template <typename T>
+void PersistentData<T>::PersistSnapshot() const {
+  MS_EXCEPTION_IF_NULL(storage_);
+  storage_->WriteSnapshot();
+}
+
 template <typename T>
 void PersistentData<T>::Restore() const {
   storage::OutputData output = std::make_pair(Data<T>::data(), Data<T>::size() * sizeof(T));
@@ -28,6 +28,12 @@ void Block::GenSha256Seq() const {
   block_meta_->Insert(kHashSeq, sha256_cal);
 }
 
+void Block::GenSha256Seq(const void *content, size_t size) const {
+  std::string sha256_cal = system::sha256::GetHashFromBuffer(content, size);
+  MS_EXCEPTION_IF_NULL(block_meta_);
+  block_meta_->Insert(kHashSeq, sha256_cal);
+}
+
 bool Block::CheckSha256Seq() const {
   MS_EXCEPTION_IF_NULL(block_meta_);
   std::string sha256_gen = block_meta_->Get<std::string>(kHashSeq);
@@ -37,6 +43,16 @@ bool Block::CheckSha256Seq() const {
   }
   return true;
 }
+
+bool Block::CheckSha256Seq(const void *content, size_t size) const {
+  MS_EXCEPTION_IF_NULL(block_meta_);
+  std::string sha256_gen = block_meta_->Get<std::string>(kHashSeq);
+  if (sha256_gen != system::sha256::GetHashFromBuffer(content, size)) {
+    MS_LOG(ERROR) << "The block file has been modified, file name: " << block_file_name_;
+    return false;
+  }
+  return true;
+}
 }  // namespace storage
 }  // namespace distributed
 }  // namespace mindspore
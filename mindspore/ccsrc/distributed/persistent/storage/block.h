@@ -42,9 +42,15 @@ class Block {
   // Generate sha256 hash sequence.
   void GenSha256Seq() const;
 
+  // Generate sha256 hash sequence from the content of the block file in memory, without reading the file.
+  void GenSha256Seq(const void *content, size_t size) const;
+
   // Check sha256 hash sequence.
   bool CheckSha256Seq() const;
 
+  // Check sha256 hash sequence of the content of the block file in memory, without reading the file.
+  bool CheckSha256Seq(const void *content, size_t size) const;
+
   // Set the block meta pointer associated with the block file.
   void set_block_meta(const std::shared_ptr<BlockMeta> &block_meta) { block_meta_ = block_meta; }
 
@@ -17,8 +17,15 @@
 #include "distributed/persistent/storage/local_file.h"
 
 #include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#endif
 #include <cmath>
+#include <cstring>
 #include <algorithm>
+#include <atomic>
 #include <numeric>
 #include <tuple>
 #include <utility>
@@ -27,6 +34,7 @@
 #include "utils/file_utils.h"
 #include "utils/log_adapter.h"
 #include "include/common/utils/utils.h"
+#include "include/common/thread_pool.h"
 #include "distributed/persistent/storage/constants.h"
 
 namespace mindspore {
@@ -95,6 +103,66 @@ void LocalFile::TransformDirtyInfoToBlockIndices(const DirtyInfo &dirty_info, st
   }
 }
 
+void LocalFile::Snapshot(const InputData &input, const DirtyInfo &dirty_info) {
+  std::vector<InputData> inputs = {input};
+  Snapshot(inputs, dirty_info);
+}
+
+void LocalFile::Snapshot(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info) {
+  if (inputs.empty()) {
+    MS_LOG(EXCEPTION) << "The inputs is empty";
+  }
+  std::lock_guard<std::mutex> lock(snapshot_mutex_);
+  // The block files are written directly from the inputs at the first time, instead of copying the whole inputs.
+  if (!finish_create_block_files_) {
+    WriteBlockFiles(inputs);
+    return;
+  }
+
+  // The dirty info is accumulated by several updates, so sort it for the block indices.
+  DirtyInfo sorted_dirty_info = dirty_info;
+  std::sort(sorted_dirty_info.begin(), sorted_dirty_info.end());
+  sorted_dirty_info.erase(std::unique(sorted_dirty_info.begin(), sorted_dirty_info.end()), sorted_dirty_info.end());
+  std::vector<int> block_indices;
+  TransformDirtyInfoToBlockIndices(sorted_dirty_info, &block_indices);
+
+  for (const auto &block_index : block_indices) {
+    // The block written by the previous snapshot is replaced.
+    auto iter = std::find_if(snapshot_blocks_.begin(), snapshot_blocks_.end(),
+                             [&](const auto &block) { return block.first == IntToSize(block_index); });
+    if (iter == snapshot_blocks_.end()) {
+      iter = snapshot_blocks_.emplace(snapshot_blocks_.end(), IntToSize(block_index), std::string());
+    }
+    const auto &block_meta_ptr = block_meta_list_.at(IntToSize(block_index));
+    MS_EXCEPTION_IF_NULL(block_meta_ptr);
+    size_t field_size = block_meta_ptr->Get<size_t>(kFieldsLength);
+    size_t offset = block_meta_ptr->Get<size_t>(kOffset);
+    std::string &content = iter->second;
+    content.resize(field_size * inputs.size());
+    for (size_t input_index = 0; input_index < inputs.size(); ++input_index) {
+      const char *data_ptr = reinterpret_cast<const char *>(std::get<1>(inputs[input_index])) + offset;
+      (void)memcpy(&content[input_index * field_size], data_ptr, field_size);
+    }
+  }
+}
+
+void LocalFile::WriteSnapshot() {
+  std::vector<std::pair<size_t, std::string>> snapshot_blocks;
+  {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    snapshot_blocks.swap(snapshot_blocks_);
+  }
+  for (const auto &block : snapshot_blocks) {
+    const auto &block_ptr = block_list_.at(block.first);
+    MS_EXCEPTION_IF_NULL(block_ptr);
+    if (!FileIOUtils::Write(block_ptr->block_file_name(), {{block.second.data(), block.second.size()}})) {
+      MS_LOG(EXCEPTION) << "Write to block file[" << block_ptr->block_file_name() << "] failed.";
+    }
+    ChangeFileMode(block_ptr->block_file_name(), S_IRWXU | S_IRWXG | S_IRWXO);
+    block_ptr->GenSha256Seq(block.second.data(), block.second.size());
+  }
+}
+
 void LocalFile::WriteBlockFiles(const std::vector<InputData> &inputs) {
   if (inputs.empty()) {
     MS_LOG(EXCEPTION) << "The inputs is empty";
@@ -197,30 +265,88 @@ void LocalFile::Read(const std::vector<OutputData> &outputs) {
     }
   }
 
-  // Read all block files.
-  for (size_t block_index = 0; block_index < block_list_.size(); ++block_index) {
-    std::vector<std::pair<void *, size_t>> block_output_data;
-    const auto &block_meta_ptr = block_meta_list_[block_index];
-    MS_EXCEPTION_IF_NULL(block_meta_ptr);
-    size_t field_size = block_meta_ptr->Get<size_t>(kFieldsLength);
-    size_t offset = block_meta_ptr->Get<size_t>(kOffset);
+  // Read all block files in parallel.
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  size_t block_num = block_list_.size();
+  size_t thread_num = std::max(std::min(thread_pool.GetSyncRunThreadNum(), block_num), static_cast<size_t>(1));
+  std::atomic_bool success{true};
+  std::vector<common::Task> tasks;
+  for (size_t i = 0; i < thread_num; ++i) {
+    (void)tasks.emplace_back([this, i, thread_num, block_num, &outputs, &success]() {
+      for (size_t block_index = i; block_index < block_num && success; block_index += thread_num) {
+        if (!ReadOneBlockFile(block_index, outputs)) {
+          success = false;
+        }
+      }
+      return common::SUCCESS;
+    });
+  }
+  (void)thread_pool.SyncRun(tasks);
+  if (!success) {
+    MS_LOG(EXCEPTION) << "Read block files failed, file path [" << file_path_ << "]";
+  }
+}
 
-    for (size_t output_index = 0; output_index < outputs.size(); ++output_index) {
-      void *data_ptr = reinterpret_cast<char *>(std::get<0>(outputs[output_index])) + offset;
-      size_t data_size = field_size;
-      (void)block_output_data.emplace_back(data_ptr, data_size);
-    }
+bool LocalFile::ReadOneBlockFile(size_t block_index, const std::vector<OutputData> &outputs) const {
+  const auto &block_meta_ptr = block_meta_list_[block_index];
+  MS_EXCEPTION_IF_NULL(block_meta_ptr);
+  size_t field_size = block_meta_ptr->Get<size_t>(kFieldsLength);
+  size_t offset = block_meta_ptr->Get<size_t>(kOffset);
+  const auto &block_ptr = block_list_[block_index];
+  MS_EXCEPTION_IF_NULL(block_ptr);
+  const std::string &file_name = block_ptr->block_file_name();
 
-    const auto &block_ptr = block_list_[block_index];
-    MS_EXCEPTION_IF_NULL(block_ptr);
-    if (!block_ptr->CheckSha256Seq()) {
-      MS_LOG(EXCEPTION) << "CheckSha256 failed, file name [" << block_ptr->block_file_name() << "]";
-    }
+#if defined(_WIN32) || defined(_WIN64)
+  // The block file is read for the sha256 check and the copy separately, as there is no mmap on windows.
+  if (!block_ptr->CheckSha256Seq()) {
+    MS_LOG(ERROR) << "CheckSha256 failed, file name [" << file_name << "]";
+    return false;
+  }
+  std::vector<std::pair<void *, size_t>> block_output_data;
+  for (size_t output_index = 0; output_index < outputs.size(); ++output_index) {
+    void *data_ptr = reinterpret_cast<char *>(std::get<0>(outputs[output_index])) + offset;
+    (void)block_output_data.emplace_back(data_ptr, field_size);
+  }
+  if (!FileIOUtils::Read(file_name, block_output_data)) {
+    MS_LOG(ERROR) << "Read block file failed, file name [" << file_name << "]";
+    return false;
+  }
+  return true;
+#else
+  // Map the block file, so it is read once for both the sha256 check and the copy.
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open block file failed, file name [" << file_name << "]";
+    return false;
+  }
+  size_t file_size = field_size * outputs.size();
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < file_size || file_size == 0) {
+    (void)close(fd);
+    MS_LOG(ERROR) << "The size of block file [" << file_name << "] is less than expected size: " << file_size;
+    return false;
+  }
+  file_size = static_cast<size_t>(file_stat.st_size);
+  void *mapped = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  if (mapped == MAP_FAILED) {
+    MS_LOG(ERROR) << "Map block file failed, file name [" << file_name << "]";
+    return false;
+  }
+  (void)madvise(mapped, file_size, MADV_SEQUENTIAL);
 
-    if (!FileIOUtils::Read(block_ptr->block_file_name(), block_output_data)) {
-      MS_LOG(EXCEPTION) << "Read block file failed, file name [" << block_ptr->block_file_name() << "]";
+  bool ret = block_ptr->CheckSha256Seq(mapped, file_size);
+  if (ret) {
+    for (size_t output_index = 0; output_index < outputs.size(); ++output_index) {
+      char *data_ptr = reinterpret_cast<char *>(std::get<0>(outputs[output_index])) + offset;
+      (void)memcpy(data_ptr, static_cast<const char *>(mapped) + output_index * field_size, field_size);
     }
+  } else {
+    MS_LOG(ERROR) << "CheckSha256 failed, file name [" << file_name << "]";
   }
+  (void)munmap(mapped, file_size);
+  return ret;
+#endif
 }
 
 bool LocalFile::LoadBlocksInfo() {
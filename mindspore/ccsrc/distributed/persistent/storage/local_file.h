@@ -19,7 +19,9 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "distributed/persistent/storage/storage.h"
@@ -59,9 +61,18 @@ class LocalFile : public StorageBase {
   // Write the entire blob data composed of multiple tensors to the block files on disk:
   void Write(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info = {}) override;
 
+  // The following two methods are override version function for Snapshot:
+  // Copy the blocks related to the dirty info to the snapshot in memory. It only takes a memory copy, and the inputs
+  // can be modified after it returns. At the first time, all the block files are written directly from the inputs.
+  void Snapshot(const InputData &input, const DirtyInfo &dirty_info = {}) override;
+  void Snapshot(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info = {}) override;
+
+  // Write the blocks of the snapshot to the block files and generate sha256 sequence from memory.
+  void WriteSnapshot() override;
+
   // The following two methods are override version function for Read:
   // 1.Tamper proof check.
-  // 2.Read all block files and merge them into contiguous memory.
+  // 2.Read all block files in parallel and merge them into contiguous memory.
   // Read data from all block files in file_path_(dir):
   void Read(const OutputData &output) override;
   // Read data from all block files in file_path_(dir) for multiple tensors.
@@ -71,6 +82,10 @@ class LocalFile : public StorageBase {
   // Create blocks and block metas and write input data to block files.
   void WriteBlockFiles(const std::vector<InputData> &inputs);
 
+  // Map one block file into memory, or read it on windows, check sha256 and copy it to the outputs, return false if it
+  // fails.
+  bool ReadOneBlockFile(size_t block_index, const std::vector<OutputData> &outputs) const;
+
   // Write shardding data to one specific block file by block index and generate sha256.
   void WriteOneBlockFile(size_t block_index, const std::vector<InputData> &inputs) const;
 
@@ -96,6 +111,10 @@ class LocalFile : public StorageBase {
 
   // Indicates whether block files has been created.
   bool finish_create_block_files_{false};
+
+  // The block indices and the contents of the blocks copied by Snapshot and not written yet.
+  std::vector<std::pair<size_t, std::string>> snapshot_blocks_;
+  std::mutex snapshot_mutex_;
 };
 }  // namespace storage
 }  // namespace distributed
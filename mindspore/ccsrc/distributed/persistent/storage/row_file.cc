@@ -0,0 +1,115 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/persistent/storage/row_file.h"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <vector>
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+namespace {
+constexpr char kRowFileTemplate[] = "/row_file_XXXXXX";
+}  // namespace
+
+RowFile::~RowFile() {
+  if (fd_ >= 0) {
+    (void)close(fd_);
+  }
+}
+
+bool RowFile::Open() {
+  if (record_size_ == 0) {
+    MS_LOG(ERROR) << "The record size of the file in the directory " << dir_path_ << " is 0.";
+    return false;
+  }
+  if (fd_ >= 0) {
+    return true;
+  }
+  // The mkstemp creates the file exclusively with the mode 0600, so an existing file of the directory is never opened.
+  std::string path_template = dir_path_ + kRowFileTemplate;
+  std::vector<char> file_path(path_template.begin(), path_template.end());
+  file_path.push_back('\0');
+  fd_ = mkstemp(file_path.data());
+  if (fd_ < 0) {
+    MS_LOG(ERROR) << "Failed to create the file in the directory " << dir_path_ << ", errno: " << errno;
+    return false;
+  }
+  file_path_ = file_path.data();
+  if (unlink(file_path_.c_str()) != 0) {
+    MS_LOG(WARNING) << "Failed to unlink the file " << file_path_ << ", errno: " << errno;
+  }
+  return true;
+}
+
+bool RowFile::IsValid(int64_t index) const {
+  return fd_ >= 0 && index >= 0 && static_cast<size_t>(index) < record_used_.size() && record_used_[index];
+}
+
+int64_t RowFile::Write(const void *data) {
+  if (fd_ < 0 || data == nullptr) {
+    MS_LOG(ERROR) << "The file " << file_path_ << " is not opened or the data is null.";
+    return -1;
+  }
+  int64_t index;
+  if (free_records_.empty()) {
+    index = static_cast<int64_t>(record_used_.size());
+    record_used_.push_back(false);
+  } else {
+    index = free_records_.back();
+    free_records_.pop_back();
+  }
+  auto written = pwrite(fd_, data, record_size_, static_cast<off_t>(index * record_size_));
+  if (written != static_cast<ssize_t>(record_size_)) {
+    MS_LOG(ERROR) << "Failed to write the record " << index << " of the file " << file_path_ << ", errno: " << errno;
+    free_records_.push_back(index);
+    return -1;
+  }
+  record_used_[index] = true;
+  record_used_num_++;
+  return index;
+}
+
+bool RowFile::Read(int64_t index, void *data) const {
+  if (!IsValid(index) || data == nullptr) {
+    MS_LOG(ERROR) << "The record " << index << " of the file " << file_path_ << " is not written.";
+    return false;
+  }
+  auto read = pread(fd_, data, record_size_, static_cast<off_t>(index * record_size_));
+  if (read != static_cast<ssize_t>(record_size_)) {
+    MS_LOG(ERROR) << "Failed to read the record " << index << " of the file " << file_path_ << ", errno: " << errno;
+    return false;
+  }
+  return true;
+}
+
+void RowFile::Free(int64_t index) {
+  if (!IsValid(index)) {
+    return;
+  }
+  record_used_[index] = false;
+  record_used_num_--;
+  free_records_.push_back(index);
+}
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
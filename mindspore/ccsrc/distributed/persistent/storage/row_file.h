@@ -0,0 +1,70 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_ROW_FILE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_ROW_FILE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+// Class RowFile stores the records of the same size in a local file and reads or writes a single record in place,
+// which is used to spill the cold rows of the embedding tables to the local disk. The records are addressed by their
+// indices, and the space of the freed records is reused by the later writes.
+class RowFile {
+ public:
+  RowFile(const std::string &dir_path, size_t record_size) : dir_path_(dir_path), record_size_(record_size) {}
+  ~RowFile();
+
+  // Create a file of a unique name in the directory, which is only accessible by the current user, return false if the
+  // file can not be created. The file is unlinked once it is created, so it is not left after the process exits.
+  bool Open();
+
+  // Write a record to a free position of the file, return the index of the record or -1 if it fails.
+  int64_t Write(const void *data);
+
+  // Read the record of the index, return false if the record is not written or it fails.
+  bool Read(int64_t index, void *data) const;
+
+  // Free the record of the index, and its space is reused by the later writes.
+  void Free(int64_t index);
+
+  // The number of the records which are written and not freed.
+  size_t record_num() const { return record_used_num_; }
+
+  const std::string &file_path() const { return file_path_; }
+
+ private:
+  bool IsValid(int64_t index) const;
+
+  std::string dir_path_;
+  std::string file_path_;
+  size_t record_size_;
+  int fd_{-1};
+
+  // Whether each record of the file is in use, and the indices of the freed records.
+  std::vector<bool> record_used_;
+  std::vector<int64_t> free_records_;
+  size_t record_used_num_{0};
+};
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_ROW_FILE_H_
@@ -53,6 +53,16 @@ class StorageBase {
   // The parameter dirty_info is optional, indicating that the part of the Tensor that needs to be rewritten to storage.
   virtual void Write(const std::vector<InputData> &input, const DirtyInfo &dirty_info = {}) {}
 
+  // Copy the part of the input related to the dirty info to a snapshot, which is written to storage medium later by
+  // WriteSnapshot, so the input can be modified while the snapshot is being written.
+  virtual void Snapshot(const InputData &input, const DirtyInfo &dirty_info = {}) {}
+
+  // Copy the part of the inputs composed of multiple tensors related to the dirty info to a snapshot.
+  virtual void Snapshot(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info = {}) {}
+
+  // Write the snapshot to storage medium.
+  virtual void WriteSnapshot() {}
+
   // Read data from the storage medium or memory buffer and merge them into contiguous memory.
   virtual void Read(const OutputData &output) {}
 
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_BUFFER_MESSAGE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_BUFFER_MESSAGE_H_
+
+#include <vector>
+#include <utility>
+#include <functional>
+
+#include "actor/msg.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+// The message carries the buffers owned by others besides the body, such as the memory of tensors. The buffers are
+// sent after the body by one writev without being copied into the body, and they are received into one data buffer
+// allocated by the allocate callback of the server, so the data is not copied out of the body either.
+// The release callback is called when the message is deleted, that is after the buffers are sent or the message is
+// dropped on the sender, and after the message is handled on the receiver unless the handler takes over the data.
+class BufferMessage : public MessageBase {
+ public:
+  BufferMessage() = default;
+  ~BufferMessage() override {
+    if (release_callback_ != nullptr) {
+      release_callback_();
+    }
+  }
+
+  // The buffer must be alive until the message is deleted.
+  void AddBuffer(void *data, size_t size) {
+    (void)buffers_.emplace_back(data, size);
+    buffers_size_ += size;
+  }
+  const std::vector<std::pair<void *, size_t>> &buffers() const { return buffers_; }
+  size_t buffers_size() const { return buffers_size_; }
+
+  void set_release_callback(const std::function<void()> &release_callback) { release_callback_ = release_callback; }
+
+ private:
+  std::vector<std::pair<void *, size_t>> buffers_;
+  size_t buffers_size_{0};
+  std::function<void()> release_callback_{nullptr};
+};
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_BUFFER_MESSAGE_H_
@@ -21,6 +21,7 @@
 
 #include "distributed/rpc/tcp/tcp_socket_operation.h"
 #include "distributed/rpc/tcp/connection_pool.h"
+#include "distributed/rpc/tcp/buffer_message.h"
 
 namespace mindspore {
 namespace distributed {
@@ -332,6 +333,18 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
       send_msg_header.to_len = htonl(static_cast<uint32_t>(send_to.size()));
       send_msg_header.from_len = htonl(static_cast<uint32_t>(send_from.size()));
       send_msg_header.body_len = htonl(static_cast<uint32_t>(msg->body.size()));
+      // The buffers of BufferMessage follow the body in the same writev.
+      auto buffer_msg = dynamic_cast<BufferMessage *>(msg);
+      size_t data_len = (buffer_msg == nullptr) ? 0 : buffer_msg->buffers_size();
+      // The buffer number and size are checked by TCPComm::Send before the message is queued.
+      send_msg_header.data_len = htonl(static_cast<uint32_t>(data_len));
+      bool data_in_shm = (data_len > 0 && WriteSharedMemory(buffer_msg));
+      uint32_t shm_flag = (send_ring == nullptr) ? 0 : (SHM_FLAG_RING | (data_in_shm ? SHM_FLAG_DATA : 0));
+      send_msg_header.shm_flag = htonl(shm_flag);
+      send_msg_header.shm_id = htonl((send_ring == nullptr) ? 0 : static_cast<uint32_t>(send_ring->shm_id()));
+      uint64_t shm_token = (send_ring == nullptr) ? 0 : send_ring->token();
+      send_msg_header.shm_token_high = htonl(static_cast<uint32_t>(shm_token >> 32));
+      send_msg_header.shm_token_low = htonl(static_cast<uint32_t>(shm_token & UINT32_MAX));
 
       send_io_vec[index].iov_base = &send_msg_header;
       send_io_vec[index].iov_len = sizeof(send_msg_header);
@@ -348,14 +361,21 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
       send_io_vec[index].iov_base = const_cast<char *>(msg->body.data());
       send_io_vec[index].iov_len = msg->body.size();
       ++index;
+      if (buffer_msg != nullptr && !data_in_shm) {
+        for (const auto &buffer : buffer_msg->buffers()) {
+          send_io_vec[index].iov_base = buffer.first;
+          send_io_vec[index].iov_len = buffer.second;
+          ++index;
+        }
+      }
       send_kernel_msg.msg_iov = send_io_vec;
       send_kernel_msg.msg_iovlen = IntToSize(index);
-      total_send_len =
-        UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + msg->body.size();
+      total_send_len = UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() +
+                       msg->body.size() + (data_in_shm ? 0 : data_len);
       send_message = msg;
 
       // update metrics
-      send_metrics->UpdateMax(msg->body.size());
+      send_metrics->UpdateMax(msg->body.size() + data_len);
       send_metrics->last_send_msg_name = msg->name;
 
       return;
@@ -390,16 +410,53 @@ void Connection::FillRecvMessage() {
   size_t recvToLen = static_cast<size_t>(recv_msg_header.to_len);
   size_t recvFromLen = static_cast<size_t>(recv_msg_header.from_len);
   size_t recvBodyLen = static_cast<size_t>(recv_msg_header.body_len);
+  size_t recvDataLen = static_cast<size_t>(recv_msg_header.data_len);
   if (recvNameLen > MAX_KMSG_NAME_LEN || recvToLen > MAX_KMSG_TO_LEN || recvFromLen > MAX_KMSG_FROM_LEN ||
-      recvBodyLen > MAX_KMSG_BODY_LEN) {
+      recvBodyLen > MAX_KMSG_BODY_LEN || recvDataLen > MAX_KMSG_DATA_LEN ||
+      (allocate_callback == nullptr && recvBodyLen + recvDataLen > MAX_KMSG_BODY_LEN)) {
     MS_LOG(ERROR) << "Drop invalid tcp data.";
     state = ConnectionState::kDisconnecting;
     return;
   }
+  if ((recv_msg_header.shm_flag & SHM_FLAG_RING) != 0) {
+    AttachSharedMemory();
+  }
+  bool data_in_shm = ((recv_msg_header.shm_flag & SHM_FLAG_DATA) != 0);
+  if (data_in_shm && recv_ring == nullptr) {
+    MS_LOG(ERROR) << "The data of message is in the shared memory " << recv_msg_header.shm_id << " not attached.";
+    state = ConnectionState::kDisconnecting;
+    return;
+  }
+
+  // The data of BufferMessage is received into the buffer allocated by the callback, or appended to the body.
+  void *data = nullptr;
+  if (recvDataLen > 0 && allocate_callback != nullptr) {
+    data = allocate_callback(recvDataLen);
+    if (data == nullptr) {
+      MS_LOG(ERROR) << "Failed to allocate the data buffer of size " << recvDataLen << " for received message.";
+      state = ConnectionState::kDisconnecting;
+      return;
+    }
+  }
 
   int i = 0;
-  MessageBase *msg = new (std::nothrow) MessageBase();
-  MS_EXCEPTION_IF_NULL(msg);
+  MessageBase *msg = nullptr;
+  if (data != nullptr) {
+    auto buffer_msg = new (std::nothrow) BufferMessage();
+    MS_EXCEPTION_IF_NULL(buffer_msg);
+    buffer_msg->AddBuffer(data, recvDataLen);
+    auto free_callback_copy = free_callback;
+    buffer_msg->set_release_callback([free_callback_copy, data]() {
+      if (free_callback_copy != nullptr) {
+        free_callback_copy(data);
+      }
+    });
+    msg = buffer_msg;
+  } else {
+    msg = new (std::nothrow) MessageBase();
+    MS_EXCEPTION_IF_NULL(msg);
+    recvBodyLen += recvDataLen;
+  }
 
   msg->name.resize(recvNameLen);
   recv_to.resize(recvToLen);
@@ -415,16 +472,68 @@ void Connection::FillRecvMessage() {
   recv_io_vec[i].iov_base = const_cast<char *>(recv_from.data());
   recv_io_vec[i].iov_len = recv_from.size();
   ++i;
+  // The data in the shared memory is not received through the socket.
+  size_t socket_body_len = msg->body.size() - ((data == nullptr && data_in_shm) ? recvDataLen : 0);
   recv_io_vec[i].iov_base = const_cast<char *>(msg->body.data());
-  recv_io_vec[i].iov_len = msg->body.size();
+  recv_io_vec[i].iov_len = socket_body_len;
   ++i;
+  if (data != nullptr && !data_in_shm) {
+    recv_io_vec[i].iov_base = data;
+    recv_io_vec[i].iov_len = recvDataLen;
+    ++i;
+  }
+  if (data_in_shm) {
+    void *dst = (data != nullptr) ? data : const_cast<char *>(msg->body.data()) + socket_body_len;
+    if (!recv_ring->Read(dst, recvDataLen)) {
+      delete msg;
+      state = ConnectionState::kDisconnecting;
+      return;
+    }
+  }
 
   recv_kernel_msg.msg_iov = recv_io_vec;
   recv_kernel_msg.msg_iovlen = IntToSize(i);
-  total_recv_len = UlongToUint(msg->name.size()) + recv_to.size() + recv_from.size() + msg->body.size();
+  total_recv_len = UlongToUint(msg->name.size()) + recv_to.size() + recv_from.size() + socket_body_len +
+                   ((data == nullptr || data_in_shm) ? 0 : recvDataLen);
   recv_message = msg;
 }
 
+bool Connection::WriteSharedMemory(const BufferMessage *msg) {
+  if (!send_ring_checked) {
+    send_ring_checked = true;
+    size_t capacity = SharedMemoryRing::TransportCapacity();
+    if (capacity > 0 && SocketOperation::IsLocalPeer(socket_fd)) {
+      send_ring = SharedMemoryRing::Create(capacity);
+    }
+  }
+  // The data is sent through the socket until the peer attaches the ring, or if the ring is full.
+  if (send_ring == nullptr || !send_ring->attached()) {
+    return false;
+  }
+  SharedMemoryBuffers buffers;
+  for (const auto &buffer : msg->buffers()) {
+    (void)buffers.emplace_back(buffer.first, buffer.second);
+  }
+  return send_ring->Write(buffers);
+}
+
+void Connection::AttachSharedMemory() {
+  if (recv_ring_checked) {
+    return;
+  }
+  recv_ring_checked = true;
+  // The shm id in the header of a remote peer refers to nothing on this host.
+  if (!SocketOperation::IsLocalPeer(socket_fd)) {
+    MS_LOG(WARNING) << "Ignore the shared memory advertised by the peer " << peer << " on another host.";
+    return;
+  }
+  uint64_t shm_token = (static_cast<uint64_t>(recv_msg_header.shm_token_high) << 32) | recv_msg_header.shm_token_low;
+  recv_ring = SharedMemoryRing::Attach(static_cast<int>(recv_msg_header.shm_id), shm_token);
+  if (recv_ring != nullptr) {
+    MS_LOG(INFO) << "Receive the data from " << peer << " through the shared memory " << recv_msg_header.shm_id;
+  }
+}
+
 int Connection::AddConnnectEventHandler() {
   return recv_event_loop->SetEventHandler(socket_fd, EPOLLIN | EPOLLHUP | EPOLLERR, NewConnectEventHandler,
                                           reinterpret_cast<void *>(this));
@@ -489,6 +598,11 @@ void Connection::ReorderHeader(MessageHeader *header) const {
   header->to_len = ntohl(header->to_len);
   header->from_len = ntohl(header->from_len);
   header->body_len = ntohl(header->body_len);
+  header->data_len = ntohl(header->data_len);
+  header->shm_flag = ntohl(header->shm_flag);
+  header->shm_id = ntohl(header->shm_id);
+  header->shm_token_high = ntohl(header->shm_token_high);
+  header->shm_token_low = ntohl(header->shm_token_low);
 }
 }  // namespace rpc
 }  // namespace distributed
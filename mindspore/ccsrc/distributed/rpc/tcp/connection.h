@@ -23,6 +23,7 @@
 #include <memory>
 
 #include "actor/msg.h"
+#include "distributed/shared_memory/shared_memory_ring.h"
 #include "distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/event_loop.h"
 #include "distributed/rpc/tcp/socket_operation.h"
@@ -30,6 +31,8 @@
 namespace mindspore {
 namespace distributed {
 namespace rpc {
+class BufferMessage;
+
 /*
  * The MessageHeader contains the stats info about the message body.
  */
@@ -49,6 +52,14 @@ struct MessageHeader {
   uint32_t to_len{0};
   uint32_t from_len{0};
   uint32_t body_len{0};
+  // The length of buffers sent after the body without copying, see BufferMessage.
+  uint32_t data_len{0};
+  // The shared memory ring of the sender for the peer on the same host, see SHM_FLAG_RING and SHM_FLAG_DATA.
+  uint32_t shm_flag{0};
+  uint32_t shm_id{0};
+  // The token of the shared memory ring, which the reader verifies before attaching the ring.
+  uint32_t shm_token_high{0};
+  uint32_t shm_token_low{0};
 };
 
 /*
@@ -194,7 +205,7 @@ struct Connection {
   struct msghdr recv_kernel_msg;
 
   struct iovec recv_io_vec[RECV_MSG_IO_VEC_LEN];
-  struct iovec send_io_vec[SEND_MSG_IO_VEC_LEN];
+  struct iovec send_io_vec[SEND_MSG_IO_VEC_LEN + MAX_MSG_BUFFER_NUM];
 
   ParseType recv_message_type{kUnknown};
 
@@ -207,6 +218,17 @@ struct Connection {
   // Function for handling received messages.
   MessageHandler message_handler;
 
+  // Functions for allocating and freeing the data buffer of received messages, the data is appended to the body if
+  // they are not set.
+  MemAllocateCallback allocate_callback;
+  MemFreeCallback free_callback;
+
+  // The shared memory rings for sending the data of BufferMessage to the peer on the same host and receiving from it.
+  SharedMemoryRingPtr send_ring;
+  SharedMemoryRingPtr recv_ring;
+  bool send_ring_checked{false};
+  bool recv_ring_checked{false};
+
   // Buffer for messages to be sent.
   std::queue<MessageBase *> send_message_queue;
 
@@ -225,6 +247,12 @@ struct Connection {
   // Make a http message based on given input message.
   std::string GenerateHttpMessage(MessageBase *msg);
 
+  // Write the buffers of message into the shared memory ring if the peer is on the same host and has attached it.
+  bool WriteSharedMemory(const BufferMessage *msg);
+
+  // Attach the shared memory ring of the sender on the same host once it is advertised in the message header.
+  void AttachSharedMemory();
+
   // Change the header body from network byte order to host byte order.
   void ReorderHeader(MessageHeader *header) const;
 
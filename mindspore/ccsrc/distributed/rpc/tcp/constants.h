@@ -32,9 +32,17 @@ namespace rpc {
 using MessageHandler = std::function<void(const std::shared_ptr<MessageBase> &)>;
 using DeleteCallBack = void (*)(const std::string &from, const std::string &to);
 using ConnectionCallBack = void (*)(void *conn);
+// Allocate and free the data buffer of received BufferMessage.
+using MemAllocateCallback = std::function<void *(size_t size)>;
+using MemFreeCallback = std::function<void(void *ptr)>;
 
 constexpr int SEND_MSG_IO_VEC_LEN = 5;
-constexpr int RECV_MSG_IO_VEC_LEN = 4;
+constexpr int RECV_MSG_IO_VEC_LEN = 5;
+// The max number of buffers carried by one BufferMessage.
+constexpr size_t MAX_MSG_BUFFER_NUM = 16;
+// The sender advertises its shared memory ring in the message header, and the data of the message is in the ring.
+constexpr uint32_t SHM_FLAG_RING = 1;
+constexpr uint32_t SHM_FLAG_DATA = 2;
 
 constexpr unsigned int BUSMAGIC_LEN = 4;
 constexpr int SENDMSG_QUEUELEN = 1024;
@@ -44,6 +52,8 @@ constexpr size_t MAX_KMSG_FROM_LEN = 1024;
 constexpr size_t MAX_KMSG_TO_LEN = 1024;
 constexpr size_t MAX_KMSG_NAME_LEN = 1024;
 constexpr size_t MAX_KMSG_BODY_LEN = 104857600;
+// The max size of the buffers of BufferMessage, which are received into the memory allocated by the callback.
+constexpr size_t MAX_KMSG_DATA_LEN = 1073741824;
 
 enum ParseType { kTcpMsg = 1, kHttpReq, kHttpRsp, kUnknown };
 enum State { kMagicId = 1, kMsgHeader, kName, kDestination, kSource, kBody };
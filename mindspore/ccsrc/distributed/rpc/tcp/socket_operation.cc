@@ -24,6 +24,7 @@
 #include <netinet/tcp.h>
 #include <unistd.h>
 #include <csignal>
+#include <cstring>
 #include <system_error>
 
 #include "actor/log.h"
@@ -297,6 +298,26 @@ std::string SocketOperation::GetPeer(int sock_fd) {
   return peer;
 }
 
+bool SocketOperation::IsLocalPeer(int sock_fd) {
+  union SocketAddress local;
+  union SocketAddress peer;
+  socklen_t local_len = sizeof(struct sockaddr_storage);
+  socklen_t peer_len = sizeof(struct sockaddr_storage);
+  if (getsockname(sock_fd, &local.sa, &local_len) < 0 || getpeername(sock_fd, &peer.sa, &peer_len) < 0) {
+    MS_LOG(INFO) << "Failed to get the socket address, fd: " << sock_fd << ", errno: " << errno;
+    return false;
+  }
+  if (local.sa.sa_family != peer.sa.sa_family) {
+    return false;
+  }
+  if (local.sa.sa_family == AF_INET) {
+    return local.saIn.sin_addr.s_addr == peer.saIn.sin_addr.s_addr;
+  } else if (local.sa.sa_family == AF_INET6) {
+    return memcmp(&local.saIn6.sin6_addr, &peer.saIn6.sin6_addr, sizeof(struct in6_addr)) == 0;
+  }
+  return false;
+}
+
 int SocketOperation::Connect(int sock_fd, const struct sockaddr *sa, socklen_t saLen, uint16_t *boundPort) {
   int retval = 0;
 
@@ -48,6 +48,9 @@ class SocketOperation {
   // Get the address(ip:port) of the other end of the connection.
   static std::string GetPeer(int sock_fd);
 
+  // Whether the other end of the connection is on the same host, in which case the ip addresses of both ends are same.
+  static bool IsLocalPeer(int sock_fd);
+
   // Get socket address of the url.
   static bool GetSockAddr(const std::string &url, SocketAddress *addr);
 
@@ -22,6 +22,7 @@
 
 #include "actor/aid.h"
 #include "distributed/rpc/tcp/constants.h"
+#include "distributed/rpc/tcp/buffer_message.h"
 #include "distributed/rpc/tcp/tcp_socket_operation.h"
 
 namespace mindspore {
@@ -111,6 +112,8 @@ void OnAccept(int server, uint32_t events, void *arg) {
 
   conn->conn_mutex = tcpmgr->conn_mutex_;
   conn->message_handler = tcpmgr->message_handler_;
+  conn->allocate_callback = tcpmgr->allocate_callback_;
+  conn->free_callback = tcpmgr->free_callback_;
 
   conn->event_callback = TCPComm::EventCallBack;
   conn->write_callback = TCPComm::WriteCallBack;
@@ -170,6 +173,11 @@ TCPComm::~TCPComm() {
 
 void TCPComm::SetMessageHandler(MessageHandler handler) { message_handler_ = handler; }
 
+void TCPComm::SetMemoryCallback(const MemAllocateCallback &allocate_callback, const MemFreeCallback &free_callback) {
+  allocate_callback_ = allocate_callback;
+  free_callback_ = free_callback;
+}
+
 bool TCPComm::Initialize() {
   conn_pool_ = std::make_shared<ConnectionPool>();
   MS_EXCEPTION_IF_NULL(conn_pool_);
@@ -354,7 +362,33 @@ void TCPComm::DropMessage(MessageBase *msg) {
   ptr = nullptr;
 }
 
+namespace {
+// The buffers of message must fit in the io vector and the data length of message header.
+bool CheckMessageBuffers(const MessageBase *msg) {
+  auto buffer_msg = dynamic_cast<const BufferMessage *>(msg);
+  if (buffer_msg == nullptr) {
+    return true;
+  }
+  if (buffer_msg->buffers().size() > MAX_MSG_BUFFER_NUM) {
+    MS_LOG(ERROR) << "The buffer number " << buffer_msg->buffers().size() << " of message " << msg->name
+                  << " exceeds the limit " << MAX_MSG_BUFFER_NUM << ", to: " << msg->to.Url();
+    return false;
+  }
+  if (buffer_msg->buffers_size() > MAX_KMSG_DATA_LEN) {
+    MS_LOG(ERROR) << "The buffer size " << buffer_msg->buffers_size() << " of message " << msg->name
+                  << " exceeds the limit " << MAX_KMSG_DATA_LEN << ", to: " << msg->to.Url();
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
 int TCPComm::Send(MessageBase *msg) {
+  // The invalid message is dropped before it is queued, as the send event loop can't report the error.
+  if (!CheckMessageBuffers(msg)) {
+    DropMessage(msg);
+    return SENDMSG_DROPED;
+  }
   return send_event_loop_->AddTask([msg, this] {
     std::lock_guard<std::mutex> lock(*conn_mutex_);
     // Search connection by the target address
@@ -412,6 +446,8 @@ void TCPComm::Connect(const std::string &dst_url) {
       conn->send_event_loop = this->send_event_loop_;
       conn->conn_mutex = conn_mutex_;
       conn->message_handler = message_handler_;
+      conn->allocate_callback = allocate_callback_;
+      conn->free_callback = free_callback_;
       conn->InitSocketOperation();
 
       // Create the client socket.
@@ -475,6 +511,8 @@ Connection *TCPComm::CreateDefaultConn(std::string to) {
   conn->send_event_loop = this->send_event_loop_;
   conn->conn_mutex = conn_mutex_;
   conn->message_handler = message_handler_;
+  conn->allocate_callback = allocate_callback_;
+  conn->free_callback = free_callback_;
   conn->InitSocketOperation();
   return conn;
 }
@@ -70,6 +70,9 @@ class TCPComm {
   // Set the message processing handler.
   void SetMessageHandler(MessageHandler handler);
 
+  // Set the callbacks to allocate and free the data buffer of received BufferMessage.
+  void SetMemoryCallback(const MemAllocateCallback &allocate_callback, const MemFreeCallback &free_callback);
+
   // Get the file descriptor of server socket.
   int GetServerFd();
 
@@ -104,6 +107,10 @@ class TCPComm {
   // User defined handler for Handling received messages.
   MessageHandler message_handler_;
 
+  // User defined callbacks for the data buffer of received messages.
+  MemAllocateCallback allocate_callback_;
+  MemFreeCallback free_callback_;
+
   // All the connections share the same read and write event loop objects.
   EventLoop *recv_event_loop_;
   EventLoop *send_event_loop_;
@@ -32,6 +32,10 @@ void TCPServer::Finalize() {
 
 void TCPServer::SetMessageHandler(MessageHandler handler) { tcp_comm_->SetMessageHandler(handler); }
 
+void TCPServer::SetMemoryCallback(const MemAllocateCallback &allocate_callback, const MemFreeCallback &free_callback) {
+  tcp_comm_->SetMemoryCallback(allocate_callback, free_callback);
+}
+
 std::string TCPServer::GetIP() { return ip_; }
 
 uint32_t TCPServer::GetPort() { return port_; }
@@ -43,6 +43,10 @@ class TCPServer {
   // Set the message processing handler.
   void SetMessageHandler(MessageHandler handler);
 
+  // Set the callbacks to allocate and free the data buffer of received BufferMessage, so the data is received into
+  // the allocated memory directly.
+  void SetMemoryCallback(const MemAllocateCallback &allocate_callback, const MemFreeCallback &free_callback);
+
   // Return the IP and port binded by this server.
   std::string GetIP();
   uint32_t GetPort();
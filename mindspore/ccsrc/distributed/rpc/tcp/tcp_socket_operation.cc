@@ -84,13 +84,13 @@ int TCPSocketOperation::ReceiveMessage(Connection *connection, struct msghdr *re
               reinterpret_cast<char *>(recvMsg->msg_iov[i].iov_base) + static_cast<unsigned int>(retval) - tmpLen;
 
             recvMsg->msg_iov = &recvMsg->msg_iov[i];
-            recvMsg->msg_iovlen -= (i + 1);
+            recvMsg->msg_iovlen -= i;
             break;
           }
         }
       }
     } else if (retval == 0) {
-      return UintToInt(-1);
+      return -1;
     } else {
       if (EAGAIN == errno) {
         return recvLen - totalRecvLen;
@@ -140,7 +140,7 @@ int TCPSocketOperation::SendMessage(Connection *connection, struct msghdr *sendM
             reinterpret_cast<char *>(sendMsg->msg_iov[i].iov_base) + static_cast<unsigned int>(retval) - tmpBytes;
 
           sendMsg->msg_iov = &sendMsg->msg_iov[i];
-          sendMsg->msg_iovlen -= (i + 1);
+          sendMsg->msg_iovlen -= i;
           break;
         }
       }
@@ -0,0 +1,184 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/shared_memory/shared_memory_ring.h"
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace distributed {
+namespace {
+constexpr size_t kMBToByte = 1 << 20;
+constexpr size_t kControlSize = 256;
+// The magic at the beginning of the control block, which is "MSSHMRNG".
+constexpr uint64_t kRingMagic = 0x474E524D4853534D;
+
+// Copy the data into the ring at the offset, wrapping around the end of the ring.
+void CopyIntoRing(uint8_t *ring, size_t capacity, uint64_t offset, const void *data, size_t size) {
+  size_t pos = static_cast<size_t>(offset % capacity);
+  size_t first = std::min(size, capacity - pos);
+  (void)memcpy(ring + pos, data, first);
+  if (size > first) {
+    (void)memcpy(ring, static_cast<const uint8_t *>(data) + first, size - first);
+  }
+}
+
+void CopyFromRing(const uint8_t *ring, size_t capacity, uint64_t offset, void *data, size_t size) {
+  size_t pos = static_cast<size_t>(offset % capacity);
+  size_t first = std::min(size, capacity - pos);
+  (void)memcpy(data, ring + pos, first);
+  if (size > first) {
+    (void)memcpy(static_cast<uint8_t *>(data) + first, ring, size - first);
+  }
+}
+}  // namespace
+
+SharedMemoryRing::SharedMemoryRing(int shm_id, void *addr, bool is_writer)
+    : shm_id_(shm_id),
+      control_(static_cast<Control *>(addr)),
+      data_(static_cast<uint8_t *>(addr) + kControlSize),
+      is_writer_(is_writer) {}
+
+SharedMemoryRing::~SharedMemoryRing() {
+  if (shmdt(control_) != 0) {
+    MS_LOG(WARNING) << "Failed to detach the shared memory " << shm_id_ << ", errno: " << errno;
+  }
+  // The segment is destroyed after both sides detach it, and the reader has removed it already if attached.
+  if (is_writer_) {
+    (void)shmctl(shm_id_, IPC_RMID, nullptr);
+  }
+}
+
+std::shared_ptr<SharedMemoryRing> SharedMemoryRing::Create(size_t capacity) {
+  static_assert(sizeof(Control) <= kControlSize, "The control block exceeds the reserved size.");
+  static_assert(std::atomic<uint64_t>::is_always_lock_free, "The ring requires lock free atomics in shared memory.");
+  if (capacity == 0) {
+    return nullptr;
+  }
+  int shm_id = shmget(IPC_PRIVATE, kControlSize + capacity, IPC_CREAT | IPC_EXCL | S_IRUSR | S_IWUSR);
+  if (shm_id == -1) {
+    MS_LOG(WARNING) << "Failed to create the shared memory of size " << capacity << ", errno: " << errno;
+    return nullptr;
+  }
+  void *addr = shmat(shm_id, nullptr, 0);
+  if (addr == reinterpret_cast<void *>(-1)) {
+    MS_LOG(WARNING) << "Failed to attach the shared memory " << shm_id << ", errno: " << errno;
+    (void)shmctl(shm_id, IPC_RMID, nullptr);
+    return nullptr;
+  }
+  auto control = new (addr) Control();
+  std::random_device random_device;
+  control->magic = kRingMagic;
+  control->token = (static_cast<uint64_t>(random_device()) << 32) | static_cast<uint64_t>(random_device());
+  control->capacity = capacity;
+  control->attached.store(0, std::memory_order_relaxed);
+  control->head.store(0, std::memory_order_relaxed);
+  control->tail.store(0, std::memory_order_relaxed);
+  return std::shared_ptr<SharedMemoryRing>(new SharedMemoryRing(shm_id, addr, true));
+}
+
+std::shared_ptr<SharedMemoryRing> SharedMemoryRing::Attach(int shm_id, uint64_t token) {
+  // Only the segment of the same user which is large enough for the control block may be a ring.
+  struct shmid_ds shm_info {};
+  if (shmctl(shm_id, IPC_STAT, &shm_info) != 0) {
+    MS_LOG(WARNING) << "Failed to get the status of the shared memory " << shm_id << " of peer, errno: " << errno;
+    return nullptr;
+  }
+  if (shm_info.shm_perm.uid != geteuid() || shm_info.shm_segsz <= kControlSize) {
+    MS_LOG(WARNING) << "The shared memory " << shm_id << " of peer is not a ring of the current user.";
+    return nullptr;
+  }
+  void *addr = shmat(shm_id, nullptr, 0);
+  if (addr == reinterpret_cast<void *>(-1)) {
+    MS_LOG(WARNING) << "Failed to attach the shared memory " << shm_id << " of peer, errno: " << errno;
+    return nullptr;
+  }
+  // Verify the ring before removing the segment or writing into it.
+  auto control = static_cast<Control *>(addr);
+  uint32_t unattached = 0;
+  if (control->magic != kRingMagic || control->token != token || control->capacity == 0 ||
+      control->capacity > shm_info.shm_segsz - kControlSize ||
+      !control->attached.compare_exchange_strong(unattached, 1, std::memory_order_acq_rel)) {
+    MS_LOG(WARNING) << "The shared memory " << shm_id << " of peer is not a ring of the token or attached already.";
+    (void)shmdt(addr);
+    return nullptr;
+  }
+  // Remove the segment after both sides attach it, so it is released even if the writer exits abnormally.
+  (void)shmctl(shm_id, IPC_RMID, nullptr);
+  return std::shared_ptr<SharedMemoryRing>(new SharedMemoryRing(shm_id, addr, false));
+}
+
+size_t SharedMemoryRing::TransportCapacity() {
+  // The env is read when a connection checks the transport, which is opt-in.
+  const auto &env = common::GetEnv("MS_DEV_SHM_TRANSPORT_SIZE");
+  if (env.empty()) {
+    return 0;
+  }
+  try {
+    return static_cast<size_t>(std::stoul(env)) * kMBToByte;
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Invalid MS_DEV_SHM_TRANSPORT_SIZE: " << env << ", the shared memory transport is disabled.";
+    return 0;
+  }
+}
+
+size_t SharedMemoryRing::capacity() const { return static_cast<size_t>(control_->capacity); }
+
+bool SharedMemoryRing::attached() const { return control_->attached.load(std::memory_order_acquire) != 0; }
+
+bool SharedMemoryRing::Write(const SharedMemoryBuffers &buffers) {
+  size_t size = 0;
+  for (const auto &buffer : buffers) {
+    size += buffer.second;
+  }
+  size_t ring_capacity = capacity();
+  uint64_t head = control_->head.load(std::memory_order_relaxed);
+  uint64_t tail = control_->tail.load(std::memory_order_acquire);
+  if (ring_capacity - static_cast<size_t>(head - tail) < size) {
+    return false;
+  }
+  for (const auto &buffer : buffers) {
+    CopyIntoRing(data_, ring_capacity, head, buffer.first, buffer.second);
+    head += buffer.second;
+  }
+  control_->head.store(head, std::memory_order_release);
+  return true;
+}
+
+bool SharedMemoryRing::Read(void *data, size_t size) {
+  uint64_t tail = control_->tail.load(std::memory_order_relaxed);
+  uint64_t head = control_->head.load(std::memory_order_acquire);
+  if (static_cast<size_t>(head - tail) < size) {
+    MS_LOG(ERROR) << "The data size " << (head - tail) << " in the shared memory " << shm_id_
+                  << " is less than the expected size " << size;
+    return false;
+  }
+  CopyFromRing(data_, capacity(), tail, data, size);
+  control_->tail.store(tail + size, std::memory_order_release);
+  return true;
+}
+}  // namespace distributed
+}  // namespace mindspore
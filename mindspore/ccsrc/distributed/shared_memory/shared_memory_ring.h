@@ -0,0 +1,86 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_SHARED_MEMORY_SHARED_MEMORY_RING_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_SHARED_MEMORY_SHARED_MEMORY_RING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace distributed {
+// The buffers written into the ring as one record.
+using SharedMemoryBuffers = std::vector<std::pair<const void *, size_t>>;
+
+// SharedMemoryRing is a single producer single consumer byte ring in the System V shared memory, which moves the data
+// between the processes on the same host by memcpy. The writer creates the ring and tells the reader the shm id and
+// the random token of the ring through its own channel(eg. the message header on the socket), which keeps the order of
+// the records. The reader only attaches the ring of the same user whose magic and token match, and marks it attached in
+// the shared memory, and the writer only writes into the ring after that, so a reader which can't attach the ring(eg.
+// in another ipc namespace) keeps receiving the data through the channel.
+class SharedMemoryRing {
+ public:
+  ~SharedMemoryRing();
+
+  // Create the ring with the capacity in bytes, return nullptr if the shared memory is not available.
+  static std::shared_ptr<SharedMemoryRing> Create(size_t capacity);
+
+  // Attach the ring created by the writer process with the token of the ring, return nullptr if failed or the segment
+  // is not a ring of the token, which is left untouched.
+  static std::shared_ptr<SharedMemoryRing> Attach(int shm_id, uint64_t token);
+
+  // The ring capacity of the transport in bytes, which is set by the environment variable MS_DEV_SHM_TRANSPORT_SIZE
+  // in MB. The transport is disabled if it is not set or 0.
+  static size_t TransportCapacity();
+
+  int shm_id() const { return shm_id_; }
+  uint64_t token() const { return control_->token; }
+  size_t capacity() const;
+
+  // Whether the reader has attached the ring.
+  bool attached() const;
+
+  // Write the buffers as one record, return false if the free space of the ring is not enough.
+  bool Write(const SharedMemoryBuffers &buffers);
+
+  // Read the next size bytes of the ring, return false if the written data is less than the size.
+  bool Read(void *data, size_t size);
+
+ private:
+  // The control block at the beginning of the shared memory, the head and tail are the total bytes written and read.
+  struct Control {
+    uint64_t magic;
+    uint64_t token;
+    uint64_t capacity;
+    std::atomic<uint32_t> attached;
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+  };
+
+  SharedMemoryRing(int shm_id, void *addr, bool is_writer);
+
+  int shm_id_;
+  Control *control_;
+  uint8_t *data_;
+  bool is_writer_;
+};
+using SharedMemoryRingPtr = std::shared_ptr<SharedMemoryRing>;
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_SHARED_MEMORY_SHARED_MEMORY_RING_H_
@@ -15,19 +15,219 @@
  */
 
 #include "fl/server/collective_ops_impl.h"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <set>
 #include "fl/server/local_meta_store.h"
 #include "fl/server/iteration.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace fl {
 namespace server {
 namespace {
+using VectorPtr = ps::core::AbstractNode::VectorPtr;
+
 const char *kCollectivePhaseRing = "ring";
 const char *kCollectivePhaseGather = "gather";
 const char *kCollectivePhaseReduce = "reduce";
 const char *kCollectivePhaseBroadcast = "broadcast";
+const char *kCollectivePhaseDoubling = "doubling";
+const char *kCollectivePhaseHalving = "halving";
+const char *kCollectivePhaseHalvingGather = "halving_gather";
+const char *kCollectivePhaseLocalReduce = "local_reduce";
+const char *kCollectivePhaseLocalBroadcast = "local_broadcast";
+const char *kCollectivePhaseAllToAll = "all_to_all";
+
+// The segment size of the pipelined ring in bytes.
+constexpr size_t kPipelineSegmentSize = 1 << 20;
+// The AllReduce of the data smaller than it is latency bound, which uses the recursive doubling algorithm.
+constexpr size_t kSmallMessageSize = 64 << 10;
+// The AllReduce of the data smaller than it uses the recursive halving algorithm, and the larger uses the ring.
+constexpr size_t kMediumMessageSize = 4 << 20;
+
+enum class AllReduceAlgorithm {
+  kRing,
+  kPipelinedRing,
+  kRecursiveDoubling,
+  kRecursiveHalving,
+  kReduceBroadcast,
+  kHierarchical,
+  kAuto
+};
+
+// The AllReduce algorithm set by the environment variable MS_DEV_ALLREDUCE_ALGORITHM, which must be the same in all the
+// processes. The ring is used by default.
+AllReduceAlgorithm ConfiguredAllReduceAlgorithm() {
+  const std::map<std::string, AllReduceAlgorithm> algorithms = {
+    {"ring", AllReduceAlgorithm::kRing},
+    {"pipelined_ring", AllReduceAlgorithm::kPipelinedRing},
+    {"doubling", AllReduceAlgorithm::kRecursiveDoubling},
+    {"halving", AllReduceAlgorithm::kRecursiveHalving},
+    {"reduce_broadcast", AllReduceAlgorithm::kReduceBroadcast},
+    {"hierarchical", AllReduceAlgorithm::kHierarchical},
+    {"auto", AllReduceAlgorithm::kAuto}};
+  const auto &env = common::GetEnv("MS_DEV_ALLREDUCE_ALGORITHM");
+  if (env.empty()) {
+    return AllReduceAlgorithm::kRing;
+  }
+  auto iter = algorithms.find(env);
+  if (iter == algorithms.end()) {
+    MS_LOG(WARNING) << "Invalid MS_DEV_ALLREDUCE_ALGORITHM: " << env << ", the ring is used.";
+    return AllReduceAlgorithm::kRing;
+  }
+  return iter->second;
+}
+
+// The rings of AllReduce, AllGather and ReduceScatter are pipelined if the pipelined ring or the automatic algorithm
+// is configured.
+bool UsePipelinedRing() {
+  auto algorithm = ConfiguredAllReduceAlgorithm();
+  return algorithm == AllReduceAlgorithm::kPipelinedRing || algorithm == AllReduceAlgorithm::kAuto;
+}
+
+bool IsPowerOfTwo(size_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+// Split the data into rank_size chunks, and the rest of the data is assigned to the first chunks.
+void SplitChunks(size_t count, size_t rank_size, std::vector<size_t> *chunk_sizes, std::vector<size_t> *chunk_offset) {
+  chunk_sizes->assign(rank_size, count / rank_size);
+  for (size_t i = 0; i < count % rank_size; i++) {
+    (*chunk_sizes)[i]++;
+  }
+  chunk_offset->assign(rank_size, 0);
+  for (size_t i = 1; i < rank_size; i++) {
+    (*chunk_offset)[i] = (*chunk_offset)[i - 1] + (*chunk_sizes)[i - 1];
+  }
+}
+
+// The elements count of each segment in the pipelined algorithms.
+template <typename T>
+size_t SegmentCount() {
+  return std::max(kPipelineSegmentSize / sizeof(T), static_cast<size_t>(1));
+}
+
+// Add src to dst. The plain loop is vectorized by the compiler. The thread pool is not used, because the collective
+// operations could be called from the tasks of the pool.
+template <typename T>
+void ReduceSum(T *dst, const T *src, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    dst[i] += src[i];
+  }
+}
+
+// Get the hosts of the ranks, return empty if any of them is unknown.
+std::vector<std::string> GetRankHosts(const std::shared_ptr<ps::core::AbstractNode> &node, ps::core::NodeRole role,
+                                      const std::vector<uint32_t> &ranks) {
+  std::vector<std::string> hosts;
+  for (auto rank : ranks) {
+    auto ip = node->GetNodeIp(role, rank);
+    if (ip.empty()) {
+      return {};
+    }
+    hosts.push_back(ip);
+  }
+  return hosts;
+}
 }  // namespace
 
+// NodeCollectiveChannel is the channel over the node. The federated learning server matches the messages by the
+// collective meta of the iteration, and the other nodes match the messages from one rank in order.
+class NodeCollectiveChannel : public CollectiveChannel {
+ public:
+  // The channel of the federated learning server.
+  NodeCollectiveChannel(const std::shared_ptr<ps::core::ServerNode> &server_node, const std::string &data_name,
+                        uint32_t rank_id)
+      : node_(server_node),
+        is_fl_server_(true),
+        node_role_(ps::core::SERVER),
+        rank_id_(rank_id),
+        data_name_(data_name),
+        iteration_(LocalMetaStore::GetInstance().curr_iter_num()) {}
+
+  // The channel of the nodes with the same role.
+  NodeCollectiveChannel(const std::shared_ptr<ps::core::AbstractNode> &node, ps::core::NodeRole node_role,
+                        uint32_t rank_id)
+      : node_(node), is_fl_server_(false), node_role_(node_role), rank_id_(rank_id), iteration_(0) {}
+  ~NodeCollectiveChannel() override = default;
+
+  void Send(uint32_t dst_rank, const char *phase, size_t chunk_index, size_t for_index, const void *data,
+            size_t size) override {
+    if (size == 0) {
+      return;
+    }
+    uint64_t request_id;
+    if (is_fl_server_) {
+      request_id = node_->FlCollectiveSendAsync(Meta(rank_id_, dst_rank, phase, chunk_index, for_index), data, size);
+    } else {
+      request_id = node_->CollectiveSendAsync(node_role_, dst_rank, data, size);
+    }
+    send_request_ids_.push_back(request_id);
+  }
+
+  bool Recv(uint32_t src_rank, const char *phase, size_t chunk_index, size_t for_index, size_t expect_size,
+            VectorPtr *output) override {
+    if (expect_size == 0) {
+      *output = std::make_shared<std::vector<unsigned char>>();
+      return true;
+    }
+    if (is_fl_server_) {
+      if (!node_->FlCollectiveWait(Meta(src_rank, rank_id_, phase, chunk_index, for_index), expect_size, output,
+                                   kCollectiveCommTimeout)) {
+        MS_LOG(ERROR) << "FlCollectiveWait failed, send rank id: " << src_rank;
+        return false;
+      }
+      return true;
+    }
+    auto recv_req_id = node_->CollectiveReceiveAsync(node_role_, src_rank, output);
+    if (!node_->CollectiveWait(recv_req_id, kCollectiveCommTimeout)) {
+      MS_LOG(ERROR) << "CollectiveWait " << recv_req_id << " failed.";
+      return false;
+    }
+    if (*output == nullptr || (*output)->size() != expect_size) {
+      MS_LOG(ERROR) << "The data size received from rank " << src_rank << " is "
+                    << (*output == nullptr ? 0 : (*output)->size()) << ", but the expected size is " << expect_size;
+      return false;
+    }
+    return true;
+  }
+
+  bool WaitAll() override {
+    std::vector<uint64_t> request_ids;
+    request_ids.swap(send_request_ids_);
+    for (auto request_id : request_ids) {
+      if (!node_->Wait(request_id, kCollectiveCommTimeout)) {
+        MS_LOG(ERROR) << "Wait response of request " << request_id << " failed.";
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  ps::core::CollectiveMessageMeta Meta(uint32_t send_rank, uint32_t recv_rank, const char *phase, size_t chunk_index,
+                                       size_t for_index) const {
+    ps::core::CollectiveMessageMeta meta;
+    meta.set_enable_flag(true);
+    meta.set_send_rank_id(send_rank);
+    meta.set_recv_rank_id(recv_rank);
+    meta.set_iteration(iteration_);
+    meta.set_weight_name(data_name_);
+    meta.set_phase(phase);
+    meta.set_chunk_index(chunk_index);
+    meta.set_for_index(for_index);
+    return meta;
+  }
+
+  std::shared_ptr<ps::core::AbstractNode> node_;
+  bool is_fl_server_;
+  ps::core::NodeRole node_role_;
+  uint32_t rank_id_;
+  std::string data_name_;
+  size_t iteration_;
+  std::vector<uint64_t> send_request_ids_;
+};
+
 void CollectiveOpsImpl::Initialize(const std::shared_ptr<ps::core::ServerNode> &server_node) {
   MS_EXCEPTION_IF_NULL(server_node);
   server_node_ = server_node;
@@ -37,257 +237,458 @@ void CollectiveOpsImpl::Initialize(const std::shared_ptr<ps::core::ServerNode> &
 }
 
 template <typename T>
-bool CollectiveOpsImpl::RingAllReduce(const std::string &data_name, const void *sendbuff, void *recvbuff,
-                                      size_t count) {
-  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
-  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+bool CollectiveOpsImpl::RunAllReduce(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+                                     const std::vector<std::string> &hosts, T *buff, size_t count) {
+  MS_ERROR_IF_NULL_W_RET_VAL(channel, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  size_t rank_size = ranks.size();
+  if (rank_size <= 1) {
+    return true;
+  }
+  size_t data_size = count * sizeof(T);
+  bool power_of_two = IsPowerOfTwo(rank_size);
+  // The hierarchical algorithm helps only if the ranks are on multiple hosts and some host has multiple ranks.
+  std::set<std::string> host_set(hosts.begin(), hosts.end());
+  bool multi_level = host_set.size() > 1 && host_set.size() < rank_size;
 
-  if (recvbuff != sendbuff) {
-    size_t src_size = count * sizeof(T);
-    size_t dst_size = count * sizeof(T);
-    auto ret = memcpy_s(recvbuff, dst_size, sendbuff, src_size);
-    if (ret != 0) {
-      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-      return false;
+  auto algorithm = ConfiguredAllReduceAlgorithm();
+  if ((!power_of_two &&
+       (algorithm == AllReduceAlgorithm::kRecursiveDoubling || algorithm == AllReduceAlgorithm::kRecursiveHalving)) ||
+      (algorithm == AllReduceAlgorithm::kHierarchical && hosts.empty())) {
+    algorithm = AllReduceAlgorithm::kRing;
+  }
+  // Like the ring, the ReduceBroadcastAllReduce is used if the data is less than the rank size.
+  if ((algorithm == AllReduceAlgorithm::kRing || algorithm == AllReduceAlgorithm::kPipelinedRing) &&
+      count < rank_size) {
+    algorithm = AllReduceAlgorithm::kReduceBroadcast;
+  }
+  if (algorithm == AllReduceAlgorithm::kAuto) {
+    if (multi_level && data_size >= kSmallMessageSize) {
+      algorithm = AllReduceAlgorithm::kHierarchical;
+    } else if (data_size < kSmallMessageSize) {
+      if (power_of_two) {
+        algorithm = AllReduceAlgorithm::kRecursiveDoubling;
+      } else {
+        algorithm = count < rank_size ? AllReduceAlgorithm::kReduceBroadcast : AllReduceAlgorithm::kRing;
+      }
+    } else if (data_size < kMediumMessageSize && power_of_two) {
+      algorithm = AllReduceAlgorithm::kRecursiveHalving;
+    } else {
+      algorithm = AllReduceAlgorithm::kRing;
     }
   }
 
-  uint32_t rank_size = server_num_;
-  size_t chunk_size = count / rank_size;
-  size_t remainder_size = count % rank_size;
-  std::vector<size_t> chunk_sizes(rank_size, chunk_size);
-  // The rest of the data should be assigned to each chunk.
-  for (size_t i = 0; i < remainder_size; i++) {
-    chunk_sizes[i]++;
+  auto start_time = std::chrono::steady_clock::now();
+  bool ret = false;
+  switch (algorithm) {
+    case AllReduceAlgorithm::kRecursiveDoubling:
+      ret = RunRecursiveDoublingAllReduce<T>(channel, ranks, index, buff, count);
+      break;
+    case AllReduceAlgorithm::kRecursiveHalving:
+      ret = RunRecursiveHalvingAllReduce<T>(channel, ranks, index, buff, count);
+      break;
+    case AllReduceAlgorithm::kReduceBroadcast:
+      ret = RunReduceBroadcastAllReduce<T>(channel, ranks, index, buff, count);
+      break;
+    case AllReduceAlgorithm::kHierarchical:
+      ret = RunHierarchicalAllReduce<T>(channel, ranks, index, hosts, buff, count);
+      break;
+    default: {
+      std::vector<size_t> chunk_sizes;
+      std::vector<size_t> chunk_offset;
+      SplitChunks(count, rank_size, &chunk_sizes, &chunk_offset);
+      ret = RunRing<T>(channel, ranks, index, chunk_sizes, chunk_offset, buff, true, true);
+      break;
+    }
   }
-  // Store offsets to get every data chunk's address.
-  std::vector<size_t> chunk_offset;
-  for (size_t i = 0; i < rank_size; i++) {
-    size_t ofs =
-      std::accumulate(chunk_sizes.begin(), chunk_sizes.begin() + i, static_cast<size_t>(0), std::plus<size_t>());
-    chunk_offset.push_back(ofs);
+  auto cost_us =
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+  MS_LOG(DEBUG) << "AllReduce algorithm:" << static_cast<int>(algorithm) << ", rank_size:" << rank_size
+                << ", data size:" << data_size << ", cost:" << cost_us << "us, bus bandwidth:"
+                << (cost_us == 0 ? 0 : 2.0 * (rank_size - 1) / rank_size * data_size / cost_us) << "MB/s";
+  return ret;
+}
+
+template <typename T>
+bool CollectiveOpsImpl::RunRing(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+                                const std::vector<size_t> &chunk_sizes, const std::vector<size_t> &chunk_offset,
+                                T *buff, bool reduce_scatter, bool all_gather) {
+  if (UsePipelinedRing()) {
+    return RunPipelinedRing<T>(channel, ranks, index, chunk_sizes, chunk_offset, buff, reduce_scatter, all_gather);
   }
+  MS_ERROR_IF_NULL_W_RET_VAL(channel, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  size_t rank_size = ranks.size();
+  if (rank_size <= 1 || chunk_sizes.size() != rank_size || chunk_offset.size() != rank_size) {
+    return true;
+  }
+  uint32_t send_to_rank = ranks[(index + 1) % rank_size];
+  uint32_t recv_from_rank = ranks[(index + rank_size - 1) % rank_size];
+  // The chunk which is "distance" positions before this process.
+  auto chunk_before = [rank_size, index](size_t distance) { return (index + rank_size - distance) % rank_size; };
+  MS_LOG(DEBUG) << "Ring rank_size:" << rank_size << ", index:" << index << ", chunk_sizes:" << chunk_sizes
+                << ", send_to_rank:" << send_to_rank << ", recv_from_rank:" << recv_from_rank;
 
-  T *output_buff = reinterpret_cast<T *>(recvbuff);
-  uint32_t send_to_rank = (rank_id_ + 1) % rank_size;
-  uint32_t recv_from_rank = (rank_id_ - 1 + rank_size) % rank_size;
-  MS_LOG(DEBUG) << "AllReduce count:" << count << ", rank_size:" << rank_size << ", rank_id_:" << rank_id_
-                << ", chunk_size:" << chunk_size << ", remainder_size:" << remainder_size
-                << ", chunk_sizes:" << chunk_sizes << ", send_to_rank:" << send_to_rank
-                << ", recv_from_rank:" << recv_from_rank;
+  // Ring ReduceScatter: in step i, send the chunk i+1 positions before, which is reduced in the last step, and receive
+  // the chunk i+2 positions before to reduce it.
+  if (reduce_scatter) {
+    MS_LOG(DEBUG) << "Start Ring ReduceScatter.";
+    for (size_t step = 0; step < rank_size - 1; step++) {
+      size_t send_chunk_index = chunk_before(step + 1);
+      channel->Send(send_to_rank, kCollectivePhaseRing, send_chunk_index, step, buff + chunk_offset[send_chunk_index],
+                    chunk_sizes[send_chunk_index] * sizeof(T));
+      size_t recv_chunk_index = chunk_before(step + 2);
+      size_t recv_count = chunk_sizes[recv_chunk_index];
+      VectorPtr recv_str;
+      if (!channel->Recv(recv_from_rank, kCollectivePhaseRing, recv_chunk_index, step, recv_count * sizeof(T),
+                         &recv_str)) {
+        return false;
+      }
+      ReduceSum(buff + chunk_offset[recv_chunk_index], reinterpret_cast<const T *>(recv_str->data()), recv_count);
+      if (!channel->WaitAll()) {
+        return false;
+      }
+    }
+    MS_LOG(DEBUG) << "End Ring ReduceScatter.";
+  }
 
-  return RunRingAllReduce<T>(data_name, send_to_rank, recv_from_rank, chunk_sizes, chunk_offset, output_buff);
+  // Ring AllGather: in step i, send the chunk i positions before and receive the chunk i+1 positions before.
+  if (all_gather) {
+    MS_LOG(DEBUG) << "Start Ring AllGather.";
+    for (size_t step = 0; step < rank_size - 1; step++) {
+      size_t send_chunk_index = chunk_before(step);
+      channel->Send(send_to_rank, kCollectivePhaseGather, send_chunk_index, step,
+                    buff + chunk_offset[send_chunk_index], chunk_sizes[send_chunk_index] * sizeof(T));
+      size_t recv_chunk_index = chunk_before(step + 1);
+      size_t recv_size = chunk_sizes[recv_chunk_index] * sizeof(T);
+      VectorPtr recv_str;
+      if (!channel->Recv(recv_from_rank, kCollectivePhaseGather, recv_chunk_index, step, recv_size, &recv_str)) {
+        return false;
+      }
+      if (recv_size != 0) {
+        auto ret = memcpy_s(buff + chunk_offset[recv_chunk_index], recv_size, recv_str->data(), recv_str->size());
+        if (ret != 0) {
+          MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                        << ", dest size is " << recv_size << ", src size is " << recv_str->size();
+          return false;
+        }
+      }
+      if (!channel->WaitAll()) {
+        return false;
+      }
+    }
+    MS_LOG(DEBUG) << "End Ring AllGather.";
+  }
+  return true;
 }
 
-// Implementation of RingAllReduce.
 template <typename T>
-bool CollectiveOpsImpl::RunRingAllReduce(const std::string &data_name, uint32_t send_to_rank, uint32_t recv_from_rank,
+bool CollectiveOpsImpl::RunPipelinedRing(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
                                          const std::vector<size_t> &chunk_sizes,
-                                         const std::vector<size_t> &chunk_offset, T *output_buff) {
-  MS_ERROR_IF_NULL_W_RET_VAL(server_node_, false);
-  MS_ERROR_IF_NULL_W_RET_VAL(output_buff, false);
-  auto curr_iteration_num = LocalMetaStore::GetInstance().curr_iter_num();
-  ps::core::CollectiveMessageMeta send_meta;
-  send_meta.set_enable_flag(true);
-  send_meta.set_send_rank_id(rank_id_);
-  send_meta.set_recv_rank_id(send_to_rank);
-  send_meta.set_iteration(curr_iteration_num);
-  send_meta.set_weight_name(data_name);
-
-  ps::core::CollectiveMessageMeta recv_meta;
-  recv_meta.set_enable_flag(true);
-  recv_meta.set_send_rank_id(recv_from_rank);
-  recv_meta.set_recv_rank_id(rank_id_);
-  recv_meta.set_iteration(curr_iteration_num);
-  recv_meta.set_weight_name(data_name);
-
-  // Ring ReduceScatter.
-  MS_LOG(DEBUG) << "Start Ring ReduceScatter.";
-  send_meta.set_phase(kCollectivePhaseRing);
-  recv_meta.set_phase(kCollectivePhaseRing);
+                                         const std::vector<size_t> &chunk_offset, T *buff, bool reduce_scatter,
+                                         bool all_gather) {
+  MS_ERROR_IF_NULL_W_RET_VAL(channel, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  size_t rank_size = ranks.size();
+  if (rank_size <= 1 || chunk_sizes.size() != rank_size || chunk_offset.size() != rank_size) {
+    return true;
+  }
+  uint32_t send_to_rank = ranks[(index + 1) % rank_size];
+  uint32_t recv_from_rank = ranks[(index + rank_size - 1) % rank_size];
+  size_t segment_count = SegmentCount<T>();
+  size_t max_chunk_size = *std::max_element(chunk_sizes.begin(), chunk_sizes.end());
+  // The for index of the message is "step * segment_num + segment".
+  size_t segment_num = (max_chunk_size + segment_count - 1) / segment_count;
+  // The chunk which is "distance" positions before this process.
+  auto chunk_before = [rank_size, index](size_t distance) { return (index + rank_size - distance) % rank_size; };
+  auto segments_of = [&chunk_sizes, segment_count](size_t chunk_index) {
+    return (chunk_sizes[chunk_index] + segment_count - 1) / segment_count;
+  };
+  auto send_segment = [&](const char *phase, size_t step, size_t chunk_index, size_t segment) {
+    size_t begin = segment * segment_count;
+    size_t size = std::min(segment_count, chunk_sizes[chunk_index] - begin);
+    channel->Send(send_to_rank, phase, chunk_index, step * segment_num + segment,
+                  buff + chunk_offset[chunk_index] + begin, size * sizeof(T));
+  };
+  MS_LOG(DEBUG) << "Pipelined ring rank_size:" << rank_size << ", index:" << index << ", chunk_sizes:" << chunk_sizes
+                << ", segment_num:" << segment_num << ", send_to_rank:" << send_to_rank
+                << ", recv_from_rank:" << recv_from_rank;
 
-  uint32_t rank_size = server_num_;
-  for (size_t i = 0; i < rank_size - 1; i++) {
-    // Step 1: Async send data to next rank.
-    size_t send_chunk_index = (rank_id_ - i + rank_size) % rank_size;
-    T *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    send_meta.set_chunk_index(send_chunk_index);
-    send_meta.set_for_index(i);
-    auto send_chunk_count = chunk_sizes[send_chunk_index];
-    auto send_req_id = server_node_->FlCollectiveSendAsync(send_meta, send_chunk, send_chunk_count * sizeof(T));
-
-    // Step 2: Async receive data to next rank and wait until it's done.
-    size_t recv_chunk_index = (rank_id_ - i - 1 + rank_size) % rank_size;
-    recv_meta.set_chunk_index(recv_chunk_index);
-    recv_meta.set_for_index(i);
-    T *recv_chunk = output_buff + chunk_offset[recv_chunk_index];
-    auto recv_chunk_count = chunk_sizes[recv_chunk_index];
-    MS_LOG(DEBUG) << "Ring ReduceScatter send_to_rank:" << send_to_rank << ", recv_from_rank:" << recv_from_rank
-                  << ", send chunk index:" << send_chunk_index << ", send count:" << send_chunk_count
-                  << ", recv chunk index:" << recv_chunk_index << ", recv count:" << recv_chunk_count
-                  << ", for index:" << i;
-
-    std::shared_ptr<std::vector<uint8_t>> recv_str;
-    auto expect_size = recv_chunk_count * sizeof(T);
-    if (!server_node_->FlCollectiveWait(recv_meta, expect_size, &recv_str, kCollectiveCommTimeout)) {
-      MS_LOG(ERROR) << "FlCollectiveWait failed, send rank id: " << recv_meta.send_rank_id();
-      return false;
+  // Ring ReduceScatter: in step i, receive the chunk i+2 positions before and reduce it, which is sent in step i+1.
+  if (reduce_scatter) {
+    MS_LOG(DEBUG) << "Start Ring ReduceScatter.";
+    size_t first_chunk = chunk_before(1);
+    for (size_t segment = 0; segment < segments_of(first_chunk); segment++) {
+      send_segment(kCollectivePhaseRing, 0, first_chunk, segment);
     }
-    auto tmp_recv_chunk = reinterpret_cast<T *>(recv_str->data());
-    // Step 3: Reduce the data so we can overlap the time cost of send.
-    for (size_t j = 0; j < recv_chunk_count; j++) {
-      recv_chunk[j] += tmp_recv_chunk[j];
+    for (size_t step = 0; step < rank_size - 1; step++) {
+      size_t recv_chunk_index = chunk_before(step + 2);
+      for (size_t segment = 0; segment < segments_of(recv_chunk_index); segment++) {
+        size_t begin = segment * segment_count;
+        size_t size = std::min(segment_count, chunk_sizes[recv_chunk_index] - begin);
+        VectorPtr recv_str;
+        if (!channel->Recv(recv_from_rank, kCollectivePhaseRing, recv_chunk_index, step * segment_num + segment,
+                           size * sizeof(T), &recv_str)) {
+          return false;
+        }
+        ReduceSum(buff + chunk_offset[recv_chunk_index] + begin, reinterpret_cast<const T *>(recv_str->data()), size);
+        // Forward the reduced segment at once, and the last reduced chunk starts the AllGather.
+        if (step + 2 < rank_size) {
+          send_segment(kCollectivePhaseRing, step + 1, recv_chunk_index, segment);
+        } else if (all_gather) {
+          send_segment(kCollectivePhaseGather, 0, recv_chunk_index, segment);
+        }
+      }
     }
-    // Step 4: Wait until send is done.
-    if (!server_node_->Wait(send_req_id, kCollectiveCommTimeout)) {
-      MS_LOG(ERROR) << "Wait response of rank " << send_req_id << " failed.";
+    MS_LOG(DEBUG) << "End Ring ReduceScatter.";
+  }
+
+  // Ring AllGather: in step i, receive the chunk i+1 positions before, which is sent in step i+1.
+  if (all_gather) {
+    MS_LOG(DEBUG) << "Start Ring AllGather.";
+    if (!reduce_scatter) {
+      for (size_t segment = 0; segment < segments_of(index); segment++) {
+        send_segment(kCollectivePhaseGather, 0, index, segment);
+      }
+    }
+    for (size_t step = 0; step < rank_size - 1; step++) {
+      size_t recv_chunk_index = chunk_before(step + 1);
+      for (size_t segment = 0; segment < segments_of(recv_chunk_index); segment++) {
+        size_t begin = segment * segment_count;
+        size_t size = std::min(segment_count, chunk_sizes[recv_chunk_index] - begin);
+        VectorPtr recv_str;
+        if (!channel->Recv(recv_from_rank, kCollectivePhaseGather, recv_chunk_index, step * segment_num + segment,
+                           size * sizeof(T), &recv_str)) {
+          return false;
+        }
+        auto ret = memcpy_s(buff + chunk_offset[recv_chunk_index] + begin, size * sizeof(T), recv_str->data(),
+                            recv_str->size());
+        if (ret != 0) {
+          MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                        << ", dest size is " << (size * sizeof(T)) << ", src size is " << recv_str->size();
+          return false;
+        }
+        if (step + 2 < rank_size) {
+          send_segment(kCollectivePhaseGather, step + 1, recv_chunk_index, segment);
+        }
+      }
+    }
+    MS_LOG(DEBUG) << "End Ring AllGather.";
+  }
+  return channel->WaitAll();
+}
+
+template <typename T>
+bool CollectiveOpsImpl::RunRecursiveDoublingAllReduce(CollectiveChannel *channel, const std::vector<uint32_t> &ranks,
+                                                      size_t index, T *buff, size_t count) {
+  MS_ERROR_IF_NULL_W_RET_VAL(channel, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  size_t rank_size = ranks.size();
+  MS_LOG(DEBUG) << "Recursive doubling AllReduce rank_size:" << rank_size << ", index:" << index << ", count:" << count;
+  for (size_t distance = 1; distance < rank_size; distance <<= 1) {
+    uint32_t peer_rank = ranks[index ^ distance];
+    channel->Send(peer_rank, kCollectivePhaseDoubling, 0, distance, buff, count * sizeof(T));
+    VectorPtr recv_str;
+    if (!channel->Recv(peer_rank, kCollectivePhaseDoubling, 0, distance, count * sizeof(T), &recv_str)) {
       return false;
     }
+    ReduceSum(buff, reinterpret_cast<const T *>(recv_str->data()), count);
   }
-  MS_LOG(DEBUG) << "End Ring ReduceScatter.";
+  return channel->WaitAll();
+}
 
-  // Ring AllGather.
-  MS_LOG(DEBUG) << "Start Ring AllGather.";
-  send_meta.set_phase(kCollectivePhaseGather);
-  recv_meta.set_phase(kCollectivePhaseGather);
-  for (size_t i = 0; i < rank_size - 1; i++) {
-    size_t send_chunk_index = (rank_id_ - i + 1 + rank_size) % rank_size;
-    T *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    send_meta.set_chunk_index(send_chunk_index);
-    send_meta.set_for_index(i);
-    auto send_chunk_count = chunk_sizes[send_chunk_index];
-    auto send_req_id = server_node_->FlCollectiveSendAsync(send_meta, send_chunk, send_chunk_count * sizeof(T));
-
-    size_t recv_chunk_index = (rank_id_ - i + rank_size) % rank_size;
-    T *recv_chunk = output_buff + chunk_offset[recv_chunk_index];
-    recv_meta.set_chunk_index(recv_chunk_index);
-    recv_meta.set_for_index(i);
-    auto recv_chunk_count = chunk_sizes[recv_chunk_index];
-    MS_LOG(DEBUG) << "Ring AllGather send_to_rank:" << send_to_rank << ", recv_from_rank:" << recv_from_rank
-                  << ", send chunk index:" << send_chunk_index << ", send count:" << send_chunk_count
-                  << ", recv chunk index:" << recv_chunk_index << ", recv count:" << recv_chunk_count
-                  << ", for index:" << i;
+template <typename T>
+bool CollectiveOpsImpl::RunRecursiveHalvingAllReduce(CollectiveChannel *channel, const std::vector<uint32_t> &ranks,
+                                                     size_t index, T *buff, size_t count) {
+  MS_ERROR_IF_NULL_W_RET_VAL(channel, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  size_t rank_size = ranks.size();
+  std::vector<size_t> chunk_sizes;
+  std::vector<size_t> chunk_offset;
+  SplitChunks(count, rank_size, &chunk_sizes, &chunk_offset);
+  // The element count of the chunks [begin, end).
+  auto range_count = [&chunk_sizes, &chunk_offset](size_t begin, size_t end) {
+    return chunk_offset[end - 1] + chunk_sizes[end - 1] - chunk_offset[begin];
+  };
+  MS_LOG(DEBUG) << "Recursive halving AllReduce rank_size:" << rank_size << ", index:" << index << ", count:" << count;
 
-    std::shared_ptr<std::vector<unsigned char>> recv_str;
-    auto expect_size = recv_chunk_count * sizeof(T);
-    if (!server_node_->FlCollectiveWait(recv_meta, expect_size, &recv_str, kCollectiveCommTimeout)) {
-      MS_LOG(ERROR) << "FlCollectiveWait failed, send rank id: " << recv_meta.send_rank_id();
+  // Recursive halving ReduceScatter: keep the half of the chunks [begin, end) where this process is, and send the
+  // other half to the peer. At last, this process holds the reduced chunk at its index.
+  size_t begin = 0;
+  size_t end = rank_size;
+  for (size_t distance = rank_size >> 1; distance > 0; distance >>= 1) {
+    uint32_t peer_rank = ranks[index ^ distance];
+    size_t middle = begin + distance;
+    size_t send_begin = middle;
+    size_t send_end = end;
+    if ((index & distance) == 0) {
+      end = middle;
+    } else {
+      send_begin = begin;
+      send_end = middle;
+      begin = middle;
+    }
+    channel->Send(peer_rank, kCollectivePhaseHalving, send_begin, distance, buff + chunk_offset[send_begin],
+                  range_count(send_begin, send_end) * sizeof(T));
+    size_t recv_count = range_count(begin, end);
+    VectorPtr recv_str;
+    if (!channel->Recv(peer_rank, kCollectivePhaseHalving, begin, distance, recv_count * sizeof(T), &recv_str)) {
       return false;
     }
-    auto ret = memcpy_s(recv_chunk, expect_size, recv_str->data(), recv_str->size());
-    if (ret != 0) {
-      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
-                    << ", dest size is " << recv_chunk_count * sizeof(T) << ", src size is " << recv_str->size();
+    ReduceSum(buff + chunk_offset[begin], reinterpret_cast<const T *>(recv_str->data()), recv_count);
+  }
+
+  // Recursive doubling AllGather: exchange the aligned chunks of size "distance" with the peer.
+  for (size_t distance = 1; distance < rank_size; distance <<= 1) {
+    size_t peer_index = index ^ distance;
+    size_t send_begin = index & ~(distance - 1);
+    size_t recv_begin = peer_index & ~(distance - 1);
+    channel->Send(ranks[peer_index], kCollectivePhaseHalvingGather, send_begin, distance,
+                  buff + chunk_offset[send_begin], range_count(send_begin, send_begin + distance) * sizeof(T));
+    size_t recv_size = range_count(recv_begin, recv_begin + distance) * sizeof(T);
+    VectorPtr recv_str;
+    if (!channel->Recv(ranks[peer_index], kCollectivePhaseHalvingGather, recv_begin, distance, recv_size,
+                       &recv_str)) {
       return false;
     }
-    if (!server_node_->Wait(send_req_id, kCollectiveCommTimeout)) {
-      MS_LOG(ERROR) << "Wait response of rank " << send_req_id << " failed.";
+    if (recv_size == 0) {
+      continue;
+    }
+    auto ret = memcpy_s(buff + chunk_offset[recv_begin], recv_size, recv_str->data(), recv_str->size());
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                    << ", dest size is " << recv_size << ", src size is " << recv_str->size();
       return false;
     }
   }
-  MS_LOG(DEBUG) << "End Ring AllGather.";
-  return true;
+  return channel->WaitAll();
 }
 
 template <typename T>
-bool CollectiveOpsImpl::ReduceBroadcastAllReduce(const std::string &data_name, const void *sendbuff, void *recvbuff,
-                                                 size_t count) {
-  MS_ERROR_IF_NULL_W_RET_VAL(server_node_, false);
-  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
-  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
-  uint32_t rank_size = server_num_;
-  MS_LOG(DEBUG) << "Reduce Broadcast AllReduce rank_size:" << rank_size << ", rank_id_:" << rank_id_
-                << ", count:" << count;
+bool CollectiveOpsImpl::RunReduceBroadcastAllReduce(CollectiveChannel *channel, const std::vector<uint32_t> &ranks,
+                                                    size_t index, T *buff, size_t count) {
+  MS_ERROR_IF_NULL_W_RET_VAL(channel, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  size_t rank_size = ranks.size();
+  size_t data_size = count * sizeof(T);
+  MS_LOG(DEBUG) << "Reduce Broadcast AllReduce rank_size:" << rank_size << ", index:" << index << ", count:" << count;
 
-  size_t src_size = count * sizeof(T);
-  size_t dst_size = count * sizeof(T);
-  int ret = memcpy_s(recvbuff, dst_size, sendbuff, src_size);
-  if (ret != 0) {
-    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
-                  << ", dest size is " << dst_size << ", src size is " << src_size;
-    return false;
-  }
-  T *output_buff = reinterpret_cast<T *>(recvbuff);
-  // Reduce data to rank 0 process.
-  auto curr_iteration_num = LocalMetaStore::GetInstance().curr_iter_num();
-  ps::core::CollectiveMessageMeta send_meta;
-  send_meta.set_enable_flag(true);
-  send_meta.set_send_rank_id(rank_id_);
-  send_meta.set_iteration(curr_iteration_num);
-  send_meta.set_weight_name(data_name);
-  send_meta.set_chunk_index(0);
-  send_meta.set_for_index(0);
-
-  ps::core::CollectiveMessageMeta recv_meta;
-  recv_meta.set_enable_flag(true);
-  recv_meta.set_recv_rank_id(rank_id_);
-  recv_meta.set_iteration(curr_iteration_num);
-  recv_meta.set_weight_name(data_name);
-  recv_meta.set_chunk_index(0);
-  recv_meta.set_for_index(0);
-
-  send_meta.set_phase(kCollectivePhaseReduce);
-  recv_meta.set_phase(kCollectivePhaseReduce);
-
-  MS_LOG(DEBUG) << "Start Reduce to rank 0 process.";
-  if (rank_id_ == 0) {
-    for (uint32_t i = 1; i < rank_size; i++) {
-      std::shared_ptr<std::vector<unsigned char>> recv_str;
-      MS_LOG(DEBUG) << "Reduce rank 0 receive from rank " << i;
-      recv_meta.set_send_rank_id(i);
-      auto expect_size = count * sizeof(T);
-      if (!server_node_->FlCollectiveWait(recv_meta, expect_size, &recv_str, kCollectiveCommTimeout)) {
-        MS_LOG(ERROR) << "FlCollectiveWait failed, send rank id: " << recv_meta.send_rank_id();
+  // Reduce data to the first process.
+  if (index == 0) {
+    for (size_t i = 1; i < rank_size; i++) {
+      VectorPtr recv_str;
+      if (!channel->Recv(ranks[i], kCollectivePhaseReduce, 0, 0, data_size, &recv_str)) {
         return false;
       }
-      auto tmp_recv_chunk = reinterpret_cast<T *>(recv_str->data());  // recv_str size has checked in FlCollectiveWait
-      for (size_t j = 0; j < count; j++) {
-        output_buff[j] += tmp_recv_chunk[j];
-      }
+      ReduceSum(buff, reinterpret_cast<const T *>(recv_str->data()), count);
+    }
+  } else {
+    channel->Send(ranks[0], kCollectivePhaseReduce, 0, 0, buff, data_size);
+  }
+
+  // Broadcast data to the other processes.
+  if (index == 0) {
+    for (size_t i = 1; i < rank_size; i++) {
+      channel->Send(ranks[i], kCollectivePhaseBroadcast, 0, 0, buff, data_size);
     }
   } else {
-    MS_LOG(DEBUG) << "Reduce send data to rank 0 process.";
-    send_meta.set_recv_rank_id(0);
-    auto send_req_id1 = server_node_->FlCollectiveSendAsync(send_meta, sendbuff, count * sizeof(T));
-    if (!server_node_->Wait(send_req_id1, kCollectiveCommTimeout)) {
-      MS_LOG(ERROR) << "Wait response of rank " << send_req_id1 << " failed.";
+    VectorPtr recv_str;
+    if (!channel->Recv(ranks[0], kCollectivePhaseBroadcast, 0, 0, data_size, &recv_str)) {
       return false;
     }
+    if (data_size != 0) {
+      auto ret = memcpy_s(buff, data_size, recv_str->data(), recv_str->size());
+      if (ret != 0) {
+        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                      << ", dest size is " << data_size << ", src size is " << recv_str->size();
+        return false;
+      }
+    }
   }
-  MS_LOG(DEBUG) << "End Reduce.";
+  return channel->WaitAll();
+}
 
-  // Broadcast data to not 0 rank process.
-  MS_LOG(DEBUG) << "Start broadcast from rank 0 to other processes.";
-  send_meta.set_phase(kCollectivePhaseBroadcast);
-  recv_meta.set_phase(kCollectivePhaseBroadcast);
-  if (rank_id_ == 0) {
-    for (uint32_t i = 1; i < rank_size; i++) {
-      MS_LOG(DEBUG) << "Broadcast data to process " << i;
-      send_meta.set_recv_rank_id(i);
-      auto send_req_id2 = server_node_->FlCollectiveSendAsync(send_meta, output_buff, count * sizeof(T));
-      if (!server_node_->Wait(send_req_id2, kCollectiveCommTimeout)) {
-        MS_LOG(ERROR) << "Wait response of rank " << send_req_id2 << " failed.";
+template <typename T>
+bool CollectiveOpsImpl::RunHierarchicalAllReduce(CollectiveChannel *channel, const std::vector<uint32_t> &ranks,
+                                                 size_t index, const std::vector<std::string> &hosts, T *buff,
+                                                 size_t count) {
+  MS_ERROR_IF_NULL_W_RET_VAL(channel, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  if (hosts.size() != ranks.size()) {
+    MS_LOG(ERROR) << "The hosts size " << hosts.size() << " is not equal to the rank size " << ranks.size();
+    return false;
+  }
+  // The positions of the processes on the same host, and the leaders which are the first processes of the hosts.
+  std::vector<size_t> local_indices;
+  std::vector<uint32_t> leader_ranks;
+  size_t leader_index = 0;
+  std::set<std::string> visited_hosts;
+  for (size_t i = 0; i < ranks.size(); i++) {
+    if (hosts[i] == hosts[index]) {
+      local_indices.push_back(i);
+    }
+    if (visited_hosts.insert(hosts[i]).second) {
+      if (i == index) {
+        leader_index = leader_ranks.size();
+      }
+      leader_ranks.push_back(ranks[i]);
+    }
+  }
+  bool is_leader = local_indices.front() == index;
+  uint32_t leader_rank = ranks[local_indices.front()];
+  size_t segment_count = SegmentCount<T>();
+  size_t segment_num = (count + segment_count - 1) / segment_count;
+  MS_LOG(DEBUG) << "Hierarchical AllReduce rank_size:" << ranks.size() << ", index:" << index
+                << ", local size:" << local_indices.size() << ", host num:" << leader_ranks.size()
+                << ", count:" << count;
+
+  // Step 1: Reduce the data to the leader of the host in segments, so the leader reduces one segment while receiving
+  // the next ones.
+  for (size_t segment = 0; segment < segment_num; segment++) {
+    size_t begin = segment * segment_count;
+    size_t size = std::min(segment_count, count - begin);
+    if (!is_leader) {
+      channel->Send(leader_rank, kCollectivePhaseLocalReduce, 0, segment, buff + begin, size * sizeof(T));
+      continue;
+    }
+    for (size_t i = 1; i < local_indices.size(); i++) {
+      VectorPtr recv_str;
+      if (!channel->Recv(ranks[local_indices[i]], kCollectivePhaseLocalReduce, 0, segment, size * sizeof(T),
+                         &recv_str)) {
         return false;
       }
+      ReduceSum(buff + begin, reinterpret_cast<const T *>(recv_str->data()), size);
     }
-  } else {
-    MS_LOG(DEBUG) << "Broadcast receive from rank 0.";
-    recv_meta.set_send_rank_id(0);
-    std::shared_ptr<std::vector<unsigned char>> recv_str;
-    auto expect_size = count * sizeof(T);
-    if (!server_node_->FlCollectiveWait(recv_meta, expect_size, &recv_str, kCollectiveCommTimeout)) {
-      MS_LOG(ERROR) << "FlCollectiveWait failed, send rank id: " << recv_meta.send_rank_id();
+  }
+
+  // Step 2: AllReduce among the leaders of the hosts.
+  if (is_leader && !RunAllReduce<T>(channel, leader_ranks, leader_index, {}, buff, count)) {
+    return false;
+  }
+
+  // Step 3: Broadcast the data from the leader in the host.
+  for (size_t segment = 0; segment < segment_num; segment++) {
+    size_t begin = segment * segment_count;
+    size_t size = std::min(segment_count, count - begin);
+    if (is_leader) {
+      for (size_t i = 1; i < local_indices.size(); i++) {
+        channel->Send(ranks[local_indices[i]], kCollectivePhaseLocalBroadcast, 0, segment, buff + begin,
+                      size * sizeof(T));
+      }
+      continue;
+    }
+    VectorPtr recv_str;
+    if (!channel->Recv(leader_rank, kCollectivePhaseLocalBroadcast, 0, segment, size * sizeof(T), &recv_str)) {
       return false;
     }
-    ret = memcpy_s(output_buff, expect_size, recv_str->data(), recv_str->size());
+    auto ret = memcpy_s(buff + begin, size * sizeof(T), recv_str->data(), recv_str->size());
     if (ret != 0) {
       MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
-                    << ", dest size is " << expect_size << ", src size is " << recv_str->size();
+                    << ", dest size is " << (size * sizeof(T)) << ", src size is " << recv_str->size();
       return false;
     }
   }
-  MS_LOG(DEBUG) << "End broadcast.";
-  return true;
+  return channel->WaitAll();
 }
 
 template <typename T>
@@ -307,11 +708,8 @@ bool CollectiveOpsImpl::RingAllGather(const void *sendbuff, void *const recvbuff
     chunk_offset.push_back(ofs);
   }
 
-  uint32_t send_to_rank = (rank_id_ + 1) % rank_size_;
-  uint32_t recv_from_rank = (rank_id_ - 1 + rank_size_) % rank_size_;
   MS_LOG(DEBUG) << "Ring AllGather count:" << send_count << ", rank_size:" << rank_size_ << ", rank_id_:" << rank_id_
-                << ", chunk_size:" << chunk_size << ", chunk_sizes:" << chunk_sizes << ", send_to_rank:" << send_to_rank
-                << ", recv_from_rank:" << recv_from_rank;
+                << ", chunk_size:" << chunk_size << ", chunk_sizes:" << chunk_sizes;
 
   T *output_buff = reinterpret_cast<T *>(recvbuff);
   size_t src_size = send_count * sizeof(T);
@@ -324,37 +722,10 @@ bool CollectiveOpsImpl::RingAllGather(const void *sendbuff, void *const recvbuff
   }
 
   // Ring AllGather.
-  for (size_t i = 0; i < rank_size_ - 1; i++) {
-    size_t send_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
-    T *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    auto send_req_id =
-      node_->CollectiveSendAsync(node_role_, send_to_rank, send_chunk, chunk_sizes[send_chunk_index] * sizeof(T));
-    size_t recv_chunk_index = (rank_id_ - i - 1 + rank_size_) % rank_size_;
-    T *recv_chunk = output_buff + chunk_offset[recv_chunk_index];
-    MS_LOG(DEBUG) << "Ring AllGather send_to_rank:" << send_to_rank << ", recv_from_rank:" << recv_from_rank
-                  << ", send count:" << chunk_sizes[send_chunk_index]
-                  << ", recv count:" << chunk_sizes[recv_chunk_index] << ", iteration:" << i;
-
-    std::shared_ptr<std::vector<unsigned char>> recv_str;
-    auto recv_req_id = node_->CollectiveReceiveAsync(node_role_, recv_from_rank, &recv_str);
-    if (!node_->CollectiveWait(recv_req_id, kCollectiveCommTimeout)) {
-      MS_LOG(ERROR) << "CollectiveWait " << recv_req_id << " failed.";
-      return false;
-    }
-    ret = memcpy_s(recv_chunk, chunk_sizes[recv_chunk_index] * sizeof(T), recv_str->data(), recv_str->size());
-    if (ret != 0) {
-      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
-                    << ", dest size is " << (chunk_sizes[recv_chunk_index] * sizeof(T)) << ", src size is "
-                    << recv_str->size();
-      return false;
-    }
-    if (!node_->Wait(send_req_id, kCollectiveCommTimeout)) {
-      MS_LOG(ERROR) << "CollectiveWait " << send_req_id << " failed.";
-      return false;
-    }
-  }
-  MS_LOG(DEBUG) << "End Ring AllGather.";
-  return true;
+  std::vector<uint32_t> ranks(rank_size_);
+  std::iota(ranks.begin(), ranks.end(), 0);
+  NodeCollectiveChannel channel(node_, node_role_, rank_id_);
+  return RunRing<T>(&channel, ranks, rank_id_, chunk_sizes, chunk_offset, output_buff, false, true);
 }
 
 template <typename T>
@@ -426,11 +797,18 @@ bool CollectiveOpsImpl::AllReduce(const std::string &data_name, const void *send
     return false;
   }
 
-  if (count >= rank_size) {
-    return RingAllReduce<T>(data_name, sendbuff, recvbuff, count);
-  } else {
-    return ReduceBroadcastAllReduce<T>(data_name, sendbuff, recvbuff, count);
+  if (recvbuff != sendbuff) {
+    auto ret = memcpy_s(recvbuff, count * sizeof(T), sendbuff, count * sizeof(T));
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
   }
+  std::vector<uint32_t> ranks(rank_size);
+  std::iota(ranks.begin(), ranks.end(), 0);
+  // The hierarchical algorithm is not used on the federated learning server.
+  NodeCollectiveChannel channel(server_node_, data_name, rank_id_);
+  return RunAllReduce<T>(&channel, ranks, rank_id_, {}, reinterpret_cast<T *>(recvbuff), count);
 }
 
 template <typename T>
@@ -494,6 +872,325 @@ bool CollectiveOpsImpl::Broadcast(const void *sendbuff, void *const recvbuff, si
   return Broadcast<T>(sendbuff, recvbuff, count, root, group_info);
 }
 
+template <typename T>
+bool CollectiveOpsImpl::AllReduce(const void *sendbuff, void *const recvbuff, size_t count,
+                                  const std::shared_ptr<ps::core::AbstractNode> &node,
+                                  const CommunicationGroupInfo &group_info) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(node, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+
+  std::vector<uint32_t> ranks;
+  size_t index = 0;
+  if (!InitGroupParams(node, group_info, &ranks, &index)) {
+    return false;
+  }
+  if (recvbuff != sendbuff && count != 0) {
+    auto ret = memcpy_s(recvbuff, count * sizeof(T), sendbuff, count * sizeof(T));
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  if (rank_size_ == 1) {
+    MS_LOG(INFO) << "Rank size is 1. Do nothing.";
+    return true;
+  }
+
+  NodeCollectiveChannel channel(node_, node_role_, rank_id_);
+  return RunAllReduce<T>(&channel, ranks, index, GetRankHosts(node_, node_role_, ranks),
+                         reinterpret_cast<T *>(recvbuff), count);
+}
+
+bool CollectiveOpsImpl::CompressedAllReduce(const float *sendbuff, float *recvbuff, size_t count,
+                                            const ps::GradientCompressionConfig &config,
+                                            const std::shared_ptr<ps::core::AbstractNode> &node,
+                                            const CommunicationGroupInfo &group_info) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(node, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+
+  std::vector<uint32_t> ranks;
+  size_t index = 0;
+  if (!InitGroupParams(node, group_info, &ranks, &index)) {
+    return false;
+  }
+  if (recvbuff != sendbuff && count != 0) {
+    auto ret = memcpy_s(recvbuff, count * sizeof(float), sendbuff, count * sizeof(float));
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  if (rank_size_ == 1) {
+    MS_LOG(INFO) << "Rank size is 1. Do nothing.";
+    return true;
+  }
+
+  NodeCollectiveChannel channel(node_, node_role_, rank_id_);
+  if (!NeedCompressedAllReduce(config, count, ranks.size())) {
+    return RunAllReduce<float>(&channel, ranks, index, GetRankHosts(node_, node_role_, ranks), recvbuff, count);
+  }
+  return RunCompressedAllReduce(&channel, ranks, index, config, recvbuff, count);
+}
+
+bool CollectiveOpsImpl::NeedCompressedAllReduce(const ps::GradientCompressionConfig &config, size_t count,
+                                                size_t rank_size) {
+  // The top-k compression needs the error feedback to converge, which the AllReduce can't keep.
+  if ((config.type != ps::GradientCompressionType::kFloat16 && config.type != ps::GradientCompressionType::kInt8) ||
+      rank_size <= 1 || !ps::GradientCompressor::NeedCompress(config, count)) {
+    return false;
+  }
+  size_t chunk_count = (count + rank_size - 1) / rank_size;
+  return ps::GradientCompressor::CompressedSize(config, chunk_count) < chunk_count * sizeof(float);
+}
+
+template <typename T>
+bool CollectiveOpsImpl::AllGather(const void *sendbuff, void *const recvbuff, size_t send_count,
+                                  const std::shared_ptr<ps::core::AbstractNode> &node,
+                                  const CommunicationGroupInfo &group_info) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(node, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+
+  std::vector<uint32_t> ranks;
+  size_t index = 0;
+  if (!InitGroupParams(node, group_info, &ranks, &index)) {
+    return false;
+  }
+  NodeCollectiveChannel channel(node_, node_role_, rank_id_);
+  return RunAllGather<T>(&channel, ranks, index, sendbuff, recvbuff, send_count);
+}
+
+template <typename T>
+bool CollectiveOpsImpl::ReduceScatter(const void *sendbuff, void *const recvbuff, size_t recv_count,
+                                      const std::shared_ptr<ps::core::AbstractNode> &node,
+                                      const CommunicationGroupInfo &group_info) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(node, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+
+  std::vector<uint32_t> ranks;
+  size_t index = 0;
+  if (!InitGroupParams(node, group_info, &ranks, &index)) {
+    return false;
+  }
+  NodeCollectiveChannel channel(node_, node_role_, rank_id_);
+  return RunReduceScatter<T>(&channel, ranks, index, sendbuff, recvbuff, recv_count);
+}
+
+template <typename T>
+bool CollectiveOpsImpl::AllToAll(const void *sendbuff, void *const recvbuff, size_t count,
+                                 const std::shared_ptr<ps::core::AbstractNode> &node,
+                                 const CommunicationGroupInfo &group_info) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(node, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+
+  std::vector<uint32_t> ranks;
+  size_t index = 0;
+  if (!InitGroupParams(node, group_info, &ranks, &index)) {
+    return false;
+  }
+  NodeCollectiveChannel channel(node_, node_role_, rank_id_);
+  return RunAllToAll<T>(&channel, ranks, index, sendbuff, recvbuff, count);
+}
+
+template <typename T>
+bool CollectiveOpsImpl::RunAllGather(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+                                     const void *sendbuff, void *recvbuff, size_t send_count) {
+  MS_ERROR_IF_NULL_W_RET_VAL(channel, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+  if (send_count == 0) {
+    return true;
+  }
+  size_t rank_size = ranks.size();
+  T *output_buff = reinterpret_cast<T *>(recvbuff);
+  auto ret = memcpy_s(output_buff + index * send_count, send_count * sizeof(T), sendbuff, send_count * sizeof(T));
+  if (ret != 0) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+  if (rank_size <= 1) {
+    return true;
+  }
+
+  std::vector<size_t> chunk_sizes(rank_size, send_count);
+  std::vector<size_t> chunk_offset;
+  for (size_t i = 0; i < rank_size; i++) {
+    chunk_offset.push_back(i * send_count);
+  }
+  return RunRing<T>(channel, ranks, index, chunk_sizes, chunk_offset, output_buff, false, true);
+}
+
+template <typename T>
+bool CollectiveOpsImpl::RunReduceScatter(CollectiveChannel *channel, const std::vector<uint32_t> &ranks,
+                                         size_t index, const void *sendbuff, void *recvbuff, size_t recv_count) {
+  MS_ERROR_IF_NULL_W_RET_VAL(channel, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+  if (recv_count == 0) {
+    return true;
+  }
+
+  // Reduce in a copy of the send buffer, whose chunk at the index of this process is reduced at last.
+  size_t rank_size = ranks.size();
+  const T *send_buff = reinterpret_cast<const T *>(sendbuff);
+  std::vector<T> buff(send_buff, send_buff + recv_count * rank_size);
+  std::vector<size_t> chunk_sizes;
+  std::vector<size_t> chunk_offset;
+  SplitChunks(buff.size(), rank_size, &chunk_sizes, &chunk_offset);
+  if (!RunRing<T>(channel, ranks, index, chunk_sizes, chunk_offset, buff.data(), true, false)) {
+    return false;
+  }
+  auto ret = memcpy_s(recvbuff, recv_count * sizeof(T), buff.data() + chunk_offset[index], recv_count * sizeof(T));
+  if (ret != 0) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool CollectiveOpsImpl::RunAllToAll(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+                                    const void *sendbuff, void *recvbuff, size_t count) {
+  MS_ERROR_IF_NULL_W_RET_VAL(channel, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+  if (count == 0) {
+    return true;
+  }
+  size_t rank_size = ranks.size();
+  const T *send_buff = reinterpret_cast<const T *>(sendbuff);
+  T *recv_buff = reinterpret_cast<T *>(recvbuff);
+  size_t chunk_size = count * sizeof(T);
+  auto ret = memcpy_s(recv_buff + index * count, chunk_size, send_buff + index * count, chunk_size);
+  if (ret != 0) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+
+  // In step i, send the chunk to the process i positions after and receive from the one i positions before, so every
+  // process sends and receives one chunk in each step.
+  for (size_t step = 1; step < rank_size; step++) {
+    size_t send_index = (index + step) % rank_size;
+    size_t recv_index = (index + rank_size - step) % rank_size;
+    channel->Send(ranks[send_index], kCollectivePhaseAllToAll, send_index, step, send_buff + send_index * count,
+                  chunk_size);
+    VectorPtr recv_str;
+    if (!channel->Recv(ranks[recv_index], kCollectivePhaseAllToAll, index, step, chunk_size, &recv_str)) {
+      return false;
+    }
+    ret = memcpy_s(recv_buff + recv_index * count, chunk_size, recv_str->data(), recv_str->size());
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                    << ", dest size is " << chunk_size << ", src size is " << recv_str->size();
+      return false;
+    }
+  }
+  return channel->WaitAll();
+}
+
+bool CollectiveOpsImpl::RunCompressedAllReduce(CollectiveChannel *channel, const std::vector<uint32_t> &ranks,
+                                               size_t index, const ps::GradientCompressionConfig &config, float *buff,
+                                               size_t count) {
+  MS_ERROR_IF_NULL_W_RET_VAL(channel, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  size_t rank_size = ranks.size();
+  if (rank_size == 0) {
+    MS_LOG(ERROR) << "Rank size should not be 0.";
+    return false;
+  }
+  size_t chunk_count = (count + rank_size - 1) / rank_size;
+  size_t encoded_size = ps::GradientCompressor::CompressedSize(config, chunk_count);
+  std::vector<float> padded(chunk_count * rank_size, 0.0f);
+  (void)std::copy(buff, buff + count, padded.begin());
+
+  // The chunks are compressed without the name, since the AllReduce has no stable identity of the data.
+  auto &compressor = ps::GradientCompressor::GetInstance();
+  std::string encoded;
+  encoded.reserve(encoded_size * rank_size);
+  for (size_t i = 0; i < rank_size; i++) {
+    compressor.Compress("", config, padded.data() + i * chunk_count, chunk_count, &encoded);
+  }
+  if (encoded.size() != encoded_size * rank_size) {
+    MS_LOG(ERROR) << "The compressed size " << encoded.size() << " is not the expected size "
+                  << encoded_size * rank_size;
+    return false;
+  }
+
+  // Each process reduces its own chunk from the compressed chunks of all the processes.
+  std::vector<char> exchanged(encoded_size * rank_size);
+  if (!RunAllToAll<char>(channel, ranks, index, encoded.data(), exchanged.data(), encoded_size)) {
+    return false;
+  }
+  std::vector<float> reduced(chunk_count, 0.0f);
+  for (size_t i = 0; i < rank_size; i++) {
+    if (ps::GradientCompressor::DecompressAdd(exchanged.data() + i * encoded_size, encoded_size, reduced.data(),
+                                              chunk_count) == 0) {
+      MS_LOG(ERROR) << "Failed to decode the compressed chunk of rank " << ranks[i];
+      return false;
+    }
+  }
+
+  // The reduced chunk of this process is decoded from the gathered one as well, so all the processes get the same data.
+  encoded.clear();
+  compressor.Compress("", config, reduced.data(), chunk_count, &encoded);
+  std::vector<char> gathered(encoded_size * rank_size);
+  if (!RunAllGather<char>(channel, ranks, index, encoded.data(), gathered.data(), encoded_size)) {
+    return false;
+  }
+  std::fill(padded.begin(), padded.end(), 0.0f);
+  for (size_t i = 0; i < rank_size; i++) {
+    if (ps::GradientCompressor::DecompressAdd(gathered.data() + i * encoded_size, encoded_size,
+                                              padded.data() + i * chunk_count, chunk_count) == 0) {
+      MS_LOG(ERROR) << "Failed to decode the reduced chunk of rank " << ranks[i];
+      return false;
+    }
+  }
+  (void)std::copy(padded.begin(), padded.begin() + SizeToLong(count), buff);
+  return true;
+}
+
+bool CollectiveOpsImpl::InitGroupParams(const std::shared_ptr<ps::core::AbstractNode> &node,
+                                        const CommunicationGroupInfo &group_info, std::vector<uint32_t> *ranks,
+                                        size_t *index) {
+  MS_ERROR_IF_NULL_W_RET_VAL(node, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(ranks, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(index, false);
+  node_ = node;
+  node_role_ = node_->role();
+  rank_id_ = node_->rank_id();
+  rank_size_ = group_info.size;
+  if (rank_size_ == 0) {
+    MS_LOG(ERROR) << "Rank size should not be 0.";
+    return false;
+  }
+
+  ranks->clear();
+  for (uint32_t i = 0; i < rank_size_; i++) {
+    auto iter = group_info.group_to_global_ranks.find(i);
+    if (iter == group_info.group_to_global_ranks.end()) {
+      MS_LOG(ERROR) << "The group rank " << i << " is not in the group.";
+      return false;
+    }
+    ranks->push_back(iter->second);
+  }
+  auto iter = group_info.global_to_group_ranks.find(rank_id_);
+  if (iter == group_info.global_to_group_ranks.end() || iter->second >= rank_size_) {
+    MS_LOG(ERROR) << "The rank " << rank_id_ << " is not in the group.";
+    return false;
+  }
+  *index = iter->second;
+  return true;
+}
+
 bool CollectiveOpsImpl::ReInitForScaling() {
   // If CollectiveOpsImpl is not initialized yet but the scaling event is triggered, do not throw exception.
   if (server_node_ == nullptr) {
@@ -524,6 +1221,70 @@ template bool CollectiveOpsImpl::AllGather<int>(const void *sendbuff, void *recv
 template bool CollectiveOpsImpl::AllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count,
                                                  const std::shared_ptr<ps::core::AbstractNode> &node);
 
+template bool CollectiveOpsImpl::AllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count,
+                                                  const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                  const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count,
+                                                     const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                     const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count,
+                                                const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count,
+                                                 const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                 const CommunicationGroupInfo &group_info);
+
+template bool CollectiveOpsImpl::AllReduce<float>(const void *sendbuff, void *recvbuff, size_t count,
+                                                  const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                  const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllReduce<uint64_t>(const void *sendbuff, void *recvbuff, size_t count,
+                                                     const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                     const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllReduce<int>(const void *sendbuff, void *recvbuff, size_t count,
+                                                const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllReduce<char>(const void *sendbuff, void *recvbuff, size_t count,
+                                                 const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                 const CommunicationGroupInfo &group_info);
+
+template bool CollectiveOpsImpl::ReduceScatter<float>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                      const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                      const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::ReduceScatter<uint64_t>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                         const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                         const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::ReduceScatter<int>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                    const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                    const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::ReduceScatter<char>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                     const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                     const CommunicationGroupInfo &group_info);
+
+template bool CollectiveOpsImpl::AllToAll<float>(const void *sendbuff, void *recvbuff, size_t count,
+                                                 const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                 const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllToAll<uint64_t>(const void *sendbuff, void *recvbuff, size_t count,
+                                                    const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                    const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllToAll<int>(const void *sendbuff, void *recvbuff, size_t count,
+                                               const std::shared_ptr<ps::core::AbstractNode> &node,
+                                               const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllToAll<char>(const void *sendbuff, void *recvbuff, size_t count,
+                                                const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                const CommunicationGroupInfo &group_info);
+
+template bool CollectiveOpsImpl::RunAllReduce<float>(CollectiveChannel *channel, const std::vector<uint32_t> &ranks,
+                                                     size_t index, const std::vector<std::string> &hosts, float *buff,
+                                                     size_t count);
+template bool CollectiveOpsImpl::RunAllGather<float>(CollectiveChannel *channel, const std::vector<uint32_t> &ranks,
+                                                     size_t index, const void *sendbuff, void *recvbuff,
+                                                     size_t send_count);
+template bool CollectiveOpsImpl::RunReduceScatter<float>(CollectiveChannel *channel, const std::vector<uint32_t> &ranks,
+                                                         size_t index, const void *sendbuff, void *recvbuff,
+                                                         size_t recv_count);
+template bool CollectiveOpsImpl::RunAllToAll<float>(CollectiveChannel *channel, const std::vector<uint32_t> &ranks,
+                                                    size_t index, const void *sendbuff, void *recvbuff, size_t count);
+
 template bool CollectiveOpsImpl::RingAllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
 template bool CollectiveOpsImpl::RingAllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
 template bool CollectiveOpsImpl::RingAllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
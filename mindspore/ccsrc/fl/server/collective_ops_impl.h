@@ -26,6 +26,7 @@
 #include "ps/ps_context.h"
 #include "ps/core/server_node.h"
 #include "fl/server/common.h"
+#include "ps/gradient_compression.h"
 
 namespace mindspore {
 namespace fl {
@@ -49,9 +50,30 @@ struct CommunicationGroupInfo {
   std::map<uint32_t, uint32_t> group_to_global_ranks;
 };
 
+// CollectiveChannel sends and receives the messages of the collective algorithms. The messages from one rank to another
+// must be received in the order they are sent, and the phase, chunk index and for index of them are unique within one
+// collective operation. The data is copied before the send returns, so the buffer could be modified at once.
+class CollectiveChannel {
+ public:
+  virtual ~CollectiveChannel() = default;
+
+  // Send the data asynchronously. The empty data is not sent.
+  virtual void Send(uint32_t dst_rank, const char *phase, size_t chunk_index, size_t for_index, const void *data,
+                    size_t size) = 0;
+
+  // Receive the data of the expected size and wait until it's done. The empty data is not received.
+  virtual bool Recv(uint32_t src_rank, const char *phase, size_t chunk_index, size_t for_index, size_t expect_size,
+                    std::shared_ptr<std::vector<unsigned char>> *output) = 0;
+
+  // Wait until all the sent data is responded.
+  virtual bool WaitAll() = 0;
+};
+
 // CollectiveOpsImpl is the collective communication API of the server.
-// For now, it implements two AllReduce algorithms: RingAllReduce and BroadcastAllReduce. Elastic AllReduce is also
-// supported for the elastic scaling feature of the server.
+// The AllReduce uses the RingAllReduce, or the ReduceBroadcastAllReduce if the data is less than the rank size. The
+// pipelined RingAllReduce, the recursive doubling and recursive halving AllReduce and the hierarchical AllReduce could
+// be set by the environment variable MS_DEV_ALLREDUCE_ALGORITHM, or picked by the message size and the hosts of the
+// ranks if it's "auto". Elastic AllReduce is also supported for the elastic scaling feature of the server.
 class CollectiveOpsImpl {
  public:
   static CollectiveOpsImpl &GetInstance() {
@@ -68,6 +90,40 @@ class CollectiveOpsImpl {
   bool AllGather(const void *sendbuff, void *recvbuff, size_t send_count,
                  const std::shared_ptr<ps::core::AbstractNode> &node);
 
+  // Collective all gather within the specified group. The data of group rank i is stored in the i-th chunk of recvbuff.
+  template <typename T>
+  bool AllGather(const void *sendbuff, void *recvbuff, size_t send_count,
+                 const std::shared_ptr<ps::core::AbstractNode> &node, const CommunicationGroupInfo &group_info);
+
+  // Collective sum allreduce within the specified group.
+  template <typename T>
+  bool AllReduce(const void *sendbuff, void *recvbuff, size_t count,
+                 const std::shared_ptr<ps::core::AbstractNode> &node, const CommunicationGroupInfo &group_info);
+
+  // Collective sum allreduce of the float data compressed with the config within the specified group: the compressed
+  // chunks are reduced by their owners with AllToAll and the compressed reduced chunks are gathered, so each process
+  // sends the compressed size of the ring. The compression is lossy and has no error feedback. The plain AllReduce is
+  // used if the compression doesn't reduce the size.
+  bool CompressedAllReduce(const float *sendbuff, float *recvbuff, size_t count,
+                           const ps::GradientCompressionConfig &config,
+                           const std::shared_ptr<ps::core::AbstractNode> &node,
+                           const CommunicationGroupInfo &group_info);
+
+  // Whether the AllReduce of count elements among rank_size processes sends less data with the compression.
+  static bool NeedCompressedAllReduce(const ps::GradientCompressionConfig &config, size_t count, size_t rank_size);
+
+  // Collective sum reduce scatter within the specified group. The process of group rank i receives the i-th chunk of
+  // the reduced data, and each chunk has recv_count elements.
+  template <typename T>
+  bool ReduceScatter(const void *sendbuff, void *recvbuff, size_t recv_count,
+                     const std::shared_ptr<ps::core::AbstractNode> &node, const CommunicationGroupInfo &group_info);
+
+  // Collective all to all within the specified group. The i-th chunk of sendbuff is sent to the process of group rank
+  // i, and the chunk received from it is stored in the i-th chunk of recvbuff. Each chunk has count elements.
+  template <typename T>
+  bool AllToAll(const void *sendbuff, void *recvbuff, size_t count, const std::shared_ptr<ps::core::AbstractNode> &node,
+                const CommunicationGroupInfo &group_info);
+
   // Collective broadcast within the specified group. The parameter "root" is the group rank of the root process.
   // Normally 0.
   template <typename T>
@@ -89,19 +145,72 @@ class CollectiveOpsImpl {
   CollectiveOpsImpl(const CollectiveOpsImpl &) = delete;
   CollectiveOpsImpl &operator=(const CollectiveOpsImpl &) = delete;
 
-  // Implementation of RingAllReduce.
+  // Initialize the node, role, rank id and rank size of the collective communication within the group.
+  bool InitGroupParams(const std::shared_ptr<ps::core::AbstractNode> &node, const CommunicationGroupInfo &group_info,
+                       std::vector<uint32_t> *ranks, size_t *index);
+
+  // The algorithms below run on the ranks with the channel. The ranks are the global ranks in ring order and "index" is
+  // the position of this process in the ranks. The data is reduced in place in "buff".
+  // Run the configured AllReduce algorithm. The hierarchical algorithm is only used if "hosts" is not empty.
   template <typename T>
-  bool RunRingAllReduce(const std::string &data_name, uint32_t send_to_rank, uint32_t recv_from_rank,
-                        const std::vector<size_t> &chunk_sizes, const std::vector<size_t> &chunk_offset,
-                        T *output_buff);
+  bool RunAllReduce(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+                    const std::vector<std::string> &hosts, T *buff, size_t count);
 
-  // Implementation of RingAllReduce.
+  // Implementation of the ring. In each step, this process sends one chunk to the next rank and receives one chunk from
+  // the previous rank. After the ReduceScatter, the process at position i holds the i-th reduced chunk, which the
+  // AllGather starts from. The pipelined ring is used instead if it's configured.
   template <typename T>
-  bool RingAllReduce(const std::string &data_name, const void *sendbuff, void *recvbuff, size_t count);
+  bool RunRing(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+               const std::vector<size_t> &chunk_sizes, const std::vector<size_t> &chunk_offset, T *buff,
+               bool reduce_scatter, bool all_gather);
 
-  // Implementation of BroadcastAllReduce.
+  // Implementation of the pipelined ring. The chunks are split into segments, so that the segment reduced or received
+  // in one step is forwarded to the next rank at once, while the next segments are still being transferred.
   template <typename T>
-  bool ReduceBroadcastAllReduce(const std::string &data_name, const void *sendbuff, void *recvbuff, size_t count);
+  bool RunPipelinedRing(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+                        const std::vector<size_t> &chunk_sizes, const std::vector<size_t> &chunk_offset, T *buff,
+                        bool reduce_scatter, bool all_gather);
+
+  // Implementation of the recursive doubling AllReduce for small messages: the processes exchange the whole data with
+  // the partners of distance 1, 2, 4... in log(n) steps. The rank size must be a power of two.
+  template <typename T>
+  bool RunRecursiveDoublingAllReduce(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+                                     T *buff, size_t count);
+
+  // Implementation of the recursive halving ReduceScatter followed by the recursive doubling AllGather for medium
+  // messages, which sends the same data size as the ring in 2*log(n) steps. The rank size must be a power of two.
+  template <typename T>
+  bool RunRecursiveHalvingAllReduce(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+                                    T *buff, size_t count);
+
+  // Implementation of ReduceBroadcastAllReduce: reduce the data to the first rank and broadcast it.
+  template <typename T>
+  bool RunReduceBroadcastAllReduce(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+                                   T *buff, size_t count);
+
+  // Implementation of the hierarchical AllReduce: reduce the data to the first process of each host, AllReduce among
+  // these processes and broadcast the result in each host, so only one process per host sends the data across hosts.
+  template <typename T>
+  bool RunHierarchicalAllReduce(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+                                const std::vector<std::string> &hosts, T *buff, size_t count);
+
+  // Implementation of AllGather, ReduceScatter and AllToAll within the ranks.
+  template <typename T>
+  bool RunAllGather(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index, const void *sendbuff,
+                    void *recvbuff, size_t send_count);
+
+  template <typename T>
+  bool RunReduceScatter(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+                        const void *sendbuff, void *recvbuff, size_t recv_count);
+
+  template <typename T>
+  bool RunAllToAll(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index, const void *sendbuff,
+                   void *recvbuff, size_t count);
+
+  // Implementation of CompressedAllReduce. The data is split into the chunks of the same count, the last one padded
+  // with zeros, so that all the compressed chunks have the same size.
+  bool RunCompressedAllReduce(CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index,
+                              const ps::GradientCompressionConfig &config, float *buff, size_t count);
 
   // Implementation of RingAllGather.
   template <typename T>
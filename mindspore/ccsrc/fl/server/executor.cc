@@ -74,10 +74,20 @@ bool Executor::HandleModelUpdate(const std::string &param_name, const UploadData
     return true;
   }
 
-  std::mutex &mtx = parameter_mutex_[param_name];
-  std::unique_lock<std::mutex> lock(mtx);
   auto &param_aggr = param_aggrs_[param_name];
   MS_ERROR_IF_NULL_W_RET_VAL(param_aggr, false);
+  // The streaming aggregation folds the uploaded data in place and is threadsafe, so the updates of the clients are
+  // aggregated concurrently without the lock of the parameter.
+  if (param_aggr->IsStreaming()) {
+    if (!param_aggr->StreamData(upload_data)) {
+      MS_LOG(ERROR) << "Streaming data for parameter " << param_name << " failed.";
+      return false;
+    }
+    return true;
+  }
+
+  std::mutex &mtx = parameter_mutex_[param_name];
+  std::unique_lock<std::mutex> lock(mtx);
   if (!param_aggr->UpdateData(upload_data)) {
     MS_LOG(ERROR) << "Updating data for parameter " << param_name << " failed.";
     return false;
@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_FL_SERVER_KERNEL_AGGREGATION_KERNEL_H_
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 #include "plugin/device/cpu/kernel/cpu_kernel.h"
@@ -47,6 +48,13 @@ class AggregationKernelMod : public NativeCpuKernelMod {
   }
   virtual bool AllReduce() = 0;
 
+  // The streaming kernel folds the uploaded data into the aggregation result as soon as it arrives and is threadsafe,
+  // so the uploaded data is neither copied into the kernel inputs nor serialized with the other uploads. The inputs in
+  // streaming_input_names() are read from the uploaded data, and no memory is assigned for them.
+  virtual bool IsStreaming() const { return false; }
+  virtual bool LaunchStreaming(const UploadData &) { return false; }
+  const std::set<std::string> &streaming_input_names() const { return streaming_input_names_; }
+
   // Server kernel's memory allocation method, which is different from the workflow in
   // Session(GPUSession/CPUSession/AscendSession).
   // virtual void AssignMemory(const CNodePtr &kernel_node, std::shared_ptr<MemoryRegister> memory_register) = 0;
@@ -100,6 +108,9 @@ class AggregationKernelMod : public NativeCpuKernelMod {
   // Information about server kernel reusing kernel node inputs memory from the front end.
   // Key refers to the server kernel's input index. Value refers to the kernel node's input index.
   ReuseKernelNodeInfo reuse_kernel_node_inputs_info_;
+
+  // The inputs which are read from the uploaded data by the streaming kernel.
+  std::set<std::string> streaming_input_names_;
 };
 }  // namespace kernel
 }  // namespace server
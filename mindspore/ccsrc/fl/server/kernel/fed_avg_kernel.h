@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_FL_SERVER_KERNEL_FED_AVG_KERNEL_H_
 
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -29,6 +30,7 @@
 #include "fl/server/local_meta_store.h"
 #include "fl/server/kernel/aggregation_kernel.h"
 #include "fl/server/kernel/aggregation_kernel_factory.h"
+#include "fl/server/kernel/streaming_accumulator.h"
 
 namespace mindspore {
 namespace fl {
@@ -40,6 +42,10 @@ constexpr size_t kFedAvgInputsNum = 4;
 
 // Pay attention that this kernel is the distributed version of federated average, which means each server node in the
 // cluster in invalved in the aggragation process. So the DistributedCountService and CollectiveOpsImpl are called.
+
+// The uploaded weights are folded into the weight by StreamingAccumulator as soon as they arrive, so only the weight is
+// kept in memory no matter how many clients there are. Each server sums the weights of its own clients and the sums are
+// reduced across the servers in AllReduce, whose hierarchical algorithm reduces the sums within each host first.
 template <typename T, typename S>
 class FedAvgKernel : public AggregationKernelMod {
  public:
@@ -48,7 +54,9 @@ class FedAvgKernel : public AggregationKernelMod {
         weight_addr_(nullptr),
         data_size_addr_(nullptr),
         new_weight_addr_(nullptr),
-        new_data_size_addr_(nullptr) {}
+        new_data_size_addr_(nullptr) {
+    streaming_input_names_ = {kNewWeight, kNewDataSize};
+  }
   ~FedAvgKernel() override = default;
 
   void InitKernel(const CNodePtr &kernel_node) override {
@@ -83,7 +91,7 @@ class FedAvgKernel : public AggregationKernelMod {
   }
 
   bool AllReduce() override {
-    std::unique_lock<std::mutex> lock(weight_mutex_);
+    std::unique_lock<std::shared_mutex> lock(weight_mutex_);
     MS_ERROR_IF_NULL_W_RET_VAL(weight_addr_, false);
     MS_ERROR_IF_NULL_W_RET_VAL(data_size_addr_, false);
     MS_ERROR_IF_NULL_W_RET_VAL(weight_addr_->addr, false);
@@ -91,6 +99,7 @@ class FedAvgKernel : public AggregationKernelMod {
     T *weight_addr = reinterpret_cast<T *>(weight_addr_->addr);
     size_t weight_size = weight_addr_->size;
     S *data_size_addr = reinterpret_cast<S *>(data_size_addr_->addr);
+    data_size_addr[0] = accumulator_.weight_sum();
     if (!CollectiveOpsImpl::GetInstance().AllReduce<T>(name_, weight_addr, weight_addr, weight_size / sizeof(T))) {
       MS_LOG(ERROR) << "Federated average allreduce failed.";
       return false;
@@ -104,9 +113,7 @@ class FedAvgKernel : public AggregationKernelMod {
       return false;
     }
     LocalMetaStore::GetInstance().put_value(kCtxFedAvgTotalDataSize, data_size_addr[0]);
-    for (size_t i = 0; i < weight_size / sizeof(T); i++) {
-      weight_addr[i] /= data_size_addr[0];
-    }
+    accumulator_.Divide(data_size_addr[0]);
     done_ = true;
     return true;
   }
@@ -121,35 +128,30 @@ class FedAvgKernel : public AggregationKernelMod {
       MS_ERROR_IF_NULL_W_RET_VAL(inputs[i]->addr, false);
     }
 
-    std::unique_lock<std::mutex> lock(weight_mutex_);
-    if (done_) {
-      MS_LOG(INFO) << "AllReduce for " << name_ << " has finished";
-      return true;
-    }
     // The weight and new_weight values should be multiplied by clients already, so we don't need to do multiplication
     // again.
-    T *weight_addr = reinterpret_cast<T *>(inputs[0]->addr);
-    S *data_size_addr = reinterpret_cast<S *>(inputs[1]->addr);
-    T *new_weight_addr = reinterpret_cast<T *>(inputs[2]->addr);
-    S *new_data_size_addr = reinterpret_cast<S *>(inputs[3]->addr);
+    return Fold(inputs[2]->addr, inputs[2]->size, inputs[3]->addr, inputs[3]->size);
+  }
 
-    MS_LOG(DEBUG) << "Iteration: " << LocalMetaStore::GetInstance().curr_iter_num() << " launching FedAvgKernel for "
-                  << name_ << " new data size is " << new_data_size_addr[0] << ", current total data size is "
-                  << data_size_addr[0];
-    for (size_t i = 0; i < inputs[2]->size / sizeof(T); i++) {
-      weight_addr[i] += new_weight_addr[i];
-    }
-    data_size_addr[0] += new_data_size_addr[0];
-    lock.unlock();
+  bool IsStreaming() const override { return true; }
 
-    accum_count_++;
-    return true;
+  bool LaunchStreaming(const UploadData &upload_data) override {
+    auto new_weight = upload_data.find(kNewWeight);
+    auto new_data_size = upload_data.find(kNewDataSize);
+    if (new_weight == upload_data.end() || new_data_size == upload_data.end()) {
+      MS_LOG(ERROR) << "The uploaded data of " << name_ << " should contain " << kNewWeight << " and " << kNewDataSize;
+      return false;
+    }
+    return Fold(new_weight->second.addr, new_weight->second.size, new_data_size->second.addr,
+                new_data_size->second.size);
   }
 
   void Reset() override {
+    std::unique_lock<std::shared_mutex> lock(weight_mutex_);
     accum_count_ = 0;
     done_ = false;
     ClearWeightAndDataSize();
+    accumulator_.Reset();
   }
 
   bool IsAggregationDone() override { return done_; }
@@ -160,6 +162,9 @@ class FedAvgKernel : public AggregationKernelMod {
     data_size_addr_ = inputs[1];
     new_weight_addr_ = inputs[2];
     new_data_size_addr_ = inputs[3];
+    if (weight_addr_ != nullptr && weight_addr_->addr != nullptr) {
+      accumulator_.Init(reinterpret_cast<T *>(weight_addr_->addr), weight_addr_->size / sizeof(T));
+    }
     return;
   }
   bool ReInitForUpdatingHyperParams(size_t aggr_threshold) override {
@@ -175,6 +180,27 @@ class FedAvgKernel : public AggregationKernelMod {
     return;
   }
 
+  // Fold the new weight of one client into the weight. The clients are folded concurrently, while AllReduce and Reset
+  // wait for them.
+  bool Fold(const void *new_weight, size_t new_weight_size, const void *new_data_size, size_t new_data_size_size) {
+    MS_ERROR_IF_NULL_W_RET_VAL(new_weight, false);
+    MS_ERROR_IF_NULL_W_RET_VAL(new_data_size, false);
+    if (new_data_size_size < sizeof(S)) {
+      MS_LOG(ERROR) << "The new data size of " << name_ << " is " << new_data_size_size << " bytes, but " << sizeof(S)
+                    << " are expected.";
+      return false;
+    }
+    std::shared_lock<std::shared_mutex> lock(weight_mutex_);
+    if (done_) {
+      MS_LOG(INFO) << "AllReduce for " << name_ << " has finished";
+      return true;
+    }
+    S data_size = *reinterpret_cast<const S *>(new_data_size);
+    MS_LOG(DEBUG) << "Iteration: " << LocalMetaStore::GetInstance().curr_iter_num() << " launching FedAvgKernel for "
+                  << name_ << " new data size is " << data_size;
+    return accumulator_.Fold(reinterpret_cast<const T *>(new_weight), new_weight_size / sizeof(T), data_size);
+  }
+
   // In some cases, the Launch method is not called and the weights involved in AllReduce should be set to 0.
   void ClearWeightAndDataSize() {
     MS_ERROR_IF_NULL_WO_RET_VAL(weight_addr_);
@@ -202,8 +228,11 @@ class FedAvgKernel : public AggregationKernelMod {
   AddressPtr data_size_addr_;
   AddressPtr new_weight_addr_;
   AddressPtr new_data_size_addr_;
-  // The kernel could be called concurrently so we need lock to ensure threadsafe.
-  std::mutex weight_mutex_;
+  // The weight which the new weights are folded into.
+  StreamingAccumulator<T, S> accumulator_;
+  // The kernel could be called concurrently so we need lock to ensure threadsafe. The new weights are folded with the
+  // shared lock, and the exclusive lock is acquired to reduce or clear the weight.
+  std::shared_mutex weight_mutex_;
 };
 }  // namespace kernel
 }  // namespace server
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_CCSRC_FL_SERVER_KERNEL_STREAMING_ACCUMULATOR_H_
+#define MINDSPORE_CCSRC_FL_SERVER_KERNEL_STREAMING_ACCUMULATOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "include/common/thread_pool.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace fl {
+namespace server {
+namespace kernel {
+// The element count of each stripe of the accumulator.
+constexpr size_t kAccumulatorStripeCount = 1 << 16;
+// The minimum element count of the update which is folded in the thread pool.
+constexpr size_t kParallelFoldCount = 1 << 20;
+
+// StreamingAccumulator folds the updates of the clients into one sum buffer as soon as each update arrives, so the
+// memory of the aggregation is one buffer of the weight size no matter how many clients there are. The sum buffer is
+// split into stripes guarded by their own locks, and each update visits the stripes from a different start, so the
+// concurrent updates are folded into different stripes at the same time. The large update is also split to the threads
+// of the thread pool.
+// Fold is threadsafe, while the other methods must not be called concurrently with Fold.
+template <typename T, typename S>
+class StreamingAccumulator {
+ public:
+  StreamingAccumulator() : sum_(nullptr), count_(0), stripe_num_(0), next_stripe_(0), weight_sum_(0), update_num_(0) {}
+  ~StreamingAccumulator() = default;
+
+  // Set the sum buffer of count elements, which is owned by the caller.
+  void Init(T *sum, size_t count) {
+    MS_EXCEPTION_IF_NULL(sum);
+    sum_ = sum;
+    count_ = count;
+    stripe_num_ = std::max((count + kAccumulatorStripeCount - 1) / kAccumulatorStripeCount, static_cast<size_t>(1));
+    stripe_mutexes_ = std::make_unique<std::mutex[]>(stripe_num_);
+    Reset();
+  }
+
+  // Add the update of count elements to the sum, and add its weight to the weight sum.
+  bool Fold(const T *update, size_t count, S weight) {
+    if (sum_ == nullptr || update == nullptr) {
+      MS_LOG(ERROR) << "The sum buffer or the update is nullptr.";
+      return false;
+    }
+    if (count != count_) {
+      MS_LOG(ERROR) << "The update has " << count << " elements, but " << count_ << " are expected.";
+      return false;
+    }
+    size_t start = next_stripe_.fetch_add(1) % stripe_num_;
+    auto &thread_pool = common::ThreadPool::GetInstance();
+    size_t thread_num = std::min(thread_pool.GetSyncRunThreadNum(), stripe_num_);
+    if (count < kParallelFoldCount || thread_num <= 1) {
+      FoldStripes(update, start, 0, 1);
+    } else {
+      std::vector<common::Task> tasks;
+      for (size_t i = 0; i < thread_num; i++) {
+        (void)tasks.emplace_back([this, update, start, i, thread_num]() {
+          FoldStripes(update, start, i, thread_num);
+          return common::SUCCESS;
+        });
+      }
+      (void)thread_pool.SyncRun(tasks);
+    }
+    std::lock_guard<std::mutex> lock(weight_mutex_);
+    weight_sum_ += weight;
+    update_num_++;
+    return true;
+  }
+
+  // Divide the sum by the divisor, eg. the weight sum of all the servers.
+  void Divide(S divisor) {
+    MS_EXCEPTION_IF_NULL(sum_);
+    auto &thread_pool = common::ThreadPool::GetInstance();
+    size_t thread_num = std::min(thread_pool.GetSyncRunThreadNum(), count_ / kParallelFoldCount);
+    if (thread_num <= 1) {
+      DivideRange(0, count_, divisor);
+      return;
+    }
+    size_t task_count = (count_ + thread_num - 1) / thread_num;
+    std::vector<common::Task> tasks;
+    for (size_t start = 0; start < count_; start += task_count) {
+      size_t end = std::min(start + task_count, count_);
+      (void)tasks.emplace_back([this, start, end, divisor]() {
+        DivideRange(start, end, divisor);
+        return common::SUCCESS;
+      });
+    }
+    (void)thread_pool.SyncRun(tasks);
+  }
+
+  // Clear the weight sum and the update number. The sum buffer is cleared by the caller.
+  void Reset() {
+    std::lock_guard<std::mutex> lock(weight_mutex_);
+    weight_sum_ = 0;
+    update_num_ = 0;
+  }
+
+  S weight_sum() {
+    std::lock_guard<std::mutex> lock(weight_mutex_);
+    return weight_sum_;
+  }
+
+  size_t update_num() {
+    std::lock_guard<std::mutex> lock(weight_mutex_);
+    return update_num_;
+  }
+
+ private:
+  // Fold the stripes start + offset, start + offset + step... of the update in turn.
+  void FoldStripes(const T *update, size_t start, size_t offset, size_t step) {
+    for (size_t i = offset; i < stripe_num_; i += step) {
+      size_t stripe = (start + i) % stripe_num_;
+      size_t begin = stripe * kAccumulatorStripeCount;
+      size_t end = std::min(begin + kAccumulatorStripeCount, count_);
+      std::lock_guard<std::mutex> lock(stripe_mutexes_[stripe]);
+      // The plain loop is vectorized by the compiler.
+      for (size_t j = begin; j < end; j++) {
+        sum_[j] += update[j];
+      }
+    }
+  }
+
+  void DivideRange(size_t begin, size_t end, S divisor) {
+    for (size_t i = begin; i < end; i++) {
+      sum_[i] /= divisor;
+    }
+  }
+
+  T *sum_;
+  size_t count_;
+  size_t stripe_num_;
+  std::unique_ptr<std::mutex[]> stripe_mutexes_;
+
+  // The stripe which the next update starts from.
+  std::atomic<size_t> next_stripe_;
+
+  std::mutex weight_mutex_;
+  S weight_sum_;
+  size_t update_num_;
+};
+}  // namespace kernel
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FL_SERVER_KERNEL_STREAMING_ACCUMULATOR_H_
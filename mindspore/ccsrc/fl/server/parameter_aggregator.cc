@@ -25,6 +25,15 @@
 namespace mindspore {
 namespace fl {
 namespace server {
+namespace {
+// The inputs of the streaming aggregation kernels are read from the uploaded data, so no memory is assigned for them.
+bool IsStreamingInput(const std::shared_ptr<kernel::AggregationKernelMod> &server_kernel, const std::string &name) {
+  return server_kernel->IsStreaming() && server_kernel->streaming_input_names().count(name) != 0;
+}
+
+bool IsStreamingInput(const std::shared_ptr<kernel::OptimizerKernelMod> &, const std::string &) { return false; }
+}  // namespace
+
 bool ParameterAggregator::Init(const CNodePtr &cnode, size_t threshold_count) {
   MS_EXCEPTION_IF_NULL(cnode);
   memory_register_ = std::make_shared<MemoryRegister>();
@@ -111,6 +120,28 @@ bool ParameterAggregator::LaunchAggregators() {
   return true;
 }
 
+bool ParameterAggregator::IsStreaming() const {
+  if (aggregation_kernel_parameters_.empty()) {
+    return false;
+  }
+  return std::all_of(aggregation_kernel_parameters_.begin(), aggregation_kernel_parameters_.end(),
+                     [](const auto &aggregator_with_params) {
+                       return aggregator_with_params.first != nullptr && aggregator_with_params.first->IsStreaming();
+                     });
+}
+
+bool ParameterAggregator::StreamData(const std::map<std::string, Address> &new_data) {
+  for (auto &aggregator_with_params : aggregation_kernel_parameters_) {
+    std::shared_ptr<kernel::AggregationKernelMod> aggr_kernel = aggregator_with_params.first;
+    MS_ERROR_IF_NULL_W_RET_VAL(aggr_kernel, false);
+    if (!aggr_kernel->LaunchStreaming(new_data)) {
+      MS_LOG(ERROR) << "Launching streaming aggregation kernel " << typeid(aggr_kernel.get()).name() << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
 AddressPtr ParameterAggregator::GetWeight() {
   if (memory_register_ == nullptr) {
     MS_LOG(ERROR)
@@ -250,6 +281,8 @@ bool ParameterAggregator::AssignMemory(const K server_kernel, const CNodePtr &cn
       AddressPtr input_addr = GenerateParameterNodeAddrPtr(cnode, index);
       MS_EXCEPTION_IF_NULL(input_addr);
       memory_register->RegisterAddressPtr(name, input_addr);
+    } else if (IsStreamingInput(server_kernel, name)) {
+      MS_LOG(INFO) << "The streaming input " << name << " is read from the uploaded data, no memory is assigned.";
     } else {
       MS_LOG(INFO) << "Assign new memory for " << name;
       auto input_addr = std::make_unique<char[]>(input_size_list[i]);
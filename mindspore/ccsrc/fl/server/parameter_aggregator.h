@@ -78,6 +78,14 @@ class ParameterAggregator {
   // Launch aggregators/optimizers of this ParameterAggregator in order.
   bool LaunchAggregators();
 
+  // Whether all the aggregation kernels are streaming kernels. The streaming aggregation is threadsafe, so the caller
+  // doesn't need to acquire lock before calling StreamData concurrently.
+  bool IsStreaming() const;
+
+  // Fold the uploaded data into the aggregation result with the streaming aggregation kernels, without copying it into
+  // the memory of ParameterAggregator.
+  bool StreamData(const std::map<std::string, Address> &new_data);
+
   // Different from the method Pull, this method simply returns the weight of this ParameterAggregator without causing
   // any change of status.
   AddressPtr GetWeight();
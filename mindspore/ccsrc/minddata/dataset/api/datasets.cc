@@ -610,7 +610,7 @@ int64_t Dataset::GetRepeatCount() {
 }
 
 std::shared_ptr<Dataset> Dataset::SetNumWorkers(int32_t num_workers) {
-  if (ir_node_ == nullptr || ir_node_->SetNumWorkers(num_workers) == nullptr) {
+  if (ir_node_ == nullptr || ir_node_->SetUserNumWorkers(num_workers) == nullptr) {
     return nullptr;
   }
   return shared_from_this();
@@ -28,10 +28,12 @@
 
 // IR non-leaf nodes
 #include "minddata/dataset/engine/ir/datasetops/batch_node.h"
+#include "minddata/dataset/engine/ir/datasetops/batch_by_tokens_node.h"
 #include "minddata/dataset/engine/ir/datasetops/concat_node.h"
 #include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
 #include "minddata/dataset/engine/ir/datasetops/filter_node.h"
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/engine/ir/datasetops/pack_sequences_node.h"
 #include "minddata/dataset/engine/ir/datasetops/project_node.h"
 #include "minddata/dataset/engine/ir/datasetops/rename_node.h"
 #include "minddata/dataset/engine/ir/datasetops/repeat_node.h"
@@ -55,7 +57,7 @@ PYBIND_REGISTER(DatasetNode, 1, ([](const py::module *m) {
                   (void)py::class_<DatasetNode, std::shared_ptr<DatasetNode>>(*m, "Dataset")
                     .def("set_num_workers",
                          [](const std::shared_ptr<DatasetNode> &self, std::optional<int32_t> num_workers) {
-                           return num_workers ? self->SetNumWorkers(*num_workers) : self;
+                           return num_workers ? self->SetUserNumWorkers(*num_workers) : self;
                          })
                     .def("set_cache_client",
                          [](const std::shared_ptr<DatasetNode> &self, std::shared_ptr<CacheClient> cc) {
@@ -113,6 +115,27 @@ PYBIND_REGISTER(
       }));
   }));
 
+PYBIND_REGISTER(BatchByTokensNode, 2, ([](const py::module *m) {
+                  (void)py::class_<BatchByTokensNode, DatasetNode, std::shared_ptr<BatchByTokensNode>>(
+                    *m, "BatchByTokensNode", "to create a BatchByTokensNode")
+                    .def(py::init([](const std::shared_ptr<DatasetNode> &dataset, const py::list &column_names,
+                                     int32_t max_tokens, int32_t lookahead_size, py::object element_length_function,
+                                     const py::dict &pad_info, bool drop_remainder) {
+                           std::map<std::string, std::pair<TensorShape, std::shared_ptr<Tensor>>> c_pad_info;
+                           THROW_IF_ERROR(toPadInfo(pad_info, &c_pad_info));
+
+                           auto batch_by_tokens = std::make_shared<BatchByTokensNode>(
+                             dataset, toStringVector(column_names), max_tokens, lookahead_size,
+                             toPyFuncOp(std::move(element_length_function), DataType::DE_INT32), c_pad_info,
+                             drop_remainder);
+                           THROW_IF_ERROR(batch_by_tokens->ValidateParams());
+                           return batch_by_tokens;
+                         }),
+                         py::arg("dataset"), py::arg("column_names"), py::arg("max_tokens"),
+                         py::arg("lookahead_size"), py::arg("element_length_function") = py::none(),
+                         py::arg("pad_info"), py::arg("drop_remainder"));
+                }));
+
 PYBIND_REGISTER(BucketBatchByLengthNode, 2, ([](const py::module *m) {
                   (void)py::class_<BucketBatchByLengthNode, DatasetNode, std::shared_ptr<BucketBatchByLengthNode>>(
                     *m, "BucketBatchByLengthNode", "to create a BucketBatchByLengthNode")
@@ -218,6 +241,18 @@ PYBIND_REGISTER(PythonMultiprocessingRuntime, 1, ([](const py::module *m) {
                     .def("GetPIDs", &PythonMultiprocessingRuntime::GetPIDs);
                 }));
 
+PYBIND_REGISTER(PackSequencesNode, 2, ([](const py::module *m) {
+                  (void)py::class_<PackSequencesNode, DatasetNode, std::shared_ptr<PackSequencesNode>>(
+                    *m, "PackSequencesNode", "to create a PackSequencesNode")
+                    .def(py::init([](const std::shared_ptr<DatasetNode> &self, const std::string &column_name,
+                                     int32_t seq_length, int32_t window_size, int64_t pad_value) {
+                      auto pack = std::make_shared<PackSequencesNode>(self, column_name, seq_length, window_size,
+                                                                      pad_value);
+                      THROW_IF_ERROR(pack->ValidateParams());
+                      return pack;
+                    }));
+                }));
+
 PYBIND_REGISTER(ProjectNode, 2, ([](const py::module *m) {
                   (void)py::class_<ProjectNode, DatasetNode, std::shared_ptr<ProjectNode>>(*m, "ProjectNode",
                                                                                            "to create a ProjectNode")
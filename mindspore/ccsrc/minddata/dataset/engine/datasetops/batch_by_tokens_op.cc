@@ -0,0 +1,207 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/batch_by_tokens_op.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+BatchByTokensOp::BatchByTokensOp(const std::vector<std::string> &length_dependent_columns, int32_t max_tokens,
+                                 int32_t lookahead_size, std::shared_ptr<TensorOp> element_length_function,
+                                 const PadInfo &pad_info, bool drop_remainder, int32_t op_connector_size)
+    : PipelineOp(op_connector_size),
+      length_dependent_columns_(length_dependent_columns),
+      max_tokens_(max_tokens),
+      lookahead_size_(lookahead_size),
+      element_length_function_(std::move(element_length_function)),
+      pad_info_(pad_info),
+      drop_remainder_(drop_remainder),
+      batch_count_(0),
+      padded_token_count_(0),
+      real_token_count_(0) {
+  window_.reserve(static_cast<size_t>(lookahead_size_));
+}
+
+void BatchByTokensOp::Print(std::ostream &out, bool show_all) const {
+  if (!show_all) {
+    // Call the super class for displaying any common 1-liner info
+    PipelineOp::Print(out, show_all);
+    // Then show any custom derived-internal 1-liner info for this op
+    out << " [max tokens: " << max_tokens_ << "]\n";
+  } else {
+    // Call the super class for displaying any common detailed info
+    PipelineOp::Print(out, show_all);
+    // Then show any custom derived-internal stuff
+    out << "\nMax tokens: " << max_tokens_ << "\nLookahead size: " << lookahead_size_
+        << "\nDrop remainder: " << (drop_remainder_ ? "yes" : "no") << "\n\n";
+  }
+}
+
+Status BatchByTokensOp::EoeReceived(int32_t) {
+  state_ = OpState::kDeOpIdle;
+  return Status::OK();
+}
+
+Status BatchByTokensOp::operator()() {
+  TaskManager::FindMe()->Post();
+
+  TensorRow current_row;
+  child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
+  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&current_row));
+  while (!child_iterator_->EofHandled()) {
+    while (!current_row.empty()) {
+      int32_t element_length;
+      RETURN_IF_NOT_OK(ObtainElementLength(&element_length, current_row));
+      window_.emplace_back(element_length, std::move(current_row));
+
+      if (window_.size() >= static_cast<size_t>(lookahead_size_)) {
+        RETURN_IF_NOT_OK(FlushWindow(false));
+      }
+
+      RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&current_row));
+    }
+
+    // got EOE, batch everything left in the window
+    RETURN_IF_NOT_OK(FlushWindow(true));
+
+    // need to send EOE manually since we set state to idle in EoeRecieved()
+    RETURN_IF_NOT_OK(out_connector_->SendEOE());
+
+    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&current_row));
+  }
+  if (padded_token_count_ > 0) {
+    MS_LOG(INFO) << Name() << " sent " << batch_count_ << " batches, padding ratio: "
+                 << static_cast<double>(padded_token_count_ - real_token_count_) / padded_token_count_;
+  }
+  RETURN_IF_NOT_OK(out_connector_->SendEOF());
+
+  return Status::OK();
+}
+
+Status BatchByTokensOp::ObtainElementLength(int32_t *out_element_length, const TensorRow &element) {
+  RETURN_UNEXPECTED_IF_NULL(out_element_length);
+  // call pyfunc here if given pyfunc, otherwise return the largest 0th dimension of the length dependent columns
+  if (element_length_function_) {
+    TensorRow input, output;
+    for (auto column_index : length_column_ids_) {
+      input.push_back(element[column_index]);
+    }
+    RETURN_IF_NOT_OK(element_length_function_->Compute(input, &output));
+    RETURN_IF_NOT_OK(output.at(0)->GetItemAt(out_element_length, {0}));
+    if (*out_element_length < 0) {
+      RETURN_STATUS_UNEXPECTED(
+        "Invalid element_length_function, element_length_function must return an integer greater than or equal to 0, "
+        "but got " +
+        std::to_string(*out_element_length));
+    }
+  } else {
+    *out_element_length = 0;
+    for (auto column_index : length_column_ids_) {
+      CHECK_FAIL_RETURN_UNEXPECTED(element[column_index]->Rank() > 0,
+                                   "Invalid data, BatchByTokens requires the length dependent columns to have rank "
+                                   "greater than 0, but got a scalar.");
+      *out_element_length = std::max(*out_element_length, static_cast<int32_t>(element[column_index]->shape()[0]));
+    }
+  }
+  return Status::OK();
+}
+
+Status BatchByTokensOp::FlushWindow(bool flush_all) {
+  // Stable sort keeps the arrival order of rows with equal length.
+  std::stable_sort(window_.begin(), window_.end(),
+                   [](const std::pair<int32_t, TensorRow> &a, const std::pair<int32_t, TensorRow> &b) {
+                     return a.first < b.first;
+                   });
+
+  size_t begin = 0;
+  while (begin < window_.size()) {
+    // Extend the batch greedily while its padded size, rows * longest row, stays within the budget. A row longer
+    // than the budget forms a batch on its own.
+    size_t end = begin;
+    int64_t longest = 0;
+    while (end < window_.size()) {
+      int64_t candidate = std::max(longest, static_cast<int64_t>(window_[end].first));
+      if (end > begin && static_cast<int64_t>(end - begin + 1) * candidate > max_tokens_) {
+        break;
+      }
+      longest = candidate;
+      end++;
+    }
+
+    // The batch which reaches the end of the window is open only if one more row of its longest length still fits
+    // in the budget, so an exactly full batch is never taken as the remainder.
+    bool is_open_batch = end == window_.size() && static_cast<int64_t>(end - begin + 1) * longest <= max_tokens_;
+    if (is_open_batch && !flush_all && begin > 0) {
+      // Keep the trailing batch in the window, the next rows may fill it up.
+      break;
+    }
+    if (is_open_batch && flush_all && drop_remainder_) {
+      begin = end;
+      break;
+    }
+    RETURN_IF_NOT_OK(PadAndBatchRows(begin, end));
+    begin = end;
+  }
+  (void)window_.erase(window_.begin(), window_.begin() + static_cast<std::ptrdiff_t>(begin));
+  return Status::OK();
+}
+
+Status BatchByTokensOp::PadAndBatchRows(size_t begin, size_t end) {
+  auto table = std::make_unique<TensorQTable>();
+  int64_t longest = 0;
+  for (size_t i = begin; i < end; i++) {
+    longest = std::max(longest, static_cast<int64_t>(window_[i].first));
+    real_token_count_ += window_[i].first;
+    table->push_back(std::move(window_[i].second));
+  }
+  padded_token_count_ += longest * static_cast<int64_t>(end - begin);
+
+  // PadColumns will change the data in table
+  RETURN_IF_NOT_OK(BatchOp::PadColumns(&table, pad_info_, column_name_id_map_));
+
+  TensorRow batched_rows;
+  RETURN_IF_NOT_OK(BatchOp::BatchRows(&table, &batched_rows, static_cast<dsize_t>(end - begin)));
+  RETURN_IF_NOT_OK(out_connector_->Add(std::move(batched_rows)));
+
+  batch_count_++;
+  return Status::OK();
+}
+
+// Computing the assignment of the column name map and check compute input columns.
+Status BatchByTokensOp::ComputeColMap() {
+  RETURN_IF_NOT_OK(DatasetOp::ComputeColMap());
+
+  length_column_ids_.clear();
+  for (const auto &in_col : length_dependent_columns_) {
+    auto it = column_name_id_map_.find(in_col);
+    if (it == column_name_id_map_.end()) {
+      std::string err_msg =
+        "Invalid parameter, input column name: " + in_col + " doesn't exist in the dataset columns.";
+      RETURN_STATUS_UNEXPECTED(err_msg);
+    }
+    length_column_ids_.push_back(it->second);
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,107 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_BY_TOKENS_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_BY_TOKENS_OP_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/dataset_iterator.h"
+#include "minddata/dataset/engine/datasetops/batch_op.h"
+#include "minddata/dataset/engine/datasetops/pipeline_op.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// BatchByTokensOp groups variable-length rows into batches whose padded size (number of rows times the longest
+// row in the batch) stays within a token budget. Rows are buffered in a lookahead window which is sorted by length
+// before batches are cut, so rows of similar length end up together and the padding per batch is minimized.
+class BatchByTokensOp : public PipelineOp {
+ public:
+  BatchByTokensOp(const std::vector<std::string> &length_dependent_columns, int32_t max_tokens,
+                  int32_t lookahead_size, std::shared_ptr<TensorOp> element_length_function, const PadInfo &pad_info,
+                  bool drop_remainder, int32_t op_connector_size);
+
+  // Destructor
+  ~BatchByTokensOp() = default;
+
+  // Might need to batch the rows left in the window after receiving eoe, so override this method.
+  // @param int32_t workerId
+  // @return Status The status code returned
+  Status EoeReceived(int32_t) override;
+
+  std::string Name() const override { return kBatchByTokensOp; }
+
+  // A print method typically used for debugging
+  // @param out - The output stream to write output to
+  // @param show_all - A bool to control if you want to show all info or just a summary
+  void Print(std::ostream &out, bool show_all) const override;
+
+  // << Stream output operator overload
+  // @notes This allows you to write the debug print info using stream operators
+  // @param out - reference to the output stream being overloaded
+  // @param bo - reference to the BatchByTokensOp to display
+  // @return - the output stream must be returned
+  friend std::ostream &operator<<(std::ostream &out, const BatchByTokensOp &bo) {
+    bo.Print(out, false);
+    return out;
+  }
+
+  // Main loop of batch
+  // @return Status The status code returned
+  Status operator()() override;
+
+ private:
+  // Compute the length of a row, either by calling element_length_function_ or by taking the largest
+  // 0th dimension of the length dependent columns.
+  // @param int32_t *out_element_length - the length of the row
+  // @param const TensorRow &element - the row to measure
+  // @return Status The status code returned
+  Status ObtainElementLength(int32_t *out_element_length, const TensorRow &element);
+
+  // Sort the lookahead window by length and emit every batch that is closed by the token budget.
+  // @param bool flush_all - if true, also emit the trailing batch that could still take more rows
+  // @return Status The status code returned
+  Status FlushWindow(bool flush_all);
+
+  // Pad the rows [begin, end) of the window to the longest row and send them as one batch.
+  // @return Status The status code returned
+  Status PadAndBatchRows(size_t begin, size_t end);
+
+  Status ComputeColMap() override;
+
+  std::vector<std::string> length_dependent_columns_;
+  std::vector<int32_t> length_column_ids_;
+  int32_t max_tokens_;
+  int32_t lookahead_size_;
+  std::shared_ptr<TensorOp> element_length_function_;
+  PadInfo pad_info_;
+  bool drop_remainder_;
+
+  int64_t batch_count_;
+  int64_t padded_token_count_;  // number of padded tokens sent, for the padding ratio in the debug log
+  int64_t real_token_count_;    // number of real tokens sent
+  std::unique_ptr<ChildIterator> child_iterator_;
+  std::vector<std::pair<int32_t, TensorRow>> window_;  // (length, row) pairs waiting to be batched
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_BY_TOKENS_OP_H_
@@ -22,6 +22,10 @@
 #include "minddata/dataset/core/pybind_support.h"
 #endif
 
+#include "minddata/dataset/core/global_context.h"
+#ifndef ENABLE_SECURITY
+#include "minddata/dataset/engine/perf/op_latency_tracing.h"
+#endif
 #include "minddata/dataset/kernels/data/data_utils.h"
 #include "minddata/dataset/util/status.h"
 
@@ -227,6 +231,11 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *d
 Status BatchOp::WorkerEntry(int32_t workerId) {
   TaskManager::FindMe()->Post();
   std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair;
+#ifndef ENABLE_SECURITY
+  // The tracing node is only returned while this tree is profiled, otherwise the timing below is skipped.
+  std::shared_ptr<OpLatencyTracing> latency_tracing = GlobalContext::profiling_manager()->GetOpLatencyTracing(tree_);
+  uint64_t wait_start = latency_tracing != nullptr ? ProfilingTime::GetCurMicroSecond() : 0;
+#endif
   RETURN_IF_NOT_OK(worker_in_queues_[workerId]->PopFront(&table_pair));
   while (table_pair.second.ctrl_ != batchCtrl::kQuit) {
     if (table_pair.second.ctrl_ == batchCtrl::kEOE) {
@@ -237,9 +246,27 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
       RETURN_IF_NOT_OK(worker_out_queues_[workerId]->EmplaceBack(TensorRow(TensorRow::TensorRowFlags::kFlagWait)));
     } else if (table_pair.second.ctrl_ == batchCtrl::kNoCtrl) {
       TensorRow new_row;
+#ifndef ENABLE_SECURITY
+      uint64_t compute_start = 0;
+      if (latency_tracing != nullptr) {
+        compute_start = ProfilingTime::GetCurMicroSecond();
+        latency_tracing->RecordLatency(id(), Name(), workerId, kOpLatencyWaitStage, wait_start, compute_start);
+      }
+#endif
       RETURN_IF_NOT_OK(MakeBatchedRow(std::move(table_pair), &new_row));
+#ifndef ENABLE_SECURITY
+      if (latency_tracing != nullptr) {
+        latency_tracing->RecordLatency(id(), Name(), workerId, kOpLatencyComputeStage, compute_start,
+                                       ProfilingTime::GetCurMicroSecond());
+      }
+#endif
       RETURN_IF_NOT_OK(worker_out_queues_[workerId]->EmplaceBack(std::move(new_row)));
     }
+#ifndef ENABLE_SECURITY
+    if (latency_tracing != nullptr) {
+      wait_start = ProfilingTime::GetCurMicroSecond();
+    }
+#endif
     RETURN_IF_NOT_OK(worker_in_queues_[workerId]->PopFront(&table_pair));
   }
   return Status::OK();
@@ -32,6 +32,7 @@ namespace mindspore {
 namespace dataset {
 
 constexpr char kBarrierOp[] = "BarrierOp";
+constexpr char kBatchByTokensOp[] = "BatchByTokensOp";
 constexpr char kBatchOp[] = "BatchOp";
 constexpr char kBucketBatchByLengthOp[] = "BucketBatchByLengthOp";
 constexpr char kBuildSentencePieceVocabOp[] = "BuildSentencePieceVocabOp";
@@ -46,6 +47,7 @@ constexpr char kDeviceQueueOp[] = "DeviceQueueOp";
 constexpr char kEpochCtrlOp[] = "EpochCtrlOp";
 constexpr char kFilterOp[] = "FilterOp";
 constexpr char kMapOp[] = "MapOp";
+constexpr char kPackSequencesOp[] = "PackSequencesOp";
 constexpr char kParallelOp[] = "ParallelOp";
 constexpr char kPipelineOp[] = "PipelineOp";
 constexpr char kProjectOp[] = "ProjectOp";
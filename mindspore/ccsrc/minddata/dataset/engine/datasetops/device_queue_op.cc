@@ -692,8 +692,28 @@ Status DeviceQueueOp::ClearDevice() {
 Status DeviceQueueOp::SendDataToCPU() {
   MS_LOG(INFO) << "Device queue, sending data to CPU.";
   int64_t total_batch = 0;
+#ifndef ENABLE_SECURITY
+  uint64_t batch_start_time = 0;
+  uint64_t end_time = 0;
+  int32_t connector_size = 0;
+  int32_t connector_capacity = 0;
+  std::shared_ptr<DeviceQueueTracing> profiling_node;
+  bool is_profiling_enable = GlobalContext::profiling_manager()->IsProfilingEnable(tree_);
+  if (is_profiling_enable) {
+    std::shared_ptr<Tracing> node;
+    RETURN_IF_NOT_OK(GlobalContext::profiling_manager()->GetTracingNode(kDeviceQueueTracingName, &node));
+    profiling_node = std::dynamic_pointer_cast<DeviceQueueTracing>(node);
+    batch_start_time = ProfilingTime::GetCurMilliSecond();
+  }
+#endif
 
   while (!(child_iterator_->EofHandled())) {
+#ifndef ENABLE_SECURITY
+    if (is_profiling_enable) {
+      connector_size = ChildOpConnectorSize();
+      connector_capacity = ChildOpConnectorCapacity();
+    }
+#endif
     TensorRow curr_row;
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&curr_row));
 
@@ -704,9 +724,20 @@ Status DeviceQueueOp::SendDataToCPU() {
       for (auto &tensor : curr_row) {
         MS_LOG(DEBUG) << "Feature size is " << tensor->SizeInBytes() << ".";
       }
+#ifndef ENABLE_SECURITY
+      // There is no push to a device on the CPU target, so the pipeline time of a batch is the time waiting for it.
+      ProfilingRecorder(is_profiling_enable, profiling_node, total_batch, 0, &batch_start_time, &end_time,
+                        connector_capacity, connector_size);
+#endif
       total_batch++;
       if (stop_send_) break;
     }
+#ifndef ENABLE_SECURITY
+    if (curr_row.eoe() && is_profiling_enable) {
+      tree_->SetEpochEnd();
+      GlobalContext::profiling_manager()->RecordEndOfEpoch(total_batch);
+    }
+#endif
   }
 
   MS_LOG(INFO) << "Device queue total batch is " << total_batch << ".";
@@ -18,6 +18,9 @@
 #include <string>
 #include <utility>
 #include "minddata/dataset/engine/datasetops/map_op/cpu_map_job.h"
+#ifndef ENABLE_SECURITY
+#include "minddata/dataset/engine/perf/op_latency_tracing.h"
+#endif
 
 namespace mindspore {
 namespace dataset {
@@ -39,8 +42,17 @@ Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
     TensorRow input_row = in[row];
     TensorRow result_row;
     for (size_t i = 0; i < ops_.size(); i++) {
+#ifndef ENABLE_SECURITY
+      uint64_t start_time = latency_tracing_ != nullptr ? ProfilingTime::GetCurMicroSecond() : 0;
+#endif
       // Call compute function for cpu
       Status rc = ops_[i]->Compute(input_row, &result_row);
+#ifndef ENABLE_SECURITY
+      if (latency_tracing_ != nullptr) {
+        latency_tracing_->RecordLatency(op_id_, op_name_, worker_id_, ops_[i]->Name(), start_time,
+                                        ProfilingTime::GetCurMicroSecond());
+      }
+#endif
       if (rc.IsError()) {
         RETURN_IF_NOT_OK(RebuildMapErrorMsg(input_row, i, &rc));
       }
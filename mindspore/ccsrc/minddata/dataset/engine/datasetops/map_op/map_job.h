@@ -17,6 +17,7 @@
 #define DATASET_ENGINE_DATASETOPS_MAP_OP_MAP_JOB_H_
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "minddata/dataset/core/tensor.h"
@@ -26,13 +27,16 @@
 
 namespace mindspore {
 namespace dataset {
+class OpLatencyTracing;
+
 class MapJob {
  public:
   // Constructor
-  explicit MapJob(std::vector<std::shared_ptr<TensorOp>> operations) : ops_(operations) {}
+  explicit MapJob(std::vector<std::shared_ptr<TensorOp>> operations)
+      : ops_(operations), latency_tracing_(nullptr), op_id_(-1), worker_id_(-1) {}
 
   // Constructor
-  MapJob() = default;
+  MapJob() : latency_tracing_(nullptr), op_id_(-1), worker_id_(-1) {}
 
   // Destructor
   virtual ~MapJob() = default;
@@ -45,8 +49,24 @@ class MapJob {
   // A pure virtual run function to execute a particular map job
   virtual Status Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) = 0;
 
+  // Time every TensorOp of this job, set by the MapOp worker while the MD profiler is running
+  // @param tracing - the op latency tracing node
+  // @param op_id - id of the MapOp
+  // @param op_name - name of the MapOp
+  // @param worker_id - id of the worker running this job
+  void SetLatencyTracing(OpLatencyTracing *tracing, int32_t op_id, const std::string &op_name, int32_t worker_id) {
+    latency_tracing_ = tracing;
+    op_id_ = op_id;
+    op_name_ = op_name;
+    worker_id_ = worker_id;
+  }
+
  protected:
   std::vector<std::shared_ptr<TensorOp>> ops_;
+  OpLatencyTracing *latency_tracing_;  // not owned, nullptr unless the MD profiler is running
+  int32_t op_id_;
+  std::string op_name_;
+  int32_t worker_id_;
 };
 
 }  // namespace dataset
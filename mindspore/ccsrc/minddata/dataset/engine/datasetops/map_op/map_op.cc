@@ -25,6 +25,9 @@
 #include "minddata/dataset/core/global_context.h"
 
 #include "minddata/dataset/engine/datasetops/map_op/cpu_map_job.h"
+#ifndef ENABLE_SECURITY
+#include "minddata/dataset/engine/perf/op_latency_tracing.h"
+#endif
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/util/log_adapter.h"
 #include "minddata/dataset/util/task_manager.h"
@@ -179,6 +182,11 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
 
   TensorRow in_row;
   std::vector<std::shared_ptr<MapJob>> job_list;
+#ifndef ENABLE_SECURITY
+  // The tracing node is only returned while this tree is profiled, otherwise the timing below is skipped.
+  std::shared_ptr<OpLatencyTracing> latency_tracing = GlobalContext::profiling_manager()->GetOpLatencyTracing(tree_);
+  uint64_t wait_start = latency_tracing != nullptr ? ProfilingTime::GetCurMicroSecond() : 0;
+#endif
   // Fetch next data row and map job list
   RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
 
@@ -195,11 +203,32 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
     } else {
       CHECK_FAIL_RETURN_UNEXPECTED(in_row.size() != 0, "[Internal ERROR] MapOp got an empty TensorRow.");
       TensorRow out_row;
+#ifndef ENABLE_SECURITY
+      uint64_t compute_start = 0;
+      if (latency_tracing != nullptr) {
+        compute_start = ProfilingTime::GetCurMicroSecond();
+        latency_tracing->RecordLatency(id(), Name(), worker_id, kOpLatencyWaitStage, wait_start, compute_start);
+        for (auto &job : job_list) {
+          job->SetLatencyTracing(latency_tracing.get(), id(), Name(), worker_id);
+        }
+      }
+#endif
       // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
       RETURN_IF_NOT_OK(WorkerCompute(in_row, &out_row, job_list));
+#ifndef ENABLE_SECURITY
+      if (latency_tracing != nullptr) {
+        latency_tracing->RecordLatency(id(), Name(), worker_id, kOpLatencyComputeStage, compute_start,
+                                       ProfilingTime::GetCurMicroSecond());
+      }
+#endif
       // Push the row onto the connector for next operator to consume.
       RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(out_row)));
     }
+#ifndef ENABLE_SECURITY
+    if (latency_tracing != nullptr) {
+      wait_start = ProfilingTime::GetCurMicroSecond();
+    }
+#endif
     // Fetch next data row and map job list
     RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
   }
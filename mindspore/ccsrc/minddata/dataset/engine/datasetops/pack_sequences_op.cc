@@ -0,0 +1,288 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/pack_sequences_op.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+template <typename T>
+bool InTypeRange(int64_t value) {
+  if (std::is_unsigned<T>::value) {
+    return value >= 0 && static_cast<uint64_t>(value) <= static_cast<uint64_t>(std::numeric_limits<T>::max());
+  }
+  return value >= static_cast<int64_t>(std::numeric_limits<T>::min()) &&
+         value <= static_cast<int64_t>(std::numeric_limits<T>::max());
+}
+}  // namespace
+
+PackSequencesOp::PackSequencesOp(const std::string &column_name, int32_t seq_length, int32_t window_size,
+                                 int64_t pad_value, int32_t op_connector_size)
+    : PipelineOp(op_connector_size),
+      column_name_(column_name),
+      seq_length_(seq_length),
+      window_size_(window_size),
+      pad_value_(pad_value),
+      column_index_(0),
+      packed_row_count_(0),
+      packed_token_count_(0),
+      truncated_count_(0) {
+  window_.reserve(static_cast<size_t>(window_size_));
+}
+
+void PackSequencesOp::Print(std::ostream &out, bool show_all) const {
+  if (!show_all) {
+    // Call the super class for displaying any common 1-liner info
+    PipelineOp::Print(out, show_all);
+    // Then show any custom derived-internal 1-liner info for this op
+    out << " [seq length: " << seq_length_ << "]\n";
+  } else {
+    // Call the super class for displaying any common detailed info
+    PipelineOp::Print(out, show_all);
+    // Then show any custom derived-internal stuff
+    out << "\nColumn: " << column_name_ << "\nSeq length: " << seq_length_ << "\nWindow size: " << window_size_
+        << "\nPad value: " << pad_value_ << "\n\n";
+  }
+}
+
+Status PackSequencesOp::EoeReceived(int32_t) {
+  state_ = OpState::kDeOpIdle;
+  return Status::OK();
+}
+
+Status PackSequencesOp::operator()() {
+  TaskManager::FindMe()->Post();
+
+  TensorRow current_row;
+  child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
+  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&current_row));
+  while (!child_iterator_->EofHandled()) {
+    while (!current_row.empty()) {
+      std::shared_ptr<Tensor> sample = current_row[column_index_];
+      CHECK_FAIL_RETURN_UNEXPECTED(sample->type().IsInt() && sample->Rank() == 1,
+                                   "Invalid data, PackSequences requires the column: " + column_name_ +
+                                     " to be a 1-D integer tensor, but got type: " + sample->type().ToString() +
+                                     " and rank: " + std::to_string(sample->Rank()));
+      if (window_.empty() && packed_row_count_ == 0) {
+        column_type_ = sample->type();
+        RETURN_IF_NOT_OK(CheckPadValue());
+      }
+      CHECK_FAIL_RETURN_UNEXPECTED(sample->type() == column_type_,
+                                   "Invalid data, PackSequences requires all samples of column: " + column_name_ +
+                                     " to have the same type, but got: " + column_type_.ToString() + " and " +
+                                     sample->type().ToString());
+      window_.push_back(std::move(sample));
+
+      if (window_.size() >= static_cast<size_t>(window_size_)) {
+        RETURN_IF_NOT_OK(PackWindow());
+      }
+
+      RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&current_row));
+    }
+
+    // got EOE, pack everything left in the window
+    RETURN_IF_NOT_OK(PackWindow());
+
+    // need to send EOE manually since we set state to idle in EoeRecieved()
+    RETURN_IF_NOT_OK(out_connector_->SendEOE());
+
+    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&current_row));
+  }
+  if (packed_row_count_ > 0) {
+    MS_LOG(INFO) << Name() << " sent " << packed_row_count_ << " rows, padding ratio: "
+                 << 1.0 - static_cast<double>(packed_token_count_) / (packed_row_count_ * seq_length_);
+  }
+  if (truncated_count_ > 0) {
+    MS_LOG(WARNING) << Name() << " truncated " << truncated_count_ << " samples longer than seq_length "
+                    << seq_length_ << ".";
+  }
+  RETURN_IF_NOT_OK(out_connector_->SendEOF());
+
+  return Status::OK();
+}
+
+Status PackSequencesOp::CheckPadValue() const {
+  bool in_range = false;
+  switch (column_type_.value()) {
+    case DataType::DE_INT8:
+      in_range = InTypeRange<int8_t>(pad_value_);
+      break;
+    case DataType::DE_UINT8:
+      in_range = InTypeRange<uint8_t>(pad_value_);
+      break;
+    case DataType::DE_INT16:
+      in_range = InTypeRange<int16_t>(pad_value_);
+      break;
+    case DataType::DE_UINT16:
+      in_range = InTypeRange<uint16_t>(pad_value_);
+      break;
+    case DataType::DE_INT32:
+      in_range = InTypeRange<int32_t>(pad_value_);
+      break;
+    case DataType::DE_UINT32:
+      in_range = InTypeRange<uint32_t>(pad_value_);
+      break;
+    case DataType::DE_INT64:
+      in_range = InTypeRange<int64_t>(pad_value_);
+      break;
+    case DataType::DE_UINT64:
+      in_range = InTypeRange<uint64_t>(pad_value_);
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("Invalid data, PackSequences does not support type: " + column_type_.ToString());
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(in_range, "Invalid data, PackSequences requires pad_value: " +
+                                           std::to_string(pad_value_) + " to fit in the type of column: " +
+                                           column_name_ + ", but got type: " + column_type_.ToString());
+  return Status::OK();
+}
+
+Status PackSequencesOp::PackWindow() {
+  if (window_.empty()) {
+    return Status::OK();
+  }
+  auto sample_length = [this](size_t i) {
+    return std::min(static_cast<int32_t>(window_[i]->shape()[0]), seq_length_);
+  };
+
+  // First-fit-decreasing: place the samples from the longest to the shortest, each into the first row with room.
+  std::vector<size_t> order(window_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&sample_length](size_t a, size_t b) { return sample_length(a) > sample_length(b); });
+
+  std::vector<int32_t> bin_used;
+  std::vector<std::vector<size_t>> bin_items;
+  for (auto i : order) {
+    int32_t length = sample_length(i);
+    auto it = std::find_if(bin_used.begin(), bin_used.end(),
+                           [this, length](int32_t used) { return seq_length_ - used >= length; });
+    if (it == bin_used.end()) {
+      bin_used.push_back(length);
+      bin_items.push_back({i});
+    } else {
+      size_t bin = static_cast<size_t>(it - bin_used.begin());
+      *it += length;
+      bin_items[bin].push_back(i);
+    }
+  }
+
+  for (const auto &items : bin_items) {
+    TensorRow packed_row;
+    switch (column_type_.value()) {
+      case DataType::DE_INT8:
+        RETURN_IF_NOT_OK(MakePackedRow<int8_t>(items, &packed_row));
+        break;
+      case DataType::DE_UINT8:
+        RETURN_IF_NOT_OK(MakePackedRow<uint8_t>(items, &packed_row));
+        break;
+      case DataType::DE_INT16:
+        RETURN_IF_NOT_OK(MakePackedRow<int16_t>(items, &packed_row));
+        break;
+      case DataType::DE_UINT16:
+        RETURN_IF_NOT_OK(MakePackedRow<uint16_t>(items, &packed_row));
+        break;
+      case DataType::DE_INT32:
+        RETURN_IF_NOT_OK(MakePackedRow<int32_t>(items, &packed_row));
+        break;
+      case DataType::DE_UINT32:
+        RETURN_IF_NOT_OK(MakePackedRow<uint32_t>(items, &packed_row));
+        break;
+      case DataType::DE_INT64:
+        RETURN_IF_NOT_OK(MakePackedRow<int64_t>(items, &packed_row));
+        break;
+      case DataType::DE_UINT64:
+        RETURN_IF_NOT_OK(MakePackedRow<uint64_t>(items, &packed_row));
+        break;
+      default:
+        RETURN_STATUS_UNEXPECTED("Invalid data, PackSequences does not support type: " + column_type_.ToString());
+    }
+    RETURN_IF_NOT_OK(out_connector_->Add(std::move(packed_row)));
+    packed_row_count_++;
+  }
+  window_.clear();
+  return Status::OK();
+}
+
+template <typename T>
+Status PackSequencesOp::MakePackedRow(const std::vector<size_t> &items, TensorRow *out_row) {
+  RETURN_UNEXPECTED_IF_NULL(out_row);
+  std::vector<T> tokens(seq_length_, static_cast<T>(pad_value_));
+  std::vector<int32_t> segment_ids(seq_length_, 0);
+  std::vector<int32_t> position_ids(seq_length_, 0);
+
+  int32_t offset = 0;
+  int32_t segment_id = 1;
+  for (auto i : items) {
+    const std::shared_ptr<Tensor> &sample = window_[i];
+    auto length = static_cast<int32_t>(sample->shape()[0]);
+    if (length > seq_length_) {
+      length = seq_length_;
+      truncated_count_++;
+    }
+    if (length == 0) {
+      continue;
+    }
+    const T *src = reinterpret_cast<const T *>(sample->GetBuffer());
+    RETURN_UNEXPECTED_IF_NULL(src);
+    std::copy(src, src + length, tokens.begin() + offset);
+    std::fill(segment_ids.begin() + offset, segment_ids.begin() + offset + length, segment_id);
+    std::iota(position_ids.begin() + offset, position_ids.begin() + offset + length, 0);
+    offset += length;
+    segment_id++;
+  }
+  packed_token_count_ += offset;
+
+  std::shared_ptr<Tensor> token_tensor, segment_tensor, position_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateFromVector(tokens, &token_tensor));
+  RETURN_IF_NOT_OK(Tensor::CreateFromVector(segment_ids, &segment_tensor));
+  RETURN_IF_NOT_OK(Tensor::CreateFromVector(position_ids, &position_tensor));
+  out_row->push_back(token_tensor);
+  out_row->push_back(segment_tensor);
+  out_row->push_back(position_tensor);
+  return Status::OK();
+}
+
+Status PackSequencesOp::ComputeColMap() {
+  if (column_name_id_map_.empty()) {
+    std::unordered_map<std::string, int32_t> child_column_name_mapping = child_[0]->column_name_id_map();
+    auto it = child_column_name_mapping.find(column_name_);
+    if (it == child_column_name_mapping.end()) {
+      std::string err_msg = "Invalid column, column name: " + column_name_ + " does not exist.";
+      RETURN_STATUS_UNEXPECTED(err_msg);
+    }
+    column_index_ = it->second;
+    column_name_id_map_[column_name_] = 0;
+    column_name_id_map_[kPackSequencesSegmentIdsColumn] = 1;
+    column_name_id_map_[kPackSequencesPositionIdsColumn] = 2;
+  } else {
+    MS_LOG(WARNING) << "Column name map is already set!";
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,106 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_PACK_SEQUENCES_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_PACK_SEQUENCES_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/dataset_iterator.h"
+#include "minddata/dataset/engine/datasetops/pipeline_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+constexpr char kPackSequencesSegmentIdsColumn[] = "segment_ids";
+constexpr char kPackSequencesPositionIdsColumn[] = "position_ids";
+
+// PackSequencesOp concatenates short 1-D token sequences into rows of exactly seq_length tokens. Samples are
+// buffered in a window of window_size samples which is packed with first-fit-decreasing: samples are sorted by
+// length in descending order and each one goes into the first row that still has room for it. Every output row
+// has three columns: the packed tokens, the segment ids (1 for the first sample in the row, 2 for the second, ...,
+// 0 for padding) and the position ids (restarting from 0 at the beginning of every sample, 0 for padding).
+class PackSequencesOp : public PipelineOp {
+ public:
+  PackSequencesOp(const std::string &column_name, int32_t seq_length, int32_t window_size, int64_t pad_value,
+                  int32_t op_connector_size);
+
+  // Destructor
+  ~PackSequencesOp() = default;
+
+  // Might need to pack the samples left in the window after receiving eoe, so override this method.
+  // @param int32_t workerId
+  // @return Status The status code returned
+  Status EoeReceived(int32_t) override;
+
+  std::string Name() const override { return kPackSequencesOp; }
+
+  // A print method typically used for debugging
+  // @param out - The output stream to write output to
+  // @param show_all - A bool to control if you want to show all info or just a summary
+  void Print(std::ostream &out, bool show_all) const override;
+
+  // << Stream output operator overload
+  // @notes This allows you to write the debug print info using stream operators
+  // @param out - reference to the output stream being overloaded
+  // @param po - reference to the PackSequencesOp to display
+  // @return - the output stream must be returned
+  friend std::ostream &operator<<(std::ostream &out, const PackSequencesOp &po) {
+    po.Print(out, false);
+    return out;
+  }
+
+  // Main loop of packing
+  // @return Status The status code returned
+  Status operator()() override;
+
+ private:
+  // Check that the pad value fits in the type of the column, so it is not wrapped, eg. -1 into 255 of uint8.
+  // @return Status The status code returned
+  Status CheckPadValue() const;
+
+  // Pack all samples in the window with first-fit-decreasing and send the packed rows.
+  // @return Status The status code returned
+  Status PackWindow();
+
+  // Concatenate the samples of one packed row and build the token, segment id and position id columns.
+  // @param const std::vector<size_t> &items - indices into the window of the samples of this row
+  // @param TensorRow *out_row - the packed row
+  // @return Status The status code returned
+  template <typename T>
+  Status MakePackedRow(const std::vector<size_t> &items, TensorRow *out_row);
+
+  Status ComputeColMap() override;
+
+  std::string column_name_;
+  int32_t seq_length_;
+  int32_t window_size_;
+  int64_t pad_value_;
+
+  int32_t column_index_;
+  DataType column_type_;
+  int64_t packed_row_count_;
+  int64_t packed_token_count_;
+  int64_t truncated_count_;
+  std::unique_ptr<ChildIterator> child_iterator_;
+  std::vector<std::shared_ptr<Tensor>> window_;  // samples waiting to be packed
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_PACK_SEQUENCES_OP_H_
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/ir/datasetops/batch_by_tokens_node.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/engine/datasetops/batch_by_tokens_op.h"
+
+#include "minddata/dataset/util/status.h"
+namespace mindspore {
+namespace dataset {
+
+BatchByTokensNode::BatchByTokensNode(
+  std::shared_ptr<DatasetNode> child, const std::vector<std::string> &column_names, int32_t max_tokens,
+  int32_t lookahead_size, std::shared_ptr<TensorOp> element_length_function,
+  const std::map<std::string, std::pair<TensorShape, std::shared_ptr<Tensor>>> &pad_info, bool drop_remainder)
+    : column_names_(column_names),
+      max_tokens_(max_tokens),
+      lookahead_size_(lookahead_size),
+      element_length_function_(element_length_function),
+      pad_info_(pad_info),
+      drop_remainder_(drop_remainder) {
+  this->AddChild(child);
+}
+
+std::shared_ptr<DatasetNode> BatchByTokensNode::Copy() {
+  auto node = std::make_shared<BatchByTokensNode>(nullptr, column_names_, max_tokens_, lookahead_size_,
+                                                  element_length_function_, pad_info_, drop_remainder_);
+  return node;
+}
+
+void BatchByTokensNode::Print(std::ostream &out) const {
+  out << (Name() + "(columns:" + PrintColumns(column_names_) + ",max_tokens:" + std::to_string(max_tokens_) +
+          ",lookahead_size:" + std::to_string(lookahead_size_) + ")");
+}
+
+Status BatchByTokensNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops) {
+  auto op = std::make_shared<BatchByTokensOp>(column_names_, max_tokens_, lookahead_size_, element_length_function_,
+                                              pad_info_, drop_remainder_, connector_que_size_);
+  op->SetTotalRepeats(GetTotalRepeats());
+  op->SetNumRepeatsPerEpoch(GetNumRepeatsPerEpoch());
+  node_ops->push_back(op);
+  return Status::OK();
+}
+
+Status BatchByTokensNode::ValidateParams() {
+  RETURN_IF_NOT_OK(DatasetNode::ValidateParams());
+  if (column_names_.empty()) {
+    std::string err_msg = "BatchByTokensNode: column_names cannot be empty.";
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
+  RETURN_IF_NOT_OK(ValidateDatasetColumnParam("BatchByTokensNode", "column_names", column_names_));
+
+  if (max_tokens_ <= 0) {
+    std::string err_msg =
+      "BatchByTokensNode: max_tokens must be greater than 0, but got: " + std::to_string(max_tokens_);
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
+
+  if (lookahead_size_ <= 0) {
+    std::string err_msg =
+      "BatchByTokensNode: lookahead_size must be greater than 0, but got: " + std::to_string(lookahead_size_);
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_IR_DATASETOPS_BATCH_BY_TOKENS_NODE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_IR_DATASETOPS_BATCH_BY_TOKENS_NODE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
+
+namespace mindspore {
+namespace dataset {
+class BatchByTokensNode : public DatasetNode {
+ public:
+  /// \brief Constructor
+  BatchByTokensNode(std::shared_ptr<DatasetNode> child, const std::vector<std::string> &column_names,
+                    int32_t max_tokens, int32_t lookahead_size,
+                    std::shared_ptr<TensorOp> element_length_function = nullptr,
+                    const std::map<std::string, std::pair<TensorShape, std::shared_ptr<Tensor>>> &pad_info = {},
+                    bool drop_remainder = false);
+
+  /// \brief Destructor
+  ~BatchByTokensNode() override = default;
+
+  /// \brief Node name getter
+  /// \return Name of the current node
+  std::string Name() const override { return kBatchByTokensNode; }
+
+  /// \brief Print the description
+  /// \param out - The output stream to write output to
+  void Print(std::ostream &out) const override;
+
+  /// \brief Copy the node to a new object
+  /// \return A shared pointer to the new copy
+  std::shared_ptr<DatasetNode> Copy() override;
+
+  /// \brief a base class override function to create the required runtime dataset op objects for this class
+  /// \param node_ops - A vector containing shared pointer to the Dataset Ops that this object will create
+  /// \return Status Status::OK() if build successfully
+  Status Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops) override;
+
+  /// \brief Parameters validation
+  /// \return Status Status::OK() if all the parameters are valid
+  Status ValidateParams() override;
+
+  bool IsSizeDefined() override { return false; };
+
+  /// \brief Getter functions
+  const std::vector<std::string> &ColumnNames() const { return column_names_; }
+  int32_t MaxTokens() const { return max_tokens_; }
+  int32_t LookaheadSize() const { return lookahead_size_; }
+  const std::shared_ptr<TensorOp> &ElementLengthFunction() const { return element_length_function_; }
+  const std::map<std::string, std::pair<TensorShape, std::shared_ptr<Tensor>>> &PadInfo() const { return pad_info_; }
+  bool DropRemainder() const { return drop_remainder_; }
+
+ private:
+  std::vector<std::string> column_names_;
+  int32_t max_tokens_;
+  int32_t lookahead_size_;
+  std::shared_ptr<TensorOp> element_length_function_;
+  std::map<std::string, std::pair<TensorShape, std::shared_ptr<Tensor>>> pad_info_;
+  bool drop_remainder_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_IR_DATASETOPS_BATCH_BY_TOKENS_NODE_H_
@@ -228,6 +228,12 @@ std::shared_ptr<DatasetNode> DatasetNode::SetNumWorkers(int32_t num_workers) {
   return shared_from_this();
 }
 
+std::shared_ptr<DatasetNode> DatasetNode::SetUserNumWorkers(int32_t num_workers) {
+  num_workers_ = num_workers;
+  user_num_workers_ = true;
+  return shared_from_this();
+}
+
 std::shared_ptr<DatasetNode> DatasetNode::SetConnectorQueueSize(int32_t connector_queue_size) {
   connector_que_size_ = connector_queue_size;
   return shared_from_this();
@@ -243,6 +249,7 @@ DatasetNode::DatasetNode()
       parent_(nullptr),
       children_({}),
       dataset_size_(-1),
+      user_num_workers_(false),
       mappable_(kNotADataSource),
       nary_op_(false),
       descendant_of_cache_(false),
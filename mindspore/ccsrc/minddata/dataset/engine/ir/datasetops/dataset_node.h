@@ -54,6 +54,7 @@ class DatasetSizeGetter;
 
 // Names for non-leaf IR node
 constexpr char kBatchNode[] = "Batch";
+constexpr char kBatchByTokensNode[] = "BatchByTokens";
 constexpr char kBucketBatchByLengthNode[] = "BucketBatchByLength";
 constexpr char kBuildSentencePieceVocabNode[] = "BuildSentencePieceVocab";
 constexpr char kBuildVocabNode[] = "BuildVocab";
@@ -64,6 +65,7 @@ constexpr char kConcatNode[] = "Concat";
 constexpr char kEpochCtrlNode[] = "EpochCtrl";
 constexpr char kFilterNode[] = "Filter";
 constexpr char kMapNode[] = "Map";
+constexpr char kPackSequencesNode[] = "PackSequences";
 constexpr char kProjectNode[] = "Project";
 constexpr char kRenameNode[] = "Rename";
 constexpr char kRepeatNode[] = "Repeat";
@@ -315,6 +317,15 @@ class DatasetNode : public std::enable_shared_from_this<DatasetNode> {
   /// \return Shared pointer to the original object
   std::shared_ptr<DatasetNode> SetNumWorkers(int32_t num_workers);
 
+  /// \brief Setter function for the number of workers given explicitly by the user, which the optimization passes
+  ///     don't change
+  /// \param[in] num_workers The number of threads in this operator
+  /// \return Shared pointer to the original object
+  std::shared_ptr<DatasetNode> SetUserNumWorkers(int32_t num_workers);
+
+  /// \brief Getter of whether the number of workers is given explicitly by the user
+  bool IsUserNumWorkers() const { return user_num_workers_; }
+
   std::shared_ptr<DatasetNode> SetConnectorQueueSize(int32_t connector_queue_size);
 
   /// \brief Setter function for DatasetCache
@@ -379,6 +390,7 @@ class DatasetNode : public std::enable_shared_from_this<DatasetNode> {
   std::shared_ptr<DatasetCache> cache_;
   int64_t dataset_size_;
   int32_t num_workers_;
+  bool user_num_workers_;  // an indicator of whether num_workers_ is given explicitly by the user
   int32_t connector_que_size_;
   int32_t worker_connector_size_;
   int32_t total_repeats_;  // Number of times required to run this operator
@@ -92,6 +92,7 @@ class MapNode : public DatasetNode {
   const std::vector<std::string> &ProjectColumns() const { return project_columns_; }
   const std::vector<std::shared_ptr<DSCallback>> &Callbacks() const { return callbacks_; }
   ManualOffloadMode GetOffload() const { return offload_; }
+  bool IsPythonMultiprocessing() const { return python_mp_ != nullptr; }
 
   /// \brief setter to set offload flag of node
   void SetOffload(ManualOffloadMode offload);
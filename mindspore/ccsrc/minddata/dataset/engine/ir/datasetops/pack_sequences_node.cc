@@ -0,0 +1,71 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/ir/datasetops/pack_sequences_node.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/engine/datasetops/pack_sequences_op.h"
+
+#include "minddata/dataset/util/status.h"
+namespace mindspore {
+namespace dataset {
+
+PackSequencesNode::PackSequencesNode(std::shared_ptr<DatasetNode> child, const std::string &column_name,
+                                     int32_t seq_length, int32_t window_size, int64_t pad_value)
+    : column_name_(column_name), seq_length_(seq_length), window_size_(window_size), pad_value_(pad_value) {
+  this->AddChild(child);
+}
+
+std::shared_ptr<DatasetNode> PackSequencesNode::Copy() {
+  auto node = std::make_shared<PackSequencesNode>(nullptr, column_name_, seq_length_, window_size_, pad_value_);
+  return node;
+}
+
+void PackSequencesNode::Print(std::ostream &out) const {
+  out << (Name() + "(column:" + column_name_ + ",seq_length:" + std::to_string(seq_length_) +
+          ",window_size:" + std::to_string(window_size_) + ")");
+}
+
+Status PackSequencesNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops) {
+  auto op = std::make_shared<PackSequencesOp>(column_name_, seq_length_, window_size_, pad_value_, connector_que_size_);
+  op->SetTotalRepeats(GetTotalRepeats());
+  op->SetNumRepeatsPerEpoch(GetNumRepeatsPerEpoch());
+  node_ops->push_back(op);
+  return Status::OK();
+}
+
+Status PackSequencesNode::ValidateParams() {
+  RETURN_IF_NOT_OK(DatasetNode::ValidateParams());
+  RETURN_IF_NOT_OK(ValidateDatasetColumnParam("PackSequencesNode", "column_name", {column_name_}));
+
+  if (seq_length_ <= 0) {
+    std::string err_msg =
+      "PackSequencesNode: seq_length must be greater than 0, but got: " + std::to_string(seq_length_);
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
+
+  if (window_size_ <= 0) {
+    std::string err_msg =
+      "PackSequencesNode: window_size must be greater than 0, but got: " + std::to_string(window_size_);
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
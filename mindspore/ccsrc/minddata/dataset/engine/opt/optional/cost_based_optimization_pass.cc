@@ -0,0 +1,328 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/opt/optional/cost_based_optimization_pass.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
+#include "minddata/dataset/engine/ir/datasetops/filter_node.h"
+#include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/engine/ir/datasetops/project_node.h"
+#include "minddata/dataset/engine/ir/datasetops/take_node.h"
+#ifndef ENABLE_SECURITY
+#include "minddata/dataset/engine/perf/op_latency_tracing.h"
+#include "minddata/dataset/engine/perf/profiling.h"
+#endif
+#include "minddata/dataset/kernels/ir/data/transforms_ir.h"
+#include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Upper bound of the rewrites applied to one tree, every rewrite moves a node down, moves a cache up or removes a node
+// so this is only reached by a pathological tree.
+constexpr int32_t kMaxRewrites = 1000;
+// A TensorOperation needs this many profiled samples for its profiled cost to be trusted.
+constexpr uint64_t kMinProfiledSamples = 16;
+// A MapNode cheaper than this (in microseconds per row) is cheap enough to be moved below a cache.
+constexpr double kCheapMapCost = 200.0;
+// Static cost estimates in microseconds per row, used when a TensorOperation has not been profiled.
+constexpr double kDefaultOpCost = 20.0;
+const std::map<std::string, double> kStaticOpCosts = {
+  {vision::kDecodeOperation, 2000.0},
+  {kDecodeOp, 2000.0},
+  {vision::kRandomCropDecodeResizeOperation, 1500.0},
+  {kRandomCropDecodeResizeOp, 1500.0},
+  {kPyFuncOp, 1000.0},
+};
+// Percentile of the profiled latencies used as the cost of a TensorOperation
+constexpr double kMedian = 50.0;
+
+// Whether the two lists of column names have no name in common
+bool IsDisjoint(const std::vector<std::string> &lhs, const std::vector<std::string> &rhs) {
+  std::set<std::string> names(lhs.begin(), lhs.end());
+  return std::none_of(rhs.begin(), rhs.end(), [&names](const std::string &name) { return names.count(name) > 0; });
+}
+
+// Whether all the names of the first list of column names are in the second one
+bool IsSubset(const std::vector<std::string> &lhs, const std::vector<std::string> &rhs) {
+  std::set<std::string> names(rhs.begin(), rhs.end());
+  return std::all_of(lhs.begin(), lhs.end(), [&names](const std::string &name) { return names.count(name) > 0; });
+}
+}  // namespace
+
+Status CostBasedOptimizationPass::CostNodes::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(node);
+  map_nodes_.push_back(node);
+  return Status::OK();
+}
+
+Status CostBasedOptimizationPass::CostNodes::Visit(std::shared_ptr<TakeNode> node, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(node);
+  push_down_nodes_.push_back(node);
+  return Status::OK();
+}
+
+Status CostBasedOptimizationPass::CostNodes::Visit(std::shared_ptr<FilterNode> node, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(node);
+  push_down_nodes_.push_back(node);
+  return Status::OK();
+}
+
+Status CostBasedOptimizationPass::CostNodes::Visit(std::shared_ptr<ProjectNode> node, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(node);
+  push_down_nodes_.push_back(node);
+  return Status::OK();
+}
+
+CostBasedOptimizationPass::CostBasedOptimizationPass()
+    : latency_tracing_(nullptr),
+      thread_cnt_(GlobalContext::config_manager()->num_cpu_threads()),
+      auto_offload_(GlobalContext::config_manager()->get_auto_offload()) {
+#ifndef ENABLE_SECURITY
+  // The tracing node keeps the latencies of the last profiled pipeline until the MD profiler is reset.
+  std::shared_ptr<Tracing> node;
+  if (GlobalContext::profiling_manager()->GetTracingNode(kOpLatencyTracingName, &node).IsOk()) {
+    latency_tracing_ = std::dynamic_pointer_cast<OpLatencyTracing>(node);
+  }
+#endif
+}
+
+Status CostBasedOptimizationPass::RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(root_ir);
+  RETURN_UNEXPECTED_IF_NULL(modified);
+  MS_LOG(INFO) << "Pre pass: CostBasedOptimizationPass started.";
+  // Every rewrite changes the shape of the tree, so the nodes are collected again after each of them.
+  int32_t num_rewrites = 0;
+  bool rewritten = true;
+  std::vector<std::shared_ptr<MapNode>> map_nodes;
+  while (rewritten) {
+    CostNodes collector;
+    bool m = false;
+    RETURN_IF_NOT_OK(collector.Run(root_ir, &m));
+    map_nodes = collector.map_nodes();
+    if (num_rewrites >= kMaxRewrites) {
+      MS_LOG(WARNING) << "CostBasedOptimizationPass stopped after " << num_rewrites << " rewrites.";
+      break;
+    }
+    rewritten = false;
+    for (const auto &node : collector.push_down_nodes()) {
+      RETURN_IF_NOT_OK(PushDown(node, &rewritten));
+      if (rewritten) {
+        break;
+      }
+    }
+    for (auto it = map_nodes.begin(); !rewritten && it != map_nodes.end(); ++it) {
+      RETURN_IF_NOT_OK(MoveBelowCache(*it, &rewritten));
+    }
+    for (auto it = map_nodes.begin(); !rewritten && it != map_nodes.end(); ++it) {
+      RETURN_IF_NOT_OK(MergeWithChild(*it, &rewritten));
+    }
+    if (rewritten) {
+      num_rewrites++;
+      *modified = true;
+    }
+  }
+  bool split = false;
+  RETURN_IF_NOT_OK(SplitWorkers(map_nodes, &split));
+  *modified = *modified || split;
+  MS_LOG(INFO) << "Pre pass: CostBasedOptimizationPass finished, applied " << num_rewrites << " rewrites.";
+  return Status::OK();
+}
+
+Status CostBasedOptimizationPass::PushDown(const std::shared_ptr<DatasetNode> &node, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(node);
+  RETURN_OK_IF_TRUE(node->Children().size() != 1);
+  auto map_node = std::dynamic_pointer_cast<MapNode>(node->Children()[0]);
+  RETURN_OK_IF_TRUE(map_node == nullptr || map_node->Children().size() != 1 || map_node->IsCached() ||
+                    !map_node->Callbacks().empty());
+
+  if (auto filter_node = std::dynamic_pointer_cast<FilterNode>(node)) {
+    // The predicate must not see any column the MapNode changes. A random MapNode would get its random draws for
+    // other rows once the rows are filtered first, so the output of a seeded pipeline would change.
+    RETURN_OK_IF_TRUE(filter_node->InputColumns().empty() || !IsInPlace(map_node) || !IsDeterministic(map_node) ||
+                      !IsDisjoint(filter_node->InputColumns(), map_node->InputColumns()));
+  } else if (auto project_node = std::dynamic_pointer_cast<ProjectNode>(node)) {
+    // The MapNode must still find all its input columns
+    RETURN_OK_IF_TRUE(!IsInPlace(map_node) || !IsSubset(map_node->InputColumns(), project_node->Columns()));
+  } else {
+    // A TakeNode can always be pushed down as a MapNode produces exactly one row out of each row.
+    RETURN_OK_IF_TRUE(std::dynamic_pointer_cast<TakeNode>(node) == nullptr);
+  }
+
+  std::shared_ptr<DatasetNode> child = map_node->Children()[0];
+  RETURN_IF_NOT_OK(node->Drop());
+  RETURN_IF_NOT_OK(child->InsertAbove(node));
+  MS_LOG(INFO) << "CostBasedOptimizationPass pushed " << node->Name() << " below " << map_node->Name() << ".";
+  *modified = true;
+  return Status::OK();
+}
+
+Status CostBasedOptimizationPass::MoveBelowCache(const std::shared_ptr<MapNode> &node, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(node);
+  RETURN_OK_IF_TRUE(node->Children().size() != 1 || !IsMovable(node));
+  std::shared_ptr<DatasetNode> child = node->Children()[0];
+  RETURN_OK_IF_TRUE(!child->IsCached() || !IsDeterministic(node));
+  bool profiled = false;
+  double cost = EstimateCost(node, &profiled);
+  RETURN_OK_IF_TRUE(cost > kCheapMapCost);
+
+  // The cache now holds the output of the MapNode, so the MapNode only runs in the first epoch.
+  (void)node->SetDatasetCache(child->GetDatasetCache());
+  (void)child->SetDatasetCache(nullptr);
+  MS_LOG(INFO) << "CostBasedOptimizationPass moved " << node->Name() << " with estimated cost " << cost
+               << "us per row below the cache of " << child->Name() << ".";
+  *modified = true;
+  return Status::OK();
+}
+
+Status CostBasedOptimizationPass::MergeWithChild(const std::shared_ptr<MapNode> &node, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(node);
+  RETURN_OK_IF_TRUE(node->Children().size() != 1 || !IsMovable(node) || !IsInPlace(node));
+  auto child = std::dynamic_pointer_cast<MapNode>(node->Children()[0]);
+  RETURN_OK_IF_TRUE(child == nullptr || !IsMovable(child) || !IsInPlace(child) ||
+                    child->InputColumns() != node->InputColumns());
+  // The merged MapNode can't keep the num_workers given by the user for either of them.
+  RETURN_OK_IF_TRUE(node->IsUserNumWorkers() || child->IsUserNumWorkers());
+
+  // The child runs first, so its TensorOperations come first. The merged MapNode gets the workers of both MapNodes
+  // so that one worker pool processes the whole row and the row is only passed through one connector.
+  std::vector<std::shared_ptr<TensorOperation>> operations = child->operations();
+  std::vector<std::shared_ptr<TensorOperation>> parent_operations = node->operations();
+  (void)operations.insert(operations.end(), parent_operations.begin(), parent_operations.end());
+  child->setOperations(operations);
+  (void)child->SetNumWorkers(std::min(child->NumWorkers() + node->NumWorkers(), thread_cnt_));
+  RETURN_IF_NOT_OK(node->Drop());
+  MS_LOG(INFO) << "CostBasedOptimizationPass merged " << node->Name() << " into its child, the merged MapNode has "
+               << operations.size() << " operations and " << child->NumWorkers() << " workers.";
+  *modified = true;
+  return Status::OK();
+}
+
+Status CostBasedOptimizationPass::SplitWorkers(const std::vector<std::shared_ptr<MapNode>> &map_nodes,
+                                                bool *const modified) {
+  RETURN_OK_IF_TRUE(latency_tracing_ == nullptr);
+  // The workers are assigned by AutoWorkerPass instead if auto_num_workers is enabled.
+  RETURN_OK_IF_TRUE(GlobalContext::config_manager()->auto_num_workers());
+  // The user's choice wins over the profiled costs, so only the MapNodes with the default num_workers are split.
+  std::vector<std::shared_ptr<MapNode>> split_nodes;
+  (void)std::copy_if(map_nodes.begin(), map_nodes.end(), std::back_inserter(split_nodes),
+                     [](const std::shared_ptr<MapNode> &node) { return !node->IsUserNumWorkers(); });
+  RETURN_OK_IF_TRUE(split_nodes.size() < 2);
+
+  std::vector<double> costs;
+  double total_cost = 0;
+  int32_t total_workers = 0;
+  for (const auto &node : split_nodes) {
+    bool profiled = false;
+    costs.push_back(EstimateCost(node, &profiled));
+    RETURN_OK_IF_TRUE(!profiled);
+    total_cost += costs.back();
+    total_workers += node->NumWorkers();
+  }
+  RETURN_OK_IF_TRUE(total_cost <= 0 || total_workers < static_cast<int32_t>(split_nodes.size()));
+
+  for (size_t i = 0; i < split_nodes.size(); i++) {
+    auto num_workers = static_cast<int32_t>(std::lround(total_workers * costs[i] / total_cost));
+    num_workers = std::max(num_workers, 1);
+    if (num_workers != split_nodes[i]->NumWorkers()) {
+      MS_LOG(INFO) << "CostBasedOptimizationPass changed the num_workers of " << split_nodes[i]->Name() << " from "
+                   << split_nodes[i]->NumWorkers() << " to " << num_workers << ", profiled cost: " << costs[i]
+                   << "us per row.";
+      (void)split_nodes[i]->SetNumWorkers(num_workers);
+      *modified = true;
+    }
+  }
+  return Status::OK();
+}
+
+double CostBasedOptimizationPass::EstimateCost(const std::shared_ptr<MapNode> &node, bool *profiled) {
+  *profiled = true;
+  double total_cost = 0;
+  for (const auto &op : node->operations()) {
+    if (op == nullptr) {
+      continue;
+    }
+    std::string name = op->Name();
+    double cost = 0;
+    if (!GetProfiledCost(name, &cost)) {
+      *profiled = false;
+      auto it = kStaticOpCosts.find(name);
+      cost = it != kStaticOpCosts.end() ? it->second : kDefaultOpCost;
+    }
+    total_cost += cost;
+  }
+  return total_cost;
+}
+
+bool CostBasedOptimizationPass::GetProfiledCost(const std::string &name, double *cost) {
+#ifndef ENABLE_SECURITY
+  if (latency_tracing_ == nullptr) {
+    return false;
+  }
+  // The profiler records the TensorOps by their name, which is the name of the TensorOperation suffixed with "Op".
+  for (const auto &stage : {name, name + "Op"}) {
+    uint64_t count = 0;
+    uint64_t latency = 0;
+    if (latency_tracing_->GetStageLatency(stage, kMedian, &count, &latency).IsOk() && count >= kMinProfiledSamples) {
+      *cost = static_cast<double>(latency);
+      return true;
+    }
+  }
+#endif
+  return false;
+}
+
+bool CostBasedOptimizationPass::IsDeterministic(const std::shared_ptr<MapNode> &node) {
+  for (const auto &op : node->operations()) {
+    if (op == nullptr || op->IsRandomOp() || op->Name() == kPyFuncOp) {
+      return false;
+    }
+    // The randomness of a pre-built TensorOp is only known by the TensorOp itself
+    auto pre_built = std::dynamic_pointer_cast<transforms::PreBuiltOperation>(op);
+    if (pre_built != nullptr) {
+      std::shared_ptr<TensorOp> tensor_op = pre_built->Build();
+      if (tensor_op == nullptr || !tensor_op->Deterministic()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CostBasedOptimizationPass::IsInPlace(const std::shared_ptr<MapNode> &node) {
+  return !node->InputColumns().empty() && node->ProjectColumns().empty() &&
+         (node->OutputColumns().empty() || node->OutputColumns() == node->InputColumns());
+}
+
+bool CostBasedOptimizationPass::IsMovable(const std::shared_ptr<MapNode> &node) const {
+  bool offloaded = node->GetOffload() == ManualOffloadMode::kEnabled ||
+                   (auto_offload_ && node->GetOffload() != ManualOffloadMode::kDisabled);
+  return !node->IsCached() && node->Callbacks().empty() && !offloaded && !node->IsPythonMultiprocessing();
+}
+}  // namespace dataset
+}  // namespace mindspore
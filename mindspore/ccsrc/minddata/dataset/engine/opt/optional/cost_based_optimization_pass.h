@@ -0,0 +1,163 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_COST_BASED_OPTIMIZATION_PASS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_COST_BASED_OPTIMIZATION_PASS_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/engine/opt/pass.h"
+
+namespace mindspore {
+namespace dataset {
+
+class OpLatencyTracing;
+
+/// \class CostBasedOptimizationPass cost_based_optimization_pass.h
+/// \brief An optional optimization pass that rewrites the IR tree based on the estimated cost of the TensorOperations.
+///     The cost of a TensorOperation is its median latency in the last profiled pipeline if the MD profiler has
+///     recorded it, otherwise a static estimate. The pass applies the rewrites below until none of them applies:
+///     1. A TakeNode, FilterNode or ProjectNode above a MapNode is pushed below the MapNode, so that the MapNode only
+///        processes the rows and columns that are used afterwards.
+///     2. A cheap and deterministic MapNode above a cached node takes over the cache, so that its output is cached
+///        and it is not computed again in the following epochs.
+///     3. Two adjacent MapNodes working in place on the same columns are merged into one MapNode with one worker pool.
+///     Finally, when the cost of every MapNode is profiled, the workers of the MapNodes are split in proportion to
+///     their cost without changing the total number of workers.
+class CostBasedOptimizationPass : public IRTreePass {
+  /// \class CostNodes
+  /// \brief This is a NodePass whose job is to collect the nodes the rewrites apply to.
+  class CostNodes : public IRNodePass {
+   public:
+    /// \brief Constructor
+    CostNodes() = default;
+
+    /// \brief Destructor
+    ~CostNodes() = default;
+
+    /// \brief Collect a MapNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+    /// \brief Collect a TakeNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<TakeNode> node, bool *const modified) override;
+
+    /// \brief Collect a FilterNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<FilterNode> node, bool *const modified) override;
+
+    /// \brief Collect a ProjectNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<ProjectNode> node, bool *const modified) override;
+
+    /// \brief Getter
+    /// \return All the MapNodes in pre-order
+    const std::vector<std::shared_ptr<MapNode>> &map_nodes() const { return map_nodes_; }
+
+    /// \brief Getter
+    /// \return All the TakeNodes, FilterNodes and ProjectNodes in pre-order
+    const std::vector<std::shared_ptr<DatasetNode>> &push_down_nodes() const { return push_down_nodes_; }
+
+   private:
+    std::vector<std::shared_ptr<MapNode>> map_nodes_;
+    std::vector<std::shared_ptr<DatasetNode>> push_down_nodes_;
+  };
+
+ public:
+  /// \brief Constructor
+  CostBasedOptimizationPass();
+
+  /// \brief Destructor
+  ~CostBasedOptimizationPass() override = default;
+
+  /// \brief Runs the rewrites until none of them applies, then splits the workers of the MapNodes.
+  /// \param[in, out] root_ir The tree to operate on.
+  /// \param[in, out] modified Indicate if the tree was modified.
+  /// \return Status The status code returned
+  Status RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const modified) override;
+
+ private:
+  /// \brief Push a TakeNode, FilterNode or ProjectNode below its child if the child is a MapNode and the result is
+  ///     the same.
+  /// \param[in] node The node to push down
+  /// \param[out] modified Indicate if the node was pushed down
+  /// \return Status The status code returned
+  Status PushDown(const std::shared_ptr<DatasetNode> &node, bool *const modified);
+
+  /// \brief Move the cache of the child of a cheap and deterministic MapNode to the MapNode.
+  /// \param[in] node The MapNode
+  /// \param[out] modified Indicate if the cache was moved
+  /// \return Status The status code returned
+  Status MoveBelowCache(const std::shared_ptr<MapNode> &node, bool *const modified);
+
+  /// \brief Merge a MapNode into its child if the child is a MapNode working in place on the same columns.
+  /// \param[in] node The MapNode
+  /// \param[out] modified Indicate if the MapNode was merged
+  /// \return Status The status code returned
+  Status MergeWithChild(const std::shared_ptr<MapNode> &node, bool *const modified);
+
+  /// \brief Split the workers of the MapNodes in proportion to their profiled cost.
+  /// \param[in] map_nodes All the MapNodes in the tree
+  /// \param[out] modified Indicate if the number of workers of any MapNode was changed
+  /// \return Status The status code returned
+  Status SplitWorkers(const std::vector<std::shared_ptr<MapNode>> &map_nodes, bool *const modified);
+
+  /// \brief Estimate the cost of a MapNode as the sum of the cost of its TensorOperations.
+  /// \param[in] node The MapNode
+  /// \param[out] profiled Indicate if the cost of every TensorOperation was profiled
+  /// \return The estimated cost in microseconds per row
+  double EstimateCost(const std::shared_ptr<MapNode> &node, bool *profiled);
+
+  /// \brief Look up the profiled cost of a TensorOperation.
+  /// \param[in] name The name of the TensorOperation
+  /// \param[out] cost The median latency in microseconds
+  /// \return True if the TensorOperation was profiled
+  bool GetProfiledCost(const std::string &name, double *cost);
+
+  /// \brief Check if the TensorOperations of a MapNode always produce the same output for the same input.
+  /// \param[in] node The MapNode
+  /// \return True if the MapNode is deterministic
+  static bool IsDeterministic(const std::shared_ptr<MapNode> &node);
+
+  /// \brief Check if a MapNode only replaces its input columns, without renaming, adding or removing any column.
+  /// \param[in] node The MapNode
+  /// \return True if the MapNode works in place
+  static bool IsInPlace(const std::shared_ptr<MapNode> &node);
+
+  /// \brief Check if a MapNode can be moved or merged without changing its runtime behavior.
+  /// \param[in] node The MapNode
+  /// \return True if the MapNode has no cache, no callbacks, no offload and no python multiprocessing
+  bool IsMovable(const std::shared_ptr<MapNode> &node) const;
+
+  std::shared_ptr<OpLatencyTracing> latency_tracing_;  // costs of the last profiled pipeline, may be nullptr
+  const int32_t thread_cnt_;                           // thread cnt of current CPU, obtained through config manager
+  const bool auto_offload_;                            // whether MapNodes are offloaded unless disabled manually
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_COST_BASED_OPTIMIZATION_PASS_H_
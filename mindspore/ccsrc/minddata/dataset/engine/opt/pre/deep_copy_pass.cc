@@ -51,7 +51,11 @@ Status DeepCopyPass::Visit(std::shared_ptr<DatasetNode> node, bool *const modifi
   // Temporary fix to set the num_workers and connector_queue_size to each cloned node.
   // This can be improved by adding a new method in the base class DatasetNode to transfer the properties to
   // the cloned node. Each derived class's Copy() will need to include this method.
-  new_node->SetNumWorkers(node->NumWorkers());
+  if (node->IsUserNumWorkers()) {
+    new_node->SetUserNumWorkers(node->NumWorkers());
+  } else {
+    new_node->SetNumWorkers(node->NumWorkers());
+  }
   new_node->SetConnectorQueueSize(node->ConnectorQueueSize());
   // This method below assumes a DFS walk and from the first child to the last child.
   // Future: A more robust implementation that does not depend on the above assumption.
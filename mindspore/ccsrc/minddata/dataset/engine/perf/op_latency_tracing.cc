@@ -0,0 +1,279 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/op_latency_tracing.h"
+#include <sys/stat.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <set>
+#include <string>
+#include <utility>
+#include "utils/ms_utils.h"
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr double kMaxPercentile = 100.0;
+constexpr double kP50 = 50.0;
+constexpr double kP90 = 90.0;
+constexpr double kP99 = 99.0;
+
+// Lower and upper bound in microseconds of the given bucket
+std::pair<uint64_t, uint64_t> BucketBounds(int32_t bucket) {
+  if (bucket == 0) {
+    return {0, 1};
+  }
+  return {static_cast<uint64_t>(1) << (bucket - 1), static_cast<uint64_t>(1) << bucket};
+}
+}  // namespace
+
+void LatencyHistogram::Add(uint64_t latency) {
+  int32_t bucket = 0;
+  while (bucket < kNumBuckets - 1 && (static_cast<uint64_t>(1) << bucket) < latency) {
+    bucket++;
+  }
+  buckets_[bucket]++;
+  count_++;
+  sum_ += latency;
+  min_ = std::min(min_, latency);
+  max_ = std::max(max_, latency);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram &other) {
+  for (int32_t i = 0; i < kNumBuckets; i++) {
+    buckets_[i] += other.buckets_[i];
+  }
+  count_ += other.count_;
+  sum_ += other.sum_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+uint64_t LatencyHistogram::Percentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  percentile = std::min(std::max(percentile, 0.0), kMaxPercentile);
+  auto target = static_cast<uint64_t>(std::ceil(percentile / kMaxPercentile * count_));
+  target = std::max(target, static_cast<uint64_t>(1));
+  uint64_t seen = 0;
+  for (int32_t i = 0; i < kNumBuckets; i++) {
+    if (seen + buckets_[i] < target) {
+      seen += buckets_[i];
+      continue;
+    }
+    auto bounds = BucketBounds(i);
+    uint64_t lower = std::max(bounds.first, min_);
+    uint64_t upper = i == kNumBuckets - 1 ? max_ : std::min(bounds.second, max_);
+    if (upper <= lower) {
+      return lower;
+    }
+    double fraction = static_cast<double>(target - seen) / buckets_[i];
+    return lower + static_cast<uint64_t>(std::llround(fraction * (upper - lower)));
+  }
+  return max_;
+}
+
+nlohmann::json LatencyHistogram::ToJson() const {
+  nlohmann::json output;
+  output["count"] = count_;
+  output["mean_us"] = count_ == 0 ? 0.0 : static_cast<double>(sum_) / count_;
+  output["min_us"] = count_ == 0 ? 0 : min_;
+  output["max_us"] = max_;
+  output["p50_us"] = Percentile(kP50);
+  output["p90_us"] = Percentile(kP90);
+  output["p99_us"] = Percentile(kP99);
+  // Trailing empty buckets are trimmed, bucket i holds the samples in (2^(i-1), 2^i] us.
+  auto last = std::find_if(buckets_.rbegin(), buckets_.rend(), [](uint64_t n) { return n != 0; });
+  output["buckets"] = std::vector<uint64_t>(buckets_.begin(), last.base());
+  return output;
+}
+
+Status OpLatencyTracing::Init() { return Status::OK(); }
+
+void OpLatencyTracing::RecordLatency(int32_t op_id, const std::string &op_name, int32_t worker_id,
+                                     const std::string &stage, uint64_t start, uint64_t end) {
+  if (!active_) {
+    return;
+  }
+  uint64_t duration = end > start ? end - start : 0;
+  std::lock_guard<std::mutex> guard(lock_);
+  histograms_[std::make_tuple(op_id, worker_id, stage)].Add(duration);
+  if (op_names_.find(op_id) == op_names_.end()) {
+    op_names_[op_id] = op_name;
+  }
+  if (events_.size() < kMaxTimelineEvents) {
+    events_.push_back({op_id, worker_id, stage, start, duration});
+  } else {
+    dropped_events_++;
+  }
+}
+
+Status OpLatencyTracing::GetOpLatency(int32_t op_id, const std::string &stage, double percentile, uint64_t *count,
+                                      uint64_t *latency) {
+  RETURN_UNEXPECTED_IF_NULL(count);
+  RETURN_UNEXPECTED_IF_NULL(latency);
+  std::lock_guard<std::mutex> guard(lock_);
+  LatencyHistogram merged;
+  for (const auto &item : histograms_) {
+    if (std::get<0>(item.first) == op_id && std::get<2>(item.first) == stage) {
+      merged.Merge(item.second);
+    }
+  }
+  *count = merged.Count();
+  *latency = merged.Percentile(percentile);
+  return Status::OK();
+}
+
+Status OpLatencyTracing::GetStageLatency(const std::string &stage, double percentile, uint64_t *count,
+                                         uint64_t *latency) {
+  RETURN_UNEXPECTED_IF_NULL(count);
+  RETURN_UNEXPECTED_IF_NULL(latency);
+  std::lock_guard<std::mutex> guard(lock_);
+  LatencyHistogram merged;
+  for (const auto &item : histograms_) {
+    if (std::get<2>(item.first) == stage) {
+      merged.Merge(item.second);
+    }
+  }
+  *count = merged.Count();
+  *latency = merged.Percentile(percentile);
+  return Status::OK();
+}
+
+Status OpLatencyTracing::SaveToFile(const std::string &dir_path, const std::string &rank_id) {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (histograms_.empty()) {
+    return Status::OK();
+  }
+
+  Path path = GetFileName(dir_path, rank_id);
+  // Remove the file if it exists (from prior profiling usage)
+  RETURN_IF_NOT_OK(path.Remove());
+  std::string file_path = path.ToString();
+
+  MS_LOG(INFO) << "Start to save op latency profiling data.";
+  nlohmann::json output;
+  for (const auto &item : histograms_) {
+    int32_t op_id = std::get<0>(item.first);
+    nlohmann::json entry = item.second.ToJson();
+    entry["op_id"] = op_id;
+    entry["op_name"] = op_names_[op_id];
+    entry["worker_id"] = std::get<1>(item.first);
+    entry["stage"] = std::get<2>(item.first);
+    output["op_latency"].push_back(entry);
+  }
+  std::ofstream handle(file_path, std::ios::trunc);
+  if (!handle.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Profiling file can not be opened.");
+  }
+  handle << output;
+  handle.close();
+
+  RETURN_IF_NOT_OK(SaveTimelineToFile(GetTimelineFileName(dir_path, rank_id).ToString()));
+  return Status::OK();
+}
+
+Status OpLatencyTracing::SaveTimelineToFile(const std::string &file_path) {
+  Path path(file_path);
+  RETURN_IF_NOT_OK(path.Remove());
+  std::ofstream handle(file_path, std::ios::trunc);
+  if (!handle.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Profiling file can not be opened.");
+  }
+  // Chrome trace event format: every op is shown as a process and every worker of the op as a thread of it.
+  // The events are streamed out one by one since the timeline can hold up to kMaxTimelineEvents of them.
+  handle << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":" << dropped_events_
+         << "},\"traceEvents\":[";
+  bool first = true;
+  auto write_event = [&handle, &first](const nlohmann::json &event) {
+    handle << (first ? "\n" : ",\n") << event;
+    first = false;
+  };
+  std::set<std::pair<int32_t, int32_t>> threads;
+  for (const auto &item : histograms_) {
+    (void)threads.emplace(std::get<0>(item.first), std::get<1>(item.first));
+  }
+  for (const auto &op : op_names_) {
+    write_event({{"name", "process_name"},
+                 {"ph", "M"},
+                 {"pid", op.first},
+                 {"args", {{"name", op.second + "(ID:" + std::to_string(op.first) + ")"}}}});
+    write_event(
+      {{"name", "process_sort_index"}, {"ph", "M"}, {"pid", op.first}, {"args", {{"sort_index", op.first}}}});
+  }
+  for (const auto &thread : threads) {
+    write_event({{"name", "thread_name"},
+                 {"ph", "M"},
+                 {"pid", thread.first},
+                 {"tid", thread.second},
+                 {"args", {{"name", "worker_" + std::to_string(thread.second)}}}});
+  }
+  for (const auto &event : events_) {
+    std::string category = event.stage == kOpLatencyWaitStage || event.stage == kOpLatencyComputeStage
+                             ? event.stage
+                             : std::string("tensor_op");
+    write_event({{"name", event.stage},
+                 {"cat", category},
+                 {"ph", "X"},
+                 {"ts", event.start},
+                 {"dur", event.duration},
+                 {"pid", event.op_id},
+                 {"tid", event.worker_id}});
+  }
+  handle << "\n]}\n";
+  handle.close();
+  if (dropped_events_ > 0) {
+    MS_LOG(WARNING) << "Op latency timeline is full, " << dropped_events_
+                    << " events were only recorded into the latency histograms.";
+  }
+  return Status::OK();
+}
+
+Status OpLatencyTracing::ChangeFileMode(const std::string &dir_path, const std::string &rank_id) {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (histograms_.empty()) {
+    return Status::OK();
+  }
+
+  for (const auto &path : {GetFileName(dir_path, rank_id), GetTimelineFileName(dir_path, rank_id)}) {
+    std::string file_path = path.ToString();
+    if (chmod(common::SafeCStr(file_path), S_IRUSR | S_IWUSR) == -1) {
+      std::string err_str = "Change file mode failed," + file_path;
+      return Status(StatusCode::kMDUnexpectedError, err_str);
+    }
+  }
+  return Status::OK();
+}
+
+void OpLatencyTracing::Clear() {
+  std::lock_guard<std::mutex> guard(lock_);
+  histograms_.clear();
+  op_names_.clear();
+  events_.clear();
+  dropped_events_ = 0;
+}
+
+Path OpLatencyTracing::GetFileName(const std::string &dir_path, const std::string &rank_id) {
+  return Path(dir_path) / Path("dataset_op_latency_" + rank_id + ".json");
+}
+
+Path OpLatencyTracing::GetTimelineFileName(const std::string &dir_path, const std::string &rank_id) {
+  return Path(dir_path) / Path("dataset_timeline_" + rank_id + ".json");
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,156 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_TRACING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_TRACING_H_
+
+#include <array>
+#include <limits>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "minddata/dataset/engine/perf/profiling.h"
+#include "minddata/dataset/util/path.h"
+
+namespace mindspore {
+namespace dataset {
+// Stage names of the latency records. A worker iteration is split into the time spent waiting on its input queue
+// and the time spent computing the row or batch. TensorOps of a MapOp are recorded under their own name.
+const char kOpLatencyWaitStage[] = "wait";
+const char kOpLatencyComputeStage[] = "compute";
+
+// LatencyHistogram counts latencies in microseconds into power of two buckets: bucket 0 holds [0, 1us],
+// bucket i holds (2^(i-1), 2^i] us and the last bucket holds everything above.
+class LatencyHistogram {
+ public:
+  static constexpr int32_t kNumBuckets = 32;
+
+  LatencyHistogram() : buckets_{}, count_(0), sum_(0), min_(std::numeric_limits<uint64_t>::max()), max_(0) {}
+
+  ~LatencyHistogram() = default;
+
+  // Add one latency sample
+  // @param latency - latency in microseconds
+  void Add(uint64_t latency);
+
+  // Add all the samples of another histogram
+  // @param other - the histogram to merge into this one
+  void Merge(const LatencyHistogram &other);
+
+  // Estimate the given percentile by linear interpolation within the bucket that holds it
+  // @param percentile - a value in [0, 100]
+  // @return the estimated latency in microseconds
+  uint64_t Percentile(double percentile) const;
+
+  uint64_t Count() const { return count_; }
+
+  // @return the histogram and its summary in json format
+  nlohmann::json ToJson() const;
+
+ private:
+  std::array<uint64_t, kNumBuckets> buckets_;
+  uint64_t count_;
+  uint64_t sum_;
+  uint64_t min_;
+  uint64_t max_;
+};
+
+// OpLatencyTracing records per op, per worker latency histograms of the parallel ops together with a timeline of
+// every worker iteration. Workers only hold a pointer to this node while the MD profiler is running for profiling,
+// so the pipeline pays nothing but a null check when profiling is disabled.
+// Two files are generated:
+//   dataset_op_latency_<rank_id>.json - latency histograms of each (op, worker, stage)
+//   dataset_timeline_<rank_id>.json   - Chrome trace event format, can be opened in chrome://tracing or Perfetto
+class OpLatencyTracing : public Tracing {
+ public:
+  // Constructor
+  OpLatencyTracing() : dropped_events_(0) {}
+
+  // Destructor
+  ~OpLatencyTracing() override = default;
+
+  std::string Name() const override { return kOpLatencyTracingName; };
+
+  Status Init() override;
+
+  // Save the latency histograms and the timeline to file
+  // @return Status The status code returned
+  Status SaveToFile(const std::string &dir_path, const std::string &rank_id) override;
+
+  Status ChangeFileMode(const std::string &dir_path, const std::string &rank_id) override;
+
+  // Record one stage of a worker iteration.
+  // @param op_id - id of the op
+  // @param op_name - name of the op
+  // @param worker_id - id of the worker thread
+  // @param stage - kOpLatencyWaitStage, kOpLatencyComputeStage or the name of a TensorOp
+  // @param start - start time in microseconds, see ProfilingTime::GetCurMicroSecond()
+  // @param end - end time in microseconds
+  void RecordLatency(int32_t op_id, const std::string &op_name, int32_t worker_id, const std::string &stage,
+                     uint64_t start, uint64_t end);
+
+  // Get the number of samples and the given percentile of a stage, summed up over all the workers of the op
+  // @param op_id - id of the op
+  // @param stage - name of the stage
+  // @param percentile - a value in [0, 100]
+  // @param count - number of samples recorded
+  // @param latency - estimated latency in microseconds
+  // @return Status The status code returned
+  Status GetOpLatency(int32_t op_id, const std::string &stage, double percentile, uint64_t *count,
+                      uint64_t *latency);
+
+  // Get the number of samples and the given percentile of a stage, summed up over all the ops and workers. This is
+  // mostly used to look up the cost of a TensorOp by its name.
+  // @param stage - name of the stage
+  // @param percentile - a value in [0, 100]
+  // @param count - number of samples recorded
+  // @param latency - estimated latency in microseconds
+  // @return Status The status code returned
+  Status GetStageLatency(const std::string &stage, double percentile, uint64_t *count, uint64_t *latency);
+
+  // Clear all collected data
+  void Clear() override;
+
+ private:
+  // Upper bound of the timeline events kept in memory, later events only go into the histograms.
+  static constexpr size_t kMaxTimelineEvents = 1 << 20;
+
+  struct TimelineEvent {
+    int32_t op_id;
+    int32_t worker_id;
+    std::string stage;
+    uint64_t start;
+    uint64_t duration;
+  };
+
+  using LatencyKey = std::tuple<int32_t, int32_t, std::string>;  // op id, worker id, stage
+
+  Path GetFileName(const std::string &dir_path, const std::string &rank_id) override;
+
+  Path GetTimelineFileName(const std::string &dir_path, const std::string &rank_id);
+
+  Status SaveTimelineToFile(const std::string &file_path);
+
+  std::map<LatencyKey, LatencyHistogram> histograms_;
+  std::map<int32_t, std::string> op_names_;
+  std::vector<TimelineEvent> events_;
+  uint64_t dropped_events_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_TRACING_H_
@@ -27,6 +27,7 @@
 #include "minddata/dataset/engine/perf/monitor.h"
 #include "minddata/dataset/engine/perf/connector_size.h"
 #include "minddata/dataset/engine/perf/cpu_sampler.h"
+#include "minddata/dataset/engine/perf/op_latency_tracing.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/tree_adapter.h"
 #include "minddata/dataset/util/log_adapter.h"
@@ -251,6 +252,11 @@ Status ProfilingManager::RegisterTree(TreeAdapter *tree_adapter) {
   std::shared_ptr<Sampling> cpu_sampler = std::make_shared<CpuSampler>(tree_);
   RETURN_IF_NOT_OK(RegisterSamplingNode(cpu_sampler));
 #endif
+  // Op latency tracing is only needed for profiling, autotune does not pay for it.
+  if (profiling_) {
+    std::shared_ptr<Tracing> op_latency_tracing = std::make_shared<OpLatencyTracing>();
+    RETURN_IF_NOT_OK(RegisterTracingNode(op_latency_tracing));
+  }
   // can insert a correct timestamp so that we can ignore the samples that were taken
   // during start up of the pipeline.
   (void)epoch_end_ts_.emplace_back(0);
@@ -294,6 +300,17 @@ Status ProfilingManager::GetTracingNode(const std::string &name, std::shared_ptr
   return Status::OK();
 }
 
+std::shared_ptr<OpLatencyTracing> ProfilingManager::GetOpLatencyTracing(const ExecutionTree *tree) {
+  if (!profiling_ || GetProfilerTreeState(tree) != kEnabledTreeRegistered) {
+    return nullptr;
+  }
+  auto node = tracing_nodes_.find(kOpLatencyTracingName);
+  if (node == tracing_nodes_.end()) {
+    return nullptr;
+  }
+  return std::dynamic_pointer_cast<OpLatencyTracing>(node->second);
+}
+
 // Profiling node registration
 Status ProfilingManager::RegisterSamplingNode(const std::shared_ptr<Sampling> &node) {
   // Check if node with the same name has already been registered.
@@ -844,5 +861,13 @@ uint64_t ProfilingTime::GetCurMilliSecond() {
   using std::chrono::steady_clock;
   return static_cast<uint64_t>(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
 }
+
+uint64_t ProfilingTime::GetCurMicroSecond() {
+  // because cpplint does not allow using namespace
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  using std::chrono::steady_clock;
+  return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -36,11 +36,13 @@ class ExecutionTree;
 class TreeConsumer;
 class CpuSampler;
 class TreeAdapter;
+class OpLatencyTracing;
 
 const char kDeviceQueueTracingName[] = "Device_Queue_Tracing";
 const char kDatasetIteratorTracingName[] = "Dataset_Iterator_Tracing";
 const char kConnectorSizeSamplingName[] = "Connector_Size_Sampling";
 const char kCpuSamplerName[] = "Cpu_Sampler";
+const char kOpLatencyTracingName[] = "Op_Latency_Tracing";
 
 // Values for process memory metrics - common for profiling and cpu_sampler
 enum ProcessMemoryMetric { kPSS, kRSS, kVSS };
@@ -178,6 +180,11 @@ class ProfilingManager {
   // @return Status The status code returned
   Status GetTracingNode(const std::string &name, std::shared_ptr<Tracing> *node);
 
+  /// \brief Getter for the op latency tracing node, used by the workers of the ops to time every row or batch.
+  /// \param tree Execution Tree pointer
+  /// \return the tracing node, nullptr if the given tree is not being profiled
+  std::shared_ptr<OpLatencyTracing> GetOpLatencyTracing(const ExecutionTree *tree);
+
   // return true if enabled_ is set to true, namely if Init() has been called successfully
   // @param tree - Execution tree pointer
   bool IsProfilingEnable(const ExecutionTree *tree = nullptr) const;
@@ -614,6 +621,7 @@ enum ProfilingTimeSubType {
 class ProfilingTime {
  public:
   static uint64_t GetCurMilliSecond();
+  static uint64_t GetCurMicroSecond();
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -19,6 +19,7 @@
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/ir/datasetops/root_node.h"
 #ifndef ENABLE_ANDROID
+#include "minddata/dataset/engine/opt/optional/cost_based_optimization_pass.h"
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/opt/pre/cache_transform_pass.h"
 #include "minddata/dataset/engine/opt/pre/node_offload_pass.h"
@@ -56,6 +57,10 @@ Status TreeAdapter::PrePass(std::shared_ptr<DatasetNode> ir) {
 
   MS_LOG(INFO) << "Running pre pass loops.";
   actions.emplace_back(std::make_unique<InputValidationPass>());
+#ifndef ENABLE_ANDROID
+  // Rewrite the tree before the cache is validated and transformed, since the rewrites may move a cache
+  if (optimize_) actions.emplace_back(std::make_unique<CostBasedOptimizationPass>());
+#endif
   actions.emplace_back(std::make_unique<CacheValidationPass>());
   actions.emplace_back(std::make_unique<NodeRemovalPass>());
   if (usage_ == kDeReset) actions.emplace_back(std::make_unique<AddSkipPass>());
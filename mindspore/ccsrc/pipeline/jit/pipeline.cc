@@ -58,6 +58,7 @@
 #include "backend/graph_compiler/segment_runner.h"
 #include "backend/common/session/executor_manager.h"
 #include "runtime/hardware/device_context_manager.h"
+#include "runtime/op_builder/op_lazy_builder.h"
 #include "runtime/device/kernel_runtime_manager.h"
 
 #ifndef ENABLE_SECURITY
@@ -1593,6 +1594,8 @@ void ClearResAtexit() {
   mindspore::RDR::ResetRecorder();
 #endif
   session::ExecutorManager::Instance().Clear();
+  // The op tasks may be launched in the async thread, which is stopped before the backend resource is cleared.
+  runtime::OpLazyBuilder::GetInstance().Finalize();
   runtime::GraphScheduler::GetInstance().Clear();
 
   MS_LOG(INFO) << "Start clear device context...";
@@ -59,6 +59,7 @@
 #include "backend/common/optimizer/const_input_to_attr.h"
 #include "backend/common/optimizer/helper.h"
 #include "runtime/hardware/device_context_manager.h"
+#include "runtime/op_builder/op_lazy_builder.h"
 #include "backend/graph_compiler/transform.h"
 
 using mindspore::tensor::TensorPy;
@@ -2114,6 +2115,8 @@ py::object ForwardExecutor::RunOpInMs(const OpExecInfoPtr &op_exec_info) {
   MS_EXCEPTION_IF_NULL(op_exec_info);
   compile::SetMindRTEnable();
   MS_LOG(DEBUG) << "Start run op [" << op_exec_info->op_name << "] with backend policy ms";
+  // The previous op tasks may be launched in the async thread, wait for the executing one without the GIL.
+  auto backend_lock = runtime::OpLazyBuilder::GetInstance().LockBackend();
   auto ms_context = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(ms_context);
   ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, true);
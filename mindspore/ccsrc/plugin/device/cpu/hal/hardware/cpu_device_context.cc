@@ -35,6 +35,12 @@
 #include "backend/common/session/anf_runtime_algorithm.h"
 #include "include/common/utils/anfalgo.h"
 #include "profiler/device/cpu/cpu_profiling.h"
+#include "backend/common/somas/somas.h"
+#include "runtime/device/ms_device_shape_transfer.h"
+#include "debug/env_config_parser.h"
+#include "utils/ms_context.h"
+#include "utils/ms_utils.h"
+#include "utils/anf_utils.h"
 #if ((defined ENABLE_CPU) && (!defined _WIN32))
 #include "plugin/device/cpu/hal/hardware/ms_collective_comm_lib.h"
 #endif
@@ -69,12 +75,35 @@ void CPUDeviceContext::Initialize() {
 
 void CPUDeviceContext::Destroy() {
   // Release memory.
+  {
+    std::lock_guard<std::mutex> lock(graph_memory_mutex_);
+    if (mem_manager_ != nullptr) {
+      for (const auto &graph_memory_block : graph_memory_blocks_) {
+        mem_manager_->FreeMemFromMemPool(graph_memory_block.second);
+      }
+    }
+    graph_memory_blocks_.clear();
+  }
   if (mem_manager_ != nullptr) {
     mem_manager_->Finalize();
     mem_manager_ = nullptr;
   }
 }
 
+void CPUDeviceContext::ClearGraph(const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  std::lock_guard<std::mutex> lock(graph_memory_mutex_);
+  auto iter = graph_memory_blocks_.find(graph->graph_id());
+  if (iter == graph_memory_blocks_.end()) {
+    return;
+  }
+  // The memory pool has been released if the device context is destroyed.
+  if (mem_manager_ != nullptr) {
+    mem_manager_->FreeMemFromMemPool(iter->second);
+  }
+  (void)graph_memory_blocks_.erase(iter);
+}
+
 bool CPUDeviceContext::AllocateMemory(DeviceAddress *const &address, size_t size) const {
   MS_EXCEPTION_IF_NULL(address);
   MS_EXCEPTION_IF_NULL(mem_manager_);
@@ -249,12 +278,140 @@ void CPUDeviceContext::UpdateDynamicShape(const CNodePtr &kernel) const {
   cpu_kernel->InitOp();
 }
 
+namespace {
+// The somas memory planning is used only in the graph mode for the static shape graphs, and the kernels which allocate
+// memory in the actor runtime by other ways, such as the continuous memory of communication kernels, are not supported.
+bool IsEnableSomas(const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  static const bool enable_cpu_somas = (common::GetEnv("MS_DEV_CPU_SOMAS") == "1");
+  if ((!enable_cpu_somas) || (!EnvConfigParser::GetInstance().GetSysMemreuse())) {
+    return false;
+  }
+  const auto &ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  if ((ms_context->get_param<int>(MS_CTX_EXECUTION_MODE) != kGraphMode) || graph->is_dynamic_shape() ||
+      graph->subgraph_multi_call() || graph->execution_order().empty()) {
+    return false;
+  }
+#ifndef ENABLE_SECURITY
+  if (DumpJsonParser::GetInstance().e2e_dump_enabled()) {
+    MS_LOG(INFO) << "Disable the somas of graph " << graph->graph_id() << " when e2e dump is enable.";
+    return false;
+  }
+#endif
+
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    if (common::AnfAlgo::IsControlOpExecInBackend(kernel) || common::AnfAlgo::IsCommunicationOp(kernel)) {
+      return false;
+    }
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    if ((kernel_mod == nullptr) ||
+        (kernel_mod->GetOutputSizeList().size() != AnfAlgo::GetOutputAddressNum(kernel))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+DeviceAddressPtr CreateKernelOutputAddress(const DeviceContext *device_context, const CNodePtr &kernel, size_t index,
+                                           void *device_ptr, size_t size) {
+  MS_EXCEPTION_IF_NULL(device_context);
+  auto output_format = AnfAlgo::GetOutputFormat(kernel, index);
+  auto output_type = AnfAlgo::GetOutputDeviceDataType(kernel, index);
+  auto device_address = device_context->CreateDeviceAddress(device_ptr, size, output_format, output_type);
+  MS_EXCEPTION_IF_NULL(device_address);
+  device_address->set_host_shape(trans::GetRuntimePaddingShape(kernel, index));
+  AnfAlgo::SetOutputAddr(device_address, index, kernel.get());
+  return device_address;
+}
+}  // namespace
+
 void CPUDeviceContext::PreprocessBeforeRunGraph(const KernelGraphPtr &graph) const {
   MS_EXCEPTION_IF_NULL(graph);
   // Remove reorder after PS feature finish adapting push/pull in auto_monad.
   auto execution_order = graph->execution_order();
   common::AnfAlgo::ReorderPosteriorExecList(NOT_NULL(&execution_order));
   graph->set_execution_order(execution_order);
+
+  if (IsEnableSomas(graph)) {
+    AllocateGraphMemory(graph);
+  }
+}
+
+void CPUDeviceContext::AllocateGraphMemory(const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(mem_manager_);
+  // The memory of graph outputs is taken over by the output tensors in every step, so create their device addresses
+  // without memory in advance, then somas skips them and they are allocated by the memory pool in the actor runtime.
+  for (const auto &output_with_index : common::AnfAlgo::GetAllOutputWithIndex(graph->output())) {
+    const auto &output_node = output_with_index.first;
+    MS_EXCEPTION_IF_NULL(output_node);
+    if ((!AnfUtils::IsRealCNodeKernel(output_node)) ||
+        AnfAlgo::OutputAddrExist(output_node, output_with_index.second)) {
+      continue;
+    }
+    auto kernel = output_node->cast<CNodePtr>();
+    (void)CreateKernelOutputAddress(this, kernel, output_with_index.second, nullptr,
+                                    AnfAlgo::GetOutputTensorMemSize(kernel, output_with_index.second));
+  }
+
+  auto somas = std::make_shared<somas::Somas>();
+  // The kernel actors are launched by the data dependency instead of the execution order.
+  somas->set_only_data_dependency(true);
+  if (!somas->Allocate(graph.get())) {
+    MS_LOG(EXCEPTION) << "Somas allocate failed for graph " << graph->graph_id();
+  }
+  size_t total_size = somas->GetTotalMemSize();
+  if (total_size == 0) {
+    return;
+  }
+  auto base_ptr = static_cast<uint8_t *>(mem_manager_->MallocMemFromMemPool(total_size, true));
+  if (base_ptr == nullptr) {
+    MS_LOG(EXCEPTION) << "Allocate somas memory failed, graph: " << graph->graph_id() << ", size: " << total_size;
+  }
+  {
+    std::lock_guard<std::mutex> lock(graph_memory_mutex_);
+    // The graph may be compiled again with the same graph id, then the block of the last compiling is useless.
+    auto iter = graph_memory_blocks_.find(graph->graph_id());
+    if (iter != graph_memory_blocks_.end()) {
+      mem_manager_->FreeMemFromMemPool(iter->second);
+    }
+    graph_memory_blocks_[graph->graph_id()] = base_ptr;
+  }
+  somas->set_mem_base_addr(base_ptr);
+
+  // The planned device addresses are not from the memory pool, so they keep the memory when the actors free them, and
+  // they are persisted so that the output actor copies them instead of taking over the memory.
+  size_t planned_size = 0;
+  for (const auto &kernel : graph->execution_order()) {
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    const auto &output_sizes = kernel_mod->GetOutputSizeList();
+    for (size_t i = 0; i < output_sizes.size(); ++i) {
+      if (AnfAlgo::OutputAddrExist(kernel, i)) {
+        continue;
+      }
+      auto device_address =
+        CreateKernelOutputAddress(this, kernel, i, somas->GetNodeOutputPtr(kernel, i), output_sizes[i]);
+      device_address->set_is_ptr_persisted(true);
+      planned_size += output_sizes[i];
+    }
+    const auto &workspace_sizes = kernel_mod->GetWorkspaceSizeList();
+    for (size_t i = 0; i < workspace_sizes.size(); ++i) {
+      if (AnfAlgo::WorkspaceAddrExist(kernel, i)) {
+        continue;
+      }
+      auto device_address =
+        CreateDeviceAddress(somas->GetNodeWorkSpacePtr(kernel, i), workspace_sizes[i], "", kTypeUnknown);
+      MS_EXCEPTION_IF_NULL(device_address);
+      device_address->set_is_ptr_persisted(true);
+      AnfAlgo::SetWorkspaceAddr(device_address, i, kernel.get());
+      planned_size += workspace_sizes[i];
+    }
+  }
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " uses somas memory, total size: " << total_size
+               << ", planned tensors size: " << planned_size;
 }
 
 bool CPUDeviceContext::LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
@@ -19,6 +19,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <map>
 #include <mutex>
 #include "runtime/hardware/device_context.h"
 #include "runtime/hardware/device_context_manager.h"
@@ -37,6 +38,8 @@ class CPUDeviceContext : public DeviceContext {
 
   void Destroy() override;
 
+  void ClearGraph(const KernelGraphPtr &graph) const override;
+
   bool AllocateMemory(DeviceAddress *const &address, size_t size) const override;
   void FreeMemory(DeviceAddress *const &address) const override;
   // Relevant function to allocate and free device memory of raw ptr.
@@ -66,6 +69,9 @@ class CPUDeviceContext : public DeviceContext {
   DISABLE_COPY_AND_ASSIGN(CPUDeviceContext);
 
   void OptimizeGraphImpl(const KernelGraphPtr &graph) const;
+  // Plan the memory of kernel outputs and workspaces in one block by somas, and create the device addresses which use
+  // the planned memory, so the kernels don't allocate and free memory in every step.
+  void AllocateGraphMemory(const KernelGraphPtr &graph) const;
 #ifndef ENABLE_SECURITY
   // Launch a kernel and record the elapsed time end to end.
   bool LaunchKernelWithProfiling(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
@@ -78,6 +84,9 @@ class CPUDeviceContext : public DeviceContext {
 
   mutable std::mutex launch_mutex_;
   std::shared_ptr<MemoryManager> mem_manager_;
+  // The somas memory block of each graph, which is freed when the graph is cleared.
+  mutable std::mutex graph_memory_mutex_;
+  mutable std::map<uint32_t, void *> graph_memory_blocks_;
   bool initialized_;
 };
 }  // namespace cpu
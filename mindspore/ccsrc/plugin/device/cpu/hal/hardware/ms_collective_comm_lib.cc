@@ -15,6 +15,7 @@
  */
 
 #include "plugin/device/cpu/hal/hardware/ms_collective_comm_lib.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace device {
@@ -24,6 +25,16 @@ MsCollectiveCommLib::MsCollectiveCommLib() {
   // Generate the global group name with node role.
   global_group_name_ = ClusterContext::instance()->node_role() + "_" + kMSGlobalGroupName;
   MS_LOG(INFO) << "Global group name of MindSpore collective communication library is " << global_group_name_;
+  // The lossy compression of the float AllReduce is only used if it's set explicitly, eg. for the gradients.
+  const auto &compression = common::GetEnv("MS_DEV_ALLREDUCE_COMPRESSION");
+  if (!compression.empty() &&
+      (!ps::GradientCompressor::ParseConfig(compression, &allreduce_compression_) ||
+       (allreduce_compression_.type != ps::GradientCompressionType::kFloat16 &&
+        allreduce_compression_.type != ps::GradientCompressionType::kInt8))) {
+    MS_LOG(WARNING) << "Invalid AllReduce compression " << compression
+                    << " in MS_DEV_ALLREDUCE_COMPRESSION, only fp16 and int8 are supported. It is ignored.";
+    allreduce_compression_ = ps::GradientCompressionConfig();
+  }
 }
 
 bool MsCollectiveCommLib::Initialize(uint32_t global_rank, uint32_t global_rank_size) {
@@ -79,19 +90,11 @@ bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size
   CHECK_IF_NULL(recv_buff);
   CHECK_IF_NULL(node_);
 
-  if (groups_.count(group_name) == 0) {
-    MS_LOG(ERROR) << "The group " << group_name << " does not exist.";
+  CommunicationGroupInfo group_info = {};
+  if (!GetGroupInfo(group_name, &group_info)) {
     return false;
   }
 
-  auto group = groups_[group_name];
-  CommunicationGroupInfo group_info = {};
-  group_info.size = group->group_size();
-  group_info.global_rank = global_rank_id_;
-  group_info.group_ranks = group->group_ranks();
-  group_info.global_to_group_ranks = group->global_to_group_ranks();
-  group_info.group_to_global_ranks = group->group_to_global_ranks();
-
   switch (data_type) {
     case TypeId::kNumberTypeInt8:
       return CollectiveOpsImpl::GetInstance().Broadcast<char>(send_buff, recv_buff, send_count, root_rank, node_,
@@ -112,6 +115,94 @@ bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size
   }
   return true;
 }
+
+bool MsCollectiveCommLib::AllReduce(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
+                                    CollectiveOpReduceType reduce_op, const std::string &group_name, void *) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  CHECK_IF_NULL(node_);
+
+  if (reduce_op != CollectiveOpReduceType::Reduce_Sum) {
+    MS_LOG(ERROR) << "The reduce type " << reduce_op << " of AllReduce is not supported, only sum is supported.";
+    return false;
+  }
+  CommunicationGroupInfo group_info = {};
+  if (!GetGroupInfo(group_name, &group_info)) {
+    return false;
+  }
+
+  switch (data_type) {
+    case TypeId::kNumberTypeInt8:
+      return CollectiveOpsImpl::GetInstance().AllReduce<char>(send_buff, recv_buff, send_count, node_, group_info);
+    case TypeId::kNumberTypeInt32:
+    case TypeId::kNumberTypeInt:
+      return CollectiveOpsImpl::GetInstance().AllReduce<int32_t>(send_buff, recv_buff, send_count, node_, group_info);
+    case TypeId::kNumberTypeUInt64:
+      return CollectiveOpsImpl::GetInstance().AllReduce<uint64_t>(send_buff, recv_buff, send_count, node_, group_info);
+    case TypeId::kNumberTypeFloat32:
+    case TypeId::kNumberTypeFloat:
+      if (allreduce_compression_.type != ps::GradientCompressionType::kNone) {
+        return CollectiveOpsImpl::GetInstance().CompressedAllReduce(static_cast<const float *>(send_buff),
+                                                                    static_cast<float *>(recv_buff), send_count,
+                                                                    allreduce_compression_, node_, group_info);
+      }
+      return CollectiveOpsImpl::GetInstance().AllReduce<float>(send_buff, recv_buff, send_count, node_, group_info);
+    default:
+      return false;
+  }
+  return true;
+}
+
+bool MsCollectiveCommLib::ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
+                                        CollectiveOpReduceType reduce_op, const std::string &group_name, void *) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  CHECK_IF_NULL(node_);
+
+  if (reduce_op != CollectiveOpReduceType::Reduce_Sum) {
+    MS_LOG(ERROR) << "The reduce type " << reduce_op << " of ReduceScatter is not supported, only sum is supported.";
+    return false;
+  }
+  CommunicationGroupInfo group_info = {};
+  if (!GetGroupInfo(group_name, &group_info)) {
+    return false;
+  }
+
+  switch (data_type) {
+    case TypeId::kNumberTypeInt8:
+      return CollectiveOpsImpl::GetInstance().ReduceScatter<char>(send_buff, recv_buff, recv_count, node_, group_info);
+    case TypeId::kNumberTypeInt32:
+    case TypeId::kNumberTypeInt:
+      return CollectiveOpsImpl::GetInstance().ReduceScatter<int32_t>(send_buff, recv_buff, recv_count, node_,
+                                                                     group_info);
+    case TypeId::kNumberTypeUInt64:
+      return CollectiveOpsImpl::GetInstance().ReduceScatter<uint64_t>(send_buff, recv_buff, recv_count, node_,
+                                                                      group_info);
+    case TypeId::kNumberTypeFloat32:
+    case TypeId::kNumberTypeFloat:
+      return CollectiveOpsImpl::GetInstance().ReduceScatter<float>(send_buff, recv_buff, recv_count, node_, group_info);
+    default:
+      return false;
+  }
+  return true;
+}
+
+bool MsCollectiveCommLib::GetGroupInfo(const std::string &group_name, CommunicationGroupInfo *group_info) {
+  CHECK_IF_NULL(group_info);
+  if (groups_.count(group_name) == 0) {
+    MS_LOG(ERROR) << "The group " << group_name << " does not exist.";
+    return false;
+  }
+
+  auto group = groups_[group_name];
+  CHECK_IF_NULL(group);
+  group_info->size = group->group_size();
+  group_info->global_rank = global_rank_id_;
+  group_info->group_ranks = group->group_ranks();
+  group_info->global_to_group_ranks = group->global_to_group_ranks();
+  group_info->group_to_global_ranks = group->group_to_global_ranks();
+  return true;
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
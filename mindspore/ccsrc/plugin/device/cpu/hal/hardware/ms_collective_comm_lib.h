@@ -24,6 +24,7 @@
 #include "plugin/device/cpu/hal/hardware/ms_communication_group.h"
 #include "distributed/cluster/cluster_context.h"
 #include "fl/server/collective_ops_impl.h"
+#include "ps/gradient_compression.h"
 
 namespace mindspore {
 namespace device {
@@ -49,23 +50,25 @@ class MsCollectiveCommLib : public CollectiveCommunicationLib {
                  const std::string &group_name, void *stream = nullptr) override;
 
   bool AllReduce(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
-                 CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override {
-    return true;
-  }
+                 CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override;
 
   bool Broadcast(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type, uint32_t root_rank,
                  const std::string &group_name, void *stream = nullptr) override;
 
   bool ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
-                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override {
-    return true;
-  }
+                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override;
 
  private:
   MsCollectiveCommLib();
   ~MsCollectiveCommLib() override = default;
 
+  // Get the group info for the collective operations, return false if the group does not exist.
+  bool GetGroupInfo(const std::string &group_name, CommunicationGroupInfo *group_info);
+
   std::shared_ptr<ps::core::AbstractNode> node_;
+
+  // The compression of the float AllReduce set by MS_DEV_ALLREDUCE_COMPRESSION, none by default.
+  ps::GradientCompressionConfig allreduce_compression_;
 };
 }  // namespace cpu
 }  // namespace device
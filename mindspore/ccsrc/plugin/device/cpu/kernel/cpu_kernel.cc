@@ -199,6 +199,9 @@ void ParallelLaunch(const CTask &task, size_t count, float block_size, Content c
   if (kernel_thread_num == 0) {
     MS_LOG(EXCEPTION) << "Actor inner pool has been init, but kernel thread is 0!";
   }
+  // The kernel only takes its group of kernel threads when the independent kernels are launched concurrently.
+  runtime::KernelThreadPartition::ThreadGroup thread_group(kernel_thread_num);
+  kernel_thread_num = thread_group.Limit(kernel_thread_num);
 
   size_t thread_num = count < block_size * kernel_thread_num ? std::ceil(count / block_size) : kernel_thread_num;
   size_t once_compute_size = (count + thread_num - 1) / thread_num;
@@ -222,12 +225,19 @@ void ParallelLaunch(const std::vector<common::Task> &tasks, Content content) {
     MS_LOG(EXCEPTION) << "Actor inner pool has been init, but kernel thread is 0!";
   }
 
-  size_t task_num = tasks.size();
+  // The tasks are run in the group of kernel threads by turns when the independent kernels are launched concurrently.
+  runtime::KernelThreadPartition::ThreadGroup thread_group(kernel_thread_num);
+  size_t task_num = thread_group.Limit(tasks.size());
+  if (task_num == 0) {
+    return;
+  }
   auto func = [&](void *, int task_id, float, float) {
-    tasks[task_id]();
+    for (size_t i = IntToSize(task_id); i < tasks.size(); i += task_num) {
+      tasks[i]();
+    }
     return common::SUCCESS;
   };
-  (void)thread_pool->ParallelLaunch(func, content, task_num);
+  (void)thread_pool->ParallelLaunch(func, content, SizeToInt(task_num));
 }
 
 void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
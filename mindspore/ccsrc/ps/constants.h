@@ -39,6 +39,8 @@ constexpr char kEnvSchedulerHost[] = "MS_SCHED_HOST";
 constexpr char kEnvSchedulerPort[] = "MS_SCHED_PORT";
 constexpr char kEnvSchedulerManagePort[] = "MS_SCHED_MANAGE_PORT";
 constexpr char kEnvNodeId[] = "MS_NODE_ID";
+// The local directory in which the servers spill the cold rows of the dynamic embedding tables.
+constexpr char kEnvDynamicEmbeddingSpillDir[] = "MS_DEV_DYNAMIC_EMBEDDING_SPILL_DIR";
 
 constexpr char kCommTypeOfIBVerbs[] = "ibverbs";
 constexpr char kRoleOfPServer[] = "server";
@@ -75,12 +77,15 @@ constexpr int64_t kInitOptimInputsShapeCmd = 12;
 constexpr int64_t kInitKeyToPushNodeIdCmd = 13;
 constexpr int64_t kInitEmbeddingsCmd = 20;
 constexpr int64_t kUpdateEmbeddingsCmd = 21;
+constexpr int64_t kInitDynamicEmbeddingsCmd = 22;
 constexpr int64_t kCheckReadyForPushCmd = 25;
 constexpr int64_t kCheckReadyForPullCmd = 26;
 constexpr int64_t kEmbeddingLookupCmd = 30;
+constexpr int64_t kDynamicEmbeddingLookupCmd = 31;
 constexpr int64_t kFinalizeCmd = 40;
 constexpr int64_t kPushCmd = 50;
 constexpr int64_t kPullCmd = 51;
+constexpr int64_t kPushDynamicEmbeddingsCmd = 52;
 
 constexpr size_t kInvalidKey = UINT64_MAX;
 constexpr int64_t kInvalidID = -1;
@@ -124,6 +129,10 @@ constexpr int64_t kSparseLazyAdamIndex = 2;
 constexpr int64_t kSparseFtrlIndex = 3;
 constexpr int64_t kSparseGradIndex = 6;
 constexpr int64_t kSparseIndiceIndex = 7;
+// The hyper parameters of the sparse Adam are beta1_power, beta2_power, lr, beta1, beta2 and epsilon.
+constexpr size_t kSparseAdamHyperParamNum = 6;
+// The state arrays of a dynamic embedding table are the var and the two states of the sparse Adam or FTRL.
+constexpr size_t kDynamicEmbeddingStateNum = 3;
 
 constexpr int64_t kHeartbeatTimes = 2;
 constexpr int64_t kGradValue = -100;
@@ -338,7 +338,7 @@ uint64_t AbstractNode::CollectiveSendAsync(const NodeRole &node_role, const uint
 
   auto client = GetOrCreateTcpClient(rank_id, node_role);
   MS_EXCEPTION_IF_NULL(client);
-  return SendMessageAsync(client, message_meta, Protos::RAW, data, size);
+  return SendCollectiveMessageAsync(client, node_role, rank_id, message_meta, data, size);
 }
 
 static std::string CollectiveMetaToString(const CollectiveMessageMeta &meta) {
@@ -371,7 +371,7 @@ uint64_t AbstractNode::FlCollectiveSendAsync(const CollectiveMessageMeta &collec
                 << ", send meta:" << CollectiveMetaToString(message_meta->collective_meta());
   auto client = GetOrCreateTcpClient(recv_rank_id, SERVER);
   MS_EXCEPTION_IF_NULL(client);
-  return SendMessageAsync(client, message_meta, Protos::RAW, data, size);
+  return SendCollectiveMessageAsync(client, SERVER, recv_rank_id, message_meta, data, size);
 }
 
 bool AbstractNode::FlCollectiveWaitInner(const CollectiveMessageMeta &expect_meta, VectorPtr *output,
@@ -517,6 +517,15 @@ bool AbstractNode::CollectiveWait(const std::pair<uint32_t, uint64_t> &request_i
   return res;
 }
 
+std::string AbstractNode::GetNodeIp(const NodeRole &node_role, uint32_t rank_id) {
+  std::lock_guard<std::mutex> lock(client_mutex_);
+  auto iter = nodes_address_.find(std::make_pair(node_role, rank_id));
+  if (iter == nodes_address_.end()) {
+    return "";
+  }
+  return iter->second.first;
+}
+
 bool AbstractNode::InitFollowerScaler() {
   follower_scaler_ = std::make_unique<FollowerScaler>(this);
   MS_EXCEPTION_IF_NULL(follower_scaler_);
@@ -1171,6 +1180,69 @@ bool AbstractNode::SendMessageSync(const std::shared_ptr<TcpClient> &client, con
   return Wait(request_id, timeout);
 }
 
+uint64_t AbstractNode::SendCollectiveMessageAsync(const std::shared_ptr<TcpClient> &client, const NodeRole &node_role,
+                                                  uint32_t rank_id, const std::shared_ptr<MessageMeta> &meta,
+                                                  const void *data, size_t size) {
+  MS_EXCEPTION_IF_NULL(client);
+  MS_EXCEPTION_IF_NULL(meta);
+  // Keep the order of data in the ring same as the order of messages on the socket.
+  std::lock_guard<std::mutex> lock(shm_send_mutex_);
+  auto key = std::make_pair(node_role, rank_id);
+  auto iter = shm_send_rings_.find(key);
+  if (iter == shm_send_rings_.end() || iter->second.first.lock() != client) {
+    distributed::SharedMemoryRingPtr ring = nullptr;
+    size_t capacity = distributed::SharedMemoryRing::TransportCapacity();
+    std::unique_lock<std::mutex> client_lock(client_mutex_);
+    bool is_local = (nodes_address_.count(key) != 0 && nodes_address_[key].first == node_info_.ip_);
+    client_lock.unlock();
+    if (capacity > 0 && is_local) {
+      ring = distributed::SharedMemoryRing::Create(capacity);
+    }
+    shm_send_rings_[key] = std::make_pair(std::weak_ptr<TcpClient>(client), ring);
+    iter = shm_send_rings_.find(key);
+  }
+
+  const auto &ring = iter->second.second;
+  if (ring != nullptr) {
+    meta->set_shm_ring(true);
+    meta->set_shm_id(ring->shm_id());
+    meta->set_shm_token(ring->token());
+    // The data is sent through the socket until the node attaches the ring, or if the ring is full.
+    if (ring->attached() && ring->Write({{data, size}})) {
+      meta->set_shm_data_size(size);
+      return SendMessageAsync(client, meta, Protos::RAW, data, 0);
+    }
+  }
+  return SendMessageAsync(client, meta, Protos::RAW, data, size);
+}
+
+distributed::SharedMemoryRingPtr AbstractNode::AttachSharedMemory(const MessageMeta &meta) {
+  std::lock_guard<std::mutex> lock(shm_recv_mutex_);
+  auto key = std::make_pair(meta.role(), meta.rank_id());
+  auto iter = shm_recv_rings_.find(key);
+  if (iter != shm_recv_rings_.end() && (iter->second == nullptr || iter->second->shm_id() == meta.shm_id())) {
+    return iter->second;
+  }
+  // Only the ring of the node registered on the same host is attached.
+  std::unique_lock<std::mutex> client_lock(client_mutex_);
+  bool is_local = (nodes_address_.count(key) != 0 && nodes_address_[key].first == node_info_.ip_);
+  client_lock.unlock();
+  if (!is_local) {
+    MS_LOG(WARNING) << "Ignore the shared memory advertised by role: " << CommUtil::NodeRoleToString(meta.role())
+                    << ", rank: " << meta.rank_id() << " which is not on the same host.";
+    shm_recv_rings_[key] = nullptr;
+    return nullptr;
+  }
+  // The sender creates a new ring after reconnecting.
+  auto ring = distributed::SharedMemoryRing::Attach(meta.shm_id(), meta.shm_token());
+  shm_recv_rings_[key] = ring;
+  if (ring != nullptr) {
+    MS_LOG(INFO) << "Receive the collective data from role: " << CommUtil::NodeRoleToString(meta.role())
+                 << ", rank: " << meta.rank_id() << " through the shared memory " << meta.shm_id();
+  }
+  return ring;
+}
+
 void AbstractNode::ProcessCollectiveSendData(const std::shared_ptr<TcpConnection> &conn,
                                              const std::shared_ptr<MessageMeta> &meta, const void *data, size_t size) {
   MS_EXCEPTION_IF_NULL(conn);
@@ -1211,12 +1283,25 @@ void AbstractNode::RunReceiveCallback(const std::shared_ptr<MessageMeta> &meta,
                                       size_t size) {
   MS_EXCEPTION_IF_NULL(meta);
   MS_EXCEPTION_IF_NULL(data);
-  std::shared_ptr<std::vector<unsigned char>> received_data = std::make_shared<std::vector<unsigned char>>(size, 0);
-  size_t dest_size = size;
-  size_t src_size = size;
-  int ret = memcpy_s(received_data->data(), dest_size, data, src_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+  auto ring = meta->shm_ring() ? AttachSharedMemory(*meta) : nullptr;
+  std::shared_ptr<std::vector<unsigned char>> received_data;
+  if (meta->shm_data_size() > 0) {
+    if (ring == nullptr) {
+      MS_LOG(EXCEPTION) << "The data from rank " << meta->rank_id() << " is in the shared memory " << meta->shm_id()
+                        << " not attached.";
+    }
+    received_data = std::make_shared<std::vector<unsigned char>>(meta->shm_data_size(), 0);
+    if (!ring->Read(received_data->data(), received_data->size())) {
+      MS_LOG(EXCEPTION) << "Failed to read the data from the shared memory " << meta->shm_id();
+    }
+  } else {
+    received_data = std::make_shared<std::vector<unsigned char>>(size, 0);
+    size_t dest_size = size;
+    size_t src_size = size;
+    int ret = memcpy_s(received_data->data(), dest_size, data, src_size);
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+    }
   }
   if (meta->collective_meta().enable_flag()) {
     OnRecvCollectiveData(*meta, received_data);
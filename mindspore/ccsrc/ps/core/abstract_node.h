@@ -34,6 +34,7 @@
 #include "ps/core/recovery_base.h"
 #include "ps/core/communicator/task_executor.h"
 #include "ps/core/communicator/communicator_base.h"
+#include "distributed/shared_memory/shared_memory_ring.h"
 
 namespace mindspore {
 namespace ps {
@@ -114,6 +115,10 @@ class AbstractNode : public Node {
                                                        VectorPtr *output);
   bool CollectiveWait(const std::pair<uint32_t, uint64_t> &request_id, const uint32_t &timeout = kCommTimeoutInSeconds);
 
+  // Get the ip of the node with the role and rank id, which is used to find the nodes on the same host. Return an empty
+  // string if the node is unknown.
+  std::string GetNodeIp(const NodeRole &node_role, uint32_t rank_id);
+
   // Initialize the scaler for server to process before/after scaling operations.
   bool InitFollowerScaler();
 
@@ -208,6 +213,12 @@ class AbstractNode : public Node {
                        const Protos &, const void *, size_t size, const uint32_t &timeout = kCommTimeoutInSeconds);
   uint64_t SendMessageAsync(const std::shared_ptr<TcpClient> &client, const std::shared_ptr<MessageMeta> &meta,
                             const Protos &protos, const void *data, size_t size);
+  // Send the collective data through the shared memory ring if the node is on the same host and has attached the ring.
+  uint64_t SendCollectiveMessageAsync(const std::shared_ptr<TcpClient> &client, const NodeRole &node_role,
+                                      uint32_t rank_id, const std::shared_ptr<MessageMeta> &meta, const void *data,
+                                      size_t size);
+  // Attach the shared memory ring advertised by the sender of the message, return nullptr if not available.
+  distributed::SharedMemoryRingPtr AttachSharedMemory(const MessageMeta &meta);
   void ProcessCollectiveSendData(const std::shared_ptr<TcpConnection> &conn, const std::shared_ptr<MessageMeta> &meta,
                                  const void *data, size_t size);
   void ProcessSendData(const std::shared_ptr<TcpConnection> &conn, const std::shared_ptr<MessageMeta> &meta,
@@ -279,6 +290,16 @@ class AbstractNode : public Node {
   std::mutex fl_receive_mutex_;
   std::condition_variable fl_receive_cond_;
 
+  // The shared memory rings for sending the collective data to the nodes on the same host, the key is <node_role,
+  // rank_id> and the value is the client which the ring is created for and the ring. A new ring is created for a new
+  // client, and the ring is nullptr if the node is on another host.
+  std::map<std::pair<NodeRole, uint32_t>, std::pair<std::weak_ptr<TcpClient>, distributed::SharedMemoryRingPtr>>
+    shm_send_rings_;
+  std::mutex shm_send_mutex_;
+  // The shared memory rings attached for receiving the collective data, the key is <node_role, rank_id> of sender.
+  std::map<std::pair<NodeRole, uint32_t>, distributed::SharedMemoryRingPtr> shm_recv_rings_;
+  std::mutex shm_recv_mutex_;
+
   // Workers and servers launch the server to process command: FINISH,SCALE_OUT,SCALE_IN,SEND_METADATA
   std::shared_ptr<TcpServer> server_;
   std::unique_ptr<std::thread> server_thread_;
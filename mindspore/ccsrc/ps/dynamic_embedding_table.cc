@@ -0,0 +1,305 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/dynamic_embedding_table.h"
+
+#include <algorithm>
+#include <climits>
+#include <random>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr uint64_t kDefaultPendingTtlSteps = 100;
+constexpr size_t kDefaultMaxPendingIdsPerRow = 16;
+
+// Mix the bits of the id, so the embeddings of the adjacent ids are initialized by the uncorrelated seeds.
+uint32_t MixSeed(Key id, uint32_t seed) {
+  uint64_t value = (static_cast<uint64_t>(id) + seed) * 0x9E3779B97F4A7C15ULL;
+  value ^= value >> 32;
+  return static_cast<uint32_t>(value);
+}
+}  // namespace
+
+DynamicEmbeddingTable::DynamicEmbeddingTable(const DynamicEmbeddingTableConfig &config) : config_(config) {
+  if (config_.embedding_dim == 0 || config_.state_num == 0) {
+    MS_LOG(EXCEPTION) << "The embedding dim " << config_.embedding_dim << " and the state number " << config_.state_num
+                      << " of the dynamic embedding table should be positive.";
+  }
+  if (config_.capacity == 0 || config_.capacity > INT_MAX) {
+    MS_LOG(EXCEPTION) << "The capacity " << config_.capacity << " of the dynamic embedding table is invalid.";
+  }
+  if (config_.initial_values.empty()) {
+    config_.initial_values.assign(config_.state_num, 0);
+  } else if (config_.initial_values.size() != config_.state_num) {
+    MS_LOG(EXCEPTION) << "The number of the initial values " << config_.initial_values.size()
+                      << " is not equal to the state number " << config_.state_num;
+  }
+  if (config_.pending_ttl_steps == 0) {
+    config_.pending_ttl_steps = config_.ttl_steps != 0 ? config_.ttl_steps : kDefaultPendingTtlSteps;
+  }
+  if (config_.max_pending_ids == 0) {
+    config_.max_pending_ids = config_.capacity * kDefaultMaxPendingIdsPerRow;
+  }
+  row_size_ = config_.state_num * config_.embedding_dim;
+  states_.resize(config_.state_num);
+  for (auto &state : states_) {
+    state.resize(config_.capacity * config_.embedding_dim);
+  }
+  // The slots are taken from the back, so the rows are filled from the beginning of the arrays.
+  free_slots_.resize(config_.capacity);
+  for (size_t i = 0; i < config_.capacity; i++) {
+    free_slots_[i] = static_cast<int>(config_.capacity - i - 1);
+  }
+  if (!config_.spill_dir.empty()) {
+    spill_file_ = std::make_unique<distributed::storage::RowFile>(config_.spill_dir, row_size_ * sizeof(float));
+    if (!spill_file_->Open()) {
+      MS_LOG(EXCEPTION) << "Failed to create the spill file in the directory " << config_.spill_dir;
+    }
+  }
+}
+
+void DynamicEmbeddingTable::Lookup(const Key *ids, size_t id_num, float *output) {
+  if (id_num == 0) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(output);
+  std::lock_guard<std::mutex> lock(mutex_);
+  request_++;
+  size_t dim = config_.embedding_dim;
+  const float *embeddings = states_[0].data();
+  for (size_t i = 0; i < id_num; i++) {
+    int slot = GetSlot(ids[i], true);
+    float *dst = output + i * dim;
+    if (slot < 0) {
+      (void)std::fill(dst, dst + dim, 0);
+    } else {
+      (void)std::copy(embeddings + slot * dim, embeddings + (slot + 1) * dim, dst);
+    }
+  }
+}
+
+bool DynamicEmbeddingTable::ApplyGradients(const Key *ids, const float *grad, size_t id_num,
+                                           const std::vector<AddressPtr> &hyper_params,
+                                           const SparseOptimizer &optimizer) {
+  if (id_num == 0) {
+    return true;
+  }
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(grad);
+  std::lock_guard<std::mutex> lock(mutex_);
+  request_++;
+  size_t dim = config_.embedding_dim;
+  std::vector<float> grads;
+  std::vector<int> indices;
+  grads.reserve(id_num * dim);
+  indices.reserve(id_num);
+  // The position of each slot in the indices.
+  std::unordered_map<int, size_t> slot_positions;
+  for (size_t i = 0; i < id_num; i++) {
+    int slot = GetSlot(ids[i], false);
+    if (slot < 0) {
+      continue;
+    }
+    auto iter = slot_positions.find(slot);
+    if (iter == slot_positions.end()) {
+      (void)slot_positions.emplace(slot, indices.size());
+      (void)grads.insert(grads.end(), grad + i * dim, grad + (i + 1) * dim);
+      indices.push_back(slot);
+      continue;
+    }
+    float *dst = grads.data() + iter->second * dim;
+    for (size_t j = 0; j < dim; j++) {
+      dst[j] += grad[i * dim + j];
+    }
+  }
+  if (indices.empty()) {
+    return true;
+  }
+
+  std::vector<AddressPtr> inputs;
+  for (auto &state : states_) {
+    (void)inputs.emplace_back(std::make_shared<kernel::Address>(state.data(), state.size() * sizeof(float)));
+  }
+  (void)inputs.insert(inputs.end(), hyper_params.begin(), hyper_params.end());
+  (void)inputs.emplace_back(std::make_shared<kernel::Address>(grads.data(), grads.size() * sizeof(float)));
+  (void)inputs.emplace_back(std::make_shared<kernel::Address>(indices.data(), indices.size() * sizeof(int)));
+  return optimizer(inputs);
+}
+
+void DynamicEmbeddingTable::EndStep() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  step_++;
+  if (config_.ttl_steps != 0) {
+    for (auto iter = rows_.begin(); iter != rows_.end();) {
+      if (step_ - iter->second.step > config_.ttl_steps) {
+        ReleaseRow(iter->second);
+        iter = rows_.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+  // The pending ids are always dropped on their own ttl, otherwise the ids seen only once are kept forever.
+  for (auto iter = pending_ids_.begin(); iter != pending_ids_.end();) {
+    if (step_ - iter->second.step > config_.pending_ttl_steps) {
+      iter = pending_ids_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+size_t DynamicEmbeddingTable::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return rows_.size();
+}
+
+size_t DynamicEmbeddingTable::resident_size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return rows_.size() - spilled_num_;
+}
+
+size_t DynamicEmbeddingTable::spilled_size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return spilled_num_;
+}
+
+int DynamicEmbeddingTable::GetSlot(Key id, bool create) {
+  size_t dim = config_.embedding_dim;
+  auto iter = rows_.find(id);
+  if (iter != rows_.end()) {
+    Row &row = iter->second;
+    row.step = step_;
+    row.request = request_;
+    if (row.slot >= 0) {
+      lru_.splice(lru_.begin(), lru_, row.lru_iter);
+      return row.slot;
+    }
+    // Load the spilled row back to the state arrays.
+    int slot = AcquireSlot();
+    std::vector<float> buffer(row_size_);
+    if (!spill_file_->Read(row.record, buffer.data())) {
+      MS_LOG(EXCEPTION) << "Failed to load the row of the id " << id << " from the spill file.";
+    }
+    for (size_t i = 0; i < states_.size(); i++) {
+      (void)std::copy(buffer.begin() + i * dim, buffer.begin() + (i + 1) * dim, states_[i].begin() + slot * dim);
+    }
+    spill_file_->Free(row.record);
+    spilled_num_--;
+    row.record = -1;
+    row.slot = slot;
+    lru_.push_front(id);
+    row.lru_iter = lru_.begin();
+    return slot;
+  }
+  if (!create) {
+    return -1;
+  }
+
+  if (config_.admission_threshold > 1) {
+    auto pending_iter = pending_ids_.find(id);
+    if (pending_iter == pending_ids_.end()) {
+      if (pending_ids_.size() >= config_.max_pending_ids) {
+        return -1;
+      }
+      pending_iter = pending_ids_.emplace(id, PendingId()).first;
+    }
+    auto &pending_id = pending_iter->second;
+    pending_id.count++;
+    pending_id.step = step_;
+    if (pending_id.count < config_.admission_threshold) {
+      return -1;
+    }
+    (void)pending_ids_.erase(id);
+  }
+  int slot = AcquireSlot();
+  InitRow(id, slot);
+  lru_.push_front(id);
+  Row &row = rows_[id];
+  row.slot = slot;
+  row.step = step_;
+  row.request = request_;
+  row.lru_iter = lru_.begin();
+  return slot;
+}
+
+int DynamicEmbeddingTable::AcquireSlot() {
+  if (!free_slots_.empty()) {
+    int slot = free_slots_.back();
+    free_slots_.pop_back();
+    return slot;
+  }
+  auto iter = rows_.find(lru_.back());
+  if (iter == rows_.end()) {
+    MS_LOG(EXCEPTION) << "The least recently used id " << lru_.back() << " has no row.";
+  }
+  Row &row = iter->second;
+  if (row.request == request_) {
+    MS_LOG(EXCEPTION) << "The capacity " << config_.capacity
+                      << " of the dynamic embedding table is less than the number of the ids of one request.";
+  }
+  int slot = row.slot;
+  lru_.pop_back();
+  if (spill_file_ == nullptr) {
+    (void)rows_.erase(iter);
+    return slot;
+  }
+
+  size_t dim = config_.embedding_dim;
+  std::vector<float> buffer(row_size_);
+  for (size_t i = 0; i < states_.size(); i++) {
+    auto begin = states_[i].begin() + slot * dim;
+    (void)std::copy(begin, begin + dim, buffer.begin() + i * dim);
+  }
+  row.record = spill_file_->Write(buffer.data());
+  if (row.record < 0) {
+    MS_LOG(EXCEPTION) << "Failed to spill the row of the id " << iter->first << " to the spill file.";
+  }
+  row.slot = -1;
+  spilled_num_++;
+  return slot;
+}
+
+void DynamicEmbeddingTable::InitRow(Key id, int slot) {
+  size_t dim = config_.embedding_dim;
+  for (size_t i = 0; i < states_.size(); i++) {
+    auto begin = states_[i].begin() + slot * dim;
+    (void)std::fill(begin, begin + dim, config_.initial_values[i]);
+  }
+  if (config_.init_stddev > 0) {
+    std::mt19937 engine(MixSeed(id, config_.seed));
+    std::normal_distribution<float> distribution(0, config_.init_stddev);
+    float *embedding = states_[0].data() + slot * dim;
+    for (size_t i = 0; i < dim; i++) {
+      embedding[i] += distribution(engine);
+    }
+  }
+}
+
+void DynamicEmbeddingTable::ReleaseRow(const Row &row) {
+  if (row.slot >= 0) {
+    free_slots_.push_back(row.slot);
+    (void)lru_.erase(row.lru_iter);
+  } else if (spill_file_ != nullptr) {
+    spill_file_->Free(row.record);
+    spilled_num_--;
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
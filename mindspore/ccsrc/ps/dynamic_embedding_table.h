@@ -0,0 +1,141 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_DYNAMIC_EMBEDDING_TABLE_H_
+#define MINDSPORE_CCSRC_PS_DYNAMIC_EMBEDDING_TABLE_H_
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "kernel/kernel.h"
+#include "ps/constants.h"
+#include "distributed/persistent/storage/row_file.h"
+
+namespace mindspore {
+namespace ps {
+using mindspore::kernel::AddressPtr;
+
+struct DynamicEmbeddingTableConfig {
+  size_t embedding_dim{0};
+  // The number of the arrays of each row: the embedding and the states of the optimizer, eg. 3 for Adam(var, m, v).
+  size_t state_num{1};
+  // The maximal number of the rows in memory. The least recently used rows are spilled to the file beyond it.
+  size_t capacity{0};
+  // An id is admitted when it is looked up this number of times, and the ids not admitted are looked up as zero.
+  uint32_t admission_threshold{1};
+  // The rows not accessed for this number of steps are evicted, and 0 means never.
+  uint64_t ttl_steps{0};
+  // The ids not admitted yet are dropped if they are not looked up for pending_ttl_steps steps, and 0 means ttl_steps,
+  // or 100 if ttl_steps is 0 too. At most max_pending_ids ids are pending, and 0 means 16 times the capacity. The other
+  // new ids are not counted until the expired ones are dropped.
+  uint64_t pending_ttl_steps{0};
+  size_t max_pending_ids{0};
+  // The initial values of the arrays of a new row, and the embedding also adds a normal noise of the stddev.
+  std::vector<float> initial_values;
+  float init_stddev{0.01};
+  uint32_t seed{0};
+  // The local directory in which the cold rows are spilled to a private file. The rows beyond the capacity are dropped
+  // if it is empty.
+  std::string spill_dir;
+};
+
+// DynamicEmbeddingTable is an embedding table on the server keyed by the 64-bit feature ids without a fixed vocabulary.
+// The row of an id is created and initialized on demand after the id is seen admission_threshold times, and is evicted
+// after it is not accessed for ttl_steps steps. The resident rows are kept in the contiguous arrays of capacity rows,
+// one array for the embedding and one for each optimizer state, so the sparse optimizer kernels of the parameter server
+// update them in place with the indices mapped from the ids. The least recently used rows are spilled to the local
+// file when the arrays are full, and are loaded back when they are accessed again.
+class DynamicEmbeddingTable {
+ public:
+  // Run the sparse optimizer kernel with the inputs: the state arrays, the hyper parameters, the gradients and the int
+  // indices of the rows, which is the input order of the sparse optimizer kernels, eg. SparseApplyAdamPSKernelMod.
+  using SparseOptimizer = std::function<bool(const std::vector<AddressPtr> &inputs)>;
+
+  explicit DynamicEmbeddingTable(const DynamicEmbeddingTableConfig &config);
+  ~DynamicEmbeddingTable() = default;
+
+  // Copy the embeddings of the ids to the output. The ids are counted for the admission, and the rows of the newly
+  // admitted ids are created. The embeddings of the ids not admitted are zero.
+  void Lookup(const Key *ids, size_t id_num, float *output);
+
+  // Update the rows of the ids with the gradients of id_num * embedding_dim elements by the sparse optimizer. The
+  // gradients of the ids without rows are dropped, and the ones of the same id are summed, so the indices passed to the
+  // optimizer are unique and no more than the capacity. Return the result of the optimizer.
+  bool ApplyGradients(const Key *ids, const float *grad, size_t id_num, const std::vector<AddressPtr> &hyper_params,
+                      const SparseOptimizer &optimizer);
+
+  // Finish a training step and evict the rows and the pending ids which are expired.
+  void EndStep();
+
+  // The number of the rows in memory and in the file.
+  size_t size() const;
+  size_t resident_size() const;
+  size_t spilled_size() const;
+
+  size_t embedding_dim() const { return config_.embedding_dim; }
+  size_t capacity() const { return config_.capacity; }
+
+ private:
+  struct Row {
+    // The index of the row in the state arrays, or -1 if the row is in the file.
+    int slot{-1};
+    // The index of the record in the file if the row is spilled.
+    int64_t record{-1};
+    // The step and the request of the last access, the request is used to keep the rows of the current request.
+    uint64_t step{0};
+    uint64_t request{0};
+    std::list<Key>::iterator lru_iter;
+  };
+
+  struct PendingId {
+    uint32_t count{0};
+    uint64_t step{0};
+  };
+
+  // Return the slot of the id, create its row if create is true and the id is admitted, return -1 if there is no row.
+  int GetSlot(Key id, bool create);
+
+  // Take a free slot, or spill the least recently used row to get one.
+  int AcquireSlot();
+  void InitRow(Key id, int slot);
+  void ReleaseRow(const Row &row);
+
+  DynamicEmbeddingTableConfig config_;
+  size_t row_size_;
+
+  mutable std::mutex mutex_;
+  // The state arrays of capacity * embedding_dim elements, and the first one is the embedding.
+  std::vector<std::vector<float>> states_;
+  std::vector<int> free_slots_;
+  std::unordered_map<Key, Row> rows_;
+  // The ids of the resident rows from the most recently used to the least.
+  std::list<Key> lru_;
+  std::unordered_map<Key, PendingId> pending_ids_;
+  std::unique_ptr<distributed::storage::RowFile> spill_file_;
+  size_t spilled_num_{0};
+  uint64_t step_{0};
+  uint64_t request_{0};
+};
+
+using DynamicEmbeddingTablePtr = std::shared_ptr<DynamicEmbeddingTable>;
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_DYNAMIC_EMBEDDING_TABLE_H_
@@ -0,0 +1,186 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/embedding_table_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include "include/common/thread_pool.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+// The requests with fewer elements are handled in the calling thread.
+constexpr size_t kParallelElementNum = 1 << 16;
+// The rows are prefetched some positions ahead, since the ids of a batch are random in the table.
+constexpr size_t kPrefetchDistance = 4;
+}  // namespace
+
+EmbeddingTableStore::EmbeddingTableStore(float *table, size_t first_dim_size, size_t outer_dim_size, int64_t offset,
+                                         size_t stripe_num)
+    : table_(table),
+      first_dim_size_(first_dim_size),
+      outer_dim_size_(outer_dim_size),
+      offset_(offset),
+      stripes_(std::max(stripe_num, static_cast<size_t>(1))) {
+  MS_EXCEPTION_IF_NULL(table_);
+}
+
+std::shared_ptr<EmbeddingTableStore> EmbeddingTableStore::Create(float *table, const std::vector<size_t> &shape,
+                                                                 int64_t offset) {
+  size_t total_dims = std::accumulate(shape.begin(), shape.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+  size_t first_dim_size = shape.empty() ? 0 : shape[0];
+  size_t outer_dim_size = first_dim_size == 0 ? 0 : total_dims / first_dim_size;
+  return std::make_shared<EmbeddingTableStore>(table, first_dim_size, outer_dim_size, offset);
+}
+
+size_t EmbeddingTableStore::GetRow(size_t id) const {
+  int64_t row = static_cast<int64_t>(id) - offset_;
+  if (row < 0 || row >= static_cast<int64_t>(first_dim_size_)) {
+    return first_dim_size_;
+  }
+  return static_cast<size_t>(row);
+}
+
+void EmbeddingTableStore::GroupByStripe(const size_t *ids, size_t id_num, std::vector<size_t> *positions,
+                                        std::vector<size_t> *begins) const {
+  size_t stripe_num = stripes_.size();
+  std::vector<size_t> stripe_of_ids(id_num);
+  begins->assign(stripe_num + 1, 0);
+  for (size_t i = 0; i < id_num; i++) {
+    // The ids out of this shard are grouped to stripe 0, which is locked but not read.
+    size_t row = GetRow(ids[i]);
+    stripe_of_ids[i] = row < first_dim_size_ ? row % stripe_num : 0;
+    (*begins)[stripe_of_ids[i] + 1]++;
+  }
+  for (size_t s = 0; s < stripe_num; s++) {
+    (*begins)[s + 1] += (*begins)[s];
+  }
+  positions->resize(id_num);
+  std::vector<size_t> next(begins->begin(), begins->end() - 1);
+  for (size_t i = 0; i < id_num; i++) {
+    (*positions)[next[stripe_of_ids[i]]++] = i;
+  }
+}
+
+void EmbeddingTableStore::RunByStripe(size_t id_num, const std::function<void(size_t, size_t)> &task) const {
+  size_t stripe_num = stripes_.size();
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  size_t thread_num =
+    std::min({thread_pool.GetSyncRunThreadNum(), stripe_num, id_num * outer_dim_size_ / kParallelElementNum});
+  if (thread_num <= 1) {
+    task(0, stripe_num);
+    return;
+  }
+  size_t stripes_per_task = (stripe_num + thread_num - 1) / thread_num;
+  std::vector<common::Task> tasks;
+  for (size_t begin = 0; begin < stripe_num; begin += stripes_per_task) {
+    size_t end = std::min(begin + stripes_per_task, stripe_num);
+    (void)tasks.emplace_back([&task, begin, end]() {
+      task(begin, end);
+      return common::SUCCESS;
+    });
+  }
+  (void)thread_pool.SyncRun(tasks);
+}
+
+void EmbeddingTableStore::Lookup(const size_t *ids, size_t id_num, float *output) const {
+  if (id_num == 0) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(output);
+  std::vector<size_t> positions;
+  std::vector<size_t> begins;
+  GroupByStripe(ids, id_num, &positions, &begins);
+  // Lock the stripes in order in this thread before running the tasks, so the threads of the thread pool never wait for
+  // the stripes locked by the optimizer, which may run on the thread pool too.
+  std::vector<std::shared_lock<std::shared_mutex>> locks;
+  for (size_t s = 0; s < stripes_.size(); s++) {
+    if (begins[s] != begins[s + 1]) {
+      (void)locks.emplace_back(stripes_[s]);
+    }
+  }
+  size_t row_size = outer_dim_size_ * sizeof(float);
+  RunByStripe(id_num, [&](size_t stripe_begin, size_t stripe_end) {
+    for (size_t s = stripe_begin; s < stripe_end; s++) {
+      for (size_t p = begins[s]; p < begins[s + 1]; p++) {
+        if (p + kPrefetchDistance < begins[s + 1]) {
+          size_t next_row = GetRow(ids[positions[p + kPrefetchDistance]]);
+          if (next_row < first_dim_size_) {
+            __builtin_prefetch(table_ + next_row * outer_dim_size_);
+          }
+        }
+        size_t i = positions[p];
+        size_t row = GetRow(ids[i]);
+        if (row < first_dim_size_) {
+          (void)memcpy(output + i * outer_dim_size_, table_ + row * outer_dim_size_, row_size);
+        } else {
+          (void)memset(output + i * outer_dim_size_, 0, row_size);
+        }
+      }
+    }
+  });
+}
+
+bool EmbeddingTableStore::Update(const size_t *ids, size_t id_num, const float *values) {
+  if (id_num == 0) {
+    return true;
+  }
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(values);
+  for (size_t i = 0; i < id_num; i++) {
+    if (GetRow(ids[i]) >= first_dim_size_) {
+      MS_LOG(ERROR) << "The id " << ids[i] << " is out of the embedding table shard [" << offset_ << ", "
+                    << (offset_ + static_cast<int64_t>(first_dim_size_)) << ")";
+      return false;
+    }
+  }
+  std::vector<size_t> positions;
+  std::vector<size_t> begins;
+  GroupByStripe(ids, id_num, &positions, &begins);
+  std::vector<std::unique_lock<std::shared_mutex>> locks;
+  for (size_t s = 0; s < stripes_.size(); s++) {
+    if (begins[s] != begins[s + 1]) {
+      (void)locks.emplace_back(stripes_[s]);
+    }
+  }
+  size_t row_size = outer_dim_size_ * sizeof(float);
+  RunByStripe(id_num, [&](size_t stripe_begin, size_t stripe_end) {
+    for (size_t s = stripe_begin; s < stripe_end; s++) {
+      for (size_t p = begins[s]; p < begins[s + 1]; p++) {
+        size_t i = positions[p];
+        (void)memcpy(table_ + GetRow(ids[i]) * outer_dim_size_, values + i * outer_dim_size_, row_size);
+      }
+    }
+  });
+  return true;
+}
+
+std::vector<std::unique_lock<std::shared_mutex>> EmbeddingTableStore::LockAll() {
+  std::vector<std::unique_lock<std::shared_mutex>> locks;
+  locks.reserve(stripes_.size());
+  // Lock in the stripe order as the lookups and updates do.
+  for (auto &stripe : stripes_) {
+    (void)locks.emplace_back(stripe);
+  }
+  return locks;
+}
+}  // namespace ps
+}  // namespace mindspore
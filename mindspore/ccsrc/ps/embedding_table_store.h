@@ -0,0 +1,82 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_EMBEDDING_TABLE_STORE_H_
+#define MINDSPORE_CCSRC_PS_EMBEDDING_TABLE_STORE_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+// EmbeddingTableStore guards the rows of an embedding table shard on the server with lock stripes. Row i belongs to
+// stripe i % stripe_num, so the lookups run concurrently, and an update only waits for the requests touching the same
+// stripes. The large requests are split by stripe to the threads of the thread pool.
+class EmbeddingTableStore {
+ public:
+  // The table is the row-major data of first_dim_size rows with outer_dim_size elements each, and the id of row i is
+  // offset + i.
+  EmbeddingTableStore(float *table, size_t first_dim_size, size_t outer_dim_size, int64_t offset,
+                      size_t stripe_num = kDefaultStripeNum);
+  ~EmbeddingTableStore() = default;
+
+  // Create the store of the table of the shape, whose first dimension is the rows, eg. the input shape of the embedding
+  // lookup kernel.
+  static std::shared_ptr<EmbeddingTableStore> Create(float *table, const std::vector<size_t> &shape, int64_t offset);
+
+  // Copy the rows of the ids to the output, and the rows of the ids out of this shard are filled with zero.
+  void Lookup(const size_t *ids, size_t id_num, float *output) const;
+
+  // Overwrite the rows of the ids with the values in order. Return false if any id is out of this shard, and then no
+  // row is updated.
+  bool Update(const size_t *ids, size_t id_num, const float *values);
+
+  // Lock all the stripes exclusively, eg. while the optimizer updates the whole table. The stripes are unlocked when
+  // the returned locks are destroyed.
+  std::vector<std::unique_lock<std::shared_mutex>> LockAll();
+
+  size_t first_dim_size() const { return first_dim_size_; }
+  size_t outer_dim_size() const { return outer_dim_size_; }
+
+ private:
+  static constexpr size_t kDefaultStripeNum = 64;
+
+  // Return the row of the id, or first_dim_size_ if the id is out of this shard.
+  size_t GetRow(size_t id) const;
+
+  // Group the positions of the ids by stripe, positions[begins[s], begins[s + 1]) are the ones of stripe s and keep the
+  // order of the ids.
+  void GroupByStripe(const size_t *ids, size_t id_num, std::vector<size_t> *positions,
+                     std::vector<size_t> *begins) const;
+
+  // Run the task on the ranges of stripes in parallel if the request is large enough.
+  void RunByStripe(size_t id_num, const std::function<void(size_t, size_t)> &task) const;
+
+  float *table_;
+  size_t first_dim_size_;
+  size_t outer_dim_size_;
+  int64_t offset_;
+  mutable std::vector<std::shared_mutex> stripes_;
+};
+using EmbeddingTableStorePtr = std::shared_ptr<EmbeddingTableStore>;
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_EMBEDDING_TABLE_STORE_H_
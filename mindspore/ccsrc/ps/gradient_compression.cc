@@ -0,0 +1,331 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/gradient_compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "base/float16.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+// The gradients with fewer elements are not compressed.
+constexpr size_t kMinCompressionCount = 1024;
+constexpr float kInt8Max = 127.0;
+
+// The header of each encoded gradient, and "nnz" is the element count of the top-k compression.
+struct CompressionHeader {
+  uint32_t type;
+  uint32_t reserved;
+  uint64_t count;
+  uint64_t nnz;
+};
+
+size_t TopKCount(const GradientCompressionConfig &config, size_t count) {
+  auto k = static_cast<size_t>(std::ceil(static_cast<double>(config.topk_ratio) * count));
+  return std::min(std::max(k, static_cast<size_t>(1)), count);
+}
+
+void Append(const void *data, size_t size, std::string *output) {
+  (void)output->append(static_cast<const char *>(data), size);
+}
+
+// The magnitude of the value, and NaN is the largest. The top-k compression sends NaN so that the overflow is detected,
+// and the int8 compression sends zeros for it.
+float Magnitude(float value) { return std::isnan(value) ? std::numeric_limits<float>::infinity() : std::fabs(value); }
+
+// The plain loops below are vectorized by the compiler.
+void EncodeFloat16(float *acc, size_t count, uint16_t *output) {
+  for (size_t i = 0; i < count; i++) {
+    output[i] = Float16(acc[i]).int_value();
+    acc[i] -= static_cast<float>(Float16::FromRaw(output[i]));
+  }
+}
+
+float EncodeInt8(float *acc, size_t count, int8_t *output) {
+  float max_abs = 0;
+  for (size_t i = 0; i < count; i++) {
+    max_abs = std::max(max_abs, Magnitude(acc[i]));
+  }
+  if (max_abs == 0 || !std::isfinite(max_abs)) {
+    (void)std::fill(output, output + count, 0);
+    return 0;
+  }
+  float scale = max_abs / kInt8Max;
+  float inv_scale = kInt8Max / max_abs;
+  for (size_t i = 0; i < count; i++) {
+    float value = std::round(acc[i] * inv_scale);
+    output[i] = static_cast<int8_t>(value);
+    acc[i] -= value * scale;
+  }
+  return scale;
+}
+
+// Select the k elements of the largest magnitude, and clear them in the accumulated gradient.
+void EncodeTopK(float *acc, size_t count, size_t k, uint32_t *indices, float *values) {
+  std::vector<float> magnitudes(count);
+  for (size_t i = 0; i < count; i++) {
+    magnitudes[i] = Magnitude(acc[i]);
+  }
+  auto kth = magnitudes.begin() + static_cast<std::ptrdiff_t>(count - k);
+  std::nth_element(magnitudes.begin(), kth, magnitudes.end());
+  float threshold = *kth;
+  // Take the elements above the threshold first, and then the ones equal to it until k elements are taken.
+  size_t nnz = 0;
+  for (size_t i = 0; i < count && nnz < k; i++) {
+    if (Magnitude(acc[i]) > threshold) {
+      indices[nnz++] = static_cast<uint32_t>(i);
+    }
+  }
+  for (size_t i = 0; i < count && nnz < k; i++) {
+    if (Magnitude(acc[i]) == threshold) {
+      indices[nnz++] = static_cast<uint32_t>(i);
+    }
+  }
+  std::sort(indices, indices + nnz);
+  for (size_t i = 0; i < nnz; i++) {
+    values[i] = acc[indices[i]];
+    acc[indices[i]] = 0;
+  }
+}
+}  // namespace
+
+GradientCompressor &GradientCompressor::GetInstance() {
+  static GradientCompressor instance;
+  return instance;
+}
+
+GradientCompressor::GradientCompressor() {
+  const auto &env = common::GetEnv("MS_DEV_GRADIENT_COMPRESSION");
+  size_t begin = 0;
+  while (begin < env.size()) {
+    size_t end = env.find(',', begin);
+    if (end == std::string::npos) {
+      end = env.size();
+    }
+    std::string item = env.substr(begin, end - begin);
+    begin = end + 1;
+    if (item.empty()) {
+      continue;
+    }
+    auto pos = item.find('=');
+    std::string param_name = pos == std::string::npos ? "" : item.substr(0, pos);
+    GradientCompressionConfig config;
+    if (!ParseConfig(pos == std::string::npos ? item : item.substr(pos + 1), &config)) {
+      MS_LOG(WARNING) << "Invalid gradient compression " << item << " in MS_DEV_GRADIENT_COMPRESSION, it is ignored.";
+      continue;
+    }
+    SetConfig(param_name, config);
+  }
+}
+
+GradientCompressionConfig GradientCompressor::GetConfig(const std::string &param_name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = param_configs_.find(param_name);
+  return iter == param_configs_.end() ? default_config_ : iter->second;
+}
+
+void GradientCompressor::SetConfig(const std::string &param_name, const GradientCompressionConfig &config) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (param_name.empty()) {
+    default_config_ = config;
+  } else {
+    param_configs_[param_name] = config;
+  }
+}
+
+bool GradientCompressor::ParseConfig(const std::string &type, GradientCompressionConfig *config) {
+  MS_EXCEPTION_IF_NULL(config);
+  const std::string kTopKPrefix = "topk:";
+  if (type == "none") {
+    config->type = GradientCompressionType::kNone;
+  } else if (type == "fp16") {
+    config->type = GradientCompressionType::kFloat16;
+  } else if (type == "int8") {
+    config->type = GradientCompressionType::kInt8;
+  } else if (type.compare(0, kTopKPrefix.size(), kTopKPrefix) == 0) {
+    char *end = nullptr;
+    float ratio = std::strtof(type.c_str() + kTopKPrefix.size(), &end);
+    if (end == nullptr || *end != '\0' || !(ratio > 0 && ratio <= 1)) {
+      return false;
+    }
+    config->type = GradientCompressionType::kTopK;
+    config->topk_ratio = ratio;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool GradientCompressor::NeedCompress(const GradientCompressionConfig &config, size_t count) {
+  return config.type != GradientCompressionType::kNone && count >= kMinCompressionCount &&
+         count <= std::numeric_limits<uint32_t>::max();
+}
+
+size_t GradientCompressor::CompressedSize(const GradientCompressionConfig &config, size_t count) {
+  size_t size = sizeof(CompressionHeader);
+  switch (config.type) {
+    case GradientCompressionType::kTopK:
+      return size + TopKCount(config, count) * (sizeof(uint32_t) + sizeof(float));
+    case GradientCompressionType::kInt8:
+      return size + sizeof(float) + count * sizeof(int8_t);
+    case GradientCompressionType::kFloat16:
+      return size + count * sizeof(uint16_t);
+    default:
+      return size + count * sizeof(float);
+  }
+}
+
+void GradientCompressor::Compress(const std::string &name, const GradientCompressionConfig &config, const float *grad,
+                                  size_t count, std::string *output) {
+  MS_EXCEPTION_IF_NULL(grad);
+  MS_EXCEPTION_IF_NULL(output);
+  CompressionHeader header = {static_cast<uint32_t>(config.type), 0, count, count};
+  if (config.type == GradientCompressionType::kNone) {
+    Append(&header, sizeof(header), output);
+    Append(grad, count * sizeof(float), output);
+    return;
+  }
+
+  // Without the name, the gradient is encoded in a temporary buffer and the compression error is dropped.
+  std::vector<float> temp_residual;
+  std::vector<float> *residual = &temp_residual;
+  if (!name.empty()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    residual = &residuals_[name];
+  }
+  if (residual->size() != count) {
+    residual->assign(count, 0);
+  }
+  // Accumulate the gradient into the residual, and the part which is not encoded is left as the new residual.
+  float *acc = residual->data();
+  for (size_t i = 0; i < count; i++) {
+    acc[i] += grad[i];
+  }
+
+  size_t offset = output->size();
+  output->resize(offset + CompressedSize(config, count));
+  char *data = &(*output)[offset] + sizeof(CompressionHeader);
+  switch (config.type) {
+    case GradientCompressionType::kTopK: {
+      header.nnz = TopKCount(config, count);
+      auto indices = reinterpret_cast<uint32_t *>(data);
+      EncodeTopK(acc, count, header.nnz, indices, reinterpret_cast<float *>(indices + header.nnz));
+      break;
+    }
+    case GradientCompressionType::kInt8: {
+      float scale = EncodeInt8(acc, count, reinterpret_cast<int8_t *>(data + sizeof(float)));
+      (void)memcpy(data, &scale, sizeof(float));
+      break;
+    }
+    case GradientCompressionType::kFloat16:
+      EncodeFloat16(acc, count, reinterpret_cast<uint16_t *>(data));
+      break;
+    default:
+      MS_LOG(EXCEPTION) << "Invalid gradient compression type " << static_cast<uint32_t>(config.type);
+  }
+  (void)memcpy(&(*output)[offset], &header, sizeof(header));
+  // The non-finite value, eg. of the overflow gradient or out of the float16 range, would be kept in the residual
+  // forever, so the residual is reset.
+  if (!std::all_of(acc, acc + count, [](float value) { return std::isfinite(value); })) {
+    MS_LOG(INFO) << "The gradient " << name << " is not finite, its residual is reset.";
+    (void)std::fill(residual->begin(), residual->end(), 0);
+  }
+}
+
+size_t GradientCompressor::DecompressAdd(const void *data, size_t size, float *output, size_t count) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(output);
+  CompressionHeader header;
+  if (size < sizeof(header)) {
+    MS_LOG(ERROR) << "The compressed gradient size " << size << " is less than the header size.";
+    return 0;
+  }
+  (void)memcpy(&header, data, sizeof(header));
+  if (header.count != count) {
+    MS_LOG(ERROR) << "The compressed gradient has " << header.count << " elements, but " << count << " are expected.";
+    return 0;
+  }
+  GradientCompressionConfig config;
+  config.type = static_cast<GradientCompressionType>(header.type);
+  size_t encoded_size = CompressedSize(config, count);
+  if (config.type == GradientCompressionType::kTopK) {
+    if (header.nnz > count) {
+      MS_LOG(ERROR) << "The top-k count " << header.nnz << " exceeds the element count " << count;
+      return 0;
+    }
+    encoded_size = sizeof(header) + header.nnz * (sizeof(uint32_t) + sizeof(float));
+  }
+  if (size < encoded_size) {
+    MS_LOG(ERROR) << "The compressed gradient size " << size << " is less than the expected size " << encoded_size;
+    return 0;
+  }
+
+  const char *payload = static_cast<const char *>(data) + sizeof(header);
+  switch (config.type) {
+    case GradientCompressionType::kNone: {
+      auto values = reinterpret_cast<const float *>(payload);
+      for (size_t i = 0; i < count; i++) {
+        output[i] += values[i];
+      }
+      break;
+    }
+    case GradientCompressionType::kTopK: {
+      auto indices = reinterpret_cast<const uint32_t *>(payload);
+      auto values = reinterpret_cast<const float *>(indices + header.nnz);
+      for (size_t i = 0; i < header.nnz; i++) {
+        if (indices[i] >= count) {
+          MS_LOG(ERROR) << "The top-k index " << indices[i] << " exceeds the element count " << count;
+          return 0;
+        }
+        output[indices[i]] += values[i];
+      }
+      break;
+    }
+    case GradientCompressionType::kInt8: {
+      float scale = 0;
+      (void)memcpy(&scale, payload, sizeof(float));
+      auto values = reinterpret_cast<const int8_t *>(payload + sizeof(float));
+      for (size_t i = 0; i < count; i++) {
+        output[i] += values[i] * scale;
+      }
+      break;
+    }
+    case GradientCompressionType::kFloat16: {
+      auto values = reinterpret_cast<const uint16_t *>(payload);
+      for (size_t i = 0; i < count; i++) {
+        output[i] += static_cast<float>(Float16::FromRaw(values[i]));
+      }
+      break;
+    }
+    default:
+      MS_LOG(ERROR) << "Invalid gradient compression type " << header.type;
+      return 0;
+  }
+  return encoded_size;
+}
+
+void GradientCompressor::ClearResiduals() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  residuals_.clear();
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_GRADIENT_COMPRESSION_H_
+#define MINDSPORE_CCSRC_PS_GRADIENT_COMPRESSION_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+// The compression types of the gradients.
+enum class GradientCompressionType : uint32_t { kNone = 0, kTopK, kInt8, kFloat16 };
+
+struct GradientCompressionConfig {
+  GradientCompressionType type{GradientCompressionType::kNone};
+  // The ratio of the elements kept by the top-k compression.
+  float topk_ratio{0.01};
+};
+
+// GradientCompressor compresses the float gradients with error feedback: the compression error of a gradient is kept as
+// its residual and added to the gradient of the next step, so the dropped or rounded part is applied later and the
+// convergence is preserved.
+// The compression is set by the environment variable MS_DEV_GRADIENT_COMPRESSION, which is a comma separated list of
+// "type" for all the parameters and "parameter_name=type" for one parameter. The type is one of "none", "fp16", "int8"
+// and "topk:ratio", eg. "int8,fc1.weight=topk:0.01,fc1.bias=none".
+class GradientCompressor {
+ public:
+  static GradientCompressor &GetInstance();
+
+  // Get the compression config of the parameter, or the default config if the parameter is not set.
+  GradientCompressionConfig GetConfig(const std::string &param_name = "") const;
+
+  // Set the compression config of the parameter, and the empty name sets the default config.
+  void SetConfig(const std::string &param_name, const GradientCompressionConfig &config);
+
+  // Parse the type like "int8" or "topk:0.01" of MS_DEV_GRADIENT_COMPRESSION, return false if it is invalid.
+  static bool ParseConfig(const std::string &type, GradientCompressionConfig *config);
+
+  // Whether the gradient of count elements is compressed with the config. The small gradients and the hyper parameters
+  // pushed with them(eg. the bias and the learning rate) are not compressed.
+  static bool NeedCompress(const GradientCompressionConfig &config, size_t count);
+
+  // The size of the encoded gradient of count elements.
+  static size_t CompressedSize(const GradientCompressionConfig &config, size_t count);
+
+  // Encode the gradient plus the residual of the name and append it to the output, and keep the compression error as
+  // the new residual. The name must be a stable identity of the gradient, eg. the parameter name. The gradient is
+  // encoded without the residual if the name is empty or the type is none. The residual is reset if it is not finite,
+  // eg. after an overflow.
+  void Compress(const std::string &name, const GradientCompressionConfig &config, const float *grad, size_t count,
+                std::string *output);
+
+  // Decode the gradient at the beginning of the data and add it to the output of count elements. Return the size of
+  // the encoded gradient, or 0 if the data is invalid.
+  static size_t DecompressAdd(const void *data, size_t size, float *output, size_t count);
+
+  // Clear the residuals, eg. after the weights are reloaded.
+  void ClearResiduals();
+
+ private:
+  GradientCompressor();
+  ~GradientCompressor() = default;
+  GradientCompressor(const GradientCompressor &) = delete;
+  GradientCompressor &operator=(const GradientCompressor &) = delete;
+
+  mutable std::mutex mutex_;
+  GradientCompressionConfig default_config_;
+  std::map<std::string, GradientCompressionConfig> param_configs_;
+
+  // The residuals of the gradients, which are accumulated with the gradients in place when compressing.
+  std::map<std::string, std::vector<float>> residuals_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_GRADIENT_COMPRESSION_H_
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/kv_buffer.h"
+
+#include <cstring>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+size_t KVBufferSize(const KVBufferHeader &header) {
+  return sizeof(KVBufferHeader) + (header.key_num + header.len_num) * sizeof(uint64_t) +
+         header.value_num * sizeof(float) + header.compressed_size;
+}
+
+KVBufferWriter::KVBufferWriter(const KVBufferHeader &header, void *buffer) : header_(header) {
+  MS_EXCEPTION_IF_NULL(buffer);
+  header_.magic = kKVBufferMagic;
+  (void)memcpy(buffer, &header_, sizeof(KVBufferHeader));
+  keys_ = static_cast<char *>(buffer) + sizeof(KVBufferHeader);
+  lens_ = keys_ + header_.key_num * sizeof(uint64_t);
+  values_ = lens_ + header_.len_num * sizeof(uint64_t);
+  compressed_ = values_ + header_.value_num * sizeof(float);
+}
+
+void KVBufferWriter::AddKey(Key key) {
+  if (key_count_ >= header_.key_num) {
+    MS_LOG(EXCEPTION) << "The key number exceeds " << header_.key_num;
+  }
+  uint64_t value = key;
+  (void)memcpy(keys_ + key_count_ * sizeof(uint64_t), &value, sizeof(uint64_t));
+  key_count_++;
+}
+
+void KVBufferWriter::AddLen(uint64_t len) {
+  if (len_count_ >= header_.len_num) {
+    MS_LOG(EXCEPTION) << "The length number exceeds " << header_.len_num;
+  }
+  (void)memcpy(lens_ + len_count_ * sizeof(uint64_t), &len, sizeof(uint64_t));
+  len_count_++;
+}
+
+void KVBufferWriter::AddValues(const float *values, size_t num) {
+  if (value_count_ + num > header_.value_num) {
+    MS_LOG(EXCEPTION) << "The value number exceeds " << header_.value_num;
+  }
+  if (num != 0) {
+    MS_EXCEPTION_IF_NULL(values);
+    (void)memcpy(values_ + value_count_ * sizeof(float), values, num * sizeof(float));
+  }
+  value_count_ += num;
+}
+
+void KVBufferWriter::AddCompressed(const void *data, size_t size) {
+  if (compressed_count_ + size > header_.compressed_size) {
+    MS_LOG(EXCEPTION) << "The compressed size exceeds " << header_.compressed_size;
+  }
+  if (size != 0) {
+    MS_EXCEPTION_IF_NULL(data);
+    (void)memcpy(compressed_ + compressed_count_, data, size);
+  }
+  compressed_count_ += size;
+}
+
+bool KVBufferReader::Parse(const void *data, size_t size) {
+  if (data == nullptr || size < sizeof(KVBufferHeader)) {
+    return false;
+  }
+  (void)memcpy(&header_, data, sizeof(KVBufferHeader));
+  if (header_.magic != kKVBufferMagic) {
+    return false;
+  }
+  // Check every array against the size first, so that the total size does not overflow.
+  if (header_.key_num > size / sizeof(uint64_t) || header_.len_num > size / sizeof(uint64_t) ||
+      header_.value_num > size / sizeof(float) || header_.compressed_size > size || KVBufferSize(header_) != size) {
+    MS_LOG(ERROR) << "The flat message size " << size << " does not match its header.";
+    return false;
+  }
+  keys_ = static_cast<const char *>(data) + sizeof(KVBufferHeader);
+  lens_ = keys_ + header_.key_num * sizeof(uint64_t);
+  values_ = lens_ + header_.len_num * sizeof(uint64_t);
+  compressed_ = values_ + header_.value_num * sizeof(float);
+  return true;
+}
+
+Key KVBufferReader::key(size_t index) const {
+  if (index >= header_.key_num) {
+    MS_LOG(EXCEPTION) << "The key index " << index << " exceeds the key number " << header_.key_num;
+  }
+  uint64_t value = 0;
+  (void)memcpy(&value, keys_ + index * sizeof(uint64_t), sizeof(uint64_t));
+  return static_cast<Key>(value);
+}
+
+uint64_t KVBufferReader::len(size_t index) const {
+  if (index >= header_.len_num) {
+    MS_LOG(EXCEPTION) << "The length index " << index << " exceeds the length number " << header_.len_num;
+  }
+  uint64_t value = 0;
+  (void)memcpy(&value, lens_ + index * sizeof(uint64_t), sizeof(uint64_t));
+  return value;
+}
+
+void KVBufferReader::GetKeys(Keys *keys) const {
+  MS_EXCEPTION_IF_NULL(keys);
+  keys->resize(key_num());
+  for (size_t i = 0; i < keys->size(); i++) {
+    (*keys)[i] = key(i);
+  }
+}
+
+void KVBufferReader::GetLens(Lengths *lens) const {
+  MS_EXCEPTION_IF_NULL(lens);
+  lens->resize(len_num());
+  for (size_t i = 0; i < lens->size(); i++) {
+    (*lens)[i] = static_cast<int>(len(i));
+  }
+}
+
+void KVBufferReader::GetValues(Values *values) const {
+  MS_EXCEPTION_IF_NULL(values);
+  size_t offset = values->size();
+  values->resize(offset + value_num());
+  if (value_num() != 0) {
+    (void)memcpy(values->data() + offset, values_, value_num() * sizeof(float));
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_KV_BUFFER_H_
+#define MINDSPORE_CCSRC_PS_KV_BUFFER_H_
+
+#include <cstdint>
+#include <cstddef>
+#include "ps/constants.h"
+
+namespace mindspore {
+namespace ps {
+// The flat binary message of the push and pull between the workers and the servers, which replaces KVMessage on the
+// training path. The message is the header followed by the contiguous arrays of the keys(uint64), the lengths(uint64),
+// the values(float) and the values encoded by the gradient compression(bytes).
+constexpr uint32_t kKVBufferMagic = 0x4642564B;
+
+struct KVBufferHeader {
+  uint32_t magic{kKVBufferMagic};
+  uint32_t reserved{0};
+  uint64_t key_num{0};
+  uint64_t len_num{0};
+  uint64_t value_num{0};
+  uint64_t compressed_size{0};
+};
+
+// The size of the message described by the header.
+size_t KVBufferSize(const KVBufferHeader &header);
+
+// KVBufferWriter fills the message into a buffer allocated by the caller, whose size is KVBufferSize(header). The
+// arrays are filled in order and each array must be filled completely.
+class KVBufferWriter {
+ public:
+  KVBufferWriter(const KVBufferHeader &header, void *buffer);
+  ~KVBufferWriter() = default;
+
+  void AddKey(Key key);
+  void AddLen(uint64_t len);
+  void AddValues(const float *values, size_t num);
+  void AddCompressed(const void *data, size_t size);
+
+ private:
+  KVBufferHeader header_;
+  char *keys_;
+  char *lens_;
+  char *values_;
+  char *compressed_;
+  size_t key_count_{0};
+  size_t len_count_{0};
+  size_t value_count_{0};
+  size_t compressed_count_{0};
+};
+
+// KVBufferReader parses the message in place without copying the arrays. The received data has no alignment
+// guarantee, so the elements are read with memcpy.
+class KVBufferReader {
+ public:
+  KVBufferReader() = default;
+  ~KVBufferReader() = default;
+
+  // Return false if the data is not a complete flat message, eg. a KVMessage serialized by protobuf.
+  bool Parse(const void *data, size_t size);
+
+  size_t key_num() const { return static_cast<size_t>(header_.key_num); }
+  size_t len_num() const { return static_cast<size_t>(header_.len_num); }
+  size_t value_num() const { return static_cast<size_t>(header_.value_num); }
+  size_t compressed_size() const { return static_cast<size_t>(header_.compressed_size); }
+  const char *compressed_data() const { return compressed_; }
+
+  Key key(size_t index) const;
+  uint64_t len(size_t index) const;
+
+  void GetKeys(Keys *keys) const;
+  void GetLens(Lengths *lens) const;
+  // Append the values to the output.
+  void GetValues(Values *values) const;
+
+ private:
+  KVBufferHeader header_;
+  const char *keys_{nullptr};
+  const char *lens_{nullptr};
+  const char *values_{nullptr};
+  const char *compressed_{nullptr};
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_KV_BUFFER_H_
@@ -16,10 +16,13 @@
 
 #include "ps/parameter_server.h"
 #include <algorithm>
+#include <numeric>
 #include <thread>
 #include <set>
 
 #include "utils/file_utils.h"
+#include "ps/gradient_compression.h"
+#include "ps/kv_buffer.h"
 
 namespace mindspore {
 namespace ps {
@@ -225,6 +228,26 @@ void CopyTensorData(void *dest_ptr, size_t tensor_size, const void *src_ptr) {
     }
   }
 }
+
+// Decode the values of a push message encoded by the gradient compression of the worker.
+void DecompressValues(const char *compressed_data, size_t compressed_size, const Lengths &lens, Values *values) {
+  MS_EXCEPTION_IF_NULL(compressed_data);
+  MS_EXCEPTION_IF_NULL(values);
+  size_t total_len = std::accumulate(lens.begin(), lens.end(), static_cast<size_t>(0));
+  values->assign(total_len, 0);
+  size_t value_offset = 0;
+  size_t data_offset = 0;
+  for (const auto &len : lens) {
+    size_t count = IntToSize(len);
+    size_t size = GradientCompressor::DecompressAdd(compressed_data + data_offset, compressed_size - data_offset,
+                                                    values->data() + value_offset, count);
+    if (size == 0) {
+      MS_LOG(EXCEPTION) << "Failed to decode the compressed values of the push message.";
+    }
+    data_offset += size;
+    value_offset += count;
+  }
+}
 }  // namespace
 
 void ParameterServer::PersistKernels(const Key &key,
@@ -373,6 +396,7 @@ void ParameterServer::InitEmbeddingTable(
     }
 
     PersistInitParameters(key, embedding);
+    RegisterEmbeddingStore(key, embedding, lookup);
 
     weights_[key] = embedding;
     MS_LOG(DEBUG) << "The key:" << key << " the embedding:" << *(embedding->MutableData());
@@ -433,6 +457,12 @@ void ParameterServer::UpdateWeights() {
         }
         optimizer->ReInit(shapes);
         optim_info->ComputeMean(shapes, worker_num_, pserver_num_, server_node_->rank_id());
+        // The optimizer updates the embedding table in place, so the lookups of the table wait for it.
+        std::vector<std::unique_lock<std::shared_mutex>> table_locks;
+        auto store = is_embedding_[key] ? embedding_store(key) : nullptr;
+        if (store != nullptr) {
+          table_locks = store->LockAll();
+        }
         optimizer->Execute(inputs, workspaces, outputs);
         optim_info->Reset();
       }
@@ -496,60 +526,16 @@ void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KV
     }
   }
 
-  std::unique_lock<std::mutex> lock(mutex_);
   MS_EXCEPTION_IF_NULL(res);
-  if (weights_.count(key) == 0) {
+  auto store = embedding_store(key);
+  if (store == nullptr) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
     return;
   }
-  if (embedding_lookup_ops_.count(key) == 0) {
-    MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
-    return;
-  }
-  WeightPtr table_ptr = weights_[key];
-  MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
-  MS_EXCEPTION_IF_NULL(table_lookup_op);
-
-  // Update shapes of lookup operator
-  std::vector<std::vector<size_t>> shapes = {};
-  std::vector<size_t> indices_shape = {};
-  indices_shape.emplace_back(lookup_ids.size());
-  shapes.push_back(indices_shape);
-  table_lookup_op->ReInit(shapes);
-
-  const std::vector<size_t> output_shapes = table_lookup_op->output_sizes();
-  std::vector<kernel::AddressPtr> inputs;
-  AddressPtr embedding_table = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(embedding_table);
-  AddressPtr indices = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(indices);
-  inputs.push_back(embedding_table);
-  inputs.push_back(indices);
-  embedding_table->addr = table_ptr->data();
-  embedding_table->size = table_ptr->size() * sizeof(float);
-
-  std::unique_ptr<int[]> tmp_ids = std::make_unique<int[]>(lookup_ids.size());
-  MS_EXCEPTION_IF_NULL(tmp_ids);
-  for (size_t i = 0; i < lookup_ids.size(); i++) {
-    tmp_ids[i] = static_cast<int>(lookup_ids[i]);
-  }
-  indices->addr = tmp_ids.get();
-  indices->size = lookup_ids.size() * sizeof(int);
-
-  std::vector<kernel::AddressPtr> workspaces;
-  std::vector<kernel::AddressPtr> outputs;
-  AddressPtr output = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(output);
-  std::shared_ptr<Values> addr = std::make_shared<Values>(output_shapes[0] / sizeof(float), 0);
-  MS_EXCEPTION_IF_NULL(addr);
-
-  output->addr = addr->data();
-  output->size = output_shapes[0];
-  outputs.push_back(output);
-
-  table_lookup_op->Execute(inputs, workspaces, outputs);
-  *res->mutable_values() = {addr->begin(), addr->end()};
+  // The rows are copied into the response directly, and the rows of other shards are zero.
+  auto values = res->mutable_values();
+  values->Resize(SizeToInt(lookup_ids.size() * store->outer_dim_size()), 0);
+  store->Lookup(lookup_ids.data(), lookup_ids.size(), values->mutable_data());
   res->add_len(res->values_size());
 }
 
@@ -560,25 +546,174 @@ void ParameterServer::UpdateEmbeddings(const Key &key, const LookupIds &lookup_i
     }
   }
 
-  std::unique_lock<std::mutex> locker(access_weight_mutex_);
-
-  if (weights_.count(key) == 0) {
+  auto store = embedding_store(key);
+  if (store == nullptr) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
     return;
   }
+  if (vals.size() < lookup_ids.size() * store->outer_dim_size()) {
+    MS_LOG(EXCEPTION) << "The update value size " << vals.size() << " is less than the size of " << lookup_ids.size()
+                      << " rows.";
+  }
+  if (!store->Update(lookup_ids.data(), lookup_ids.size(), vals.data())) {
+    MS_LOG(EXCEPTION) << "UpdateEmbeddings index invalid.";
+  }
+
+  std::unique_lock<std::mutex> locker(access_weight_mutex_);
   if (embedding_lookup_ops_.count(key) == 0) {
     MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
     return;
   }
-  WeightPtr table_ptr = weights_[key];
-  MS_EXCEPTION_IF_NULL(table_ptr);
   std::shared_ptr<PServerKernel> lookup_op = embedding_lookup_ops_[key];
   MS_EXCEPTION_IF_NULL(lookup_op);
-  lookup_op->UpdateEmbeddings(table_ptr->data(), lookup_ids.data(), vals.data(), lookup_ids.size());
-
   UpdateDirtyInfo(key, lookup_ids, lookup_op->offset());
 }
 
+EmbeddingTableStorePtr ParameterServer::embedding_store(const Key &key) {
+  std::unique_lock<std::mutex> lock(embedding_stores_mutex_);
+  auto iter = embedding_stores_.find(key);
+  return iter == embedding_stores_.end() ? nullptr : iter->second;
+}
+
+void ParameterServer::RegisterEmbeddingStore(const Key &key, const WeightPtr &weight,
+                                             const std::shared_ptr<PServerKernel> &lookup) {
+  MS_EXCEPTION_IF_NULL(weight);
+  MS_EXCEPTION_IF_NULL(lookup);
+  auto store = EmbeddingTableStore::Create(weight->data(), lookup->input_sizes(), lookup->offset());
+  std::unique_lock<std::mutex> lock(embedding_stores_mutex_);
+  embedding_stores_[key] = store;
+}
+
+std::shared_ptr<ParameterServer::DynamicEmbedding> ParameterServer::dynamic_embedding(const Key &key) {
+  std::unique_lock<std::mutex> lock(dynamic_embeddings_mutex_);
+  auto iter = dynamic_embeddings_.find(key);
+  return iter == dynamic_embeddings_.end() ? nullptr : iter->second;
+}
+
+void ParameterServer::InitDynamicEmbeddingTable(const DynamicEmbeddingTableMeta &meta) {
+  const Key &key = meta.key();
+  if (dynamic_embedding(key) != nullptr) {
+    return;
+  }
+  InitWeightKeyToOptims(key, meta.optim_id());
+  if (weight_key_to_optims_.count(key) == 0) {
+    MS_LOG(EXCEPTION) << "The optimizer id " << meta.optim_id() << " of the dynamic embedding table " << key
+                      << " is invalid.";
+  }
+  const std::string &optim_name = weight_key_to_optims_[key];
+  const CNodePtr cnode = GetCNode(weight_key_to_optim_op_[key]);
+  MS_EXCEPTION_IF_NULL(cnode);
+
+  DynamicEmbeddingTableConfig config;
+  config.embedding_dim = meta.embedding_dim();
+  config.capacity = meta.capacity();
+  config.admission_threshold = std::max(meta.admission_threshold(), static_cast<uint32_t>(1));
+  config.ttl_steps = meta.ttl_steps();
+  config.init_stddev = kStdDev;
+  config.seed = meta.seed();
+  config.spill_dir = common::GetEnv(kEnvDynamicEmbeddingSpillDir);
+
+  // The kernel is created as of the only server and worker, so it neither shards the state arrays of the table on this
+  // server nor scales the workspaces by the workers, and the table passes at most capacity unique indices to it.
+  auto state_shape = std::make_shared<std::vector<size_t>>(std::vector<size_t>{config.capacity, config.embedding_dim});
+  auto scalar_shape = std::make_shared<std::vector<size_t>>(std::vector<size_t>{1});
+  auto grad_shape = std::make_shared<std::vector<size_t>>(std::vector<size_t>{config.capacity, config.embedding_dim});
+  auto indices_shape = std::make_shared<std::vector<size_t>>(std::vector<size_t>{config.capacity});
+  auto shapes = std::make_shared<std::vector<std::shared_ptr<std::vector<size_t>>>>();
+  std::shared_ptr<PServerKernel> optimizer = nullptr;
+  size_t hyper_param_num = 0;
+  if (optim_name == kSparseAdam) {
+    optimizer = std::make_shared<kernel::ps::SparseApplyAdamPSKernelMod>(0, 1, 1);
+    hyper_param_num = kSparseAdamHyperParamNum;
+  } else if (optim_name == kSparseLazyAdam) {
+    optimizer = std::make_shared<kernel::ps::SparseApplyLazyAdamPSKernelMod>(0, 1, 1);
+    hyper_param_num = kSparseAdamHyperParamNum;
+  } else if (optim_name == kSparseFtrl) {
+    optimizer = std::make_shared<kernel::ps::SparseApplyFtrlPSKernelMod>(0, 1, 1);
+  } else {
+    MS_LOG(EXCEPTION) << "The optimizer " << optim_name << " of the dynamic embedding table " << key
+                      << " is not a sparse optimizer.";
+  }
+  // The states of Adam are var, m and v, and the ones of FTRL are var, accum and linear.
+  config.state_num = kDynamicEmbeddingStateNum;
+  shapes->assign(config.state_num, state_shape);
+  (void)shapes->insert(shapes->end(), hyper_param_num, scalar_shape);
+  shapes->push_back(grad_shape);
+  shapes->push_back(indices_shape);
+  optimizer->InitKernel(cnode, shapes);
+  if (optim_name == kSparseFtrl) {
+    auto ftrl = std::dynamic_pointer_cast<kernel::ps::SparseApplyFtrlPSKernelMod>(optimizer);
+    MS_EXCEPTION_IF_NULL(ftrl);
+    config.initial_values = {0, ftrl->init_accum(), 0};
+  }
+
+  auto embedding = std::make_shared<DynamicEmbedding>();
+  embedding->table = std::make_shared<DynamicEmbeddingTable>(config);
+  embedding->optimizer = optimizer;
+  embedding->hyper_param_num = hyper_param_num;
+  for (const auto &workspace_size : optimizer->workspace_sizes()) {
+    auto &data = embedding->workspace_data.emplace_back(workspace_size);
+    (void)embedding->workspaces.emplace_back(std::make_shared<kernel::Address>(data.data(), data.size()));
+  }
+  std::unique_lock<std::mutex> lock(dynamic_embeddings_mutex_);
+  (void)dynamic_embeddings_.emplace(key, embedding);
+  MS_LOG(INFO) << "Initialize the dynamic embedding table " << key << " with the optimizer " << optim_name
+               << ", embedding dim " << config.embedding_dim << ", capacity " << config.capacity;
+}
+
+void ParameterServer::DoDynamicEmbeddingLookup(const Key &key, const std::vector<Key> &ids, KVMessage *res) {
+  MS_EXCEPTION_IF_NULL(res);
+  auto embedding = dynamic_embedding(key);
+  if (embedding == nullptr) {
+    MS_LOG(ERROR) << "Invalid dynamic embedding table key " << key;
+    return;
+  }
+  const auto &table = embedding->table;
+  auto values = res->mutable_values();
+  values->Resize(SizeToInt(ids.size() * table->embedding_dim()), 0);
+  table->Lookup(ids.data(), ids.size(), values->mutable_data());
+  res->add_len(res->values_size());
+}
+
+void ParameterServer::PushDynamicEmbeddings(const Key &key, const std::vector<Key> &ids, const Values &values,
+                                            const Lengths &lens) {
+  auto embedding = dynamic_embedding(key);
+  if (embedding == nullptr) {
+    MS_LOG(ERROR) << "Invalid dynamic embedding table key " << key;
+    return;
+  }
+  const auto &table = embedding->table;
+  if (lens.size() != embedding->hyper_param_num + 1) {
+    MS_LOG(EXCEPTION) << "The push of the dynamic embedding table " << key << " has " << lens.size()
+                      << " values, but the optimizer needs " << embedding->hyper_param_num
+                      << " hyper parameters and the gradients.";
+  }
+  std::vector<AddressPtr> hyper_params;
+  size_t offset = 0;
+  for (size_t i = 0; i < embedding->hyper_param_num; i++) {
+    size_t len = IntToSize(lens[i]);
+    float *addr = const_cast<float *>(values.data()) + offset;
+    (void)hyper_params.emplace_back(std::make_shared<kernel::Address>(addr, len * sizeof(float)));
+    offset += len;
+  }
+  size_t grad_size = IntToSize(lens.back());
+  if (offset + grad_size != values.size() || grad_size != ids.size() * table->embedding_dim()) {
+    MS_LOG(EXCEPTION) << "The gradient size " << grad_size << " of the dynamic embedding table " << key
+                      << " is not equal to the size of " << ids.size() << " rows, or the values size "
+                      << values.size() << " is invalid.";
+  }
+
+  auto run_optimizer = [&embedding](const std::vector<AddressPtr> &inputs) {
+    return embedding->optimizer->Execute(inputs, embedding->workspaces, {});
+  };
+  if (!table->ApplyGradients(ids.data(), values.data() + offset, ids.size(), hyper_params, run_optimizer)) {
+    MS_LOG(ERROR) << "Failed to apply the gradients of the dynamic embedding table " << key;
+  }
+  if (worker_num_ != 0 && ++embedding->push_count % worker_num_ == 0) {
+    table->EndStep();
+  }
+}
+
 void ParameterServer::UpdateDirtyInfo(const Key &key, const LookupIds &lookup_ids, int64_t offset) {
   if (EnableRecovery()) {
     std::set<int> sorted_ids;
@@ -766,7 +901,9 @@ void ParameterServer::RecoverParameters(const std::vector<Key> &keys) {
       config_map[distributed::storage::kFileStoragePath] = real_storage_file_path;
       embedding->Initialize(config_map);
       embedding->Restore();
+      RegisterEmbeddingStore(key, embedding, lookup);
       weights_[key] = embedding;
+      is_embedding_[key] = true;
       (void)weights_dirty_info_.emplace(key, distributed::storage::DirtyInfo());
     }
   }
@@ -808,25 +945,39 @@ void ParameterServer::PersistParameters() {
   }
 
   auto do_persist_task = [this]() {
-    std::unique_lock<std::mutex> locker(access_weight_mutex_);
-
     set_persistent_state(core::PersistentState::PERSISTING);
 
-    for (const auto &weight_key_pair : weights_) {
-      const WeightPtr &weight = weight_key_pair.second;
-      auto persistent_weight = std::dynamic_pointer_cast<PersistentWeight>(weight);
-      MS_EXCEPTION_IF_NULL(persistent_weight);
-
-      Key key = weight_key_pair.first;
-      auto iter = weights_dirty_info_.find(key);
-      if (iter == weights_dirty_info_.end()) {
-        MS_LOG(EXCEPTION) << "Cannot find dirty info for weight, key: " << key;
-      }
+    // Only the dirty blocks are copied to the snapshots while the weights are locked, and the snapshots are written to
+    // files after the locks are released, so the server keeps serving during the file writing.
+    std::vector<PersistentWeightPtr> snapshot_weights;
+    {
+      std::unique_lock<std::mutex> locker(access_weight_mutex_);
+      for (const auto &weight_key_pair : weights_) {
+        const WeightPtr &weight = weight_key_pair.second;
+        auto persistent_weight = std::dynamic_pointer_cast<PersistentWeight>(weight);
+        MS_EXCEPTION_IF_NULL(persistent_weight);
+
+        Key key = weight_key_pair.first;
+        auto iter = weights_dirty_info_.find(key);
+        if (iter == weights_dirty_info_.end()) {
+          MS_LOG(EXCEPTION) << "Cannot find dirty info for weight, key: " << key;
+        }
 
-      distributed::storage::DirtyInfo &dirty_info = iter->second;
-      persistent_weight->Persist(dirty_info);
+        // The embedding table is not updated while it is copied.
+        std::vector<std::unique_lock<std::shared_mutex>> table_locks;
+        auto store = embedding_store(key);
+        if (store != nullptr) {
+          table_locks = store->LockAll();
+        }
+        distributed::storage::DirtyInfo &dirty_info = iter->second;
+        persistent_weight->Snapshot(dirty_info);
+        snapshot_weights.push_back(persistent_weight);
 
-      dirty_info.clear();
+        dirty_info.clear();
+      }
+    }
+    for (const auto &persistent_weight : snapshot_weights) {
+      persistent_weight->PersistSnapshot();
     }
 
     set_persistent_state(core::PersistentState::FINISH_PERSIST);
@@ -879,6 +1030,9 @@ void ParameterServer::ServerHandler::Init() {
   handlers_[kFinalizeCmd] = &ServerHandler::HandleFinalize;
   handlers_[kPushCmd] = &ServerHandler::HandlePushReq;
   handlers_[kPullCmd] = &ServerHandler::HandlePullReq;
+  handlers_[kInitDynamicEmbeddingsCmd] = &ServerHandler::HandleInitDynamicEmbeddings;
+  handlers_[kDynamicEmbeddingLookupCmd] = &ServerHandler::HandleDynamicEmbeddingLookup;
+  handlers_[kPushDynamicEmbeddingsCmd] = &ServerHandler::HandlePushDynamicEmbeddings;
   commands_[kInitWeightsCmd] = "kInitWeightsCmd";
   commands_[kInitWeightToOptimIdCmd] = "kInitWeightToOptimIdCmd";
   commands_[kInitOptimInputsShapeCmd] = "kInitOptimInputsShapeCmd";
@@ -890,6 +1044,9 @@ void ParameterServer::ServerHandler::Init() {
   commands_[kFinalizeCmd] = "kFinalizeCmd";
   commands_[kPushCmd] = "kPushCmd";
   commands_[kPullCmd] = "kPullCmd";
+  commands_[kInitDynamicEmbeddingsCmd] = "kInitDynamicEmbeddingsCmd";
+  commands_[kDynamicEmbeddingLookupCmd] = "kDynamicEmbeddingLookupCmd";
+  commands_[kPushDynamicEmbeddingsCmd] = "kPushDynamicEmbeddingsCmd";
 }
 
 void ParameterServer::ServerHandler::operator()(const std::shared_ptr<core::TcpConnection> &conn,
@@ -923,11 +1080,26 @@ void ParameterServer::ServerHandler::operator()(const std::shared_ptr<core::TcpC
 void ParameterServer::ServerHandler::HandlePushReq(const void *data, size_t size, const VectorPtr &res) {
   MS_EXCEPTION_IF_NULL(data);
   MS_EXCEPTION_IF_NULL(res);
-  KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
-  Keys keys = {input.keys().begin(), input.keys().end()};
-  Values values = {input.values().begin(), input.values().end()};
-  Lengths lens = {input.len().begin(), input.len().end()};
+  Keys keys;
+  Values values;
+  Lengths lens;
+  // The dense gradients are pushed in the flat message, and the sparse gradients of embedding tables in KVMessage.
+  KVBufferReader reader;
+  if (reader.Parse(data, size)) {
+    reader.GetKeys(&keys);
+    reader.GetLens(&lens);
+    if (reader.compressed_size() != 0) {
+      DecompressValues(reader.compressed_data(), reader.compressed_size(), lens, &values);
+    } else {
+      reader.GetValues(&values);
+    }
+  } else {
+    KVMessage input;
+    CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
+    keys = {input.keys().begin(), input.keys().end()};
+    values = {input.values().begin(), input.values().end()};
+    lens = {input.len().begin(), input.len().end()};
+  }
   MS_LOG(DEBUG) << "The keys:" << keys << " the values:" << values << " the len:" << lens;
   ps_->AccumGrad(keys, values, lens);
 }
@@ -935,6 +1107,26 @@ void ParameterServer::ServerHandler::HandlePushReq(const void *data, size_t size
 void ParameterServer::ServerHandler::HandlePullReq(const void *data, size_t size, const VectorPtr &res) {
   MS_EXCEPTION_IF_NULL(data);
   MS_EXCEPTION_IF_NULL(res);
+  KVBufferReader reader;
+  if (reader.Parse(data, size)) {
+    if (reader.key_num() == 0) {
+      MS_LOG(EXCEPTION) << "The pull request has no key.";
+    }
+    auto weight = ps_->weight(reader.key(0));
+    MS_EXCEPTION_IF_NULL(weight);
+    auto weight_data = weight->MutableData();
+    MS_EXCEPTION_IF_NULL(weight_data);
+    KVBufferHeader header;
+    header.key_num = reader.key_num();
+    header.value_num = weight_data->size();
+    res->resize(KVBufferSize(header));
+    KVBufferWriter writer(header, res->data());
+    for (size_t i = 0; i < reader.key_num(); i++) {
+      writer.AddKey(reader.key(i));
+    }
+    writer.AddValues(weight_data->data(), weight_data->size());
+    return;
+  }
   KVMessage input;
   CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
   KVMessage res_data;
@@ -1107,17 +1299,14 @@ void ParameterServer::ServerHandler::HandleEmbeddingLookup(const void *data, siz
 
   ps_->DoEmbeddingLookup(key, keys, &res_data);
 
+  // Serialize into the response directly, since the rows of a large batch are large.
   res->resize(res_data.ByteSizeLong());
-  size_t dest_size = res_data.ByteSizeLong();
-  size_t src_size = res_data.ByteSizeLong();
-  int ret = memcpy_s(res->data(), dest_size, res_data.SerializeAsString().data(), src_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+  if (!res_data.SerializeToArray(res->data(), SizeToInt(res->size()))) {
+    MS_LOG(EXCEPTION) << "Failed to serialize the embedding lookup result.";
   }
 }
 
 void ParameterServer::ServerHandler::HandleUpdateEmbeddings(const void *data, size_t size, const VectorPtr &res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(data);
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
@@ -1128,6 +1317,52 @@ void ParameterServer::ServerHandler::HandleUpdateEmbeddings(const void *data, si
   ps_->UpdateEmbeddings(key, lookup_ids, update_vals);
 }
 
+void ParameterServer::ServerHandler::HandleInitDynamicEmbeddings(const void *data, size_t size, const VectorPtr &) {
+  std::unique_lock<std::mutex> lock(ps_->mutex());
+  MS_EXCEPTION_IF_NULL(data);
+  DynamicEmbeddingTableMeta meta;
+  CHECK_RETURN_TYPE(meta.ParseFromArray(data, SizeToInt(size)));
+  MS_LOG(INFO) << "Initializing dynamic embedding table for key:" << meta.key();
+  ps_->InitDynamicEmbeddingTable(meta);
+}
+
+void ParameterServer::ServerHandler::HandleDynamicEmbeddingLookup(const void *data, size_t size,
+                                                                  const VectorPtr &res) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(res);
+  KVMessage input;
+  CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
+  if (input.keys_size() == 0) {
+    MS_LOG(EXCEPTION) << "The dynamic embedding lookup request has no key.";
+  }
+  // The first key is the table, and the others are the ids.
+  const Key &key = input.keys()[0];
+  std::vector<Key> ids = {input.keys().begin() + 1, input.keys().end()};
+  KVMessage res_data;
+  *res_data.mutable_keys() = {ids.begin(), ids.end()};
+  ps_->DoDynamicEmbeddingLookup(key, ids, &res_data);
+
+  res->resize(res_data.ByteSizeLong());
+  if (!res_data.SerializeToArray(res->data(), SizeToInt(res->size()))) {
+    MS_LOG(EXCEPTION) << "Failed to serialize the dynamic embedding lookup result.";
+  }
+}
+
+void ParameterServer::ServerHandler::HandlePushDynamicEmbeddings(const void *data, size_t size, const VectorPtr &res) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(res);
+  KVMessage input;
+  CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
+  if (input.keys_size() == 0) {
+    MS_LOG(EXCEPTION) << "The dynamic embedding push request has no key.";
+  }
+  const Key &key = input.keys()[0];
+  std::vector<Key> ids = {input.keys().begin() + 1, input.keys().end()};
+  const Values &values = {input.values().begin(), input.values().end()};
+  const Lengths &lens = {input.len().begin(), input.len().end()};
+  ps_->PushDynamicEmbeddings(key, ids, values, lens);
+}
+
 void ParameterServer::ServerHandler::HandleFinalize(const void *, size_t, const VectorPtr &res) {
   MS_EXCEPTION_IF_NULL(res);
   ps_->Finalize();
@@ -25,6 +25,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <thread>
+#include <atomic>
 #include <cmath>
 #include <random>
 #include <utility>
@@ -59,6 +60,8 @@
 #include "ps/constants.h"
 #include "ps/util.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/embedding_table_store.h"
+#include "ps/dynamic_embedding_table.h"
 #include "utils/log_adapter.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
@@ -109,6 +112,9 @@ class ParameterServer {
     void HandleCheckReadyForPull(const void *data, size_t size, const VectorPtr &res);
     void HandleEmbeddingLookup(const void *data, size_t size, const VectorPtr &res);
     void HandleUpdateEmbeddings(const void *data, size_t size, const VectorPtr &res);
+    void HandleInitDynamicEmbeddings(const void *data, size_t size, const VectorPtr &res);
+    void HandleDynamicEmbeddingLookup(const void *data, size_t size, const VectorPtr &res);
+    void HandlePushDynamicEmbeddings(const void *data, size_t size, const VectorPtr &res);
     void HandleFinalize(const void *data, size_t size, const VectorPtr &res);
 
    private:
@@ -146,6 +152,18 @@ class ParameterServer {
     std::unique_ptr<core::FileConfiguration> storage_{nullptr};
   };
 
+  // The dynamic embedding table and the sparse optimizer kernel which updates its rows.
+  struct DynamicEmbedding {
+    DynamicEmbeddingTablePtr table;
+    std::shared_ptr<PServerKernel> optimizer;
+    size_t hyper_param_num{0};
+    // The workspaces of the optimizer for capacity indices, which are shared by the pushes since the table runs the
+    // optimizer one at a time.
+    std::vector<std::vector<unsigned char>> workspace_data;
+    std::vector<AddressPtr> workspaces;
+    std::atomic<size_t> push_count{0};
+  };
+
   bool Init(const FuncGraphPtr &func_graph);
   void InitOptimInfoBuilders();
   void InitWeightKeyToOptims(const Key &key, const int64_t &optim_id);
@@ -162,6 +180,18 @@ class ParameterServer {
   WeightPtr weight(const Key &key);
   void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KVMessage *res);
   void UpdateEmbeddings(const Key &key, const LookupIds &lookup_ids, const Values &vals);
+  // Get the store of the embedding table, or nullptr if the key is not an embedding table.
+  EmbeddingTableStorePtr embedding_store(const Key &key);
+  // Register the store of the embedding table weight, whose shape and offset are of the lookup kernel.
+  void RegisterEmbeddingStore(const Key &key, const WeightPtr &weight, const std::shared_ptr<PServerKernel> &lookup);
+  // Create the dynamic embedding table of the meta, whose rows are updated by the sparse optimizer of the optim id.
+  void InitDynamicEmbeddingTable(const DynamicEmbeddingTableMeta &meta);
+  // Get the dynamic embedding table, or nullptr if the key is not a dynamic embedding table.
+  std::shared_ptr<DynamicEmbedding> dynamic_embedding(const Key &key);
+  void DoDynamicEmbeddingLookup(const Key &key, const std::vector<Key> &ids, KVMessage *res);
+  // Apply the gradients of the ids pushed by a worker, and the values are the hyper parameters of the optimizer
+  // followed by the gradients. A step of the table is finished after every worker pushes once.
+  void PushDynamicEmbeddings(const Key &key, const std::vector<Key> &ids, const Values &values, const Lengths &lens);
   inline bool ReadyForUpdateWeights() const;
   inline bool ReadyForPush(const Key &key);
   inline bool ReadyForPull(const Key &key);
@@ -231,6 +261,11 @@ class ParameterServer {
   mindspore::HashMap<Key, GradPtr> grads_;
   mindspore::HashMap<Key, size_t> grads_accum_counter_;
   mindspore::HashMap<Key, std::shared_ptr<PServerKernel>> embedding_lookup_ops_;
+  // The embedding tables are looked up and updated through the stores without the server lock.
+  mindspore::HashMap<Key, EmbeddingTableStorePtr> embedding_stores_;
+  std::mutex embedding_stores_mutex_;
+  mindspore::HashMap<Key, std::shared_ptr<DynamicEmbedding>> dynamic_embeddings_;
+  std::mutex dynamic_embeddings_mutex_;
   mindspore::HashMap<Key, uint64_t> tokens_;
 
   std::mutex mutex_;
@@ -16,8 +16,30 @@
 
 #include "ps/ps_cache/embedding_hash_map.h"
 
+#include <string>
+#include "utils/ms_utils.h"
+
 namespace mindspore {
 namespace ps {
+namespace {
+// The number of the positions checked to choose the element to swap out by the LRU or LFU policy.
+constexpr size_t kEvictionSampleNum = 8;
+}  // namespace
+
+EvictionPolicy GetEvictionPolicyFromEnv() {
+  const std::string &policy = common::GetEnv("MS_DEV_EMBEDDING_CACHE_EVICTION");
+  if (policy == "lru") {
+    return EvictionPolicy::kLRU;
+  }
+  if (policy == "lfu") {
+    return EvictionPolicy::kLFU;
+  }
+  if (!policy.empty()) {
+    MS_LOG(WARNING) << "Invalid embedding cache eviction policy " << policy << ", it should be lru or lfu.";
+  }
+  return EvictionPolicy::kStep;
+}
+
 int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *const swap_out_ids,
                                 const size_t data_step, const size_t graph_running_step, size_t *const swap_out_size,
                                 bool *const need_wait_graph) {
@@ -32,19 +54,21 @@ int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *co
 
   if (!need_swap) {
     hash_count_++;
-    (void)hash_id_to_index_.emplace(id, hash_index);
+    (void)hash_id_to_index_.Insert(id, hash_index);
     hash_map_elements_[hash_index].set_id(id);
     hash_map_elements_[hash_index].set_step(data_step);
+    hash_map_elements_[hash_index].set_frequency(1);
     return hash_index;
   }
 
   swap_out_index[*swap_out_size] = hash_index;
   swap_out_ids[*swap_out_size] = hash_map_elements_[hash_index].id_;
   (*swap_out_size)++;
-  (void)hash_id_to_index_.erase(hash_map_elements_[hash_index].id_);
-  (void)hash_id_to_index_.emplace(id, hash_index);
+  (void)hash_id_to_index_.Erase(hash_map_elements_[hash_index].id_);
+  (void)hash_id_to_index_.Insert(id, hash_index);
   hash_map_elements_[hash_index].set_id(id);
   hash_map_elements_[hash_index].set_step(data_step);
+  hash_map_elements_[hash_index].set_frequency(1);
   return hash_index;
 }
 
@@ -60,6 +84,13 @@ int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_
     } else if (hash_map_elements_[current_pos_].IsExpired(graph_running_step)) {
       hash_index = current_pos_;
       *need_swap = true;
+      if (eviction_policy_ != EvictionPolicy::kStep) {
+        size_t pos = SampleEvictionPos(graph_running_step);
+        if (pos != current_pos_) {
+          // The expired element at current_pos_ is left for the next insertion.
+          return SizeToInt(pos);
+        }
+      }
     } else if (hash_map_elements_[current_pos_].IsStep(graph_running_step)) {
       graph_running_index_[graph_running_index_num_++] = current_pos_;
     }
@@ -82,12 +113,32 @@ int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_
   return INVALID_INDEX_VALUE;
 }
 
+size_t EmbeddingHashMap::SampleEvictionPos(const size_t graph_running_step) const {
+  size_t best_pos = current_pos_;
+  size_t pos = current_pos_;
+  for (size_t i = 1; i < kEvictionSampleNum; i++) {
+    pos = (pos + 1) % hash_capacity_;
+    if (pos == current_batch_start_pos_) {
+      break;
+    }
+    const auto &element = hash_map_elements_[pos];
+    if (element.IsEmpty() || !element.IsExpired(graph_running_step)) {
+      continue;
+    }
+    const auto &best_element = hash_map_elements_[best_pos];
+    bool better = eviction_policy_ == EvictionPolicy::kLRU ? element.step_ < best_element.step_
+                                                           : element.frequency_ < best_element.frequency_;
+    if (better) {
+      best_pos = pos;
+    }
+  }
+  return best_pos;
+}
+
 void EmbeddingHashMap::DumpHashMap() {
   MS_LOG(INFO) << "Dump hash map info begin, hash_capacity: " << hash_capacity_ << " hash_count: " << hash_count_;
   MS_LOG(INFO) << "Dump hash_id_to_index: ";
-  for (auto iter = hash_id_to_index_.begin(); iter != hash_id_to_index_.end(); ++iter) {
-    MS_LOG(INFO) << "  id: " << iter->first << " index: " << iter->second;
-  }
+  hash_id_to_index_.ForEach([](int id, int index) { MS_LOG(INFO) << "  id: " << id << " index: " << index; });
   MS_LOG(INFO) << "Dump hash_map_unit: ";
   for (size_t i = 0; i < hash_map_elements_.size(); i++) {
     if (!hash_map_elements_[i].IsEmpty()) {
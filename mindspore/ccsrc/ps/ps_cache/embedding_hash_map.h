@@ -21,22 +21,31 @@
 #include <utility>
 #include <memory>
 #include <vector>
-#include "utils/hash_map.h"
 #include "utils/convert_utils_base.h"
+#include "ps/ps_cache/embedding_id_map.h"
 
 namespace mindspore {
 namespace ps {
 static const size_t INVALID_STEP_VALUE = 0;
 static const int INVALID_INDEX_VALUE = -1;
 
+// The policy to choose the expired element to swap out. kStep takes the first expired element in the order of the
+// positions, kLRU and kLFU take the least recently used and the least frequently used one of several sampled expired
+// elements. It is set by the environment variable MS_DEV_EMBEDDING_CACHE_EVICTION, which is "lru" or "lfu".
+enum class EvictionPolicy { kStep = 0, kLRU, kLFU };
+EvictionPolicy GetEvictionPolicyFromEnv();
+
 struct HashMapElement {
   int id_{INVALID_INDEX_VALUE};
   size_t step_{INVALID_STEP_VALUE};
+  // The number of the steps in which the element is used.
+  size_t frequency_{0};
   bool IsEmpty() const { return step_ == INVALID_STEP_VALUE; }
   bool IsExpired(size_t graph_running_step) const { return graph_running_step > step_; }
   bool IsStep(size_t step) const { return step_ == step; }
   void set_id(int id) { id_ = id; }
   void set_step(size_t step) { step_ = step; }
+  void set_frequency(size_t frequency) { frequency_ = frequency; }
 };
 
 // Hash table is held in device, HashMap is used to manage hash table in host.
@@ -45,11 +54,13 @@ class EmbeddingHashMap {
   EmbeddingHashMap(size_t hash_count, size_t hash_capacity)
       : hash_count_(hash_count),
         hash_capacity_(hash_capacity),
+        hash_id_to_index_(hash_capacity),
         current_pos_(0),
         current_batch_start_pos_(0),
         graph_running_index_num_(0),
         graph_running_index_pos_(0),
-        expired_element_full_(false) {
+        expired_element_full_(false),
+        eviction_policy_(GetEvictionPolicyFromEnv()) {
     hash_map_elements_.resize(hash_capacity);
     // In multi-device mode, embedding table are distributed on different devices by ID interval,
     // and IDs outside the range of local device will use the front and back positions of the table,
@@ -62,8 +73,15 @@ class EmbeddingHashMap {
   int ParseData(const int id, int *const swap_out_index, int *const swap_out_ids, const size_t data_step,
                 const size_t graph_running_step, size_t *const swap_out_size, bool *const need_wait_graph);
   size_t hash_step(const int hash_index) const { return hash_map_elements_[hash_index].step_; }
-  void set_hash_step(const int hash_index, const size_t step) { hash_map_elements_[hash_index].set_step(step); }
-  const mindspore::HashMap<int, int> &hash_id_to_index() const { return hash_id_to_index_; }
+  // Set the step of the element which is hit, and count the frequency for the LFU eviction.
+  void set_hash_step(const int hash_index, const size_t step) {
+    auto &element = hash_map_elements_[hash_index];
+    element.set_step(step);
+    element.set_frequency(element.frequency_ + 1);
+  }
+  const EmbeddingIdMap &hash_id_to_index() const { return hash_id_to_index_; }
+  EvictionPolicy eviction_policy() const { return eviction_policy_; }
+  void set_eviction_policy(EvictionPolicy policy) { eviction_policy_ = policy; }
   size_t hash_capacity() const { return hash_capacity_; }
   void DumpHashMap();
   void Reset();
@@ -71,16 +89,19 @@ class EmbeddingHashMap {
  private:
   int FindInsertionPos(const size_t data_step, const size_t graph_running_step, bool *const need_swap,
                        bool *const need_wait_graph);
+  // Choose the element to swap out among the expired element at current_pos_ and the following sampled ones.
+  size_t SampleEvictionPos(const size_t graph_running_step) const;
   size_t hash_count_;
   size_t hash_capacity_;
   std::vector<HashMapElement> hash_map_elements_;
-  mindspore::HashMap<int, int> hash_id_to_index_;
+  EmbeddingIdMap hash_id_to_index_;
   size_t current_pos_;
   size_t current_batch_start_pos_;
   size_t graph_running_index_num_;
   size_t graph_running_index_pos_;
   std::unique_ptr<int[]> graph_running_index_;
   bool expired_element_full_;
+  EvictionPolicy eviction_policy_;
 };
 }  // namespace ps
 }  // namespace mindspore
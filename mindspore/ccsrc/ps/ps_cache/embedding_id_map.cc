@@ -0,0 +1,193 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/ps_cache/embedding_id_map.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include <algorithm>
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr size_t kGroupWidth = 16;
+constexpr int8_t kEmpty = -128;
+constexpr int8_t kDeleted = -2;
+constexpr uint64_t kTagMask = 0x7F;
+// The number of the ids whose groups are prefetched together in the batch lookup.
+constexpr size_t kPrefetchBlock = 16;
+
+uint64_t Hash(int id) {
+  uint64_t hash = static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ULL;
+  return hash ^ (hash >> 32);
+}
+
+int8_t Tag(uint64_t hash) { return static_cast<int8_t>(hash & kTagMask); }
+
+// Return the bit mask of the control bytes of the group which equal the value.
+uint32_t Match(const int8_t *group, int8_t value) {
+#if defined(__SSE2__)
+  __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), ctrl)));
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kGroupWidth; i++) {
+    mask |= static_cast<uint32_t>(group[i] == value) << i;
+  }
+  return mask;
+#endif
+}
+
+// Return the bit mask of the empty or deleted control bytes, whose sign bits are set.
+uint32_t MatchEmptyOrDeleted(const int8_t *group) {
+#if defined(__SSE2__)
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(group))));
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kGroupWidth; i++) {
+    mask |= static_cast<uint32_t>(group[i] < 0) << i;
+  }
+  return mask;
+#endif
+}
+
+size_t LowestBit(uint32_t mask) { return static_cast<size_t>(__builtin_ctz(mask)); }
+}  // namespace
+
+EmbeddingIdMap::EmbeddingIdMap(size_t capacity) {
+  // Keep the load factor under 7/8.
+  size_t slot_num = capacity + capacity / 7 + 1;
+  size_t group_num = 1;
+  while (group_num * kGroupWidth < slot_num) {
+    group_num <<= 1;
+  }
+  Rehash(group_num);
+}
+
+int EmbeddingIdMap::Find(int id) const {
+  size_t pos = FindPos(id, Hash(id));
+  return pos == slots_.size() ? -1 : slots_[pos].index;
+}
+
+void EmbeddingIdMap::FindBatch(const int *ids, size_t id_num, int *indices) const {
+  uint64_t hashes[kPrefetchBlock];
+  for (size_t begin = 0; begin < id_num; begin += kPrefetchBlock) {
+    size_t end = std::min(begin + kPrefetchBlock, id_num);
+    for (size_t i = begin; i < end; i++) {
+      hashes[i - begin] = Hash(ids[i]);
+      Prefetch(hashes[i - begin]);
+    }
+    for (size_t i = begin; i < end; i++) {
+      size_t pos = FindPos(ids[i], hashes[i - begin]);
+      indices[i] = pos == slots_.size() ? -1 : slots_[pos].index;
+    }
+  }
+}
+
+bool EmbeddingIdMap::Insert(int id, int index) {
+  uint64_t hash = Hash(id);
+  if (FindPos(id, hash) != slots_.size()) {
+    return false;
+  }
+  // Take the first empty or deleted slot on the probe sequence.
+  size_t group = GroupOf(hash);
+  for (size_t step = 1;; step++) {
+    uint32_t mask = MatchEmptyOrDeleted(&ctrl_[group * kGroupWidth]);
+    if (mask != 0) {
+      size_t pos = group * kGroupWidth + LowestBit(mask);
+      if (ctrl_[pos] == kEmpty) {
+        if (growth_left_ == 0) {
+          // Drop the deleted slots, and double the groups if the map is more than half full.
+          size_t group_num = group_mask_ + 1;
+          Rehash(size_ * 2 > group_num * kGroupWidth * 7 / 8 ? group_num * 2 : group_num);
+          return Insert(id, index);
+        }
+        growth_left_--;
+      }
+      ctrl_[pos] = Tag(hash);
+      slots_[pos] = {id, index};
+      size_++;
+      return true;
+    }
+    group = (group + step) & group_mask_;
+  }
+}
+
+bool EmbeddingIdMap::Erase(int id) {
+  size_t pos = FindPos(id, Hash(id));
+  if (pos == slots_.size()) {
+    return false;
+  }
+  // The lookups stop at a group with an empty slot, so no id is probed past this group if it has an empty slot, and
+  // the slot is set to empty directly.
+  if (Match(&ctrl_[pos / kGroupWidth * kGroupWidth], kEmpty) != 0) {
+    ctrl_[pos] = kEmpty;
+    growth_left_++;
+  } else {
+    ctrl_[pos] = kDeleted;
+  }
+  size_--;
+  return true;
+}
+
+void EmbeddingIdMap::Clear() {
+  (void)std::fill(ctrl_.begin(), ctrl_.end(), kEmpty);
+  size_ = 0;
+  growth_left_ = ctrl_.size() * 7 / 8;
+}
+
+size_t EmbeddingIdMap::FindPos(int id, uint64_t hash) const {
+  int8_t tag = Tag(hash);
+  size_t group = GroupOf(hash);
+  for (size_t step = 1; step <= group_mask_ + 1; step++) {
+    const int8_t *ctrl = &ctrl_[group * kGroupWidth];
+    for (uint32_t mask = Match(ctrl, tag); mask != 0; mask &= mask - 1) {
+      size_t pos = group * kGroupWidth + LowestBit(mask);
+      if (slots_[pos].id == id) {
+        return pos;
+      }
+    }
+    if (Match(ctrl, kEmpty) != 0) {
+      break;
+    }
+    group = (group + step) & group_mask_;
+  }
+  return slots_.size();
+}
+
+void EmbeddingIdMap::Prefetch(uint64_t hash) const {
+  size_t group = GroupOf(hash);
+  __builtin_prefetch(&ctrl_[group * kGroupWidth]);
+  __builtin_prefetch(&slots_[group * kGroupWidth]);
+}
+
+void EmbeddingIdMap::Rehash(size_t group_num) {
+  std::vector<int8_t> old_ctrl(group_num * kGroupWidth, kEmpty);
+  std::vector<Slot> old_slots(group_num * kGroupWidth);
+  old_ctrl.swap(ctrl_);
+  old_slots.swap(slots_);
+  group_mask_ = group_num - 1;
+  size_ = 0;
+  growth_left_ = ctrl_.size() * 7 / 8;
+  for (size_t i = 0; i < old_ctrl.size(); i++) {
+    if (old_ctrl[i] >= 0) {
+      (void)Insert(old_slots[i].id, old_slots[i].index);
+    }
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
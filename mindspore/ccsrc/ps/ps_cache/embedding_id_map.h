@@ -0,0 +1,86 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_ID_MAP_H_
+#define MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_ID_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+// EmbeddingIdMap maps the embedding ids to the cache indices by open addressing in the groups of 16 slots. Each slot
+// has a control byte which is empty, deleted or the 7-bit tag of the hash of its id, and the control bytes of a group
+// are compared with the tag by one SIMD instruction, so a lookup usually reads one group of control bytes and one slot.
+// Insert and Erase are not thread safe, but Find and FindBatch run concurrently while the map is not modified.
+class EmbeddingIdMap {
+ public:
+  // The map keeps up to capacity ids without rehashing.
+  explicit EmbeddingIdMap(size_t capacity = 0);
+  ~EmbeddingIdMap() = default;
+
+  // Return the index of the id, or -1 if the id is not found.
+  int Find(int id) const;
+
+  // Find the indices of a batch of ids, and the groups of the following ids are prefetched during the lookup.
+  void FindBatch(const int *ids, size_t id_num, int *indices) const;
+
+  // Insert the id with the index, return false if the id exists and then the index is not changed.
+  bool Insert(int id, int index);
+
+  // Erase the id, return false if the id is not found.
+  bool Erase(int id);
+
+  void Clear();
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Call the function with the id and the index of each item.
+  template <typename Function>
+  void ForEach(Function &&func) const {
+    for (size_t i = 0; i < ctrl_.size(); i++) {
+      if (ctrl_[i] >= 0) {
+        func(slots_[i].id, slots_[i].index);
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    int id;
+    int index;
+  };
+
+  // Return the position of the id, or the size of the slots if the id is not found.
+  size_t FindPos(int id, uint64_t hash) const;
+  void Prefetch(uint64_t hash) const;
+  void Rehash(size_t group_num);
+  size_t GroupOf(uint64_t hash) const { return static_cast<size_t>(hash >> kTagBits) & group_mask_; }
+
+  static constexpr size_t kTagBits = 7;
+
+  std::vector<int8_t> ctrl_;
+  std::vector<Slot> slots_;
+  size_t group_mask_{0};
+  size_t size_{0};
+  // The number of the empty slots which can be taken before the rehash, and the deleted slots are reused freely.
+  size_t growth_left_{0};
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_ID_MAP_H_
@@ -392,6 +392,149 @@ bool Worker::UpdateEmbeddingTable(const std::vector<Key> &keys, const std::vecto
   return true;
 }
 
+bool Worker::InitPSDynamicEmbeddingTable(const Key &key, size_t embedding_dim, size_t capacity,
+                                         uint32_t admission_threshold, uint64_t ttl_steps, uint32_t timeout) {
+  if (key_to_optimId_.count(key) == 0) {
+    MS_LOG(ERROR) << "Can't find optimizer id of the dynamic embedding table " << key;
+    return false;
+  }
+  DynamicEmbeddingTableMeta meta;
+  meta.set_key(key);
+  meta.set_optim_id(key_to_optimId_[key]);
+  meta.set_embedding_dim(embedding_dim);
+  meta.set_capacity(capacity);
+  meta.set_admission_threshold(admission_threshold);
+  meta.set_ttl_steps(ttl_steps);
+  meta.set_seed(static_cast<uint32_t>(key));
+
+  const std::string &meta_data = meta.SerializeAsString();
+  while (!worker_node_.Broadcast(core::NodeRole::SERVER, meta_data, kInitDynamicEmbeddingsCmd, timeout)) {
+    MS_LOG(INFO) << "Worker Broadcast failed!, retrying.";
+    if (!running_) {
+      MS_LOG(ERROR) << "Worker Broadcast failed!";
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(kRetryDuration));
+  }
+  dynamic_embedding_dims_[key] = embedding_dim;
+  return true;
+}
+
+bool Worker::DoPSDynamicEmbeddingLookup(const Key &key, const std::vector<Key> &ids,
+                                        std::vector<float> *lookup_result) {
+  MS_EXCEPTION_IF_NULL(lookup_result);
+  auto dim_iter = dynamic_embedding_dims_.find(key);
+  if (dim_iter == dynamic_embedding_dims_.end() || server_num_ <= 0) {
+    MS_LOG(ERROR) << "The dynamic embedding table " << key << " is not initialized.";
+    return false;
+  }
+  size_t dim = dim_iter->second;
+  lookup_result->assign(ids.size() * dim, 0);
+
+  // The ids are sent to the servers once per request, so each id is counted once for the admission.
+  size_t server_num = LongToSize(server_num_);
+  mindspore::HashSet<Key> unique_ids;
+  std::vector<KVMessage> messages(server_num);
+  for (const auto &id : ids) {
+    if (unique_ids.insert(id).second) {
+      auto &message = messages[id % server_num];
+      if (message.keys_size() == 0) {
+        message.add_keys(key);
+      }
+      message.add_keys(id);
+    }
+  }
+  std::vector<uint32_t> rank_ids;
+  std::vector<std::string> data_strs;
+  for (size_t i = 0; i < server_num; i++) {
+    if (messages[i].keys_size() > 0) {
+      rank_ids.push_back(SizeToUint(i));
+      data_strs.emplace_back(messages[i].SerializeAsString());
+    }
+  }
+  if (rank_ids.empty()) {
+    return true;
+  }
+
+  std::vector<VectorPtr> resp;
+  while (!worker_node_.Send(core::NodeRole::SERVER, rank_ids, data_strs, kDynamicEmbeddingLookupCmd, &resp)) {
+    MS_LOG(INFO) << "Worker send failed!, retrying.";
+    if (!running_) {
+      MS_LOG(ERROR) << "Worker send failed!";
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(kRetryDuration));
+  }
+
+  std::vector<KVMessage> results(resp.size());
+  mindspore::HashMap<Key, const float *> rows;
+  for (size_t i = 0; i < resp.size(); i++) {
+    MS_EXCEPTION_IF_NULL(resp[i]);
+    KVMessage &result = results[i];
+    CHECK_RETURN_TYPE(result.ParseFromArray(resp[i]->data(), SizeToInt(resp[i]->size())));
+    if (IntToSize(result.values_size()) != IntToSize(result.keys_size()) * dim) {
+      MS_LOG(ERROR) << "The size " << result.values_size() << " of the dynamic embedding lookup result is invalid.";
+      return false;
+    }
+    for (int j = 0; j < result.keys_size(); j++) {
+      rows[result.keys(j)] = result.values().data() + IntToSize(j) * dim;
+    }
+  }
+  for (size_t i = 0; i < ids.size(); i++) {
+    auto iter = rows.find(ids[i]);
+    if (iter != rows.end()) {
+      (void)std::copy(iter->second, iter->second + dim, lookup_result->begin() + i * dim);
+    }
+  }
+  return true;
+}
+
+bool Worker::PushDynamicEmbeddings(const Key &key, const std::vector<Key> &ids, const std::vector<float> &grads,
+                                   const std::vector<std::vector<float>> &hyper_params) {
+  auto dim_iter = dynamic_embedding_dims_.find(key);
+  if (dim_iter == dynamic_embedding_dims_.end() || server_num_ <= 0) {
+    MS_LOG(ERROR) << "The dynamic embedding table " << key << " is not initialized.";
+    return false;
+  }
+  size_t dim = dim_iter->second;
+  if (grads.size() != ids.size() * dim) {
+    MS_LOG(ERROR) << "The gradient size " << grads.size() << " is not equal to the size of " << ids.size() << " rows.";
+    return false;
+  }
+
+  // Every server gets a push even if it has no id, since a step of the table is finished after every worker pushes.
+  size_t server_num = LongToSize(server_num_);
+  std::vector<KVMessage> messages(server_num);
+  for (auto &message : messages) {
+    message.add_keys(key);
+    for (const auto &hyper_param : hyper_params) {
+      message.mutable_values()->Add(hyper_param.begin(), hyper_param.end());
+      message.add_len(hyper_param.size());
+    }
+  }
+  for (size_t i = 0; i < ids.size(); i++) {
+    auto &message = messages[ids[i] % server_num];
+    message.add_keys(ids[i]);
+    message.mutable_values()->Add(grads.begin() + i * dim, grads.begin() + (i + 1) * dim);
+  }
+  std::vector<uint32_t> rank_ids;
+  std::vector<std::string> data_strs;
+  for (size_t i = 0; i < server_num; i++) {
+    messages[i].add_len(IntToSize(messages[i].keys_size() - 1) * dim);
+    rank_ids.push_back(SizeToUint(i));
+    data_strs.emplace_back(messages[i].SerializeAsString());
+  }
+  while (!worker_node_.Send(core::NodeRole::SERVER, rank_ids, data_strs, kPushDynamicEmbeddingsCmd)) {
+    MS_LOG(INFO) << "Worker send failed!, retrying.";
+    if (!running_) {
+      MS_LOG(ERROR) << "Worker send failed!";
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(kRetryDuration));
+  }
+  return true;
+}
+
 void Worker::Finalize() {
   if (running_) {
     MS_LOG(INFO) << "Worker starts finalizing...";
@@ -623,6 +766,10 @@ void Worker::BuildSparseValue(const std::vector<int> &lengths, const size_t grad
 
 void Worker::PushData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
                       int cmd, int64_t) {
+  if (cmd == kPushCmd && embedding_table_ranges_.count(keys[0]) == 0) {
+    SendFlatPush(keys, vals, lens, true);
+    return;
+  }
   KVMessage kvs;
   *kvs.mutable_keys() = {keys.begin(), keys.end()};
   *kvs.mutable_values() = {vals.begin(), vals.end()};
@@ -642,21 +789,26 @@ void Worker::PushData(const std::vector<Key> &keys, const std::vector<float> &va
 
 void Worker::PushSparseData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
                             size_t grad_index, size_t indice_index, size_t first_dim_size, size_t outer_dim_size) {
+  if (embedding_table_ranges_.count(keys[0]) == 0) {
+    // The indices are pushed as the values of the sparse gradients, so they are not compressed.
+    SendFlatPush(keys, vals, lens, false);
+    return;
+  }
   KVMessage kvs;
   *kvs.mutable_keys() = {keys.begin(), keys.end()};
   *kvs.mutable_values() = {vals.begin(), vals.end()};
   *kvs.mutable_len() = {lens.begin(), lens.end()};
-  if (embedding_table_ranges_.count(keys[0])) {
-    std::map<int64_t, int64_t> attrs{{0, grad_index}, {1, indice_index}, {2, first_dim_size}, {3, outer_dim_size}};
-    SendForPush(kPushCmd, kvs, sparse_partitioner_, attrs);
-  } else {
-    SendForPush(kPushCmd, kvs, round_robin_partitioner_, {});
-  }
+  std::map<int64_t, int64_t> attrs{{0, grad_index}, {1, indice_index}, {2, first_dim_size}, {3, outer_dim_size}};
+  SendForPush(kPushCmd, kvs, sparse_partitioner_, attrs);
 }
 
 void Worker::PullData(const std::vector<Key> &keys, std::vector<float> *const vals, std::vector<int> *lens, int cmd,
                       int64_t priority) {
   MS_EXCEPTION_IF_NULL(vals);
+  if (cmd == kPullCmd && embedding_table_ranges_.count(keys[0]) == 0) {
+    SendFlatPull(keys, vals, lens);
+    return;
+  }
   KVMessage kvs;
   *kvs.mutable_keys() = {keys.begin(), keys.end()};
   if (embedding_table_ranges_.count(keys[0])) {
@@ -962,5 +1114,134 @@ void Worker::SendForPull(int cmd, const KVMessage &send, const KVPartitioner &pa
     }
   }
 }
+
+void Worker::SendFlatPush(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
+                          bool compress) {
+  if (keys.size() != lens.size()) {
+    MS_LOG(EXCEPTION) << "The key size " << keys.size() << " is not equal to the length size " << lens.size();
+  }
+  // The inputs of the optimizer are pushed with the same key, and each input is compressed with its own residual.
+  std::vector<size_t> offsets(keys.size(), 0);
+  std::vector<GradientCompressionConfig> configs(keys.size());
+  std::vector<bool> compressed(keys.size(), false);
+  size_t offset = 0;
+  for (size_t i = 0; i < keys.size(); i++) {
+    offsets[i] = offset;
+    offset += IntToSize(lens[i]);
+    if (compress) {
+      configs[i] = GetCompressionConfig(keys[i]);
+      compressed[i] = GradientCompressor::NeedCompress(configs[i], IntToSize(lens[i]));
+    }
+  }
+  if (offset > vals.size()) {
+    MS_LOG(EXCEPTION) << "The value size " << vals.size() << " is less than the total length " << offset;
+  }
+
+  // Coalesce the keys of each server, and the values of a server are all compressed if any of them is compressed.
+  std::vector<std::vector<size_t>> server_keys(LongToSize(server_num_));
+  std::vector<bool> server_compressed(LongToSize(server_num_), false);
+  for (size_t i = 0; i < keys.size(); i++) {
+    size_t server_id = LongToSize(key_to_server_id_[keys[i]]);
+    if (server_id >= server_keys.size()) {
+      MS_LOG(EXCEPTION) << "The server id " << server_id << " of key " << keys[i] << " is invalid.";
+    }
+    server_keys[server_id].push_back(i);
+    server_compressed[server_id] = server_compressed[server_id] || compressed[i];
+  }
+
+  auto &compressor = GradientCompressor::GetInstance();
+  GradientCompressionConfig none_config;
+  std::vector<uint32_t> rank_ids;
+  std::vector<std::string> data_strs;
+  for (size_t server_id = 0; server_id < server_keys.size(); server_id++) {
+    const auto &indices = server_keys[server_id];
+    if (indices.empty()) {
+      continue;
+    }
+    std::string encoded;
+    size_t value_num = 0;
+    for (size_t i : indices) {
+      if (server_compressed[server_id]) {
+        std::string name = std::to_string(keys[i]) + "_" + std::to_string(i);
+        compressor.Compress(name, compressed[i] ? configs[i] : none_config, vals.data() + offsets[i],
+                            IntToSize(lens[i]), &encoded);
+      } else {
+        value_num += IntToSize(lens[i]);
+      }
+    }
+    KVBufferHeader header;
+    header.key_num = indices.size();
+    header.len_num = indices.size();
+    header.value_num = value_num;
+    header.compressed_size = encoded.size();
+    std::string data(KVBufferSize(header), '\0');
+    KVBufferWriter writer(header, &data[0]);
+    for (size_t i : indices) {
+      writer.AddKey(keys[i]);
+    }
+    for (size_t i : indices) {
+      writer.AddLen(IntToSize(lens[i]));
+    }
+    if (server_compressed[server_id]) {
+      writer.AddCompressed(encoded.data(), encoded.size());
+    } else {
+      for (size_t i : indices) {
+        writer.AddValues(vals.data() + offsets[i], IntToSize(lens[i]));
+      }
+    }
+    rank_ids.push_back(SizeToUint(server_id));
+    data_strs.emplace_back(std::move(data));
+  }
+  worker_node_.Send(core::NodeRole::SERVER, rank_ids, data_strs, kPushCmd);
+}
+
+void Worker::SendFlatPull(const std::vector<Key> &keys, std::vector<float> *vals, std::vector<int> *lens) {
+  MS_EXCEPTION_IF_NULL(vals);
+  std::vector<std::vector<Key>> server_keys(LongToSize(server_num_));
+  for (const auto &key : keys) {
+    size_t server_id = LongToSize(key_to_server_id_[key]);
+    if (server_id >= server_keys.size()) {
+      MS_LOG(EXCEPTION) << "The server id " << server_id << " of key " << key << " is invalid.";
+    }
+    server_keys[server_id].push_back(key);
+  }
+  std::vector<uint32_t> rank_ids;
+  std::vector<std::string> data_strs;
+  for (size_t server_id = 0; server_id < server_keys.size(); server_id++) {
+    if (server_keys[server_id].empty()) {
+      continue;
+    }
+    KVBufferHeader header;
+    header.key_num = server_keys[server_id].size();
+    std::string data(KVBufferSize(header), '\0');
+    KVBufferWriter writer(header, &data[0]);
+    for (const auto &key : server_keys[server_id]) {
+      writer.AddKey(key);
+    }
+    rank_ids.push_back(SizeToUint(server_id));
+    data_strs.emplace_back(std::move(data));
+  }
+
+  std::vector<VectorPtr> resp;
+  worker_node_.Send(core::NodeRole::SERVER, rank_ids, data_strs, kPullCmd, &resp);
+  vals->clear();
+  for (size_t i = 0; i < resp.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(resp.at(i));
+    KVBufferReader reader;
+    if (!reader.Parse(resp.at(i)->data(), resp.at(i)->size())) {
+      MS_LOG(EXCEPTION) << "Failed to parse the pull response of the server " << rank_ids[i];
+    }
+    reader.GetValues(vals);
+    if (lens) {
+      reader.GetLens(lens);
+    }
+  }
+}
+
+GradientCompressionConfig Worker::GetCompressionConfig(Key key) const {
+  auto iter = std::find_if(param_to_key_.begin(), param_to_key_.end(),
+                           [key](const std::pair<std::string, size_t> &item) { return item.second == key; });
+  return GradientCompressor::GetInstance().GetConfig(iter == param_to_key_.end() ? "" : iter->first);
+}
 }  // namespace ps
 }  // namespace mindspore
@@ -37,6 +37,8 @@
 #include "ps/ps_cache/ps_data/ps_data_prefetch.h"
 #include "ps/core/ps_worker_node.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/gradient_compression.h"
+#include "ps/kv_buffer.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
 #include "ps/ps_context.h"
@@ -76,6 +78,15 @@ class Worker {
                            int64_t cmd);
   bool UpdateEmbeddingTable(const std::vector<Key> &keys, const std::vector<int> &lookup_ids,
                             const std::vector<float> &vals);
+  // Create the dynamic embedding table of the key on all the servers, whose rows are keyed by the 64-bit feature ids
+  // and sharded to the servers by the ids. The sparse optimizer of the key should be set by SetKeyOptimId before.
+  bool InitPSDynamicEmbeddingTable(const Key &key, size_t embedding_dim, size_t capacity, uint32_t admission_threshold,
+                                   uint64_t ttl_steps, uint32_t timeout = core::kCommTimeoutInSeconds);
+  bool DoPSDynamicEmbeddingLookup(const Key &key, const std::vector<Key> &ids, std::vector<float> *lookup_result);
+  // Push the gradients of the ids with the hyper parameters of the optimizer, eg. beta1_power, beta2_power, lr, beta1,
+  // beta2 and epsilon of Adam, and none of FTRL.
+  bool PushDynamicEmbeddings(const Key &key, const std::vector<Key> &ids, const std::vector<float> &grads,
+                             const std::vector<std::vector<float>> &hyper_params);
 
   bool running() const { return running_; }
   void Finalize();
@@ -125,6 +136,13 @@ class Worker {
                    const std::map<int64_t, int64_t> &attrs);
   void SendForPull(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
                    const std::map<int64_t, int64_t> &attrs, std::vector<float> *vals, std::vector<int> *lens);
+  // Push and pull the keys which are not embedding tables in the flat message. The keys of the same server are
+  // coalesced into one message, and the dense gradients are encoded by the gradient compression if compress is true.
+  void SendFlatPush(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
+                    bool compress);
+  void SendFlatPull(const std::vector<Key> &keys, std::vector<float> *vals, std::vector<int> *lens);
+  // Get the gradient compression config of the parameter of the key.
+  GradientCompressionConfig GetCompressionConfig(Key key) const;
 
   int64_t server_num_;
   bool running_;
@@ -147,6 +165,8 @@ class Worker {
   mindspore::HashMap<Key, size_t> embedding_row_cnt_;
 
   mindspore::HashMap<Key, std::shared_ptr<std::vector<EmbeddingTableShardMetadata>>> embedding_table_ranges_;
+  // The embedding dims of the dynamic embedding tables.
+  mindspore::HashMap<Key, size_t> dynamic_embedding_dims_;
 };
 }  // namespace ps
 }  // namespace mindspore
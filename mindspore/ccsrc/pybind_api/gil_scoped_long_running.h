@@ -18,6 +18,7 @@
 #define PYBIND_API_GIL_SCOPED_LONG_RUNNING_H_
 
 #include <memory>
+#include <vector>
 
 #include "pybind11/pybind11.h"
 
@@ -26,13 +27,21 @@
 namespace py = pybind11;
 
 namespace mindspore {
+// The hook is shared by all threads, so the GIL is released per thread, and only if the thread holds it. The thread
+// without the GIL, e.g. the async launch thread of op tasks, or the nested long running scope, keeps nothing.
 class GilScopedLongRunningHook : public ScopedLongRunningHook {
  public:
-  void Enter() override { release_ = std::make_unique<py::gil_scoped_release>(); }
-  void Leave() override { release_ = nullptr; }
+  void Enter() override {
+    (void)releases_.emplace_back(PyGILState_Check() != 0 ? std::make_unique<py::gil_scoped_release>() : nullptr);
+  }
+  void Leave() override {
+    if (!releases_.empty()) {
+      releases_.pop_back();
+    }
+  }
 
  private:
-  std::unique_ptr<py::gil_scoped_release> release_;
+  inline static thread_local std::vector<std::unique_ptr<py::gil_scoped_release>> releases_;
 };
 }  // namespace mindspore
 #endif  // PYBIND_API_GIL_SCOPED_LONG_RUNNING_H_
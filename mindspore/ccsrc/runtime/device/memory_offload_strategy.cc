@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "runtime/device/memory_offload_strategy.h"
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <memory>
@@ -24,6 +25,8 @@ namespace mindspore {
 namespace device {
 constexpr size_t kFirstGetMemEventIndex = 1;
 constexpr size_t kInitOrMallocMemEventIndex = 0;
+// The memory swapped out after a step is swapped in no earlier than the step after next.
+constexpr size_t kMinSwapInSpan = 2;
 
 std::vector<std::shared_ptr<MemEvent>> &MemOffloadStrategy::GetPreComputeEvents(size_t step) {
   if (pre_compute_events_.size() <= step) {
@@ -134,7 +137,10 @@ void MemOffloadStrategy::GenEventSpan() {
         span = total_step_;
       }
       if (span > 1) {
-        const size_t span_mul_size = (span - 1) * event->mem_size;
+        // The memory is idle between the events, which is measured by the compute time when it is recorded.
+        const size_t idle_span =
+          HasComputeTime() ? static_cast<size_t>(GetIdleTime(latest_event->index, span)) + 1 : span - 1;
+        const size_t span_mul_size = idle_span * event->mem_size;
         (void)event_span_.emplace(std::make_pair(span_mul_size, std::make_pair(event, span)));
       }
     }
@@ -143,6 +149,7 @@ void MemOffloadStrategy::GenEventSpan() {
 
 void MemOffloadStrategy::GenSwapEventSet() {
   swap_events_.clear();
+  swap_mem_used_.clear();
   // manual offload strategy
   if (!manual_offload_keys_.empty()) {
     for (const auto &iter : event_span_) {
@@ -184,6 +191,7 @@ void MemOffloadStrategy::GenSwapEventSet() {
       (void)swap_events_.emplace(event);
     }
   }
+  swap_mem_used_.swap(cur_mem_used);
 }
 
 void MemOffloadStrategy::GenComputeMemEvents() {
@@ -229,10 +237,11 @@ void MemOffloadStrategy::GenComputeMemEvents() {
         post_compute_events_[pre_index].emplace_back(free_or_swap_out_event);
         // avoid swap-in-event follow init-event
         if (i != kFirstGetMemEventIndex || first_event->type != kInit) {
-          auto swap_in_event = std::make_shared<MemEvent>(kSwapIn, event->index);
+          auto swap_in_step = GetSwapInStep(pre_index, event->index, first_event->mem_size);
+          auto swap_in_event = std::make_shared<MemEvent>(kSwapIn, swap_in_step);
           swap_in_event->key = item.first;
           swap_in_event->mem_size = first_event->mem_size;
-          (void)pre_compute_events_[event->index].emplace_back(swap_in_event);
+          (void)pre_compute_events_[swap_in_step].emplace_back(swap_in_event);
         }
       }
       if (event->index < pre_compute_events_.size()) {
@@ -255,6 +264,39 @@ void MemOffloadStrategy::GenFreeEvent(const std::shared_ptr<MemEvent> &last_even
   }
 }
 
+bool MemOffloadStrategy::HasComputeTime() const {
+  return compute_time_.size() == total_step_ &&
+         std::any_of(compute_time_.begin(), compute_time_.end(), [](double time) { return time > 0; });
+}
+
+double MemOffloadStrategy::GetIdleTime(size_t pre_step, size_t span) const {
+  double idle_time = 0;
+  for (size_t i = 1; i < span; ++i) {
+    idle_time += compute_time_[(pre_step + i) % total_step_];
+  }
+  return idle_time;
+}
+
+size_t MemOffloadStrategy::GetSwapInStep(size_t pre_step, size_t step, size_t mem_size) {
+  // The memory is swapped in before the step computes if the compute time is not recorded.
+  if (!HasComputeTime() || swap_mem_used_.size() != total_step_ || pre_step >= step) {
+    return step;
+  }
+  const double swap_time = mem_size / swap_bandwidth_;
+  double hidden_time = 0;
+  auto swap_in_step = step;
+  while (hidden_time < swap_time && swap_in_step >= pre_step + kMinSwapInSpan + 1) {
+    auto prev_step = swap_in_step - 1;
+    if (swap_mem_used_[prev_step] + mem_size > mem_size_) {
+      break;
+    }
+    swap_mem_used_[prev_step] += mem_size;
+    hidden_time += compute_time_[prev_step];
+    swap_in_step = prev_step;
+  }
+  return swap_in_step;
+}
+
 std::set<size_t> MemOffloadStrategy::GetSwapOutEventIndex(const void *key,
                                                           const std::vector<std::shared_ptr<MemEvent>> &mem_events) {
   const auto &update_step_iter = high_priority_updated_step_.find(key);
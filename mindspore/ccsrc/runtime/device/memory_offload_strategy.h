@@ -28,6 +28,9 @@ enum MemPriority { kMemPriorityLow, kMemPriorityHigh };
 
 enum MemEventType { kInit, kMalloc, kGet, kFree, kSwapIn, kSwapOut };
 
+// The swap bandwidth in bytes per microsecond before it is measured.
+constexpr double kDefaultSwapBandwidth = 1.0e4;
+
 struct MemEvent {
   MemEvent(const MemEventType &in_type, size_t in_index) : type(in_type), index(in_index) {}
 
@@ -53,7 +56,14 @@ class MemOffloadStrategy {
 
   virtual void Execute();
 
-  void SetComputeTime(const std::vector<double> &compute_time) { compute_time_ = compute_time; }
+  // The compute time of each step in microseconds, the event span is regenerated by the compute time.
+  void SetComputeTime(const std::vector<double> &compute_time) {
+    compute_time_ = compute_time;
+    event_span_.clear();
+  }
+
+  // The bandwidth of swap in bytes per microsecond.
+  void SetSwapBandwidth(double swap_bandwidth) { swap_bandwidth_ = swap_bandwidth; }
 
   std::vector<std::shared_ptr<MemEvent>> &GetPreComputeEvents(size_t step);
 
@@ -77,6 +87,14 @@ class MemOffloadStrategy {
   void GenComputeMemEvents();
 
   void GenFreeEvent(const std::shared_ptr<MemEvent> &last_event);
+
+  bool HasComputeTime() const;
+
+  // The total compute time of the steps between the previous event and the event.
+  double GetIdleTime(size_t pre_step, size_t span) const;
+
+  // The step to swap in the memory which is early enough to hide the swap by the computation.
+  size_t GetSwapInStep(size_t pre_step, size_t step, size_t mem_size);
   std::set<size_t> GetSwapOutEventIndex(const void *key, const std::vector<std::shared_ptr<MemEvent>> &mem_events);
 
   size_t GetSpanBetweenMemEvents(size_t pre_step, size_t post_step) const {
@@ -93,10 +111,13 @@ class MemOffloadStrategy {
 
   size_t mem_size_{0};
   std::vector<double> compute_time_;
+  double swap_bandwidth_{kDefaultSwapBandwidth};
   bool need_swap_{false};
   std::multimap<size_t, std::pair<std::shared_ptr<MemEvent>, size_t>> event_span_;
   std::set<std::shared_ptr<MemEvent>> swap_events_;
   std::vector<size_t> min_mem_used_;
+  // The memory used in each step with the swap events, which limits how early the memory is swapped in.
+  std::vector<size_t> swap_mem_used_;
   size_t mem_used_without_swap_{0};
   size_t min_mem_needed_{0};
 };
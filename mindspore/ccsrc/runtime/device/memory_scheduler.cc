@@ -134,7 +134,7 @@ bool MemScheduler::PreComputeInit(const std::shared_ptr<MemEvent> &event, void *
     MS_LOG(DEBUG) << "Init input data from host, key: " << event->key;
     auto host_ptr = init_host_ptr_[event->key];
     MS_EXCEPTION_IF_NULL(host_ptr);
-    mem_handler_->SwapIn(host_ptr, device_ptr, event->mem_size, stream);
+    SwapIn(host_ptr, device_ptr, event->mem_size, stream);
   }
   mem_result_[event->key] = device_ptr;
   return true;
@@ -165,7 +165,7 @@ bool MemScheduler::PreComputeSwapIn(const std::shared_ptr<MemEvent> &event, void
     return false;
   }
   MS_EXCEPTION_IF_NULL(host_ptr);
-  mem_handler_->SwapIn(host_ptr, device_ptr, event->mem_size, stream);
+  SwapIn(host_ptr, device_ptr, event->mem_size, stream);
   mem_result_[event->key] = device_ptr;
   if (!from_init) {
     mem_handler_->FreeHost(host_ptr);
@@ -193,7 +193,7 @@ bool MemScheduler::PreComputeGet(const std::shared_ptr<MemEvent> &event, void *s
     return false;
   }
   auto device_ptr = MallocDevice(mem_size, stream);
-  mem_handler_->SwapIn(host_ptr, device_ptr, mem_size, stream);
+  SwapIn(host_ptr, device_ptr, mem_size, stream);
   if (!from_init) {
     swap_host_ptr_.erase(host_ptr);
     mem_handler_->FreeHost(host_ptr);
@@ -389,11 +389,26 @@ void *MemScheduler::MallocDevice(size_t mem_size, void *stream) {
 void MemScheduler::SwapOutAndFreeDevice(const void *key, void *device_ptr, size_t mem_size, void *stream) {
   auto host_ptr = GetOrMallocHostPtr(key, mem_size);
   MS_EXCEPTION_IF_NULL(host_ptr);
+  auto start_time = GetCurrentTime();
   mem_handler_->SwapOut(device_ptr, host_ptr, mem_size, stream);
+  RecordSwapTime(start_time, mem_size);
   mem_handler_->FreeDevice(device_ptr);
   (void)mem_result_.erase(key);
 }
 
+void MemScheduler::SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) {
+  auto start_time = GetCurrentTime();
+  mem_handler_->SwapIn(host_ptr, device_ptr, mem_size, stream);
+  RecordSwapTime(start_time, mem_size);
+}
+
+void MemScheduler::RecordSwapTime(double start_time, size_t mem_size) {
+  if (record_compute_time_ && !updated_) {
+    swap_time_ += GetCurrentTime() - start_time;
+    swap_mem_size_ += mem_size;
+  }
+}
+
 size_t MemScheduler::GetMemSize(const void *key) {
   const auto &iter = mem_events_.find(key);
   if (iter == mem_events_.end() || iter->second.empty()) {
@@ -447,6 +462,10 @@ void MemScheduler::Update() {
   }
 
   strategy_->SetComputeTime(compute_time_);
+  if (swap_time_ > 0) {
+    strategy_->SetSwapBandwidth(swap_mem_size_ / swap_time_);
+    MS_LOG(INFO) << "Swap " << swap_mem_size_ << " bytes in " << swap_time_ << " us.";
+  }
   strategy_->Execute();
   updated_ = true;
 }
@@ -101,6 +101,11 @@ class MemScheduler {
 
   void SwapOutAndFreeDevice(const void *key, void *device_ptr, size_t mem_size, void *stream);
 
+  void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream);
+
+  // Record the swap time with the compute time to measure the swap bandwidth.
+  void RecordSwapTime(double start_time, size_t mem_size);
+
   size_t GetMemSize(const void *key);
 
   void *GetOrMallocHostPtr(const void *key, size_t mem_size);
@@ -131,6 +136,8 @@ class MemScheduler {
   double compute_start_time_{0};
   std::vector<double> compute_time_;
   bool record_compute_time_{false};
+  double swap_time_{0};
+  size_t swap_mem_size_{0};
   bool updated_{false};
   std::shared_ptr<MemHandler> mem_handler_{nullptr};
   std::shared_ptr<MemOffloadStrategy> strategy_{nullptr};
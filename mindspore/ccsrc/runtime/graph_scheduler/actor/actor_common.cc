@@ -15,13 +15,18 @@
  */
 
 #include "runtime/graph_scheduler/actor/actor_common.h"
+#include <cmath>
 #include "runtime/graph_scheduler/device_tensor_store.h"
 #include "utils/ms_context.h"
+#include "utils/ms_utils.h"
 #include "include/common/utils/anfalgo.h"
 
 namespace mindspore {
 namespace runtime {
 bool ActorDispatcher::is_multi_thread_execution_ = true;
+std::atomic<size_t> KernelThreadPartition::launching_cost_{0};
+std::atomic<size_t> KernelThreadPartition::reserved_thread_num_{0};
+thread_local size_t KernelThreadPartition::kernel_cost_ = 0;
 
 void ComputeThreadNums(size_t *actor_thread_num, size_t *actor_and_kernel_thread_num) {
   MS_EXCEPTION_IF_NULL(actor_thread_num);
@@ -39,6 +44,11 @@ void ComputeThreadNums(size_t *actor_thread_num, size_t *actor_and_kernel_thread
   // The MemoryManagerActor binds single thread, and the other actors share one thread at least, so the min num is 2.
   *actor_thread_num = runtime_num_threads_min < kActorThreadMinNum ? kActorThreadMinNum : runtime_num_threads_min;
   *actor_thread_num = *actor_thread_num > actor_thread_max_num ? actor_thread_max_num : *actor_thread_num;
+  // The kernels run in the inter op parallel num of threads besides the thread of MemoryManagerActor.
+  auto inter_op_parallel_num = KernelThreadPartition::inter_op_parallel_num();
+  if (inter_op_parallel_num > 0) {
+    *actor_thread_num = std::max(inter_op_parallel_num + 1, kActorThreadMinNum);
+  }
 
   // Compute the actor and kernel thread num.
   *actor_and_kernel_thread_num =
@@ -49,6 +59,74 @@ void ComputeThreadNums(size_t *actor_thread_num, size_t *actor_and_kernel_thread
   }
 }
 
+size_t KernelThreadPartition::inter_op_parallel_num() {
+  static const size_t inter_op_parallel_num = []() -> size_t {
+    const auto &env = common::GetEnv("MS_DEV_CPU_INTER_OP_PARALLEL_NUM");
+    if (env.empty()) {
+      return 0;
+    }
+    try {
+      auto num = std::stoi(env);
+      return num > 0 ? IntToSize(num) : 0;
+    } catch (const std::exception &) {
+      MS_LOG(WARNING) << "Invalid MS_DEV_CPU_INTER_OP_PARALLEL_NUM: " << env << ", the inter op parallel is disabled.";
+      return 0;
+    }
+  }();
+  return inter_op_parallel_num;
+}
+
+KernelThreadPartition::LaunchGuard::LaunchGuard(const kernel::KernelLaunchInfo *launch_info) {
+  if (launch_info == nullptr || inter_op_parallel_num() == 0) {
+    return;
+  }
+  // Count the zero size kernel as one byte, so it still takes one thread at least.
+  cost_ = 1;
+  for (const auto &addresses : {&launch_info->inputs_, &launch_info->outputs_}) {
+    for (const auto &address : *addresses) {
+      if (address != nullptr) {
+        cost_ += address->size;
+      }
+    }
+  }
+  (void)launching_cost_.fetch_add(cost_);
+  kernel_cost_ = cost_;
+}
+
+KernelThreadPartition::LaunchGuard::~LaunchGuard() {
+  if (cost_ == 0) {
+    return;
+  }
+  (void)launching_cost_.fetch_sub(cost_);
+  kernel_cost_ = 0;
+}
+
+KernelThreadPartition::ThreadGroup::ThreadGroup(size_t kernel_thread_num) {
+  if (kernel_cost_ == 0) {
+    return;
+  }
+  limited_ = true;
+  // The share of kernel is computed by the launching kernels at the time of each parallel launch.
+  auto total_cost = std::max(launching_cost_.load(), kernel_cost_);
+  auto share = static_cast<size_t>(static_cast<double>(kernel_thread_num) * static_cast<double>(kernel_cost_) /
+                                   static_cast<double>(total_cost));
+  share = std::max(share, static_cast<size_t>(1));
+  auto reserved_thread_num = KernelThreadPartition::reserved_thread_num_.load();
+  size_t thread_num = 0;
+  do {
+    auto idle_thread_num = kernel_thread_num > reserved_thread_num ? kernel_thread_num - reserved_thread_num : 0;
+    thread_num = std::min(share, idle_thread_num);
+  } while (!KernelThreadPartition::reserved_thread_num_.compare_exchange_weak(reserved_thread_num,
+                                                                              reserved_thread_num + thread_num));
+  reserved_thread_num_ = thread_num;
+}
+
+KernelThreadPartition::ThreadGroup::~ThreadGroup() {
+  if (reserved_thread_num_ > 0) {
+    (void)KernelThreadPartition::reserved_thread_num_.fetch_sub(reserved_thread_num_);
+  }
+}
+
 bool IsDeviceQueueDSActor(const AnfNodePtr &node, GraphExecutionStrategy strategy) {
   MS_EXCEPTION_IF_NULL(node);
   if (strategy == GraphExecutionStrategy::kStep) {
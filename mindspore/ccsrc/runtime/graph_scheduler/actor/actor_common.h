@@ -23,6 +23,7 @@
 #include <utility>
 #include <thread>
 #include <algorithm>
+#include <atomic>
 #include "utils/hash_map.h"
 #include "mindrt/include/actor/op_actor.h"
 #include "runtime/device/device_address.h"
@@ -189,6 +190,48 @@ class ActorDispatcher {
 
 void ComputeThreadNums(size_t *actor_thread_num, size_t *actor_and_kernel_thread_num);
 
+// The kernel threads are shared by the CPU kernels which are launched concurrently in the actor threads, and the first
+// launched kernel takes all of them in the default. If the inter op parallel num is set by the env
+// MS_DEV_CPU_INTER_OP_PARALLEL_NUM, the independent kernels run in that many actor threads concurrently and each
+// parallel launch of kernel reserves a group of the idle kernel threads in proportion to its cost among the launching
+// kernels, so the groups never exceed the kernel threads.
+class KernelThreadPartition {
+ public:
+  // The num of actor threads which run kernels concurrently, 0 means the partition is disabled.
+  static size_t inter_op_parallel_num();
+
+  // The guard of kernel launch, the cost of kernel is the size of inputs and outputs.
+  class LaunchGuard {
+   public:
+    explicit LaunchGuard(const kernel::KernelLaunchInfo *launch_info);
+    ~LaunchGuard();
+
+   private:
+    size_t cost_{0};
+  };
+
+  // The kernel threads reserved by one parallel launch of the kernel launching in the current thread.
+  class ThreadGroup {
+   public:
+    explicit ThreadGroup(size_t kernel_thread_num);
+    ~ThreadGroup();
+    // Limit the num of subtasks to the reserved threads. The task runs in the current thread if no kernel thread is
+    // idle, and it is not limited out of the kernel launch or if the partition is disabled.
+    size_t Limit(size_t task_num) const {
+      return limited_ ? std::min(task_num, std::max(reserved_thread_num_, static_cast<size_t>(1))) : task_num;
+    }
+
+   private:
+    bool limited_{false};
+    size_t reserved_thread_num_{0};
+  };
+
+ private:
+  static std::atomic<size_t> launching_cost_;
+  static std::atomic<size_t> reserved_thread_num_;
+  static thread_local size_t kernel_cost_;
+};
+
 bool IsDeviceQueueDSActor(const AnfNodePtr &node, GraphExecutionStrategy strategy = GraphExecutionStrategy::kPipeline);
 
 // Host parameters are parameters of root funcgraph, in control flow, only the parameters of the root funcgraph are
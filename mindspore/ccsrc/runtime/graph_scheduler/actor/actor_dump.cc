@@ -151,6 +151,9 @@ void DumpKernelActor(const KernelActor *actor, std::ofstream &ofs) {
 
   DumpAbstractActor(actor, ofs);
 
+  if (actor->inline_next() != nullptr) {
+    ofs << "\t\tinline_next_actor:" << actor->inline_next()->GetAID().Name() << "\n";
+  }
   if (actor->modifiable_ref_input_indexes().size() != 0) {
     ofs << "\t\tmodifiable_ref_input_indexes:" << actor->modifiable_ref_input_indexes().size() << "\n";
     for (auto &ref_input_index : actor->modifiable_ref_input_indexes()) {
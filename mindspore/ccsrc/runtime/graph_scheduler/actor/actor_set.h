@@ -42,6 +42,7 @@
 #include "runtime/graph_scheduler/actor/control_flow/entrance_actor.h"
 #include "runtime/graph_scheduler/actor/control_flow/exit_actor.h"
 #include "runtime/graph_scheduler/actor/control_flow/stack_actor.h"
+#include "runtime/graph_scheduler/graph_capture.h"
 
 #ifdef ENABLE_RPC_ACTOR
 #include "runtime/graph_scheduler/actor/rpc/send_actor.h"
@@ -111,6 +112,8 @@ struct ActorSet {
   RpcActorSetPtr rpc_actors_{nullptr};
 #endif
   ActorInfo name_;
+  // The graph capture replays the static shape steps of kernel actors on CPU, which is nullptr if not supported.
+  GraphCapturePtr graph_capture_{nullptr};
   // The related statistics information of multi thread and single thread to decide whether use the multi thread.
   bool is_multi_thread_execution_{true};
   size_t execution_count_{0};
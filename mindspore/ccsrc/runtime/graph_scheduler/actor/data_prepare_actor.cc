@@ -298,6 +298,19 @@ void DataPrepareActor::PrepareData(const std::vector<std::vector<TensorPtr>> &in
   }
 }
 
+void DataPrepareActor::PrepareDataForGraphCapture(const std::vector<std::vector<TensorPtr>> &input_tensors,
+                                                  OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  real_strategy_ = GraphExecutionStrategy::kPipeline;
+  try {
+    PrepareDataForDeviceTensorStore(input_tensors, context);
+    UpdateGraphsRefNodeAddress(graph_compiler_info_->graphs_);
+  } catch (const std::exception &e) {
+    std::string error_info = e.what();
+    SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
+  }
+}
+
 void DataPrepareActor::SendDebugReq(OpContext<DeviceTensor> *const context) {
   ActorDispatcher::Send(*debug_aid_, &DebugActor::DebugOnStepBegin, graph_compiler_info_->graphs_,
                         graph_compiler_info_->origin_parameters_order_, graph_compiler_info_->device_contexts_, context,
@@ -52,6 +52,10 @@ class DataPrepareActor : public DebugAwareActor {
   // The process entry of data prepare.
   void PrepareData(const std::vector<std::vector<TensorPtr>> &input_tensors, OpContext<DeviceTensor> *const context,
                    GraphExecutionStrategy real_strategy);
+  // Prepare the device tensor store in the calling thread for the step which is replayed by the graph capture, the
+  // graph inputs are copied by the graph capture.
+  void PrepareDataForGraphCapture(const std::vector<std::vector<TensorPtr>> &input_tensors,
+                                  OpContext<DeviceTensor> *const context);
 
   // The debug related operation interface.
   void SendDebugReq(OpContext<DeviceTensor> *const context) override;
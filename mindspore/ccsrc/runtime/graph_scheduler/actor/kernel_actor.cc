@@ -37,6 +37,8 @@ void KernelActor::Init() {
   real_input_num_ = common::AnfAlgo::GetInputTensorNum(kernel_);
   kernel_info_ = dynamic_cast<KernelInfo *>(kernel_->kernel_info());
   is_dynamic_shape_ = common::AnfAlgo::IsDynamicShape(kernel_);
+  MS_EXCEPTION_IF_NULL(device_contexts_[0]);
+  is_cpu_kernel_ = (device_contexts_[0]->GetDeviceAddressType() == device::DeviceAddressType::kCPU);
 
   // Init the device tensors and kernel launch info.
   copy_input_device_tensors_.resize(real_input_num_);
@@ -103,8 +105,11 @@ void KernelActor::Run(OpContext<DeviceTensor> *const context) {
   if (is_dynamic_shape_) {
     FetchWorkspaceDeviceTensor();
   }
+  if (!inline_actors_.empty()) {
+    FetchInlineChainOutputDeviceTensor(context);
+  }
 
-  if (memory_alloc_list_.size() > 0) {
+  if ((memory_alloc_list_.size() > 0) || (inline_alloc_list_.size() > 0)) {
     SendMemoryAllocReq(context);
   } else {
     OnMemoryAllocFinish(context);
@@ -207,11 +212,13 @@ void FreeMemory(const std::vector<DeviceTensor *> &free_list, const DeviceContex
 
 void KernelActor::SendMemoryAllocReq(OpContext<DeviceTensor> *const context) {
   running_dependent_msg_num_ = 1;
+  // The head of inline chain allocates the memory of the whole chain.
+  auto alloc_list = inline_actors_.empty() ? &memory_alloc_list_ : &inline_alloc_list_;
   if (strategy_ == GraphExecutionStrategy::kPipeline) {
-    ActorDispatcher::Send(memory_manager_aid_, &MemoryManagerActor::AllocateMemory, &memory_alloc_list_,
-                          device_contexts_[0], context, GetAID());
+    ActorDispatcher::Send(memory_manager_aid_, &MemoryManagerActor::AllocateMemory, alloc_list, device_contexts_[0],
+                          context, GetAID());
   } else {
-    AllocateMemory(memory_alloc_list_, device_contexts_[0], context, GetAID().Name());
+    AllocateMemory(*alloc_list, device_contexts_[0], context, GetAID().Name());
   }
 }
 
@@ -233,12 +240,22 @@ void KernelActor::SendMemoryFreeReq(OpContext<DeviceTensor> *const context) {
 }
 
 void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
+  if (inline_actors_.empty()) {
+    LaunchKernel(context);
+  } else {
+    RunInlineChain(context);
+  }
+}
+
+void KernelActor::LaunchKernel(OpContext<DeviceTensor> *const context) {
   MS_EXCEPTION_IF_NULL(context);
   MS_EXCEPTION_IF_NULL(kernel_);
   MS_EXCEPTION_IF_NULL(device_contexts_[0]);
   PreLaunchKernel(context);
 
   try {
+    // The CPU kernels launched concurrently share the kernel threads by their cost.
+    KernelThreadPartition::LaunchGuard launch_guard(is_cpu_kernel_ ? &launch_info_ : nullptr);
     auto ret = device_contexts_[0]->LaunchKernel(kernel_, launch_info_.inputs_, launch_info_.workspaces_,
                                                  launch_info_.outputs_, is_dynamic_shape_);
     if (!ret) {
@@ -467,7 +484,70 @@ void KernelActor::PostLaunchKernel(OpContext<DeviceTensor> *const context) {
   }
 
   if (strategy_ == GraphExecutionStrategy::kPipeline) {
-    SendOutput(context);
+    if (inline_next_ != nullptr) {
+      SendOutputInline(context);
+    } else {
+      SendOutput(context);
+    }
+  }
+}
+
+void KernelActor::FetchInlineChainOutputDeviceTensor(OpContext<DeviceTensor> *const context) {
+  inline_alloc_list_.assign(memory_alloc_list_.begin(), memory_alloc_list_.end());
+  for (auto &inline_actor : inline_actors_) {
+    MS_EXCEPTION_IF_NULL(inline_actor);
+    inline_actor->FetchOutputDeviceTensor(context);
+    (void)inline_alloc_list_.insert(inline_alloc_list_.end(), inline_actor->memory_alloc_list_.begin(),
+                                    inline_actor->memory_alloc_list_.end());
+  }
+}
+
+void KernelActor::SendOutputInline(OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  MS_EXCEPTION_IF_NULL(inline_next_);
+  // All the output arrows point to the next actor, whose running condition is satisfied by them.
+  auto &sequential_num = context->sequential_num_;
+  for (auto &output_data : output_data_) {
+    (void)inline_next_->input_op_datas_[sequential_num].emplace_back(output_data.get());
+  }
+  auto from_aid = const_cast<AID *>(&GetAID());
+  for (size_t i = 0; i < output_control_arrows_.size(); ++i) {
+    (void)inline_next_->input_op_controls_[sequential_num].emplace_back(from_aid);
+  }
+  SendRecorderInfo(context);
+  is_inline_output_sent_ = true;
+}
+
+void KernelActor::RunInlineChain(OpContext<DeviceTensor> *const context) {
+  // The actors of chain run one by one in the thread of head. The chain is broken when an actor fails and doesn't hand
+  // its output over to the next actor.
+  is_inline_output_sent_ = false;
+  LaunchKernel(context);
+  KernelActor *prev_actor = this;
+  for (size_t i = 0; i < inline_actors_.size(); ++i) {
+    if (!prev_actor->is_inline_output_sent_) {
+      FreeInlineChainMemory(i);
+      return;
+    }
+    auto inline_actor = inline_actors_[i];
+    MS_EXCEPTION_IF_NULL(inline_actor);
+    inline_actor->is_inline_output_sent_ = false;
+    inline_actor->FetchInputDeviceTensor(context);
+    inline_actor->LaunchKernel(context);
+    prev_actor = inline_actor;
+  }
+}
+
+void KernelActor::FreeInlineChainMemory(size_t begin) {
+  MS_EXCEPTION_IF_NULL(device_contexts_[0]);
+  // The memory is allocated by the head for the actors which never run, and it isn't referenced by any actor.
+  for (size_t i = begin; i < inline_actors_.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(inline_actors_[i]);
+    for (auto &device_tensor : inline_actors_[i]->memory_alloc_list_) {
+      if ((device_tensor != nullptr) && (device_tensor->GetPtr() != nullptr)) {
+        device_contexts_[0]->FreeMemory(device_tensor);
+      }
+    }
   }
 }
 
@@ -79,6 +79,7 @@ class KernelActor : public DebugAwareActor {
   const CNodePtr &kernel() const { return kernel_; }
   const std::set<size_t> &modifiable_ref_input_indexes() const { return modifiable_ref_input_indexes_; }
   const std::set<size_t> &modifiable_ref_output_indexes() const { return modifiable_ref_output_indexes_; }
+  const KernelActor *inline_next() const { return inline_next_; }
 
  protected:
   void Init() override;
@@ -104,11 +105,22 @@ class KernelActor : public DebugAwareActor {
 
   // The processing before kernel launch: update the info of kernel launch.
   void PreLaunchKernel(OpContext<DeviceTensor> *const context);
+  // Launch kernel and do the processing after kernel launch if it succeeds.
+  void LaunchKernel(OpContext<DeviceTensor> *const context);
   // The processing after kernel launch: 1.erase input, 2.free memory, 3.send output.
   void PostLaunchKernel(OpContext<DeviceTensor> *const context);
   // Back refresh the dynamic device tensor stores that have been triggered copy.
   void RefreshDeviceTensorCopyStore(OpContext<DeviceTensor> *const context);
 
+  // The head of inline chain fetches the output device tensors of the whole chain to allocate memory at once.
+  void FetchInlineChainOutputDeviceTensor(OpContext<DeviceTensor> *const context);
+  // Hand the output data over to the next actor of inline chain directly instead of sending messages.
+  void SendOutputInline(OpContext<DeviceTensor> *const context);
+  // The head runs the actors of inline chain in turn, the memory has been allocated by the head.
+  void RunInlineChain(OpContext<DeviceTensor> *const context);
+  // Free the memory of the actors from the begin index of inline chain, which don't run because of the failure.
+  void FreeInlineChainMemory(size_t begin);
+
   // The size of output address may be changed in dynamic shape scenario, for example, the output shape of operator
   // 'Unique' will change after PostExecute, the output address size should update.
   void UpdateOutputAddrSize();
@@ -116,6 +128,7 @@ class KernelActor : public DebugAwareActor {
   // The info of kernel.
   CNodePtr kernel_;
   bool is_dynamic_shape_;
+  bool is_cpu_kernel_{false};
 
   // The real input number of kernel launch.
   size_t real_input_num_;
@@ -147,6 +160,17 @@ class KernelActor : public DebugAwareActor {
 
   // Cache output data by output index to modify the output data effectively.
   std::vector<std::vector<OpData<DeviceTensor> *>> output_data_by_output_index_;
+
+  // The linear chain of kernel actors which is fused by the graph scheduler, the actors in the chain launch kernels
+  // back to back in the thread of the head actor without any message between them.
+  // The next actor in the chain, whose inputs all come from this actor.
+  KernelActor *inline_next_{nullptr};
+  // The actors following the head in the chain, only the head has them.
+  std::vector<KernelActor *> inline_actors_;
+  // output + workspace of the whole chain, only the head has them.
+  std::vector<DeviceTensor *> inline_alloc_list_;
+  // Whether the output has been handed over to the next actor of inline chain in this step.
+  bool is_inline_output_sent_{false};
 };
 
 using KernelActorPtr = std::shared_ptr<KernelActor>;
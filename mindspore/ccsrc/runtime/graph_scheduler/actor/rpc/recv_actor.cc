@@ -53,6 +53,11 @@ bool RecvActor::StartServer() {
 
   // Step 2: Set the message handler of the server.
   server_->SetMessageHandler(std::bind(&RecvActor::HandleMessage, this, std::placeholders::_1));
+  // The data sent without copying is received into the memory of device context directly.
+  auto device_context = device_contexts_[0];
+  MS_EXCEPTION_IF_NULL(device_context);
+  server_->SetMemoryCallback([device_context](size_t size) { return device_context->AllocateMemory(size); },
+                             [device_context](void *ptr) { device_context->FreeMemory(ptr); });
 
   // Step 2: Register the server address to route table. The server should not be connected before this step is done.
   ActorAddress recv_actor_addresss;
@@ -17,6 +17,8 @@
 #include "runtime/graph_scheduler/actor/rpc/send_actor.h"
 
 #include <utility>
+#include "distributed/rpc/tcp/buffer_message.h"
+#include "distributed/rpc/tcp/constants.h"
 
 namespace mindspore {
 namespace runtime {
@@ -64,16 +66,49 @@ void SendActor::SendOutput(OpContext<DeviceTensor> *const context) {
     return;
   }
   auto send_output = launch_info_.outputs_[0];
+  auto send_memory = TakeOverOutputMemory(send_output);
   for (const auto &peer : peer_actor_urls_) {
     std::string peer_server_url = peer.second;
-    auto message = BuildRpcMessage(send_output, peer_server_url);
+    auto message = BuildRpcMessage(send_output, peer_server_url, send_memory);
     MS_ERROR_IF_NULL_WO_RET_VAL(message);
     client_->Send(std::move(message));
   }
 }
 
-std::unique_ptr<MessageBase> SendActor::BuildRpcMessage(const kernel::AddressPtr &data, const std::string &server_url) {
+std::shared_ptr<void> SendActor::TakeOverOutputMemory(const kernel::AddressPtr &data) {
+  // The output is taken over only if it's not used by other actors of this process.
+  if (data == nullptr || data->addr == nullptr || output_device_tensors_.empty() || !output_data_arrows_.empty()) {
+    return nullptr;
+  }
+  auto device_tensor = output_device_tensors_[0];
+  if (device_tensor == nullptr || device_tensor->GetPtr() != data->addr || !device_tensor->from_mem_pool()) {
+    return nullptr;
+  }
+  // The device tensor is allocated again in the next step, as the memory is detached from it and not freed by the
+  // memory manager, until the messages are sent.
+  auto device_context = device_contexts_[0];
+  MS_EXCEPTION_IF_NULL(device_context);
+  device_tensor->set_ptr(nullptr);
+  return std::shared_ptr<void>(data->addr, [device_context](void *ptr) { device_context->FreeMemory(ptr); });
+}
+
+std::unique_ptr<MessageBase> SendActor::BuildRpcMessage(const kernel::AddressPtr &data, const std::string &server_url,
+                                                        const std::shared_ptr<void> &memory) {
   MS_ERROR_IF_NULL_W_RET_VAL(data, nullptr);
+  if (memory != nullptr) {
+    if (data->size > distributed::rpc::MAX_KMSG_DATA_LEN) {
+      MS_LOG(ERROR) << "The size " << data->size << " of send data exceeds the limit "
+                    << distributed::rpc::MAX_KMSG_DATA_LEN << ", server url: " << server_url;
+      return nullptr;
+    }
+    // The memory is sent without copying and held by the message until it's sent.
+    auto message = std::make_unique<distributed::rpc::BufferMessage>();
+    MS_ERROR_IF_NULL_W_RET_VAL(message, nullptr);
+    message->to = AID("", server_url);
+    message->AddBuffer(memory.get(), data->size);
+    message->set_release_callback([memory]() {});
+    return message;
+  }
   std::unique_ptr<MessageBase> message = std::make_unique<MessageBase>();
   MS_ERROR_IF_NULL_W_RET_VAL(message, nullptr);
   message->to = AID("", server_url);
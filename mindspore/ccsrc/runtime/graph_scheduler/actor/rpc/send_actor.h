@@ -48,8 +48,14 @@ class SendActor : public RpcActor {
   void SendOutput(OpContext<DeviceTensor> *const context) override;
 
  private:
-  // Client only supports to send MessageBase, so build MessageBase with data and url.
-  std::unique_ptr<MessageBase> BuildRpcMessage(const kernel::AddressPtr &data, const std::string &server_url);
+  // Take over the memory of output from the device tensor, so it can be sent without copying. Return nullptr if the
+  // output is used by other actors, and the output is copied into the message body.
+  std::shared_ptr<void> TakeOverOutputMemory(const kernel::AddressPtr &data);
+
+  // Client only supports to send MessageBase, so build MessageBase with data and url. The data is carried as the
+  // buffer of BufferMessage if its memory is taken over.
+  std::unique_ptr<MessageBase> BuildRpcMessage(const kernel::AddressPtr &data, const std::string &server_url,
+                                               const std::shared_ptr<void> &memory);
 
   friend class GraphScheduler;
 
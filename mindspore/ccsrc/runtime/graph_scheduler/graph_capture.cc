@@ -0,0 +1,527 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/graph_capture.h"
+#include <algorithm>
+#include <cstdint>
+#include "runtime/graph_scheduler/actor/data_prepare_actor.h"
+#include "runtime/graph_scheduler/actor/output_actor.h"
+#include "runtime/graph_scheduler/device_tensor_store.h"
+#include "runtime/graph_scheduler/device_tensor_copy_store.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_exception.h"
+#ifndef ENABLE_SECURITY
+#include "profiler/device/cpu/cpu_profiling.h"
+#endif
+
+namespace mindspore {
+namespace runtime {
+namespace {
+// The alignment of the device tensors in the planned memory block.
+constexpr size_t kCaptureMemoryAlignSize = 64;
+
+size_t AlignCaptureMemorySize(size_t size) {
+  return (size + kCaptureMemoryAlignSize - 1) / kCaptureMemoryAlignSize * kCaptureMemoryAlignSize;
+}
+
+// The lifetime of planned device tensor is the range of the launch index in which it is used.
+struct PlannedBlock {
+  DeviceTensor *device_tensor_;
+  size_t size_;
+  size_t first_use_;
+  size_t last_use_;
+  size_t offset_;
+};
+}  // namespace
+
+bool GraphCapture::Run(const std::vector<std::vector<TensorPtr>> &input_tensors,
+                       OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  if (!CheckInputTensors(input_tensors)) {
+    MS_LOG(INFO) << "The input tensors of graph capture " << name_ << " are changed, run by the actors.";
+    Release();
+    return false;
+  }
+
+  // The device tensors of graph inputs may be replaced, so fetch them before preparing the weights which updates the
+  // ref node addresses.
+  if (!is_recorded_) {
+    FetchInputDeviceTensor();
+  }
+  MS_EXCEPTION_IF_NULL(data_prepare_actor_);
+  data_prepare_actor_->PrepareDataForGraphCapture(input_tensors, context);
+  if (!context->error_info_.empty()) {
+    return true;
+  }
+  Replay(input_tensors, context);
+  return true;
+}
+
+void GraphCapture::Replay(const std::vector<std::vector<TensorPtr>> &input_tensors,
+                          OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  if (is_recorded_ && (!CheckFixedDeviceTensor())) {
+    MS_LOG(INFO) << "The fixed device tensors of graph capture " << name_ << " are changed, record again.";
+    Release();
+    FetchInputDeviceTensor();
+  }
+  if (!is_recorded_) {
+    Record(input_tensors, context);
+    if (!context->error_info_.empty()) {
+      Release();
+      return;
+    }
+  }
+
+  AllocateOutputMemory(context);
+  if (!context->error_info_.empty()) {
+    return;
+  }
+  CopyInputTensor(input_tensors, context);
+  if (!context->error_info_.empty()) {
+    return;
+  }
+  LaunchKernels(context);
+  if (!context->error_info_.empty()) {
+    return;
+  }
+  SendOutput(context);
+}
+
+void GraphCapture::Release() {
+  MS_EXCEPTION_IF_NULL(device_context_);
+  for (auto &device_tensor : input_device_tensors_) {
+    if ((device_tensor != nullptr) && (device_tensor->GetPtr() != nullptr)) {
+      device_context_->FreeMemory(device_tensor);
+    }
+  }
+  // The memory of graph outputs is taken over by the output tensors after the step, so only free the memory which
+  // is still held.
+  for (auto &device_tensor : output_device_tensors_) {
+    if (device_tensor->GetPtr() != nullptr) {
+      device_context_->FreeMemory(device_tensor);
+    }
+  }
+  for (auto &device_tensor : planned_device_tensors_) {
+    device_tensor->set_ptr(nullptr);
+  }
+  if (planned_memory_ != nullptr) {
+    device_context_->FreeMemory(planned_memory_);
+    planned_memory_ = nullptr;
+  }
+  planned_memory_size_ = 0;
+
+  for (auto &kernel : kernels_) {
+    kernel.launch_info_.inputs_.clear();
+    kernel.launch_info_.outputs_.clear();
+    kernel.launch_info_.workspaces_.clear();
+    kernel.ref_device_tensors_.clear();
+  }
+  input_device_tensors_.clear();
+  input_shapes_.clear();
+  input_types_.clear();
+  fixed_device_tensors_.clear();
+  fixed_device_tensor_sources_.clear();
+  planned_device_tensors_.clear();
+  planned_offsets_.clear();
+  output_device_tensors_.clear();
+  output_device_tensor_sources_.clear();
+  output_launch_addresses_.clear();
+  output_data_.clear();
+  is_recorded_ = false;
+}
+
+bool GraphCapture::CheckInputTensors(const std::vector<std::vector<TensorPtr>> &input_tensors) const {
+  // The input tensors of control nodes are in the end, which are not used.
+  if (input_tensors.size() < input_positions_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < input_positions_.size(); ++i) {
+    if (input_tensors[i].size() != input_positions_[i].size()) {
+      return false;
+    }
+    for (size_t j = 0; j < input_tensors[i].size(); ++j) {
+      auto position = input_positions_[i][j];
+      if (position == SIZE_MAX) {
+        continue;
+      }
+      const auto &input_tensor = input_tensors[i][j];
+      if (input_tensor == nullptr) {
+        return false;
+      }
+      // The shape and type of input tensors are recorded in the first step.
+      if (is_recorded_ && ((input_tensor->data_type() != input_types_[position]) ||
+                           (input_tensor->shape() != input_shapes_[position]))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void GraphCapture::FetchInputDeviceTensor() {
+  MS_EXCEPTION_IF_NULL(device_context_);
+  input_device_tensors_.resize(data_nodes_.size());
+  for (size_t i = 0; i < data_nodes_.size(); ++i) {
+    const auto &data_node = data_nodes_[i];
+    MS_EXCEPTION_IF_NULL(data_node);
+    auto device_tensor = AnfAlgo::GetMutableOutputAddr(data_node, 0, false);
+    MS_EXCEPTION_IF_NULL(device_tensor);
+    // The device tensor of graph input may be replaced by the device tensor of input tensor in the last step, which
+    // can't be held by the capture, so create a new one.
+    if (device_tensor->GetPtr() != nullptr) {
+      auto new_device_tensor = device_context_->CreateDeviceAddress(nullptr, device_tensor->GetSize(),
+                                                                    device_tensor->format(), device_tensor->type_id());
+      MS_EXCEPTION_IF_NULL(new_device_tensor);
+      new_device_tensor->set_original_ref_count(device_tensor->original_ref_count());
+      new_device_tensor->ResetRefCount();
+      AnfAlgo::SetOutputAddr(new_device_tensor, 0, data_node.get());
+      new_device_tensor->SetNodeIndex(data_node, 0);
+      device_tensor = new_device_tensor;
+    }
+    input_device_tensors_[i] = device_tensor.get();
+  }
+}
+
+bool GraphCapture::CheckFixedDeviceTensor() const {
+  for (size_t i = 0; i < fixed_device_tensors_.size(); ++i) {
+    const auto &source = fixed_device_tensor_sources_[i];
+    const auto &fixed_device_tensor = fixed_device_tensors_[i];
+    if ((source.node_ != nullptr) && (FetchDeviceTensor(source) != fixed_device_tensor.first)) {
+      return false;
+    }
+    if (fixed_device_tensor.first->GetPtr() != fixed_device_tensor.second) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < output_device_tensors_.size(); ++i) {
+    if (FetchDeviceTensor(output_device_tensor_sources_[i]) != output_device_tensors_[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+DeviceTensor *GraphCapture::FetchDeviceTensor(const CaptureTensorSource &source) const {
+  if (source.data_position_ != SIZE_MAX) {
+    if (source.data_position_ >= input_device_tensors_.size()) {
+      MS_LOG(EXCEPTION) << "The data position is out of range: " << source.data_position_;
+    }
+    return input_device_tensors_[source.data_position_];
+  }
+  MS_EXCEPTION_IF_NULL(source.node_);
+  if (source.is_device_tensor_store_) {
+    MS_EXCEPTION_IF_NULL(device_context_);
+    return DeviceTensorStore::GetInstance().Fetch(source.node_.get(), device_context_->GetDeviceAddressType());
+  }
+  return AnfAlgo::GetMutableOutputAddr(source.node_, source.index_, false).get();
+}
+
+void GraphCapture::Record(const std::vector<std::vector<TensorPtr>> &input_tensors,
+                          OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  MS_EXCEPTION_IF_NULL(device_context_);
+  MS_EXCEPTION_IF_NULL(output_actor_);
+  is_recorded_ = true;
+
+  // Record the shape and type of input tensors, and allocate the device tensors of graph inputs.
+  input_shapes_.resize(data_nodes_.size());
+  input_types_.resize(data_nodes_.size(), kTypeUnknown);
+  for (size_t i = 0; i < input_positions_.size(); ++i) {
+    for (size_t j = 0; j < input_tensors[i].size(); ++j) {
+      auto position = input_positions_[i][j];
+      if (position != SIZE_MAX) {
+        input_shapes_[position] = input_tensors[i][j]->shape();
+        input_types_[position] = input_tensors[i][j]->data_type();
+      }
+    }
+  }
+  mindspore::HashSet<DeviceTensor *> held_device_tensors;
+  for (auto &device_tensor : input_device_tensors_) {
+    MS_EXCEPTION_IF_NULL(device_tensor);
+    (void)held_device_tensors.insert(device_tensor);
+    if ((device_tensor->GetPtr() == nullptr) &&
+        (!device_context_->AllocateMemory(device_tensor, device_tensor->GetSize()))) {
+      SET_OPCONTEXT_MEMORY_ALLOC_FAIL_BY_STRATEGY(GraphExecutionStrategy::kPipeline, *context, *device_context_, name_,
+                                                  device_tensor->GetSize());
+    }
+  }
+
+  // The graph outputs are allocated every step, the others are sent to the output actor directly.
+  mindspore::HashMap<DeviceTensor *, size_t> output_indexes;
+  for (auto &output : outputs_) {
+    auto device_tensor = FetchDeviceTensor(output.second);
+    MS_EXCEPTION_IF_NULL(device_tensor);
+    if ((held_device_tensors.count(device_tensor) == 0) && (device_tensor->GetPtr() == nullptr)) {
+      output_indexes[device_tensor] = output_device_tensors_.size();
+      (void)output_device_tensors_.emplace_back(device_tensor);
+      (void)output_device_tensor_sources_.emplace_back(output.second);
+      (void)held_device_tensors.insert(device_tensor);
+    }
+    (void)output_data_.emplace_back(
+      std::make_unique<OpData<DeviceTensor>>(output_actor_->GetAID(), device_tensor, SizeToInt(output.first)));
+  }
+  output_launch_addresses_.resize(output_device_tensors_.size());
+
+  // Resolve the device tensors of kernels: input + output + workspace.
+  std::vector<std::vector<DeviceTensor *>> kernel_device_tensors(kernels_.size());
+  std::vector<std::vector<CaptureTensorSource>> kernel_device_tensor_sources(kernels_.size());
+  std::vector<size_t> kernel_output_nums(kernels_.size());
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    auto &kernel = kernels_[i];
+    MS_EXCEPTION_IF_NULL(kernel.kernel_);
+    auto kernel_info = dynamic_cast<KernelInfo *>(kernel.kernel_->kernel_info());
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    for (auto &input : kernel.inputs_) {
+      (void)kernel_device_tensors[i].emplace_back(FetchDeviceTensor(input));
+      (void)kernel_device_tensor_sources[i].emplace_back(input);
+    }
+    const auto &output_addresses = kernel_info->output_address_list();
+    kernel_output_nums[i] = output_addresses.size();
+    for (size_t j = 0; j < output_addresses.size(); ++j) {
+      (void)kernel_device_tensors[i].emplace_back(output_addresses[j].get());
+      (void)kernel_device_tensor_sources[i].emplace_back(CaptureTensorSource{kernel.kernel_, j});
+    }
+    for (auto &workspace_address : kernel_info->workspace_address_list()) {
+      (void)kernel_device_tensors[i].emplace_back(workspace_address.get());
+      // The workspace can't be fetched by the source, only its ptr is checked.
+      (void)kernel_device_tensor_sources[i].emplace_back(CaptureTensorSource());
+    }
+    // The ref output usually shares the device tensor of ref input, so it is refreshed once.
+    std::vector<size_t> ref_positions(kernel.ref_input_indexes_);
+    for (auto ref_output_index : kernel.ref_output_indexes_) {
+      (void)ref_positions.emplace_back(kernel.inputs_.size() + ref_output_index);
+    }
+    for (auto position : ref_positions) {
+      if (position >= kernel.inputs_.size() + kernel_output_nums[i]) {
+        MS_LOG(EXCEPTION) << "The ref position " << position << " is out of range of kernel "
+                          << kernel.kernel_->fullname_with_scope();
+      }
+      auto device_tensor = kernel_device_tensors[i][position];
+      if (std::find(kernel.ref_device_tensors_.begin(), kernel.ref_device_tensors_.end(), device_tensor) ==
+          kernel.ref_device_tensors_.end()) {
+        (void)kernel.ref_device_tensors_.emplace_back(device_tensor);
+      }
+    }
+  }
+
+  // The device tensors whose memory exists before the step, such as the weights, are fixed and not held.
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    for (size_t j = 0; j < kernel_device_tensors[i].size(); ++j) {
+      auto device_tensor = kernel_device_tensors[i][j];
+      MS_EXCEPTION_IF_NULL(device_tensor);
+      if ((held_device_tensors.count(device_tensor) > 0) || (device_tensor->GetPtr() == nullptr)) {
+        continue;
+      }
+      (void)held_device_tensors.insert(device_tensor);
+      (void)fixed_device_tensors_.emplace_back(device_tensor, device_tensor->GetPtr());
+      (void)fixed_device_tensor_sources_.emplace_back(kernel_device_tensor_sources[i][j]);
+    }
+  }
+  PlanMemory(kernel_device_tensors, held_device_tensors);
+  if (planned_memory_size_ > 0) {
+    planned_memory_ = device_context_->AllocateMemory(planned_memory_size_);
+    if (planned_memory_ == nullptr) {
+      SET_OPCONTEXT_MEMORY_ALLOC_FAIL_BY_STRATEGY(GraphExecutionStrategy::kPipeline, *context, *device_context_, name_,
+                                                  planned_memory_size_);
+    }
+    for (size_t i = 0; i < planned_device_tensors_.size(); ++i) {
+      planned_device_tensors_[i]->set_ptr(static_cast<uint8_t *>(planned_memory_) + planned_offsets_[i]);
+      planned_device_tensors_[i]->set_from_mem_pool(false);
+    }
+  }
+
+  // Build the launch info by the resolved addresses, the addresses of graph outputs are updated every step.
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    auto &kernel = kernels_[i];
+    auto &launch_info = kernel.launch_info_;
+    auto input_num = kernel.inputs_.size();
+    auto output_num = kernel_output_nums[i];
+    for (size_t j = 0; j < kernel_device_tensors[i].size(); ++j) {
+      auto device_tensor = kernel_device_tensors[i][j];
+      auto address = std::make_shared<Address>(device_tensor->GetMutablePtr(), device_tensor->GetSize());
+      const auto &iter = output_indexes.find(device_tensor);
+      if (iter != output_indexes.end()) {
+        (void)output_launch_addresses_[iter->second].emplace_back(address.get());
+      }
+      if (j < input_num) {
+        (void)launch_info.inputs_.emplace_back(address);
+      } else if (j < input_num + output_num) {
+        (void)launch_info.outputs_.emplace_back(address);
+      } else {
+        (void)launch_info.workspaces_.emplace_back(address);
+      }
+    }
+  }
+  MS_LOG(INFO) << "Graph capture " << name_ << " records " << kernels_.size() << " kernels, planned memory size: "
+               << planned_memory_size_ << ", planned device tensor num: " << planned_device_tensors_.size()
+               << ", fixed device tensor num: " << fixed_device_tensors_.size()
+               << ", graph output num: " << output_device_tensors_.size();
+}
+
+void GraphCapture::PlanMemory(const std::vector<std::vector<DeviceTensor *>> &kernel_device_tensors,
+                              const mindspore::HashSet<DeviceTensor *> &held_device_tensors) {
+  // Collect the lifetime of the device tensors which are allocated and freed in the step.
+  std::vector<PlannedBlock> blocks;
+  mindspore::HashMap<DeviceTensor *, size_t> block_indexes;
+  for (size_t i = 0; i < kernel_device_tensors.size(); ++i) {
+    for (auto &device_tensor : kernel_device_tensors[i]) {
+      if (held_device_tensors.count(device_tensor) > 0) {
+        continue;
+      }
+      const auto &iter = block_indexes.find(device_tensor);
+      if (iter != block_indexes.end()) {
+        blocks[iter->second].last_use_ = i;
+        continue;
+      }
+      block_indexes[device_tensor] = blocks.size();
+      (void)blocks.emplace_back(PlannedBlock{device_tensor, AlignCaptureMemorySize(device_tensor->GetSize()), i, i, 0});
+    }
+  }
+
+  // Place the larger blocks first at the lowest offset which doesn't overlap the placed blocks in the same lifetime.
+  std::vector<size_t> order(blocks.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&blocks](size_t lhs, size_t rhs) { return blocks[lhs].size_ > blocks[rhs].size_; });
+  std::vector<PlannedBlock *> placed_blocks;
+  for (auto index : order) {
+    auto &block = blocks[index];
+    std::vector<PlannedBlock *> live_blocks;
+    for (auto &placed_block : placed_blocks) {
+      if ((placed_block->first_use_ <= block.last_use_) && (block.first_use_ <= placed_block->last_use_)) {
+        (void)live_blocks.emplace_back(placed_block);
+      }
+    }
+    std::sort(live_blocks.begin(), live_blocks.end(),
+              [](const PlannedBlock *lhs, const PlannedBlock *rhs) { return lhs->offset_ < rhs->offset_; });
+    size_t offset = 0;
+    for (auto &live_block : live_blocks) {
+      if (offset + block.size_ <= live_block->offset_) {
+        break;
+      }
+      offset = std::max(offset, live_block->offset_ + live_block->size_);
+    }
+    block.offset_ = offset;
+    planned_memory_size_ = std::max(planned_memory_size_, offset + block.size_);
+    (void)placed_blocks.emplace_back(&block);
+  }
+
+  for (auto &block : blocks) {
+    (void)planned_device_tensors_.emplace_back(block.device_tensor_);
+    (void)planned_offsets_.emplace_back(block.offset_);
+  }
+}
+
+void GraphCapture::CopyInputTensor(const std::vector<std::vector<TensorPtr>> &input_tensors,
+                                   OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  for (size_t i = 0; i < input_positions_.size(); ++i) {
+    for (size_t j = 0; j < input_tensors[i].size(); ++j) {
+      auto position = input_positions_[i][j];
+      if (position == SIZE_MAX) {
+        continue;
+      }
+      const auto &input_tensor = input_tensors[i][j];
+      auto device_tensor = input_device_tensors_[position];
+      MS_EXCEPTION_IF_NULL(input_tensor);
+      MS_EXCEPTION_IF_NULL(device_tensor);
+      // Copy in the same way as the host data source actor.
+      auto tensor_device_address = std::dynamic_pointer_cast<DeviceTensor>(input_tensor->device_address());
+      if (tensor_device_address != nullptr) {
+        if ((tensor_device_address.get() != device_tensor) && (!Copy(device_tensor, tensor_device_address.get()))) {
+          SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), "Copy data failed.");
+        }
+        continue;
+      }
+      if (!device_tensor->SyncHostToDevice(trans::GetRuntimePaddingShape(data_nodes_[position], 0),
+                                           LongToSize(input_tensor->data().nbytes()), input_tensor->data_type(),
+                                           input_tensor->data_c(), input_tensor->device_info().host_format_)) {
+        SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), "SyncHostToDevice failed.");
+      }
+    }
+  }
+}
+
+void GraphCapture::AllocateOutputMemory(OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  MS_EXCEPTION_IF_NULL(device_context_);
+  for (size_t i = 0; i < output_device_tensors_.size(); ++i) {
+    auto device_tensor = output_device_tensors_[i];
+    if ((device_tensor->GetPtr() == nullptr) &&
+        (!device_context_->AllocateMemory(device_tensor, device_tensor->GetSize()))) {
+      SET_OPCONTEXT_MEMORY_ALLOC_FAIL_BY_STRATEGY(GraphExecutionStrategy::kPipeline, *context, *device_context_, name_,
+                                                  device_tensor->GetSize());
+    }
+    for (auto &address : output_launch_addresses_[i]) {
+      address->addr = device_tensor->GetMutablePtr();
+    }
+  }
+}
+
+void GraphCapture::LaunchKernels(OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  MS_EXCEPTION_IF_NULL(device_context_);
+  // The profiling data of every kernel is collected by the device context.
+  bool is_profiling = false;
+#ifndef ENABLE_SECURITY
+  const auto &profiler_inst = profiler::cpu::CPUProfiler::GetInstance();
+  MS_EXCEPTION_IF_NULL(profiler_inst);
+  is_profiling = profiler_inst->GetEnableFlag();
+#endif
+  for (auto &kernel : kernels_) {
+    const auto &launch_info = kernel.launch_info_;
+    try {
+      auto ret = (kernel.is_launch_by_device_context_ || is_profiling)
+                   ? device_context_->LaunchKernel(kernel.kernel_, launch_info.inputs_, launch_info.workspaces_,
+                                                   launch_info.outputs_, false)
+                   : kernel.kernel_mod_->Launch(launch_info.inputs_, launch_info.workspaces_, launch_info.outputs_,
+                                                nullptr);
+      if (!ret) {
+        std::string error_info = "Launch kernel failed: " + kernel.kernel_->fullname_with_scope();
+        SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
+      }
+    } catch (const std::exception &e) {
+      MsException::Instance().SetException();
+      std::string error_info = "Launch kernel exception: " + kernel.kernel_->fullname_with_scope();
+      SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
+    }
+
+    for (auto &ref_device_tensor : kernel.ref_device_tensors_) {
+      for (auto &copy_device_tensor : DeviceTensorCopyStore::GetInstance().Fetch(ref_device_tensor)) {
+        MS_EXCEPTION_IF_NULL(copy_device_tensor);
+        if (!Copy(copy_device_tensor, ref_device_tensor)) {
+          std::string error_info = "Copy ref device tensor failed: " + kernel.kernel_->fullname_with_scope();
+          SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
+        }
+      }
+    }
+  }
+}
+
+void GraphCapture::SendOutput(OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  MS_EXCEPTION_IF_NULL(output_actor_);
+  for (auto &output_data : output_data_) {
+    output_actor_->RunOpData(output_data.get(), context);
+  }
+  // The output actor collects the outputs of device tensor store and finishes the step.
+  output_actor_->RunOpControl(nullptr, context);
+}
+}  // namespace runtime
+}  // namespace mindspore
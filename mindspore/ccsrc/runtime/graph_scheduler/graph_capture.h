@@ -0,0 +1,164 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_GRAPH_CAPTURE_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_GRAPH_CAPTURE_H_
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <utility>
+#include "utils/hash_map.h"
+#include "utils/hash_set.h"
+#include "runtime/graph_scheduler/actor/actor_common.h"
+#include "runtime/hardware/device_context.h"
+#include "kernel/kernel.h"
+#include "ir/anf.h"
+#include "ir/tensor.h"
+
+namespace mindspore {
+namespace runtime {
+using mindspore::device::DeviceContext;
+using mindspore::device::KernelInfo;
+using mindspore::kernel::Address;
+using mindspore::kernel::KernelLaunchInfo;
+using mindspore::kernel::KernelMod;
+using mindspore::tensor::TensorPtr;
+
+class DataPrepareActor;
+class OutputActor;
+
+// The source of the device tensor which the captured kernel reads.
+struct CaptureTensorSource {
+  // The kernel output or the key of device tensor store.
+  AnfNodePtr node_{nullptr};
+  size_t index_{0};
+  // The position of graph input in the host data source actor, SIZE_MAX if the source is not graph input.
+  size_t data_position_{SIZE_MAX};
+  bool is_device_tensor_store_{false};
+};
+
+// The captured kernel, the launch info is resolved when the capture records.
+struct CaptureKernel {
+  CNodePtr kernel_{nullptr};
+  KernelMod *kernel_mod_{nullptr};
+  // Some CPU kernels need reinitialize before launch in other threads, they launch by device context.
+  bool is_launch_by_device_context_{false};
+  std::vector<CaptureTensorSource> inputs_;
+  // The ref inputs and outputs modified by the kernel, such as the weights updated by the optimizer, their copies in
+  // the device tensor copy store are refreshed after every launch as the kernel actor does.
+  std::vector<size_t> ref_input_indexes_;
+  std::vector<size_t> ref_output_indexes_;
+  std::vector<DeviceTensor *> ref_device_tensors_;
+  KernelLaunchInfo launch_info_;
+};
+
+// The graph capture records the kernel launch sequence of a static shape CPU actor set with the resolved addresses in
+// the first step, and replays the following steps by launching the kernels one by one in the calling thread, so the
+// steps skip the actor messages, the input fetching and the memory alloc and free requests of every kernel.
+// The memory of intermediate outputs and workspaces is planned into one block by the lifetime in the launch sequence
+// and held by the capture, the graph inputs are copied into the device tensors held by the capture and the graph
+// outputs are allocated every step because they are taken over by the output tensors.
+// The capture is built by the graph scheduler only when the actor set has no control flow, no dynamic shape and no
+// other actors between the kernels, and the step falls back to the actors when the input shapes change.
+class GraphCapture {
+ public:
+  GraphCapture(const std::string &name, const DeviceContext *device_context, DataPrepareActor *data_prepare_actor,
+               OutputActor *output_actor)
+      : name_(name),
+        device_context_(device_context),
+        data_prepare_actor_(data_prepare_actor),
+        output_actor_(output_actor) {}
+  ~GraphCapture() = default;
+
+  // Run one step by the capture, record it if the capture is not recorded. Return false if the step can't run by the
+  // capture and needs to run by the actors, the memory held by the capture is released in that case. The kernels
+  // launch by the device context when the profiler is enabled, so the profiling data of every kernel is collected.
+  bool Run(const std::vector<std::vector<TensorPtr>> &input_tensors, OpContext<DeviceTensor> *const context);
+
+  // Release the memory held by the capture, the next step records again.
+  void Release();
+
+  bool is_recorded() const { return is_recorded_; }
+  size_t kernel_num() const { return kernels_.size(); }
+
+ private:
+  friend class GraphScheduler;
+
+  // Run the step after the data is prepared, the capture records the step first if it is not recorded.
+  void Replay(const std::vector<std::vector<TensorPtr>> &input_tensors, OpContext<DeviceTensor> *const context);
+
+  // Check whether the shape and type of input tensors are the same as the graph inputs.
+  bool CheckInputTensors(const std::vector<std::vector<TensorPtr>> &input_tensors) const;
+  // The device tensors of graph inputs which are held by the capture.
+  void FetchInputDeviceTensor();
+  // Check whether the fixed device tensors, such as the weights, are the same as the recorded.
+  bool CheckFixedDeviceTensor() const;
+
+  // Resolve the device tensors of kernels, plan and allocate memory, and build the launch info.
+  void Record(const std::vector<std::vector<TensorPtr>> &input_tensors, OpContext<DeviceTensor> *const context);
+  DeviceTensor *FetchDeviceTensor(const CaptureTensorSource &source) const;
+  // Plan the offsets of the device tensors which are not held or fixed in one memory block by their lifetime.
+  void PlanMemory(const std::vector<std::vector<DeviceTensor *>> &kernel_device_tensors,
+                  const mindspore::HashSet<DeviceTensor *> &held_device_tensors);
+
+  // Copy the input tensors to the device tensors of graph inputs.
+  void CopyInputTensor(const std::vector<std::vector<TensorPtr>> &input_tensors,
+                       OpContext<DeviceTensor> *const context);
+  // Allocate the graph outputs whose memory is taken over by the output tensors in the last step.
+  void AllocateOutputMemory(OpContext<DeviceTensor> *const context);
+  void LaunchKernels(OpContext<DeviceTensor> *const context);
+  void SendOutput(OpContext<DeviceTensor> *const context);
+
+  std::string name_;
+  const DeviceContext *device_context_;
+  DataPrepareActor *data_prepare_actor_;
+  OutputActor *output_actor_;
+
+  // The captured kernels in launch order.
+  std::vector<CaptureKernel> kernels_;
+  // The graph inputs are the data nodes of host data source actor, the position of input tensor in the data nodes is
+  // indexed by the graph index and the input index.
+  std::vector<AnfNodePtr> data_nodes_;
+  std::vector<std::vector<size_t>> input_positions_;
+  // The graph outputs are sent to the output actor by the output position.
+  std::vector<std::pair<size_t, CaptureTensorSource>> outputs_;
+
+  // The recorded info.
+  bool is_recorded_{false};
+  std::vector<DeviceTensor *> input_device_tensors_;
+  std::vector<ShapeVector> input_shapes_;
+  std::vector<TypeId> input_types_;
+  // The device tensors which are not held by the capture, with the recorded ptr and the source to fetch them again.
+  std::vector<std::pair<DeviceTensor *, const void *>> fixed_device_tensors_;
+  std::vector<CaptureTensorSource> fixed_device_tensor_sources_;
+  // The planned device tensors share the memory block of capture.
+  std::vector<DeviceTensor *> planned_device_tensors_;
+  std::vector<size_t> planned_offsets_;
+  void *planned_memory_{nullptr};
+  size_t planned_memory_size_{0};
+  // The kernel outputs of graph outputs and the launch addresses which use them.
+  std::vector<DeviceTensor *> output_device_tensors_;
+  std::vector<CaptureTensorSource> output_device_tensor_sources_;
+  std::vector<std::vector<Address *>> output_launch_addresses_;
+  std::vector<OpDataUniquePtr<DeviceTensor>> output_data_;
+};
+
+using GraphCapturePtr = std::shared_ptr<GraphCapture>;
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_GRAPH_CAPTURE_H_
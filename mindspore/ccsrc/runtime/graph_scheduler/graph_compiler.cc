@@ -349,6 +349,12 @@ void UpdateRefCountForGraphOutput(const std::vector<KernelWithIndex> &output_wit
 
 GraphCompilerInfo::~GraphCompilerInfo() {
   GraphScheduler::GetInstance().Clear(name_, graphs_, origin_parameters_order_, control_node_parser_);
+  // The device resource of graphs is released after the device tensors are cleared.
+  for (size_t i = 0; i < graphs_.size() && i < device_contexts_.size(); ++i) {
+    if ((graphs_[i] != nullptr) && (device_contexts_[i] != nullptr)) {
+      device_contexts_[i]->ClearGraph(graphs_[i]);
+    }
+  }
 }
 
 GraphId GraphCompiler::CompileGraph(const GraphSegmentPtr &segment, const AnfNodePtrList &outputs,
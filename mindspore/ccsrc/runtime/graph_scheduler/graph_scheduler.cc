@@ -30,6 +30,7 @@
 #include "utils/log_adapter.h"
 #include "include/common/utils/convert_utils.h"
 #include "utils/ms_context.h"
+#include "utils/ms_utils.h"
 #include "utils/profile.h"
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "include/common/utils/signal_util.h"
@@ -50,6 +51,10 @@
 namespace mindspore {
 namespace runtime {
 namespace {
+// The memory of the whole inline chain is allocated before the chain runs, so the length of chain is limited to bound
+// the memory held by the chain.
+constexpr size_t kMaxInlineChainLength = 32;
+
 bool IsNeedInsertCopyActor(const DeviceContext *from_device_context, const DeviceContext *to_device_context) {
   MS_EXCEPTION_IF_NULL(from_device_context);
   MS_EXCEPTION_IF_NULL(to_device_context);
@@ -193,6 +198,10 @@ void GraphScheduler::Clear(const ActorInfo &actor_info, const std::vector<Kernel
       return;
     }
     auto actor_set = actors_[actor_info];
+    // The memory held by the graph capture must be released before the device tensors are cleared.
+    if (actor_set->graph_capture_ != nullptr) {
+      actor_set->graph_capture_->Release();
+    }
     auto base_actors = CollectActors(actor_set.get());
     for (auto &base_actor : base_actors) {
       MS_EXCEPTION_IF_NULL(base_actor);
@@ -395,7 +404,14 @@ void GraphScheduler::Schedule(const ActorSet *actor_set) {
   // Schedule actors.
   auto actor_manager = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actor_manager);
+  // The lock free mailbox is disabled by default until it is validated on more networks.
+  static const bool enable_lock_free_mailbox = (common::GetEnv("MS_DEV_LOCK_FREE_MAILBOX") == "1");
   for (auto actor : actors) {
+    MS_EXCEPTION_IF_NULL(actor);
+    // Kernel actors receive most of the messages of a step, so they use the lock free mailbox.
+    if (enable_lock_free_mailbox && actor->type() == KernelTransformType::kKernelActor) {
+      actor->set_lock_free_mailbox(true);
+    }
     (void)actor_manager->Spawn(actor);
   }
 
@@ -434,14 +450,20 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<DeviceCont
     return;
   }
 
+  // Replay the step by the graph capture, which falls back to the actors when the step can't be replayed.
+  bool is_replayed = (strategy == GraphExecutionStrategy::kPipeline) && (actor_set->graph_capture_ != nullptr) &&
+                     actor_set->graph_capture_->Run(input_tensors, &op_context);
+
   // Trigger data prepare actor running.
   MS_EXCEPTION_IF_NULL(ActorMgr::GetActorMgrRef());
   auto thread_pool = ActorMgr::GetActorMgrRef()->GetActorThreadPool();
   MS_EXCEPTION_IF_NULL(thread_pool);
   ActorDispatcher::is_multi_thread_execution(actor_set->is_multi_thread_execution_);
   double start_time = GetTime();
-  ActorDispatcher::Send(actor_set->data_prepare_actor_->GetAID(), &DataPrepareActor::PrepareData, input_tensors,
-                        &op_context, GraphExecutionStrategy::kPipeline);
+  if (!is_replayed) {
+    ActorDispatcher::Send(actor_set->data_prepare_actor_->GetAID(), &DataPrepareActor::PrepareData, input_tensors,
+                          &op_context, GraphExecutionStrategy::kPipeline);
+  }
 
   // Get the run result.
   auto result_future = result[0].GetFuture();
@@ -476,6 +498,10 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<DeviceCont
     }
   }
 
+  // The replayed step doesn't run by the actors, so it isn't counted in the execution strategy.
+  if (is_replayed) {
+    return;
+  }
   double end_time = GetTime();
   const size_t kSecondsToMilliseconds = 1000;
   SetActorExecutionStrategy(actor_set, strategy, (end_time - start_time) * kSecondsToMilliseconds);
@@ -652,6 +678,307 @@ void GraphScheduler::Link(ActorSet *actor_set, const GraphCompilerInfo &graph_co
 void GraphScheduler::Optimize(ActorSet *const actor_set) {
   MS_EXCEPTION_IF_NULL(actor_set);
   control_node_scheduler_.Optimize(actor_set->control_actors_.get());
+  FuseKernelActorChain(actor_set);
+  BuildGraphCapture(actor_set);
+}
+
+void GraphScheduler::FuseKernelActorChain(const ActorSet *actor_set) const {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  // The head of inline chain holds the memory of the whole chain, which raises the peak memory, so it is disabled by
+  // default.
+  static const bool enable_inline_chain = (common::GetEnv("MS_DEV_INLINE_KERNEL_ACTOR") == "1");
+  if (!enable_inline_chain) {
+    return;
+  }
+
+  mindspore::HashMap<std::string, KernelActor *> name_to_actors;
+  for (auto &kernel_actor : actor_set->kernel_actors_) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    name_to_actors[kernel_actor->GetAID().Name()] = kernel_actor.get();
+  }
+
+  // All the inputs of the next actor come from the actor, so every actor has one previous actor at most.
+  mindspore::HashMap<KernelActor *, KernelActor *> actor_to_next_actors;
+  mindspore::HashSet<KernelActor *> next_actors;
+  for (auto &kernel_actor : actor_set->kernel_actors_) {
+    auto next_actor = FetchInlineNextActor(kernel_actor.get(), name_to_actors);
+    if (next_actor != nullptr) {
+      actor_to_next_actors[kernel_actor.get()] = next_actor;
+      (void)next_actors.insert(next_actor);
+    }
+  }
+
+  // Walk the chains from the heads and cut them by the max length.
+  size_t chain_num = 0;
+  size_t fused_actor_num = 0;
+  for (auto &kernel_actor : actor_set->kernel_actors_) {
+    auto head = kernel_actor.get();
+    if ((next_actors.count(head) > 0) || (actor_to_next_actors.count(head) == 0)) {
+      continue;
+    }
+    ++chain_num;
+    for (auto actor = head; actor_to_next_actors.count(actor) > 0; actor = actor_to_next_actors[actor]) {
+      auto next_actor = actor_to_next_actors[actor];
+      if (head->inline_actors_.size() + 1 >= kMaxInlineChainLength) {
+        head = next_actor;
+        ++chain_num;
+        continue;
+      }
+      actor->inline_next_ = next_actor;
+      (void)head->inline_actors_.emplace_back(next_actor);
+      ++fused_actor_num;
+    }
+  }
+  MS_LOG(INFO) << "Actor set: " << actor_set->name_ << " fuses " << fused_actor_num << " kernel actors into "
+               << chain_num << " inline chains.";
+}
+
+KernelActor *GraphScheduler::FetchInlineNextActor(
+  const KernelActor *actor, const mindspore::HashMap<std::string, KernelActor *> &name_to_actors) const {
+  MS_EXCEPTION_IF_NULL(actor);
+  auto is_inline_actor = [](const KernelActor *kernel_actor) {
+    // The debug actor must be called back between the kernels, and the dynamic shape kernel can't allocate the
+    // memory of its outputs before the previous kernels launch.
+    const auto &device_context = kernel_actor->device_contexts_[0];
+    MS_EXCEPTION_IF_NULL(device_context);
+    return (kernel_actor->type_ == KernelTransformType::kKernelActor) &&
+           (kernel_actor->strategy_ == GraphExecutionStrategy::kPipeline) && (kernel_actor->debug_aid_ == nullptr) &&
+           (device_context->GetDeviceAddressType() == device::DeviceAddressType::kCPU) &&
+           (!common::AnfAlgo::IsDynamicShape(kernel_actor->kernel_));
+  };
+  if (!is_inline_actor(actor)) {
+    return nullptr;
+  }
+
+  // All the output arrows point to the same kernel actor.
+  std::string next_actor_name;
+  for (auto &data_arrow : actor->output_data_arrows_) {
+    MS_EXCEPTION_IF_NULL(data_arrow);
+    if ((!next_actor_name.empty()) && (data_arrow->to_op_id_.Name() != next_actor_name)) {
+      return nullptr;
+    }
+    next_actor_name = data_arrow->to_op_id_.Name();
+  }
+  for (auto &control_arrow : actor->output_control_arrows_) {
+    if ((!next_actor_name.empty()) && (control_arrow.Name() != next_actor_name)) {
+      return nullptr;
+    }
+    next_actor_name = control_arrow.Name();
+  }
+  const auto &iter = name_to_actors.find(next_actor_name);
+  if (iter == name_to_actors.end()) {
+    return nullptr;
+  }
+  auto next_actor = iter->second;
+  MS_EXCEPTION_IF_NULL(next_actor);
+  if ((!is_inline_actor(next_actor)) || (next_actor->device_contexts_[0] != actor->device_contexts_[0])) {
+    return nullptr;
+  }
+
+  // All the inputs of the next actor come from the actor.
+  if ((next_actor->input_datas_num_ != actor->output_data_arrows_.size()) ||
+      (next_actor->input_controls_num_ != actor->output_control_arrows_.size())) {
+    return nullptr;
+  }
+  return next_actor;
+}
+
+void GraphScheduler::BuildGraphCapture(ActorSet *const actor_set) const {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  static const bool enable_graph_capture = (common::GetEnv("MS_DEV_GRAPH_CAPTURE") == "1");
+  if ((!enable_graph_capture) || actor_set->kernel_actors_.empty()) {
+    return;
+  }
+
+  // The actor set can't be captured if there are other actors between the kernel actors, and the step must be run
+  // once by the data prepare actor, the loop count actor and the output actor.
+  if ((actor_set->control_actors_ != nullptr) || (!actor_set->custom_actors_.empty()) ||
+      (!actor_set->super_kernel_actors_.empty()) || (!actor_set->copy_actors_.empty())) {
+    return;
+  }
+#ifdef ENABLE_RPC_ACTOR
+  if (actor_set->rpc_actors_ != nullptr) {
+    return;
+  }
+#endif
+  const auto &data_prepare_actor = actor_set->data_prepare_actor_;
+  const auto &loop_count_actor = actor_set->loop_count_actor_;
+  const auto &output_actor = actor_set->output_actor_;
+  if ((data_prepare_actor == nullptr) || (loop_count_actor == nullptr) || (output_actor == nullptr) ||
+      (data_prepare_actor->debug_aid_ != nullptr) || (!data_prepare_actor->continuous_memory_nodes_.empty()) ||
+      (loop_count_actor->loop_count_ != 1) || (loop_count_actor->debug_aid_ != nullptr) ||
+      (loop_count_actor->recorder_aid_ != nullptr) || (output_actor->loop_count_ != 1)) {
+    return;
+  }
+  HostQueueDataSourceActor *host_ds_actor = nullptr;
+  for (auto &data_source_actor : actor_set->data_source_actors_) {
+    MS_EXCEPTION_IF_NULL(data_source_actor);
+    if (data_source_actor->type_ != KernelTransformType::kHostDataSourceActor) {
+      return;
+    }
+    host_ds_actor = dynamic_cast<HostQueueDataSourceActor *>(data_source_actor.get());
+  }
+
+  const auto &device_context = actor_set->kernel_actors_[0]->device_contexts_[0];
+  MS_EXCEPTION_IF_NULL(device_context);
+  if (device_context->GetDeviceAddressType() != device::DeviceAddressType::kCPU) {
+    return;
+  }
+  mindspore::HashMap<std::string, size_t> name_to_indexes;
+  std::vector<CaptureKernel> kernels(actor_set->kernel_actors_.size());
+  for (size_t i = 0; i < actor_set->kernel_actors_.size(); ++i) {
+    const auto &kernel_actor = actor_set->kernel_actors_[i];
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    const auto &kernel = kernel_actor->kernel_;
+    MS_EXCEPTION_IF_NULL(kernel);
+    auto kernel_info = dynamic_cast<KernelInfo *>(kernel->kernel_info());
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    auto kernel_mod = kernel_info->MutableKernelMod();
+    if ((kernel_actor->type_ != KernelTransformType::kKernelActor) ||
+        (kernel_actor->strategy_ != GraphExecutionStrategy::kPipeline) || (kernel_actor->debug_aid_ != nullptr) ||
+        (kernel_actor->device_contexts_[0] != device_context) || common::AnfAlgo::IsDynamicShape(kernel) ||
+        (kernel_mod == nullptr) ||
+        (kernel_mod->GetOutputSizeList().size() != kernel_info->output_address_list().size())) {
+      return;
+    }
+    name_to_indexes[kernel_actor->GetAID().Name()] = i;
+    kernels[i].kernel_ = kernel;
+    kernels[i].kernel_mod_ = kernel_mod;
+    kernels[i].is_launch_by_device_context_ =
+      (kOpNotSupportMultiThreadExecList.count(common::AnfAlgo::GetCNodeName(kernel)) > 0);
+    kernels[i].inputs_.resize(common::AnfAlgo::GetInputTensorNum(kernel));
+    // The ref weights are the fixed device tensors of capture and their addresses are checked every step.
+    kernels[i].ref_input_indexes_.assign(kernel_actor->modifiable_ref_input_indexes_.begin(),
+                                         kernel_actor->modifiable_ref_input_indexes_.end());
+    kernels[i].ref_output_indexes_.assign(kernel_actor->modifiable_ref_output_indexes_.begin(),
+                                          kernel_actor->modifiable_ref_output_indexes_.end());
+  }
+
+  // Resolve the source of every kernel input by the data arrows and the device tensor stores.
+  std::vector<std::vector<bool>> is_input_resolved(kernels.size());
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    is_input_resolved[i].resize(kernels[i].inputs_.size(), false);
+  }
+  auto resolve_input = [&kernels, &is_input_resolved](size_t kernel_index, size_t input_index,
+                                                      const CaptureTensorSource &source) {
+    if ((input_index >= kernels[kernel_index].inputs_.size()) || is_input_resolved[kernel_index][input_index]) {
+      return false;
+    }
+    kernels[kernel_index].inputs_[input_index] = source;
+    is_input_resolved[kernel_index][input_index] = true;
+    return true;
+  };
+  std::vector<std::pair<size_t, CaptureTensorSource>> outputs;
+  std::vector<size_t> in_degrees(kernels.size(), 0);
+  std::vector<std::vector<size_t>> successors(kernels.size());
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    const auto &kernel_actor = actor_set->kernel_actors_[i];
+    for (const auto &device_tensor_store_key : kernel_actor->device_tensor_store_keys_) {
+      if (!resolve_input(i, device_tensor_store_key.first,
+                         CaptureTensorSource{device_tensor_store_key.second, 0, SIZE_MAX, true})) {
+        return;
+      }
+    }
+    for (size_t j = 0; j < kernel_actor->output_data_arrows_.size(); ++j) {
+      const auto &data_arrow = kernel_actor->output_data_arrows_[j];
+      MS_EXCEPTION_IF_NULL(data_arrow);
+      CaptureTensorSource source{kernel_actor->output_data_nodes_[j], IntToSize(data_arrow->from_output_index_)};
+      if (data_arrow->to_op_id_ == output_actor->GetAID()) {
+        (void)outputs.emplace_back(IntToSize(data_arrow->to_input_index_), source);
+        continue;
+      }
+      const auto &iter = name_to_indexes.find(data_arrow->to_op_id_.Name());
+      if ((iter == name_to_indexes.end()) ||
+          (!resolve_input(iter->second, IntToSize(data_arrow->to_input_index_), source))) {
+        return;
+      }
+      (void)successors[i].emplace_back(iter->second);
+      ++in_degrees[iter->second];
+    }
+    for (const auto &control_arrow : kernel_actor->output_control_arrows_) {
+      const auto &iter = name_to_indexes.find(control_arrow.Name());
+      if (iter != name_to_indexes.end()) {
+        (void)successors[i].emplace_back(iter->second);
+        ++in_degrees[iter->second];
+      }
+    }
+  }
+  if (host_ds_actor != nullptr) {
+    for (size_t j = 0; j < host_ds_actor->output_data_arrows_.size(); ++j) {
+      const auto &data_arrow = host_ds_actor->output_data_arrows_[j];
+      MS_EXCEPTION_IF_NULL(data_arrow);
+      CaptureTensorSource source;
+      source.data_position_ = host_ds_actor->FetchNodePosition(host_ds_actor->output_data_nodes_[j]);
+      if (data_arrow->to_op_id_ == output_actor->GetAID()) {
+        (void)outputs.emplace_back(IntToSize(data_arrow->to_input_index_), source);
+        continue;
+      }
+      const auto &iter = name_to_indexes.find(data_arrow->to_op_id_.Name());
+      if ((iter == name_to_indexes.end()) ||
+          (!resolve_input(iter->second, IntToSize(data_arrow->to_input_index_), source))) {
+        return;
+      }
+    }
+  }
+  for (const auto &resolved : is_input_resolved) {
+    if (std::find(resolved.begin(), resolved.end(), false) != resolved.end()) {
+      return;
+    }
+  }
+  if (outputs.size() + output_actor->device_tensor_store_keys_.size() != output_actor->outputs_num_) {
+    return;
+  }
+
+  // The launch order is the topological order of the arrows, the kernels keep the order of kernel actors if possible.
+  std::set<size_t> ready_kernels;
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    if (in_degrees[i] == 0) {
+      (void)ready_kernels.insert(i);
+    }
+  }
+  std::vector<size_t> launch_order;
+  while (!ready_kernels.empty()) {
+    auto index = *ready_kernels.begin();
+    (void)ready_kernels.erase(ready_kernels.begin());
+    (void)launch_order.emplace_back(index);
+    for (auto successor : successors[index]) {
+      if (--in_degrees[successor] == 0) {
+        (void)ready_kernels.insert(successor);
+      }
+    }
+  }
+  if (launch_order.size() != kernels.size()) {
+    MS_LOG(WARNING) << "The kernel actors of actor set: " << actor_set->name_ << " have a cycle.";
+    return;
+  }
+
+  auto graph_capture = std::make_shared<GraphCapture>(actor_set->name_, device_context, data_prepare_actor.get(),
+                                                      output_actor.get());
+  for (auto index : launch_order) {
+    (void)graph_capture->kernels_.emplace_back(std::move(kernels[index]));
+  }
+  graph_capture->outputs_ = std::move(outputs);
+  if (host_ds_actor != nullptr) {
+    graph_capture->data_nodes_ = host_ds_actor->data_nodes_;
+  }
+  const auto &graphs = data_prepare_actor->graph_compiler_info_->graphs_;
+  graph_capture->input_positions_.resize(graphs.size());
+  for (size_t i = 0; i < graphs.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(graphs[i]);
+    for (const auto &input_node : graphs[i]->input_nodes()) {
+      size_t position = SIZE_MAX;
+      if (host_ds_actor != nullptr) {
+        const auto &iter = host_ds_actor->data_node_position_map_.find(input_node);
+        if (iter != host_ds_actor->data_node_position_map_.end()) {
+          position = iter->second;
+        }
+      }
+      (void)graph_capture->input_positions_[i].emplace_back(position);
+    }
+  }
+  actor_set->graph_capture_ = graph_capture;
+  MS_LOG(INFO) << "Actor set: " << actor_set->name_ << " builds the graph capture of " << kernels.size()
+               << " kernels.";
 }
 
 std::vector<DataSourceActorPtr> GraphScheduler::BuildDataSourceActor(const GraphCompilerInfo &graph_compiler_info,
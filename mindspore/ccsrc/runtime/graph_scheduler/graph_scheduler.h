@@ -100,6 +100,15 @@ class GraphScheduler {
   void Link(ActorSet *actor_set, const GraphCompilerInfo &graph_compiler_info);
   // Optimize the actor DAG. For example, erase invalid data arrow, etc.
   void Optimize(ActorSet *const actor_set);
+  // Fuse the linear chains of kernel actors on CPU into inline chains, which launch kernels back to back without
+  // messages. The actor model is kept at the real fan-in and fan-out points.
+  void FuseKernelActorChain(const ActorSet *actor_set) const;
+  // Get the kernel actor which can run inline right after the actor, return nullptr if there is none.
+  KernelActor *FetchInlineNextActor(const KernelActor *actor,
+                                    const mindspore::HashMap<std::string, KernelActor *> &name_to_actors) const;
+  // Build the graph capture which records the kernel launches of the first step and replays the following steps, only
+  // for the actor set which consists of the static shape kernel actors on CPU.
+  void BuildGraphCapture(ActorSet *const actor_set) const;
 
   // The processing of actors build.
   std::vector<DataSourceActorPtr> BuildDataSourceActor(const GraphCompilerInfo &graph_compiler_info,
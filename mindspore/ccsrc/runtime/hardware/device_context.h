@@ -61,6 +61,9 @@ class DeviceContext {
   // Destroy device context and release device resource.
   virtual void Destroy() {}
 
+  // Release the device resource held by the graph when the graph is cleared.
+  virtual void ClearGraph(const KernelGraphPtr &graph) const {}
+
   // Partition the function graph through the device capability and return the partition segments.
   // The second parameter is the default partition segments which are provided by the framework.
   // Device can reprocess the default partition segments to new segments, also can partition the function graph again.
@@ -15,31 +15,155 @@
  */
 
 #include "runtime/op_builder/op_lazy_builder.h"
+#include "utils/ms_utils.h"
+#include "include/common/utils/scoped_long_running.h"
 
 namespace mindspore::runtime {
+OpLazyBuilder::OpLazyBuilder() { async_launch_ = (common::GetEnv("MS_DEV_PYNATIVE_ASYNC_LAUNCH") == "1"); }
+
+OpLazyBuilder::~OpLazyBuilder() {
+  // The async thread is joined in Finalize, detach it if the process exits without clearing the resource, rather than
+  // joining it in the static destructor.
+  if (async_thread_.joinable()) {
+    async_thread_.detach();
+  }
+}
+
+std::unique_lock<std::recursive_mutex> OpLazyBuilder::LockBackend() {
+  std::unique_lock<std::recursive_mutex> lock(backend_mutex_, std::defer_lock);
+  if (!lock.try_lock()) {
+    mindspore::ScopedLongRunning long_running;
+    lock.lock();
+  }
+  return lock;
+}
+
 void OpLazyBuilder::Register(const std::function<void()> &callback) {
+  auto lock = LockBackend();
   execute_callback_ = callback;
   registered_ = true;
 }
 
 void OpLazyBuilder::Reset() {
+  auto lock = LockBackend();
   ClearAllResources();
   execute_callback_ = nullptr;
   registered_ = false;
+  // The exception of the cleared tasks in the async thread is dropped.
+  std::lock_guard<std::mutex> async_lock(async_mutex_);
+  async_exception_ = nullptr;
+}
+
+void OpLazyBuilder::ResetAfterFailure() {
+  if (in_async_thread_) {
+    return;
+  }
+  Reset();
 }
 
 void OpLazyBuilder::ClearAllResources() {
+  auto lock = LockBackend();
   op_build_tasks.clear();
   std::queue<std::shared_ptr<OpTask>> empty;
   std::swap(op_run_tasks, empty);
 }
 
 void OpLazyBuilder::ExecuteRemainingTasks() {
+  RethrowAsyncException();
   if (!executing_) {
     ExecuteGuard guard;
-    if (execute_callback_ != nullptr) {
-      execute_callback_();
+    std::function<void()> callback;
+    {
+      auto lock = LockBackend();
+      callback = execute_callback_;
+    }
+    // The callback locks the backend for each task, so it also waits for the task executing in the async thread.
+    if (callback != nullptr) {
+      callback();
+    }
+    // The task may fail in the async thread while waiting.
+    RethrowAsyncException();
+  }
+}
+
+void OpLazyBuilder::ExecuteRemainingTasksAsync() {
+  RethrowAsyncException();
+  bool launch_async = false;
+  {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    // The tasks are executed in the current thread if the async thread is finalized.
+    launch_async = async_launch_ && !stop_;
+    if (launch_async) {
+      if (!async_thread_.joinable()) {
+        async_thread_ = std::thread(&OpLazyBuilder::AsyncLaunchLoop, this);
+      }
+      has_async_task_ = true;
+    }
+  }
+  if (launch_async) {
+    async_cond_.notify_one();
+    return;
+  }
+  ExecuteRemainingTasks();
+}
+
+void OpLazyBuilder::Finalize() {
+  {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    stop_ = true;
+  }
+  async_cond_.notify_one();
+  if (async_thread_.joinable()) {
+    // The executing task may acquire the GIL.
+    mindspore::ScopedLongRunning long_running;
+    async_thread_.join();
+  }
+}
+
+void OpLazyBuilder::AsyncLaunchLoop() {
+  in_async_thread_ = true;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(async_mutex_);
+      async_cond_.wait(lock, [this]() { return has_async_task_ || stop_; });
+      if (stop_) {
+        return;
+      }
+      has_async_task_ = false;
+      // The failed task is kept in the queue until the python thread throws the exception and resets the builder.
+      if (async_exception_ != nullptr) {
+        continue;
+      }
     }
+
+    std::function<void()> callback;
+    {
+      auto lock = LockBackend();
+      callback = execute_callback_;
+    }
+    if (callback == nullptr) {
+      continue;
+    }
+    try {
+      ExecuteGuard guard;
+      callback();
+    } catch (...) {
+      MS_LOG(ERROR) << "Execute op tasks failed in the async thread.";
+      std::lock_guard<std::mutex> lock(async_mutex_);
+      async_exception_ = std::current_exception();
+    }
+  }
+}
+
+void OpLazyBuilder::RethrowAsyncException() {
+  std::exception_ptr exception = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    std::swap(exception, async_exception_);
+  }
+  if (exception != nullptr) {
+    Reset();
+    std::rethrow_exception(exception);
   }
 }
 }  // namespace mindspore::runtime
@@ -23,6 +23,11 @@
 #include <map>
 #include <string>
 #include <utility>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include "backend/common/session/kernel_graph.h"
 #include "backend/common/session/anf_runtime_algorithm.h"
 #include "include/common/utils/anfalgo.h"
@@ -81,6 +86,11 @@ class OpRunTask : public OpTask {
   ~OpRunTask() override = default;
 };
 
+// The op tasks are executed in the python thread when the queue is full or the outputs are used. If the async launch
+// is enabled by MS_DEV_PYNATIVE_ASYNC_LAUNCH, the tasks are built and launched in the async thread once they are
+// pushed, so that the python thread goes on with the infer and the kernel select of following ops. The backend is
+// locked by the frontend for each op and by the executor for each task, and the lazy callback of output tensors waits
+// for the remaining tasks before the data is used.
 class OpLazyBuilder {
  public:
   static OpLazyBuilder &GetInstance() {
@@ -90,35 +100,68 @@ class OpLazyBuilder {
 
   class ExecuteGuard {
    public:
-    ExecuteGuard() { OpLazyBuilder::GetInstance().executing_ = true; }
-    ~ExecuteGuard() { OpLazyBuilder::GetInstance().executing_ = false; }
+    ExecuteGuard() { OpLazyBuilder::executing_ = true; }
+    ~ExecuteGuard() { OpLazyBuilder::executing_ = false; }
   };
 
+  // Lock the backend against the tasks executed in the other thread. The GIL is released while waiting, since the
+  // task which holds the backend may acquire the GIL, e.g. the PyFunc kernel.
+  std::unique_lock<std::recursive_mutex> LockBackend();
+
   void Register(const std::function<void()> &callback);
   const std::vector<std::shared_ptr<OpTask>> &GetOpBuildTasks() const { return op_build_tasks; }
   const std::queue<std::shared_ptr<OpTask>> &GetOpRunTasks() const { return op_run_tasks; }
   void ClearOpBuildTasks() { op_build_tasks.clear(); }
   void Reset();
+  // Reset the builder after a task failed. The async thread leaves it to the python thread, which resets the builder
+  // when the exception is thrown again.
+  void ResetAfterFailure();
   void ClearAllResources();
   void ExecuteRemainingTasks();
+  // Wake up the async thread to execute the tasks, or execute them in the current thread if async launch is disabled.
+  void ExecuteRemainingTasksAsync();
+  // Stop and join the async thread, which is called when the resource is cleared at exit.
+  void Finalize();
 
-  void PushOpBuildTask(const std::shared_ptr<OpTask> &op_build_task) { op_build_tasks.push_back(op_build_task); }
-  void PushOpRunTask(const std::shared_ptr<OpTask> &op_run_task) { op_run_tasks.push(op_run_task); }
+  void PushOpBuildTask(const std::shared_ptr<OpTask> &op_build_task) {
+    auto lock = LockBackend();
+    op_build_tasks.push_back(op_build_task);
+  }
+  void PushOpRunTask(const std::shared_ptr<OpTask> &op_run_task) {
+    auto lock = LockBackend();
+    op_run_tasks.push(op_run_task);
+  }
   void PopOpRunTask() { op_run_tasks.pop(); }
   bool QueueEmpty() const { return op_run_tasks.empty() && op_build_tasks.empty(); }
   bool QueueFull() const { return op_build_tasks.size() > kMaxQueueSize || op_run_tasks.size() > kMaxQueueSize; }
   bool registered() const { return registered_; }
+  bool async_launch() const { return async_launch_; }
 
  private:
-  OpLazyBuilder() = default;
-  ~OpLazyBuilder() = default;
+  OpLazyBuilder();
+  ~OpLazyBuilder();
   DISABLE_COPY_AND_ASSIGN(OpLazyBuilder);
+  void AsyncLaunchLoop();
+  // The exception thrown in the async thread is thrown again in the python thread.
+  void RethrowAsyncException();
+
   std::vector<std::shared_ptr<OpTask>> op_build_tasks;
   std::queue<std::shared_ptr<OpTask>> op_run_tasks;
   std::function<void()> execute_callback_{nullptr};
   inline static size_t kMaxQueueSize = 20;
-  bool executing_{false};
+  // The tasks may be executed by the python thread and the async thread, the guard avoids the reentry in each thread.
+  inline static thread_local bool executing_{false};
+  inline static thread_local bool in_async_thread_{false};
   bool registered_{false};
+
+  std::recursive_mutex backend_mutex_;
+  bool async_launch_{false};
+  std::thread async_thread_;
+  std::mutex async_mutex_;
+  std::condition_variable async_cond_;
+  bool has_async_task_{false};
+  bool stop_{false};
+  std::exception_ptr async_exception_{nullptr};
 };
 }  // namespace mindspore::runtime
 #endif  // MINDSPORE_MINDSPORE_CCSRC_RUNTIME_OP_BUILDER_OP_LAZY_BUILDER_H_
@@ -80,6 +80,10 @@ class MS_CORE_API ActorBase {
 
   void set_thread_pool(ActorThreadPool *pool) { pool_ = pool; }
 
+  // Use the lock free mailbox instead of the locked one when the actor is spawned to share threads. It suits the actors
+  // receiving a lot of messages from many senders. This must be called before the actor is spawned.
+  void set_lock_free_mailbox(bool lock_free_mailbox) { lock_free_mailbox_ = lock_free_mailbox; }
+
   // Judge if actor running by the received message number, the default is true.
   virtual bool IsActive(int msg_num) { return true; }
 
@@ -210,6 +214,7 @@ class MS_CORE_API ActorBase {
   uint32_t recordNextPoint = 0;
 
   ActorThreadPool *pool_{nullptr};
+  bool lock_free_mailbox_{false};
 };
 using ActorReference = std::shared_ptr<ActorBase>;
 };  // namespace mindspore
@@ -17,6 +17,8 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 
+#include <cstddef>
+#include <new>
 #include <utility>
 #include <string>
 
@@ -79,6 +81,71 @@ class MessageBase {
   std::string name;
   std::string body;
   Type type;
+  // intrusive link of LockFreeMailBox, only used while the message is enqueued there
+  MessageBase *mailboxNext = nullptr;
+};
+
+// MessageFreeList recycles the memory of the message objects of type T through a bounded per thread list, so that
+// sending a message does not go to the heap allocator in the steady state. A message is usually freed by the thread of
+// the receiving actor, whose list then feeds the messages that thread sends.
+template <typename T>
+class MessageFreeList {
+ public:
+  static void *Allocate(size_t size) noexcept {
+    if (size == sizeof(T)) {
+      FreeList &list = Local();
+      if (list.head != nullptr) {
+        Block *block = list.head;
+        list.head = block->next;
+        list.size--;
+        return block;
+      }
+    }
+    return ::operator new(size, std::nothrow);
+  }
+
+  static void Free(void *ptr, size_t size) noexcept {
+    if (ptr == nullptr) {
+      return;
+    }
+    if (size == sizeof(T)) {
+      FreeList &list = Local();
+      if (list.size < kMaxCachedMessages) {
+        Block *block = static_cast<Block *>(ptr);
+        block->next = list.head;
+        list.head = block;
+        list.size++;
+        return;
+      }
+    }
+    ::operator delete(ptr);
+  }
+
+ private:
+  static constexpr size_t kMaxCachedMessages = 1024;
+
+  struct Block {
+    Block *next;
+  };
+
+  struct FreeList {
+    ~FreeList() {
+      while (head != nullptr) {
+        Block *next = head->next;
+        ::operator delete(head);
+        head = next;
+      }
+      // messages freed during the thread exit afterwards go back to the heap
+      size = kMaxCachedMessages;
+    }
+    Block *head = nullptr;
+    size_t size = 0;
+  };
+
+  static FreeList &Local() {
+    static thread_local FreeList list;
+    return list;
+  }
 };
 }  // namespace mindspore
 
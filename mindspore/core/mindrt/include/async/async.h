@@ -19,6 +19,7 @@
 
 #include <tuple>
 #include <memory>
+#include <new>
 #include <utility>
 
 #include "actor/actor.h"
@@ -36,6 +37,22 @@ class MessageAsync : public MessageBase {
   virtual ~MessageAsync() = default;
   void Run(ActorBase *actor) override { (handler)(actor); }
 
+  // MessageAsync is the message sent by every Async call, so its objects are recycled instead of going to the heap.
+  static void *operator new(size_t size) {
+    void *ptr = MessageFreeList<MessageAsync>::Allocate(size);
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+  static void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    return MessageFreeList<MessageAsync>::Allocate(size);
+  }
+  static void operator delete(void *ptr, size_t size) noexcept { MessageFreeList<MessageAsync>::Free(ptr, size); }
+  static void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+    MessageFreeList<MessageAsync>::Free(ptr, sizeof(MessageAsync));
+  }
+
  private:
   MessageHandler handler;
 };
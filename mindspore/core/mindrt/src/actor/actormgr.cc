@@ -237,7 +237,8 @@ AID ActorMgr::Spawn(const ActorReference &actor, bool shareThread) {
   MS_LOG(DEBUG) << "ACTOR was spawned,a=" << actor->GetAID().Name().c_str();
 
   if (shareThread) {
-    auto mailbox = std::unique_ptr<MailBox>(new (std::nothrow) NonblockingMailBox());
+    auto mailbox = actor->lock_free_mailbox_ ? std::unique_ptr<MailBox>(new (std::nothrow) LockFreeMailBox())
+                                             : std::unique_ptr<MailBox>(new (std::nothrow) NonblockingMailBox());
     auto hook = std::unique_ptr<std::function<void()>>(
       new std::function<void()>([actor]() { ActorMgr::GetActorMgrRef()->SetActorReady(actor); }));
     // the mailbox has this hook, the hook holds the actor reference, the actor has the mailbox. this is a cycle which
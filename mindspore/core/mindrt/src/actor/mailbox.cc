@@ -85,4 +85,65 @@ std::unique_ptr<MessageBase> HQueMailBox::GetMsg() {
   std::unique_ptr<MessageBase> msg(mailbox.Dequeue());
   return msg;
 }
+
+MessageBase *LockFreeMailBox::Released() {
+  static MessageBase sentinel;
+  return &sentinel;
+}
+
+LockFreeMailBox::~LockFreeMailBox() {
+  MessageBase *stack = head.exchange(nullptr);
+  for (MessageBase *list : {batch, stack == Released() ? nullptr : stack}) {
+    while (list != nullptr) {
+      MessageBase *next = list->mailboxNext;
+      delete list;
+      list = next;
+    }
+  }
+  batch = nullptr;
+}
+
+int LockFreeMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
+  MessageBase *msgPtr = msg.release();
+  MessageBase *old = head.load(std::memory_order_relaxed);
+  do {
+    msgPtr->mailboxNext = (old == Released()) ? nullptr : old;
+  } while (!head.compare_exchange_weak(old, msgPtr, std::memory_order_release, std::memory_order_relaxed));
+  if (old == Released() && notifyHook) {
+    (*notifyHook.get())();
+  }
+  return 0;
+}
+
+bool LockFreeMailBox::Drain() {
+  MessageBase *stack = head.exchange(nullptr, std::memory_order_acquire);
+  if (stack == nullptr || stack == Released()) {
+    // Nothing arrived since the last drain. Release the actor, unless a producer comes in between.
+    MessageBase *expected = nullptr;
+    if (head.compare_exchange_strong(expected, Released(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+      return false;
+    }
+    stack = head.exchange(nullptr, std::memory_order_acquire);
+  }
+  // The stack holds the latest message first, reverse it into the arrival order.
+  MessageBase *fifo = nullptr;
+  while (stack != nullptr) {
+    MessageBase *next = stack->mailboxNext;
+    stack->mailboxNext = fifo;
+    fifo = stack;
+    stack = next;
+  }
+  batch = fifo;
+  return true;
+}
+
+std::unique_ptr<MessageBase> LockFreeMailBox::GetMsg() {
+  if (batch == nullptr && !Drain()) {
+    return nullptr;
+  }
+  MessageBase *msg = batch;
+  batch = msg->mailboxNext;
+  msg->mailboxNext = nullptr;
+  return std::unique_ptr<MessageBase>(msg);
+}
 }  // namespace mindspore
@@ -16,6 +16,7 @@
 
 #ifndef MINDSPORE_MAILBOX_H
 #define MINDSPORE_MAILBOX_H
+#include <atomic>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -99,6 +100,29 @@ class HQueMailBox : public MailBox {
   HQueue<MessageBase> mailbox;
   static const int32_t MAX_MSG_QUE_SIZE = 4096;
 };
+
+// LockFreeMailBox is an unbounded multi-producer single-consumer mailbox. Producers push the messages onto a lock free
+// stack linked through MessageBase::mailboxNext, so enqueueing never takes a lock nor allocates. The consumer takes the
+// whole stack with one atomic exchange and hands it out in FIFO order, so it touches the shared head once per batch.
+class LockFreeMailBox : public MailBox {
+ public:
+  LockFreeMailBox() : head(Released()), batch(nullptr) { takeAllMsgsEachTime = false; }
+  ~LockFreeMailBox() override;
+  int EnqueueMessage(std::unique_ptr<MessageBase> msg) override;
+  std::list<std::unique_ptr<MessageBase>> *GetMsgs() override { return nullptr; }
+  std::unique_ptr<MessageBase> GetMsg() override;
+
+ private:
+  // head points to this sentinel when the mailbox is empty and the consumer has given up the actor, the producer that
+  // replaces it calls the notify hook to schedule the actor again.
+  static MessageBase *Released();
+  // Take all the messages pushed so far into batch, return false and release the actor if there is none.
+  bool Drain();
+
+  std::atomic<MessageBase *> head;
+  // drained messages in FIFO order, only touched by the consumer
+  MessageBase *batch;
+};
 }  // namespace mindspore
 
 #endif  // MINDSPORE_MAILBOX_H
@@ -22,9 +22,15 @@
 
 namespace mindspore {
 constexpr size_t MAX_READY_ACTOR_NR = 4096;
+constexpr size_t MAX_LOCAL_READY_ACTOR_NR = 1024;
+// the actor worker running on the current thread, nullptr if the current thread is not an actor worker
+static thread_local ActorWorker *current_actor_worker = nullptr;
+
 void ActorWorker::CreateThread(ActorThreadPool *pool) {
   THREAD_RETURN_IF_NULL(pool);
   pool_ = pool;
+  // any odd seed differing between the workers is fine for choosing the victims
+  steal_seed_ = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this) >> 4) | 1;
   thread_ = std::thread(&ActorWorker::RunWithSpin, this);
 }
 
@@ -39,6 +45,7 @@ void ActorWorker::RunWithSpin() {
   _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
   _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
 #endif
+  current_actor_worker = this;
   while (alive_) {
     // only run either local KernelTask or PoolQueue ActorTask
     if (RunLocalKernelTask() || RunQueueActorTask()) {
@@ -55,7 +62,18 @@ void ActorWorker::RunWithSpin() {
 
 bool ActorWorker::RunQueueActorTask() {
   THREAD_ERROR_IF_NULL(pool_);
-  auto actor = pool_->PopActorFromQueue();
+  // the local queue first, then the pool queue, then steal from a random victim
+  auto actor = local_actors_.Pop();
+  if (actor == nullptr) {
+    actor = pool_->PopActorFromQueue();
+  }
+  if (actor == nullptr) {
+    // xorshift
+    steal_seed_ ^= steal_seed_ << 13;
+    steal_seed_ ^= steal_seed_ >> 17;
+    steal_seed_ ^= steal_seed_ << 5;
+    actor = pool_->StealActorFromWorkers(steal_seed_, this);
+  }
   if (actor == nullptr) {
     return false;
   }
@@ -63,6 +81,17 @@ bool ActorWorker::RunQueueActorTask() {
   return true;
 }
 
+void ActorWorker::StopThread() {
+  {
+    std::lock_guard<std::mutex> _l(mutex_);
+    alive_ = false;
+  }
+  cond_var_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
 bool ActorWorker::ActorActive() {
   if (status_ != kThreadIdle) {
     return false;
@@ -89,6 +118,9 @@ ActorThreadPool::~ActorThreadPool() {
       terminate = actor_queue_.empty();
 #endif
     }
+    for (size_t i = 0; terminate && i < actor_worker_num_; ++i) {
+      terminate = reinterpret_cast<ActorWorker *>(workers_[i])->LocalQueueEmpty();
+    }
     if (!terminate) {
       for (auto &worker : workers_) {
         worker->Active();
@@ -96,6 +128,10 @@ ActorThreadPool::~ActorThreadPool() {
       std::this_thread::yield();
     }
   } while (!terminate && count++ < kMaxCount);
+  // the actor workers steal from each other, so all of them are stopped before any of them is deleted
+  for (size_t i = 0; i < actor_worker_num_; ++i) {
+    reinterpret_cast<ActorWorker *>(workers_[i])->StopThread();
+  }
   for (auto &worker : workers_) {
     delete worker;
     worker = nullptr;
@@ -120,11 +156,31 @@ ActorBase *ActorThreadPool::PopActorFromQueue() {
 #endif
 }
 
+ActorBase *ActorThreadPool::StealActorFromWorkers(size_t start, const ActorWorker *thief) {
+  size_t worker_num = actor_worker_num_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < worker_num; ++i) {
+    auto victim = reinterpret_cast<ActorWorker *>(workers_[(start + i) % worker_num]);
+    if (victim == thief) {
+      continue;
+    }
+    auto actor = victim->StealLocalActor();
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  return nullptr;
+}
+
 void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
-  {
+  // the actor made ready by an actor running on a worker of this pool most likely consumes its output,
+  // so it is queued to the same worker
+  auto curr = current_actor_worker;
+  if (curr != nullptr && curr->pool() == this && curr->PushLocalActor(actor)) {
+    THREAD_DEBUG("actor[%s] enqueue to local queue success", actor->GetAID().Name().c_str());
+  } else {
 #ifdef USE_HQUEUE
     while (!actor_queue_.Enqueue(actor)) {
     }
@@ -132,9 +188,9 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
     std::lock_guard<std::mutex> _l(actor_mutex_);
     actor_queue_.push(actor);
 #endif
+    THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
   }
-  THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
-  // active one idle actor thread if exist
+  // active one idle actor thread if exist, which steals the actor if it is still queued locally
   for (size_t i = 0; i < actor_thread_num_; ++i) {
     auto worker = reinterpret_cast<ActorWorker *>(workers_[i]);
     if (worker->ActorActive()) {
@@ -160,13 +216,21 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
     THREAD_ERROR("thread num is invalid");
     return THREAD_ERROR;
   }
+  // the running actor workers steal from each other while the others are created, so workers_ must not reallocate
+  workers_.reserve(all_thread_num);
   for (size_t i = 0; i < actor_thread_num_; ++i) {
     std::lock_guard<std::mutex> _l(pool_mutex_);
     auto worker = new (std::nothrow) ActorWorker();
     THREAD_ERROR_IF_NULL(worker);
+    if (!worker->InitLocalQueue(MAX_LOCAL_READY_ACTOR_NR)) {
+      delete worker;
+      THREAD_ERROR("init local actor queue failed.");
+      return THREAD_ERROR;
+    }
     worker->InitWorkerMask(core_list, workers_.size());
     worker->CreateThread(this);
     workers_.push_back(worker);
+    actor_worker_num_.store(workers_.size(), std::memory_order_release);
     THREAD_INFO("create actor thread[%zu]", i);
   }
   size_t kernel_thread_num = all_thread_num - actor_thread_num_;
@@ -26,6 +26,7 @@
 #include "thread/core_affinity.h"
 #include "actor/actor.h"
 #include "thread/hqueue.h"
+#include "thread/work_stealing_deque.h"
 #define USE_HQUEUE
 namespace mindspore {
 class ActorThreadPool;
@@ -33,12 +34,25 @@ class ActorWorker : public Worker {
  public:
   void CreateThread(ActorThreadPool *pool);
   bool ActorActive();
+  bool InitLocalQueue(size_t size) { return local_actors_.Init(size); }
+  // called by the worker thread only, return false if the local queue is full
+  bool PushLocalActor(ActorBase *actor) { return local_actors_.Push(actor); }
+  // called by any thread
+  ActorBase *StealLocalActor() { return local_actors_.Steal(); }
+  bool LocalQueueEmpty() const { return local_actors_.Empty(); }
+  ActorThreadPool *pool() const { return pool_; }
+  // stop and join the thread, the worker can be deleted once no other actor worker steals from it
+  void StopThread();
 
  private:
   void RunWithSpin();
   bool RunQueueActorTask();
 
   ActorThreadPool *pool_{nullptr};
+  // the actors made ready by the actors running on this worker, run by this worker first to reuse the hot cache
+  // and stolen by the idle workers otherwise
+  WorkStealingDeque<ActorBase> local_actors_;
+  uint32_t steal_seed_{0};
 };
 
 class ActorThreadPool : public ThreadPool {
@@ -54,11 +68,15 @@ class ActorThreadPool : public ThreadPool {
 
   void PushActorToQueue(ActorBase *actor);
   ActorBase *PopActorFromQueue();
+  // steal an actor from the local queue of the actor workers starting from the given one, except the thief
+  ActorBase *StealActorFromWorkers(size_t start, const ActorWorker *thief);
 
  private:
   ActorThreadPool() {}
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
   size_t actor_thread_num_{0};
+  // number of the actor workers which have been created and can be stolen from
+  std::atomic_size_t actor_worker_num_{0};
 
   std::mutex actor_mutex_;
   std::condition_variable actor_cond_;
@@ -21,6 +21,28 @@
 #include "thread/core_affinity.h"
 
 namespace mindspore {
+bool Task::Claim(int task_id) {
+  auto &claimed = sub_tasks[task_id].claimed;
+  // check first to keep the cache line shared when the subtask has been claimed
+  return !claimed.load(std::memory_order_relaxed) && !claimed.exchange(true, std::memory_order_acq_rel);
+}
+
+int Task::Steal() {
+  for (int i = steal_hint.load(std::memory_order_relaxed); i < task_num; ++i) {
+    if (Claim(i)) {
+      steal_hint.store(i + 1, std::memory_order_relaxed);
+      return i;
+    }
+  }
+  return -1;
+}
+
+void Task::Run(int task_id) {
+  const auto &sub_task = sub_tasks[task_id];
+  status |= func(content, task_id, sub_task.lhs_scale, sub_task.rhs_scale);
+  (void)++finished;
+}
+
 Worker::~Worker() {
   {
     std::lock_guard<std::mutex> _l(mutex_);
@@ -106,9 +128,16 @@ bool Worker::RunLocalKernelTask() {
     return false;
   }
   int task_id = task_id_.load(std::memory_order_consume);
-  task->status |= task->func(task->content, task_id, lhs_scale_, rhs_scale_);
+  if (task->Claim(task_id)) {
+    task->Run(task_id);
+  }
+  // steal the subtasks which are not started yet by the other workers or the master thread
+  for (int id = task->Steal(); id >= 0; id = task->Steal()) {
+    task->Run(id);
+  }
   task_.store(nullptr, std::memory_order_relaxed);
-  (void)++task->finished;
+  // the task lives on the stack of the master thread, it must not be touched after being released
+  (void)--task->holders;
   return true;
 }
 
@@ -136,7 +165,7 @@ void Worker::Active(Task *task, int task_id) {
   {
     std::lock_guard<std::mutex> _l(mutex_);
     task_id_.store(task_id, std::memory_order_relaxed);
-    task_.store(task, std::memory_order_relaxed);
+    task_.store(task, std::memory_order_release);
     status_ = kThreadBusy;
   }
   cond_var_.notify_one();
@@ -205,12 +234,17 @@ int ThreadPool::ParallelLaunch(const Func &func, Content content, int task_num)
   // distribute task to the KernelThread and the idle ActorThread,
   // if the task num is greater than the KernelThread num
   THREAD_DEBUG("launch: %d", task_num);
-  Task task = {func, content};
+  Task task(func, content, task_num);
+  THREAD_ERROR_IF_NULL(task.sub_tasks);
 
   DistributeTask(&task, task_num);
+  // help the workers with the subtasks which are not started yet
+  for (int id = task.Steal(); id >= 0; id = task.Steal()) {
+    task.Run(id);
+  }
   // synchronization
-  // wait until the finished is equal to task_num
-  while (task.finished != task_num) {
+  // wait until the finished is equal to task_num and no worker holds the task anymore
+  while (task.finished != task_num || task.holders != 0) {
     std::this_thread::yield();
   }
   // check the return value of task
@@ -222,14 +256,12 @@ int ThreadPool::ParallelLaunch(const Func &func, Content content, int task_num)
 
 void ThreadPool::SyncRunTask(Task *task, int start_num, int task_num) const {
   // run task sequentially
-  // if the current thread is not the actor thread
-  float per_scale = kMaxScale / (task_num - start_num);
+  // if the current thread is not the actor thread,
+  // skip the subtasks which have been stolen by the workers
   for (int i = start_num; i < task_num; ++i) {
-    float lhs_scale = i * per_scale;
-    float rhs_scale = (i + 1) * per_scale;
-    rhs_scale = i == task_num - 1 ? kMaxScale : rhs_scale;
-    task->status |= task->func(task->content, i, lhs_scale, rhs_scale);
-    (void)++task->finished;
+    if (task->Claim(i)) {
+      task->Run(i);
+    }
   }
 }
 
@@ -260,14 +292,14 @@ void ThreadPool::DistributeTask(Task *task, int task_num) const {
       assigned.push_back(curr);
       sum_frequency += curr->frequency();
     }
-  } else if (assigned.size() != static_cast<size_t>(task_num)) {
-    CalculateScales(assigned, sum_frequency);
-    ActiveWorkers(assigned, task, assigned.size(), curr);
-    SyncRunTask(task, assigned.size(), task_num);
-    return;
   }
   CalculateScales(assigned, sum_frequency);
-  ActiveWorkers(assigned, task, task_num, curr);
+  // any subtask can be stolen once a worker is activated, so the scales of all of them are recorded first
+  RecordScales(assigned, task, task_num);
+  ActiveWorkers(assigned, task, assigned.size(), curr);
+  if (assigned.size() != static_cast<size_t>(task_num)) {
+    SyncRunTask(task, assigned.size(), task_num);
+  }
 }
 
 void ThreadPool::CalculateScales(const std::vector<Worker *> &assigned, int sum_frequency) const {
@@ -286,14 +318,40 @@ void ThreadPool::CalculateScales(const std::vector<Worker *> &assigned, int sum_
   }
 }
 
+void ThreadPool::RecordScales(const std::vector<Worker *> &workers, Task *task, int task_num) const {
+  int num_assigned = static_cast<int>(workers.size());
+  for (int i = 0; i < num_assigned; ++i) {
+    task->sub_tasks[i].lhs_scale = workers[i]->lhs_scale();
+    task->sub_tasks[i].rhs_scale = workers[i]->rhs_scale();
+  }
+  if (num_assigned >= task_num) {
+    return;
+  }
+  // the subtasks run by the master thread are divided evenly
+  float per_scale = kMaxScale / (task_num - num_assigned);
+  for (int i = num_assigned; i < task_num; ++i) {
+    float rhs_scale = (i + 1) * per_scale;
+    task->sub_tasks[i].lhs_scale = i * per_scale;
+    task->sub_tasks[i].rhs_scale = i == task_num - 1 ? kMaxScale : rhs_scale;
+  }
+}
+
 void ThreadPool::ActiveWorkers(const std::vector<Worker *> &workers, Task *task, int task_num,
                                const Worker *curr) const {
+  // activate all the other workers before the current thread runs anything, otherwise it would steal the subtasks of
+  // the workers which are not activated yet and run them serially
   for (int i = 0; i < task_num; ++i) {
     Worker *worker = workers[i];
     THREAD_RETURN_IF_NULL(worker);
-    worker->Active(task, i);
-    if (worker == curr) {
-      (void)worker->RunLocalKernelTask();
+    if (worker != curr) {
+      (void)++task->holders;
+      worker->Active(task, i);
+    }
+  }
+  // the current thread runs its own subtasks, and the rest are stolen one by one by whichever thread is free
+  for (int i = 0; i < task_num; ++i) {
+    if (workers[i] == curr && task->Claim(i)) {
+      task->Run(i);
     }
   }
 }
@@ -43,6 +43,8 @@ constexpr int kDefaultKernelSpinCount = 3000;
 constexpr int kMinSpinCount = 1;
 constexpr int kDefaultFrequency = 1;
 constexpr float kMaxScale = 1.;
+// the subtasks of a launch up to this number are kept in the task on the stack of the launching thread
+constexpr int kMaxInlineSubTaskNum = 64;
 
 enum ThreadStatus {
   kThreadBusy = 0,  // busy, the thread is running task
@@ -55,10 +57,37 @@ enum ThreadStatus {
 using Func = std::function<int(void *, int, float, float)>;
 using Content = void *;
 
+// a subtask is run by whichever thread claims it first, so that the workers which are done with their own subtask
+// and the launching thread can steal the subtasks which are not started yet
+typedef struct SubTask {
+  std::atomic_bool claimed{false};
+  float lhs_scale{0.};
+  float rhs_scale{kMaxScale};
+} SubTask;
+
 typedef struct Task {
-  Task(Func f, Content c) : func(f), content(c) {}
+  Task(Func f, Content c, int num) : func(f), content(c), task_num(num), sub_tasks(inline_sub_tasks) {
+    // only the launches of more subtasks than kMaxInlineSubTaskNum allocate memory
+    if (task_num > kMaxInlineSubTaskNum) {
+      heap_sub_tasks.reset(new (std::nothrow) SubTask[task_num]);
+      sub_tasks = heap_sub_tasks.get();
+    }
+  }
+  // claim the given subtask, return false if it has been claimed by another thread
+  bool Claim(int task_id);
+  // claim any subtask which is not claimed yet, return -1 if there is none
+  int Steal();
+  // run a claimed subtask
+  void Run(int task_id);
+
   Func func;
   Content content;
+  int task_num;
+  SubTask *sub_tasks;
+  SubTask inline_sub_tasks[kMaxInlineSubTaskNum];
+  std::unique_ptr<SubTask[]> heap_sub_tasks;
+  std::atomic_int steal_hint{0};  // all subtasks before the hint have been claimed
+  std::atomic_int holders{0};     // workers which still hold the task
   std::atomic_int finished{0};
   std::atomic_int status{THREAD_OK};  // return status, RET_OK
 } Task;
@@ -163,6 +192,7 @@ class MS_CORE_API ThreadPool {
   void DistributeTask(Task *task, int task_num) const;
   void CalculateScales(const std::vector<Worker *> &workers, int sum_frequency) const;
   void ActiveWorkers(const std::vector<Worker *> &workers, Task *task, int task_num, const Worker *curr) const;
+  void RecordScales(const std::vector<Worker *> &workers, Task *task, int task_num) const;
 
   Worker *CurrentWorker() const;
 
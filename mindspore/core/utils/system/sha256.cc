@@ -43,6 +43,9 @@ const uint32_t constant[64] = {
   0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
   0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
 
+const uint32_t kInitialDigest[kDigestSize] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                             0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
 std::string LoadFilePath(const std::string &path) {
   char real_path[PATH_MAX] = {0};
 #if defined(_WIN32) || defined(_WIN64)
@@ -62,9 +65,11 @@ std::string LoadFilePath(const std::string &path) {
   return message;
 }
 
-bool Padding(std::string *message) {
-  uint64_t bits_message = message->size() * kBitNumber;
-  const int remains = message->size() % kMessageBlockLength;
+bool Padding(std::string *message) { return Padding(message, message->size()); }
+
+bool Padding(std::string *message, size_t message_size) {
+  uint64_t bits_message = message_size * kBitNumber;
+  const int remains = message_size % kMessageBlockLength;
   // The length of the message needs to be stored in 8 bytes, supplemented at the end of the message.
   const int size_append = 8;
   const int size_required = kMessageBlockLength - size_append;
@@ -83,15 +88,19 @@ bool Padding(std::string *message) {
 }
 
 bool ProcessInner(const std::string &message, const int &bias, uint32_t *digest, const int &digest_size) {
+  return ProcessInner(reinterpret_cast<const uint8_t *>(message.data()) + bias, digest, digest_size);
+}
+
+bool ProcessInner(const uint8_t *message, uint32_t *digest, const int &digest_size) {
   if (digest_size != 8) {  // The number of digests is fixed at 8
     return false;
   }
   uint32_t w[kIterationNumber] = {0};
   for (int i = 0; i < 16; ++i) {
-    w[i] = (static_cast<uint32_t>(static_cast<uint8_t>(message[IntToSize(bias + i * 4)]) & 0xff) << 24) |
-           (static_cast<uint32_t>(static_cast<uint8_t>(message[IntToSize(bias + i * 4 + 1)]) & 0xff) << 16) |
-           (static_cast<uint32_t>(static_cast<uint8_t>(message[IntToSize(bias + i * 4 + 2)]) & 0xff) << 8) |
-           (static_cast<uint32_t>(static_cast<uint8_t>(message[IntToSize(bias + i * 4 + 3)]) & 0xff));
+    w[i] = (static_cast<uint32_t>(message[IntToSize(i * 4)]) << 24) |
+           (static_cast<uint32_t>(message[IntToSize(i * 4 + 1)]) << 16) |
+           (static_cast<uint32_t>(message[IntToSize(i * 4 + 2)]) << 8) |
+           (static_cast<uint32_t>(message[IntToSize(i * 4 + 3)]));
   }
   for (int i = 16; i < kIterationNumber; ++i) {
     w[i] = sigma3(w[i - 2]) + w[i - 7] + sigma2(w[i - 15]) + w[i - 16];
@@ -135,8 +144,8 @@ std::string ConvertToString(uint32_t *input, const int &size) {
 }
 
 std::string Encrypt(const std::string &message) {
-  uint32_t digest[kDigestSize] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
-                                  0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+  uint32_t digest[kDigestSize];
+  std::copy(kInitialDigest, kInitialDigest + kDigestSize, digest);
   for (int i = 0; i < static_cast<int>(message.size()); i += kMessageBlockLength) {
     if (!ProcessInner(message, i, digest, kDigestSize)) {
       return "";
@@ -153,6 +162,32 @@ std::string GetHashFromString(const std::string &data) {
   return Encrypt(message);
 }
 
+std::string GetHashFromBuffer(const void *data, size_t size) {
+  if (data == nullptr || size == 0) {
+    return "";
+  }
+  // The full message blocks are hashed in place, only the tail is copied to be padded.
+  auto message = static_cast<const uint8_t *>(data);
+  size_t full_size = size - size % kMessageBlockLength;
+  std::string tail(reinterpret_cast<const char *>(message + full_size), size - full_size);
+  if (!Padding(&tail, size)) {
+    return "";
+  }
+  uint32_t digest[kDigestSize];
+  std::copy(kInitialDigest, kInitialDigest + kDigestSize, digest);
+  for (size_t i = 0; i < full_size; i += kMessageBlockLength) {
+    if (!ProcessInner(message + i, digest, kDigestSize)) {
+      return "";
+    }
+  }
+  for (int i = 0; i < static_cast<int>(tail.size()); i += kMessageBlockLength) {
+    if (!ProcessInner(tail, i, digest, kDigestSize)) {
+      return "";
+    }
+  }
+  return ConvertToString(digest, kDigestSize);
+}
+
 std::string GetHashFromFile(const std::string &path) {
   std::string message = LoadFilePath(path);
   if (message.empty() || !Padding(&message)) {
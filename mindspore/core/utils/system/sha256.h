@@ -34,14 +34,22 @@ std::string LoadFilePath(const std::string &path);
 
 bool Padding(std::string *message);
 
+// Pad the tail of a message whose total size is message_size.
+bool Padding(std::string *message, size_t message_size);
+
 bool ProcessInner(const std::string &message, const int &bias, uint32_t *digest, const int &digest_size);
 
+bool ProcessInner(const uint8_t *message, uint32_t *digest, const int &digest_size);
+
 std::string ConvertToString(uint32_t *input, const int &size);
 
 std::string Encrypt(const std::string &message);
 
 std::string GetHashFromString(const std::string &data);
 
+// Hash the memory in place, eg. a mapped file, without copying it to a string.
+MS_CORE_API std::string GetHashFromBuffer(const void *data, size_t size);
+
 MS_CORE_API std::string GetHashFromFile(const std::string &path);
 
 #ifndef _WIN32
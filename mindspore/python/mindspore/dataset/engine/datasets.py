@@ -64,7 +64,8 @@ from .queue import _SharedQueue
 from .validators import check_batch, check_shuffle, check_map, check_filter, check_repeat, check_skip, check_zip, \
     check_rename, check_device_send, check_take, check_project, \
     check_sync_wait, check_zip_dataset, check_add_column, check_concat, check_split, check_bucket_batch_by_length, \
-    check_save, check_tuple_iterator, check_dict_iterator, check_schema, check_to_device_send
+    check_batch_by_tokens, check_pack_sequences, check_save, check_tuple_iterator, check_dict_iterator, \
+    check_schema, check_to_device_send
 from ..core.config import get_callback_timeout, _init_device_info, get_enable_shared_mem, get_num_parallel_workers
 from ..core.datatypes import mstype_to_detype
 from ..core.validator_helpers import replace_none
@@ -275,6 +276,8 @@ class Dataset:
     DatasetOperator: MapDataset(UnionBaseDataset)
                      BatchDataset(UnionBaseDataset)
                      BucketBatchByLengthDataset(UnionBaseDataset)
+                     BatchByTokensDataset(UnionBaseDataset)
+                     PackSequencesDataset(UnionBaseDataset)
                      ShuffleDataset(UnionBaseDataset)
                      FilterDataset(UnionBaseDataset)
                      RepeatDataset(UnionBaseDataset)
@@ -538,6 +541,57 @@ class Dataset:
         return BucketBatchByLengthDataset(self, column_names, bucket_boundaries, bucket_batch_sizes,
                                           element_length_function, pad_info, pad_to_bucket_boundary, drop_remainder)
 
+    @check_batch_by_tokens
+    def batch_by_tokens(self, column_names, max_tokens, lookahead_size=1000, element_length_function=None,
+                        pad_info=None, drop_remainder=False):
+        """
+        Combine rows of variable length into batches bounded by a token budget instead of a fixed batch size.
+
+        Rows are buffered in a lookahead window of lookahead_size rows. When the window is full, it is sorted by
+        length and cut greedily into batches so that the padded size of each batch, i.e. the number of rows
+        multiplied by the length of the longest row in the batch, does not exceed max_tokens. Rows of similar
+        length therefore end up in the same batch and little padding is needed. The last, possibly unfilled
+        batch of the window stays in the window and is completed with the next rows.
+
+        Note:
+            Batches are emitted in increasing order of length within a window. Apply shuffle after
+            batch_by_tokens if the order of batches matters.
+
+        Args:
+            column_names (list[str]): Columns passed to element_length_function.
+            max_tokens (int): The maximum padded number of tokens in a batch. A row longer than
+                max_tokens forms a batch on its own.
+            lookahead_size (int, optional): The number of rows buffered and sorted by length before
+                batches are formed (default=1000).
+            element_length_function (Callable, optional): A function that takes in
+                M arguments where M = len(column_names) and returns an integer. If no value
+                provided, the length of a row is the largest size of the first dimension of
+                the columns in column_names (default=None).
+            pad_info (dict, optional): The information about how to batch each column. The key
+                corresponds to the column name, and the value must be a tuple of 2 elements.
+                The first element corresponds to the shape to pad to, and the second
+                element corresponds to the value to pad with. If no value provided, every
+                column will be padded to the longest in the current batch, and 0 will be used
+                as the padding value (default=None).
+            drop_remainder (bool, optional): If True, will drop the last batch of each epoch
+                if it is not filled up to max_tokens (default=False).
+
+        Returns:
+            Dataset, dataset batched by token budget.
+
+        Examples:
+            >>> import numpy as np
+            >>> def generate_sequences(n):
+            ...     for i in range(n):
+            ...         yield (np.array([j for j in range(i % 16 + 1)]),)
+            >>>
+            >>> dataset = ds.GeneratorDataset(generate_sequences(100), ["text"])
+            >>> # Every batch holds at most 64 tokens including padding.
+            >>> dataset = dataset.batch_by_tokens(["text"], max_tokens=64, lookahead_size=50)
+        """
+        return BatchByTokensDataset(self, column_names, max_tokens, lookahead_size, element_length_function,
+                                    pad_info, drop_remainder)
+
     @check_batch
     def batch(self, batch_size, drop_remainder=False, num_parallel_workers=None, per_batch_map=None,
               input_columns=None, output_columns=None, column_order=None, pad_info=None,
@@ -2022,6 +2076,42 @@ class TextBaseDataset(Dataset):
 
         return vocab
 
+    @check_pack_sequences
+    def pack_sequences(self, column_name, seq_length, window_size=1000, pad_value=0):
+        """
+        Concatenate short tokenized samples into rows of fixed length to avoid padding every sample to the
+        maximum length.
+
+        Samples are buffered in a window of window_size samples, which is packed with first-fit-decreasing:
+        samples are sorted by length from the longest to the shortest and each one is put into the first row
+        that still has room for it. The rest of each row is filled with pad_value.
+
+        Every output row has three columns: the packed tokens in column_name, `segment_ids` which numbers the
+        samples inside the row from 1 (0 for padding), and `position_ids` which restarts from 0 at the beginning
+        of every sample (0 for padding). All other columns are dropped.
+
+        Args:
+            column_name (str): Column holding the 1-D integer token ids to pack.
+            seq_length (int): Length of every packed row. Samples longer than seq_length are truncated.
+            window_size (int, optional): Number of samples buffered and packed together (default=1000).
+            pad_value (int, optional): Token id used to fill the rest of each row (default=0).
+
+        Returns:
+            Dataset, dataset with packed rows.
+
+        Examples:
+            >>> import numpy as np
+            >>> def generate_sequences(n):
+            ...     for i in range(n):
+            ...         yield (np.array([j + 1 for j in range(i % 16 + 1)], dtype=np.int32),)
+            >>>
+            >>> dataset = ds.GeneratorDataset(generate_sequences(100), ["text"])
+            >>> # Pack the samples into rows of 64 tokens, the columns are now "text", "segment_ids", "position_ids".
+            >>> dataset = dataset.pack_sequences("text", seq_length=64, window_size=50)
+            >>> dataset = dataset.batch(8)
+        """
+        return PackSequencesDataset(self, column_name, seq_length, window_size, pad_value)
+
 
 class AudioBaseDataset(Dataset):
     """
@@ -2301,6 +2391,45 @@ class BucketBatchByLengthDataset(UnionBaseDataset):
                                            self.pad_to_bucket_boundary, self.drop_remainder)
 
 
+class BatchByTokensDataset(UnionBaseDataset):
+    """
+    The result of applying BatchByTokens operator to the input dataset.
+    """
+
+    def __init__(self, input_dataset, column_names, max_tokens, lookahead_size, element_length_function, pad_info,
+                 drop_remainder):
+        super().__init__(children=input_dataset)
+
+        self.column_names = to_list(column_names)
+        self.max_tokens = max_tokens
+        self.lookahead_size = replace_none(lookahead_size, 1000)
+        self.element_length_function = element_length_function
+        self.pad_info = replace_none(pad_info, {})
+        self.drop_remainder = replace_none(drop_remainder, False)
+
+    def parse(self, children=None):
+        return cde.BatchByTokensNode(children[0], self.column_names, self.max_tokens, self.lookahead_size,
+                                     self.element_length_function, self.pad_info, self.drop_remainder)
+
+
+class PackSequencesDataset(UnionBaseDataset):
+    """
+    The result of applying PackSequences operator to the input dataset.
+    """
+
+    def __init__(self, input_dataset, column_name, seq_length, window_size, pad_value):
+        super().__init__(children=input_dataset)
+
+        self.column_name = column_name
+        self.seq_length = seq_length
+        self.window_size = replace_none(window_size, 1000)
+        self.pad_value = replace_none(pad_value, 0)
+
+    def parse(self, children=None):
+        return cde.PackSequencesNode(children[0], self.column_name, self.seq_length, self.window_size,
+                                     self.pad_value)
+
+
 def _check_shm_usage(num_worker, queue_size, max_rowsize, num_queues=1):
     """
     Check sufficient shared memory is available for shared memory queues
@@ -24,7 +24,7 @@ from functools import wraps
 import numpy as np
 from mindspore._c_expression import typing
 from ..core.validator_helpers import parse_user_args, type_check, type_check_list, check_value, \
-    INT32_MAX, check_valid_detype, check_dir, check_file, check_sampler_shuffle_shard_options, \
+    INT32_MAX, INT64_MIN, INT64_MAX, check_valid_detype, check_dir, check_file, check_sampler_shuffle_shard_options, \
     validate_dataset_param_value, check_padding_options, check_gnn_list_or_ndarray, check_gnn_list_of_pair_or_ndarray, \
     check_num_parallel_workers, check_columns, check_pos_int32, check_valid_str, check_dataset_num_shards_shard_id, \
     check_valid_list_tuple
@@ -1185,6 +1185,58 @@ def check_bucket_batch_by_length(method):
     return new_method
 
 
+def check_batch_by_tokens(method):
+    """check the input arguments of batch_by_tokens."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        [column_names, max_tokens, lookahead_size, element_length_function, pad_info,
+         drop_remainder], _ = parse_user_args(method, *args, **kwargs)
+
+        type_check(column_names, (list,), "column_names")
+        check_columns(column_names, "column_names")
+
+        type_check(max_tokens, (int,), "max_tokens")
+        check_pos_int32(max_tokens, "max_tokens")
+        type_check(lookahead_size, (int,), "lookahead_size")
+        check_pos_int32(lookahead_size, "lookahead_size")
+        type_check(drop_remainder, (bool,), "drop_remainder")
+
+        if element_length_function is not None and not callable(element_length_function):
+            raise TypeError("element_length_function object is not callable.")
+
+        if pad_info is not None:
+            type_check(pad_info, (dict,), "pad_info")
+
+            for k, v in pad_info.items():
+                check_pad_info(k, v)
+
+        return method(self, *args, **kwargs)
+
+    return new_method
+
+
+def check_pack_sequences(method):
+    """check the input arguments of pack_sequences."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        [column_name, seq_length, window_size, pad_value], _ = parse_user_args(method, *args, **kwargs)
+
+        type_check(column_name, (str,), "column_name")
+        check_columns(column_name, "column_name")
+        type_check(seq_length, (int,), "seq_length")
+        check_pos_int32(seq_length, "seq_length")
+        type_check(window_size, (int,), "window_size")
+        check_pos_int32(window_size, "window_size")
+        type_check(pad_value, (int,), "pad_value")
+        check_value(pad_value, [INT64_MIN, INT64_MAX], "pad_value")
+
+        return method(self, *args, **kwargs)
+
+    return new_method
+
+
 def check_batch(method):
     """check the input arguments of batch."""
 
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "distributed/rpc/tcp/tcp_server.h"
+#include "distributed/rpc/tcp/tcp_client.h"
+#include "distributed/rpc/tcp/buffer_message.h"
+
+// The throughput benchmark of sending the same data over loopback in the body and in the buffer of message.
+// Usage: tcp_throughput_benchmark [data size in MB] [message number] [port]
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+namespace {
+constexpr size_t kDefaultDataSizeInMB = 16;
+constexpr size_t kDefaultMsgNum = 32;
+constexpr int kDefaultPort = 8081;
+// The send queue drops the messages beyond its length, so the sender waits for the receiver.
+constexpr size_t kMaxInflightMsgNum = 4;
+constexpr int kWaitTimeoutInSec = 60;
+
+std::atomic<size_t> g_recv_msg_num(0);
+
+bool WaitForRecvMsg(size_t expected_msg_num, int timeout_in_sec) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout_in_sec);
+  while (g_recv_msg_num < expected_msg_num) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+// Send the messages and return the throughput in MB/s, or a negative value if the messages are not all received.
+double RunBenchmark(TCPClient *client, const std::string &server_url, const std::vector<char> &data, size_t msg_num,
+                    bool use_buffer) {
+  g_recv_msg_num = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < msg_num; ++i) {
+    std::unique_ptr<MessageBase> message;
+    if (use_buffer) {
+      auto buffer_message = std::make_unique<BufferMessage>();
+      buffer_message->AddBuffer(const_cast<char *>(data.data()), data.size());
+      message = std::move(buffer_message);
+    } else {
+      message = std::make_unique<MessageBase>();
+      message->body.assign(data.data(), data.size());
+    }
+    message->name = "benchmark";
+    message->from = AID("client", "127.0.0.1:1234");
+    message->to = AID("server", server_url);
+    (void)client->Send(std::move(message));
+    while (i >= g_recv_msg_num + kMaxInflightMsgNum) {
+      std::this_thread::yield();
+    }
+  }
+  if (!WaitForRecvMsg(msg_num, kWaitTimeoutInSec)) {
+    return -1;
+  }
+  auto cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return data.size() * msg_num / cost / (1 << 20);
+}
+}  // namespace
+
+int Run(size_t data_size, size_t msg_num, int port) {
+  auto server_url = "127.0.0.1:" + std::to_string(port);
+  auto server = std::make_unique<TCPServer>();
+  if (!server->Initialize(server_url)) {
+    std::cerr << "Failed to start the server on " << server_url << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<char> recv_data(data_size);
+  server->SetMemoryCallback([&recv_data](size_t) -> void * { return recv_data.data(); }, [](void *) {});
+  server->SetMessageHandler([](const std::shared_ptr<MessageBase> &) -> void { ++g_recv_msg_num; });
+
+  auto client = std::make_unique<TCPClient>();
+  if (!client->Initialize()) {
+    std::cerr << "Failed to initialize the client." << std::endl;
+    server->Finalize();
+    return EXIT_FAILURE;
+  }
+  client->Connect(server_url);
+
+  int ret = EXIT_SUCCESS;
+  std::vector<char> data(data_size, 'A');
+  for (bool use_buffer : {false, true}) {
+    auto throughput = RunBenchmark(client.get(), server_url, data, msg_num, use_buffer);
+    std::string name = use_buffer ? "Buffer" : "Body";
+    if (throughput < 0) {
+      std::cerr << name << " messages are not all received in " << kWaitTimeoutInSec << "s." << std::endl;
+      ret = EXIT_FAILURE;
+      continue;
+    }
+    std::cout << name << " message throughput: " << throughput << " MB/s" << std::endl;
+  }
+
+  client->Disconnect(server_url);
+  client->Finalize();
+  server->Finalize();
+  return ret;
+}
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+
+int main(int argc, char **argv) {
+  namespace rpc = mindspore::distributed::rpc;
+  size_t data_size_in_mb = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : rpc::kDefaultDataSizeInMB;
+  size_t msg_num = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : rpc::kDefaultMsgNum;
+  int port = (argc > 3) ? std::atoi(argv[3]) : rpc::kDefaultPort;
+  return rpc::Run(data_size_in_mb << 20, msg_num, port);
+}
@@ -14,14 +14,21 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
 #include "common/common.h"
 #include "gtest/gtest.h"
 #include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
+#include "minddata/dataset/engine/ir/datasetops/filter_node.h"
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/engine/ir/datasetops/project_node.h"
+#include "minddata/dataset/engine/ir/datasetops/root_node.h"
+#include "minddata/dataset/engine/ir/datasetops/take_node.h"
+#include "minddata/dataset/engine/opt/optional/cost_based_optimization_pass.h"
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/opt/post/auto_worker_pass.h"
 #include "minddata/dataset/include/dataset/transforms.h"
@@ -29,6 +36,7 @@
 #include "minddata/dataset/include/dataset/vision_lite.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
 
@@ -111,3 +119,142 @@ TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassPreBuiltTensorO
   ASSERT_EQ(fused_ops.size(), 1);
   ASSERT_EQ(fused_ops[0]->Name(), kRandomCropDecodeResizeOp);
 }
+
+/// Feature: CostBasedOptimizationPass
+/// Description: Test pushing TakeNode and ProjectNode below a MapNode
+/// Expectation: The MapNode becomes the parent of the TakeNode and the ProjectNode
+TEST_F(MindDataTestOptimizationPass, MindDataTestCostBasedPushDown) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestCostBasedPushDown.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false)->Map({decode_op}, {"image"});
+  ds = ds->Project({"image"})->Take(2);
+  // the root is needed since a node can only be dropped from its parent
+  auto root = std::make_shared<RootNode>(ds->IRNode());
+
+  CostBasedOptimizationPass pass;
+  bool modified = false;
+  ASSERT_OK(pass.Run(root, &modified));
+  EXPECT_EQ(modified, true);
+
+  // Root -> Map -> Take -> Project -> ImageFolder
+  std::shared_ptr<DatasetNode> node = root->Children()[0];
+  ASSERT_NE(std::dynamic_pointer_cast<MapNode>(node), nullptr);
+  node = node->Children()[0];
+  ASSERT_NE(std::dynamic_pointer_cast<TakeNode>(node), nullptr);
+  node = node->Children()[0];
+  ASSERT_NE(std::dynamic_pointer_cast<ProjectNode>(node), nullptr);
+  node = node->Children()[0];
+  EXPECT_TRUE(node->IsLeaf());
+}
+
+/// Feature: CostBasedOptimizationPass
+/// Description: Test merging two adjacent MapNodes working on the same column
+/// Expectation: One MapNode is left with the operations of both in order and the workers of both
+TEST_F(MindDataTestOptimizationPass, MindDataTestCostBasedMergeMaps) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestCostBasedMergeMaps.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto hwc2chw_op = vision::HWC2CHW();
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false)->Map({decode_op}, {"image"});
+  ds = ds->Map({hwc2chw_op}, {"image"});
+  auto root = std::make_shared<RootNode>(ds->IRNode());
+
+  CostBasedOptimizationPass pass;
+  bool modified = false;
+  ASSERT_OK(pass.Run(root, &modified));
+  EXPECT_EQ(modified, true);
+
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->Children()[0]);
+  ASSERT_NE(map_node, nullptr);
+  EXPECT_TRUE(map_node->Children()[0]->IsLeaf());
+  auto ops = map_node->operations();
+  ASSERT_EQ(ops.size(), 2);
+  EXPECT_EQ(ops[0]->Name(), vision::kDecodeOperation);
+  EXPECT_EQ(ops[1]->Name(), vision::kHwcToChwOperation);
+  auto config = GlobalContext::config_manager();
+  EXPECT_EQ(map_node->NumWorkers(), std::min(2 * config->num_parallel_workers(), config->num_cpu_threads()));
+}
+
+/// Feature: CostBasedOptimizationPass
+/// Description: Test two adjacent MapNodes on the same column, one of them with the num_workers set by the user
+/// Expectation: The MapNodes are not merged, so the num_workers of the user is kept
+TEST_F(MindDataTestOptimizationPass, MindDataTestCostBasedNoMergeUserNumWorkers) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestCostBasedNoMergeUserNumWorkers.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto hwc2chw_op = vision::HWC2CHW();
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false)->Map({decode_op}, {"image"});
+  ds = ds->Map({hwc2chw_op}, {"image"})->SetNumWorkers(1);
+  auto root = std::make_shared<RootNode>(ds->IRNode());
+
+  CostBasedOptimizationPass pass;
+  bool modified = false;
+  ASSERT_OK(pass.Run(root, &modified));
+  EXPECT_EQ(modified, false);
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->Children()[0]);
+  ASSERT_NE(map_node, nullptr);
+  EXPECT_EQ(map_node->NumWorkers(), 1);
+  EXPECT_NE(std::dynamic_pointer_cast<MapNode>(map_node->Children()[0]), nullptr);
+}
+
+/// Feature: CostBasedOptimizationPass
+/// Description: Test a FilterNode above a random MapNode working on another column
+/// Expectation: The FilterNode is not pushed down, so every row keeps its random draw
+TEST_F(MindDataTestOptimizationPass, MindDataTestCostBasedNoPushDownRandomMap) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestCostBasedNoPushDownRandomMap.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto random_resized_crop_op = vision::RandomResizedCrop({100});
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, true)->Map({random_resized_crop_op}, {"image"});
+  ds = ds->Filter([](MSTensorVec in) { return in; }, {"label"});
+  auto root = std::make_shared<RootNode>(ds->IRNode());
+
+  CostBasedOptimizationPass pass;
+  bool modified = false;
+  ASSERT_OK(pass.Run(root, &modified));
+  EXPECT_EQ(modified, false);
+  ASSERT_NE(std::dynamic_pointer_cast<FilterNode>(root->Children()[0]), nullptr);
+}
+
+/// Feature: CostBasedOptimizationPass
+/// Description: Test a MapNode renaming its column and a ProjectNode dropping the input column of a MapNode
+/// Expectation: The MapNodes are not merged and the ProjectNode is not pushed down
+TEST_F(MindDataTestOptimizationPass, MindDataTestCostBasedNotInPlace) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestCostBasedNotInPlace.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto hwc2chw_op = vision::HWC2CHW();
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false)->Map({decode_op}, {"image"}, {"decoded"});
+  ds = ds->Map({hwc2chw_op}, {"decoded"})->Project({"label"});
+  auto root = std::make_shared<RootNode>(ds->IRNode());
+
+  CostBasedOptimizationPass pass;
+  bool modified = false;
+  ASSERT_OK(pass.Run(root, &modified));
+  EXPECT_EQ(modified, false);
+  ASSERT_NE(std::dynamic_pointer_cast<ProjectNode>(root->Children()[0]), nullptr);
+}
+
+/// Feature: CostBasedOptimizationPass
+/// Description: Test the num_workers given by the user and the default num_workers of the MapNodes
+/// Expectation: Only the MapNode whose num_workers is set by the user is marked, and the pass keeps its num_workers
+TEST_F(MindDataTestOptimizationPass, MindDataTestCostBasedUserNumWorkers) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestCostBasedUserNumWorkers.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto hwc2chw_op = vision::HWC2CHW();
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false)->Map({decode_op}, {"image"}, {"decoded"});
+  ds = ds->Map({hwc2chw_op}, {"decoded"})->SetNumWorkers(3);
+  auto root = std::make_shared<RootNode>(ds->IRNode());
+  auto user_map = std::dynamic_pointer_cast<MapNode>(root->Children()[0]);
+  ASSERT_NE(user_map, nullptr);
+  auto default_map = std::dynamic_pointer_cast<MapNode>(user_map->Children()[0]);
+  ASSERT_NE(default_map, nullptr);
+  EXPECT_TRUE(user_map->IsUserNumWorkers());
+  EXPECT_FALSE(default_map->IsUserNumWorkers());
+
+  CostBasedOptimizationPass pass;
+  bool modified = false;
+  ASSERT_OK(pass.Run(root, &modified));
+  EXPECT_EQ(user_map->NumWorkers(), 3);
+}
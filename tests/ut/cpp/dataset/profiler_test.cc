@@ -16,6 +16,7 @@
 #include <chrono>
 #include <thread>
 #include "common/common.h"
+#include "minddata/dataset/engine/perf/op_latency_tracing.h"
 #include "minddata/dataset/engine/perf/profiling.h"
 #include "minddata/dataset/include/dataset/datasets.h"
 
@@ -34,6 +35,9 @@ class MindDataTestProfiler : public UT::DatasetOpTesting {
     std::string pipeline_file = "./pipeline_profiling_" + std::to_string(file_id) + ".json";
     std::string cpu_util_file = "./minddata_cpu_utilization_" + std::to_string(file_id) + ".json";
     std::string dataset_iterator_file = "./dataset_iterator_profiling_" + std::to_string(file_id) + ".txt";
+    // Op latency files are only written for pipelines with parallel ops
+    (void)remove(("./dataset_op_latency_" + std::to_string(file_id) + ".json").c_str());
+    (void)remove(("./dataset_timeline_" + std::to_string(file_id) + ".json").c_str());
     if (remove(pipeline_file.c_str()) == 0 && remove(cpu_util_file.c_str()) == 0 &&
         remove(dataset_iterator_file.c_str()) == 0) {
       return Status::OK();
@@ -449,6 +453,43 @@ TEST_F(MindDataTestProfiler, TestProfilerManagerByTime) {
   // File_id is expected to equal RANK_ID
   EXPECT_OK(DeleteFiles(2));
 }
+
+/// Feature: MindData Profiling Support
+/// Description: Test the latency histogram used by op latency tracing
+/// Expectation: Percentiles are estimated within the bucket that holds them
+TEST_F(MindDataTestProfiler, TestOpLatencyHistogram) {
+  MS_LOG(INFO) << "Doing MindDataTestPipeline-TestOpLatencyHistogram.";
+
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Percentile(50), 0);
+
+  // 90 fast samples of 10us and 10 slow samples of 1000us
+  for (int32_t i = 0; i < 90; i++) {
+    histogram.Add(10);
+  }
+  for (int32_t i = 0; i < 10; i++) {
+    histogram.Add(1000);
+  }
+  EXPECT_EQ(histogram.Count(), 100);
+  // 10us falls into the bucket (8, 16], 1000us into the bucket (512, 1024]
+  EXPECT_GE(histogram.Percentile(50), 10);
+  EXPECT_LE(histogram.Percentile(50), 16);
+  EXPECT_GE(histogram.Percentile(99), 512);
+  EXPECT_LE(histogram.Percentile(99), 1000);
+  EXPECT_EQ(histogram.Percentile(100), 1000);
+
+  LatencyHistogram other;
+  other.Add(1);
+  histogram.Merge(other);
+  EXPECT_EQ(histogram.Count(), 101);
+  EXPECT_EQ(histogram.Percentile(0), 1);
+
+  nlohmann::json output = histogram.ToJson();
+  EXPECT_EQ(output["count"], 101);
+  EXPECT_EQ(output["max_us"], 1000);
+  // Trailing empty buckets are trimmed
+  EXPECT_EQ(output["buckets"].size(), 11);
+}
 }  // namespace test
 }  // namespace dataset
 }  // namespace mindspore
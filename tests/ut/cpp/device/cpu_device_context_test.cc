@@ -0,0 +1,117 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/common/session/kernel_graph.h"
+#include "plugin/device/cpu/hal/device/cpu_memory_manager.h"
+#include "runtime/graph_scheduler/graph_compiler.h"
+#define private public
+#define protected public
+#include "plugin/device/cpu/hal/hardware/cpu_device_context.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kBlockSize = 64;
+
+// The memory manager which allocates memory by malloc and records the freed memory.
+class TestMemoryManager : public CPUMemoryManager {
+ public:
+  void Finalize() override {}
+  void *MallocMemFromMemPool(size_t size, bool) override { return malloc(size); }
+  void FreeMemFromMemPool(void *device_ptr) override {
+    (void)freed_ptrs_.insert(device_ptr);
+    free(device_ptr);
+  }
+  std::set<void *> freed_ptrs_;
+};
+}  // namespace
+
+class CPUDeviceContextTest : public UT::Common {
+ public:
+  CPUDeviceContextTest() = default;
+
+  void SetUp() override {
+    device_context_ = std::make_shared<CPUDeviceContext>(DeviceContextKey{"CPU", 0});
+    mem_manager_ = std::make_shared<TestMemoryManager>();
+    device_context_->mem_manager_ = mem_manager_;
+  }
+
+  // Record a somas memory block for the graph in the way of 'AllocateGraphMemory'.
+  KernelGraphPtr CreateGraphWithMemoryBlock(uint32_t graph_id, void **block) {
+    auto graph = std::make_shared<session::KernelGraph>();
+    graph->set_graph_id(graph_id);
+    *block = mem_manager_->MallocMemFromMemPool(kBlockSize, true);
+    device_context_->graph_memory_blocks_[graph_id] = *block;
+    return graph;
+  }
+
+  std::shared_ptr<CPUDeviceContext> device_context_;
+  std::shared_ptr<TestMemoryManager> mem_manager_;
+};
+
+/// Feature: the somas memory of graph in cpu device context.
+/// Description: clear the graph which holds a somas memory block twice.
+/// Expectation: the block is freed once in the first clearing and only the block of the cleared graph is freed.
+TEST_F(CPUDeviceContextTest, ClearGraphFreeMemoryBlock) {
+  void *block1 = nullptr;
+  void *block2 = nullptr;
+  auto graph1 = CreateGraphWithMemoryBlock(1, &block1);
+  auto graph2 = CreateGraphWithMemoryBlock(2, &block2);
+
+  device_context_->ClearGraph(graph1);
+  ASSERT_EQ(mem_manager_->freed_ptrs_.size(), 1);
+  ASSERT_EQ(mem_manager_->freed_ptrs_.count(block1), 1);
+  ASSERT_EQ(device_context_->graph_memory_blocks_.count(1), 0);
+  ASSERT_EQ(device_context_->graph_memory_blocks_.count(2), 1);
+
+  device_context_->ClearGraph(graph1);
+  ASSERT_EQ(mem_manager_->freed_ptrs_.size(), 1);
+
+  device_context_->Destroy();
+  ASSERT_EQ(mem_manager_->freed_ptrs_.size(), 2);
+  ASSERT_EQ(mem_manager_->freed_ptrs_.count(block2), 1);
+  ASSERT_TRUE(device_context_->graph_memory_blocks_.empty());
+}
+
+/// Feature: the somas memory of graph in cpu device context.
+/// Description: destroy the graph compiler info of the graph which holds a somas memory block.
+/// Expectation: the block of the graph is freed.
+TEST_F(CPUDeviceContextTest, GraphCompilerInfoClearGraph) {
+  void *block = nullptr;
+  auto graph = CreateGraphWithMemoryBlock(1, &block);
+  {
+    std::vector<DeviceContext *> device_contexts = {device_context_.get()};
+    runtime::GraphCompilerInfo graph_compiler_info({graph}, device_contexts, {}, {}, {}, {}, nullptr, {}, 0,
+                                                   "cpu_device_context_test", false,
+                                                   runtime::GraphExecutionStrategy::kPipeline);
+  }
+  ASSERT_EQ(mem_manager_->freed_ptrs_.size(), 1);
+  ASSERT_EQ(mem_manager_->freed_ptrs_.count(block), 1);
+  ASSERT_TRUE(device_context_->graph_memory_blocks_.empty());
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,183 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "common/mem_reuse/mem_dynamic_allocator.h"
+#undef private
+#undef protected
+
+namespace mindspore::device {
+namespace {
+// The same as the thread cache limits of memory pool.
+constexpr size_t kMaxCacheBufSize = 64 << 10;
+constexpr size_t kMaxCacheBufNumPerClass = 64;
+constexpr size_t kMaxCacheMemSize = 8 << 20;
+
+// The memory pool whose device memory is allocated from the host by the fixed size blocks.
+class TestMemPool : public DynamicMemPoolBestFit {
+ public:
+  TestMemPool(size_t block_size, size_t max_block_num) : block_size_(block_size), max_block_num_(max_block_num) {}
+  ~TestMemPool() override {
+    for (auto &block : blocks_) {
+      free(block);
+    }
+  }
+
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    if (blocks_.size() >= max_block_num_) {
+      return 0;
+    }
+    *addr = malloc(size);
+    if (*addr == nullptr) {
+      return 0;
+    }
+    (void)blocks_.emplace_back(*addr);
+    return size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &) override { return true; }
+  size_t free_mem_size() override { return (max_block_num_ - blocks_.size()) * block_size_; }
+
+ protected:
+  size_t CalMemBlockAllocSize(size_t size, bool) override {
+    return ((blocks_.size() < max_block_num_) && (size <= block_size_)) ? block_size_ : 0;
+  }
+
+ private:
+  size_t block_size_;
+  size_t max_block_num_;
+  std::vector<DeviceMemPtr> blocks_;
+};
+}  // namespace
+
+class TestMemDynamicAllocator : public UT::Common {
+ public:
+  TestMemDynamicAllocator() = default;
+  void SetUp() override { (void)setenv("MS_DEV_MEM_THREAD_CACHE", "1", 1); }
+  void TearDown() override { (void)unsetenv("MS_DEV_MEM_THREAD_CACHE"); }
+};
+
+/// Feature: thread cache of memory pool.
+/// Description: alloc and free the small memory bufs and the large memory buf.
+/// Expectation: the freed small memory buf is reused by the next alloc of the same size class, the other size classes
+/// miss the thread cache and the large memory buf bypasses the thread cache.
+TEST_F(TestMemDynamicAllocator, test_thread_cache_hit_and_miss) {
+  TestMemPool pool(1 << 20, 1);
+  EXPECT_TRUE(pool.enable_thread_cache_);
+  auto addr = pool.AllocTensorMem(100);
+  ASSERT_NE(addr, nullptr);
+  EXPECT_EQ(pool.thread_cache_hit_count_, 0);
+  EXPECT_EQ(pool.thread_cache_miss_count_, 1);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), DYNAMIC_MEM_ALIGN_SIZE);
+
+  pool.FreeTensorMem(addr);
+  EXPECT_EQ(pool.thread_cache_mem_size_, DYNAMIC_MEM_ALIGN_SIZE);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), 0);
+  EXPECT_EQ(pool.AllocTensorMem(DYNAMIC_MEM_ALIGN_SIZE), addr);
+  EXPECT_EQ(pool.thread_cache_hit_count_, 1);
+  EXPECT_EQ(pool.thread_cache_mem_size_, 0);
+
+  auto other_addr = pool.AllocTensorMem(DYNAMIC_MEM_ALIGN_SIZE * 2);
+  EXPECT_NE(other_addr, addr);
+  EXPECT_EQ(pool.thread_cache_miss_count_, 2);
+
+  auto large_addr = pool.AllocTensorMem(kMaxCacheBufSize + 1);
+  ASSERT_NE(large_addr, nullptr);
+  EXPECT_EQ(pool.thread_cache_hit_count_ + pool.thread_cache_miss_count_, 3);
+  pool.FreeTensorMem(large_addr);
+  EXPECT_EQ(pool.thread_cache_mem_size_, 0);
+  pool.FreeTensorMem(addr);
+  pool.FreeTensorMem(other_addr);
+  EXPECT_EQ(pool.thread_cache_mem_size_, DYNAMIC_MEM_ALIGN_SIZE * 3);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), 0);
+}
+
+/// Feature: thread cache of memory pool.
+/// Description: free more memory bufs than the buf number limit of one size class and the memory size limit of one
+/// thread cache.
+/// Expectation: the memory bufs over the limits are returned to the pool and the used memory statistics exclude the
+/// memory bufs held by the thread cache.
+TEST_F(TestMemDynamicAllocator, test_thread_cache_limits) {
+  TestMemPool pool(16 << 20, 1);
+  const std::vector<std::pair<size_t, size_t>> size_and_nums = {{kMaxCacheBufSize, kMaxCacheBufNumPerClass + 1},
+                                                                 {kMaxCacheBufSize - DYNAMIC_MEM_ALIGN_SIZE,
+                                                                  kMaxCacheBufNumPerClass},
+                                                                 {kMaxCacheBufSize - DYNAMIC_MEM_ALIGN_SIZE * 2, 1}};
+  std::vector<DeviceMemPtr> addrs;
+  size_t alloc_size = 0;
+  for (auto &size_and_num : size_and_nums) {
+    for (size_t i = 0; i < size_and_num.second; ++i) {
+      auto addr = pool.AllocTensorMem(size_and_num.first);
+      ASSERT_NE(addr, nullptr);
+      (void)addrs.emplace_back(addr);
+      alloc_size += size_and_num.first;
+    }
+  }
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), alloc_size);
+
+  for (auto &addr : addrs) {
+    pool.FreeTensorMem(addr);
+  }
+  // The last buf of the first size class exceeds the buf number limit, the buf of the third size class exceeds the
+  // memory size limit.
+  size_t cached_size = kMaxCacheBufNumPerClass * (kMaxCacheBufSize * 2 - DYNAMIC_MEM_ALIGN_SIZE);
+  EXPECT_LE(cached_size, kMaxCacheMemSize);
+  EXPECT_GT(cached_size + kMaxCacheBufSize - DYNAMIC_MEM_ALIGN_SIZE * 2, kMaxCacheMemSize);
+  EXPECT_EQ(pool.thread_cache_mem_size_, cached_size);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), 0);
+  EXPECT_EQ(pool.common_mem_->mps_.total_used_mem_size_, cached_size);
+}
+
+/// Feature: thread cache of memory pool.
+/// Description: the pool runs out of device memory while the freed memory bufs are held by the thread cache.
+/// Expectation: the thread caches are flushed to the pool and the alloc succeeds by the flushed memory bufs.
+TEST_F(TestMemDynamicAllocator, test_thread_cache_flush_on_oom) {
+  constexpr size_t kBlockSize = 1 << 20;
+  TestMemPool pool(kBlockSize, 1);
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < kBlockSize / kMaxCacheBufSize; ++i) {
+    auto addr = pool.AllocTensorMem(kMaxCacheBufSize);
+    ASSERT_NE(addr, nullptr);
+    (void)addrs.emplace_back(addr);
+  }
+  for (auto &addr : addrs) {
+    pool.FreeTensorMem(addr);
+  }
+  EXPECT_EQ(pool.thread_cache_mem_size_, kBlockSize);
+  EXPECT_EQ(pool.TotalMemStatistics(), kBlockSize);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), 0);
+
+  // The large memory buf can't be found in the pool or allocated from the device before the flush.
+  auto addr = pool.AllocTensorMem(kMaxCacheBufSize * 2);
+  ASSERT_NE(addr, nullptr);
+  EXPECT_EQ(pool.thread_cache_mem_size_, 0);
+  EXPECT_EQ(pool.TotalMemStatistics(), kBlockSize);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), kMaxCacheBufSize * 2);
+  for (auto &mem_record : pool.thread_cache_mem_records_) {
+    EXPECT_TRUE(mem_record->mem_buf_sizes_.empty());
+  }
+
+  // The flushed memory bufs are allocated from the pool again.
+  auto miss_count = pool.thread_cache_miss_count_.load();
+  EXPECT_NE(pool.AllocTensorMem(kMaxCacheBufSize), nullptr);
+  EXPECT_EQ(pool.thread_cache_miss_count_, miss_count + 1);
+  EXPECT_EQ(pool.AllocTensorMem(kBlockSize), nullptr);
+}
+}  // namespace mindspore::device
@@ -16,6 +16,7 @@
 
 #include <vector>
 #include <map>
+#include <set>
 #include "common/common_test.h"
 #include "runtime/device/memory_scheduler.h"
 namespace mindspore::device {
@@ -232,4 +233,70 @@ TEST_F(TestMemScheduler, test_manual_mem_scheduler) {
   // run
   Run(scheduler);
 }
-}  // namespace mindspore::device
\ No newline at end of file
+
+/// Feature: MemOffloadStrategy
+/// Description: Test MemOffloadStrategy swap in early by the compute time and the swap bandwidth
+/// Expectation: The swap in event is moved to the earliest step whose memory is enough
+TEST_F(TestMemScheduler, test_mem_offload_strategy_swap_in_early) {
+  // 6 step tensor usage, the tensor 0 is swapped out as the memory size is 2
+  //
+  // 0----------------0
+  //    1  1
+  //    2  2
+  //          3
+  constexpr size_t kTotalStep = 6;
+  constexpr size_t kMemSize = 2;
+  std::vector<uint8_t> tensor_keys(4, 0);
+  std::vector<std::vector<size_t>> step_used_tensors = {{0}, {1, 2}, {1, 2}, {3}, {}, {0}};
+  std::map<const void *, MemPriority> mem_priority;
+  std::map<const void *, std::vector<std::shared_ptr<MemEvent>>> mem_events;
+  for (size_t step = 0; step < kTotalStep; ++step) {
+    for (auto index : step_used_tensors[step]) {
+      const void *key = tensor_keys.data() + index;
+      auto &events = mem_events[key];
+      if (events.empty()) {
+        mem_priority[key] = kMemPriorityLow;
+        (void)events.emplace_back(std::make_shared<MemEvent>(kMalloc, step));
+      }
+      (void)events.emplace_back(std::make_shared<MemEvent>(kGet, step));
+      for (auto &event : events) {
+        event->key = key;
+        event->mem_size = 1;
+      }
+    }
+  }
+  std::set<const void *> manual_offload_keys;
+  std::map<const void *, std::vector<size_t>> high_priority_updated_step;
+  MemOffloadStrategy strategy(mem_priority, mem_events, manual_offload_keys, high_priority_updated_step, kTotalStep);
+  strategy.set_mem_size(kMemSize);
+
+  auto get_swap_in_step = [&strategy]() {
+    for (size_t step = 0; step < kTotalStep; ++step) {
+      for (const auto &event : strategy.GetPreComputeEvents(step)) {
+        if (event->type == kSwapIn) {
+          return step;
+        }
+      }
+    }
+    return kTotalStep;
+  };
+
+  // Swap in before the step computes without the compute time.
+  strategy.Execute();
+  ASSERT_TRUE(strategy.need_swap());
+  ASSERT_EQ(get_swap_in_step(), 5);
+
+  // Swap in early to hide the swap time, until the step 2 whose memory is not enough.
+  constexpr double kComputeTime = 10;
+  constexpr double kSwapBandwidth = 0.01;
+  strategy.SetComputeTime(std::vector<double>(kTotalStep, kComputeTime));
+  strategy.SetSwapBandwidth(kSwapBandwidth);
+  strategy.Execute();
+  ASSERT_EQ(get_swap_in_step(), 3);
+
+  // Swap in at the step 4 if the compute time of the step 4 hides the swap time.
+  strategy.SetComputeTime(std::vector<double>(kTotalStep, 1 / kSwapBandwidth));
+  strategy.Execute();
+  ASSERT_EQ(get_swap_in_step(), 4);
+}
+}  // namespace mindspore::device
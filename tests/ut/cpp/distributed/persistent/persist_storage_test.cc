@@ -98,6 +98,53 @@ TEST_F(TestPersistStorage, test_embedding_storage) {
     EXPECT_EQ(data[i], embdding_table_data->at(i));
   }
 }
+
+/// Feature: test the snapshot of parameter persistent storage.
+/// Description: Take a snapshot of the dirty rows, modify them again, write the snapshot and restore it from the file.
+/// Expectation: The restored content is the content when the snapshot is taken.
+TEST_F(TestPersistStorage, test_embedding_snapshot) {
+  int vocab = 1000;
+  int emb_dim = 16;
+  std::shared_ptr<std::vector<int>> embedding_shape = std::make_shared<std::vector<int>>();
+  embedding_shape->push_back(vocab);
+  embedding_shape->push_back(emb_dim);
+  auto data_ptr = std::make_shared<std::vector<float>>(vocab * emb_dim, 1);
+  PersistentData<float> embedding_table(data_ptr, embedding_shape);
+
+  std::string storage_file_path = "./snapshot_storage";
+  if (!distributed::storage::FileIOUtils::IsFileOrDirExist(storage_file_path)) {
+    distributed::storage::FileIOUtils::CreateDir(storage_file_path);
+  }
+  auto ret = FileUtils::GetRealPath(storage_file_path.c_str());
+  if (!ret.has_value()) {
+    MS_LOG(EXCEPTION) << "Cannot get real path of persistent storage file for parameter.";
+  }
+  std::map<std::string, std::string> config_map;
+  config_map[distributed::storage::kFileStoragePath] = ret.value();
+  // Split the table into several blocks.
+  config_map[distributed::storage::kMaxBlockLength] = std::to_string(100 * emb_dim * sizeof(float));
+  embedding_table.Initialize(config_map);
+
+  // All the blocks are written at the first time.
+  EXPECT_NO_THROW(embedding_table.Snapshot({}));
+  EXPECT_NO_THROW(embedding_table.PersistSnapshot());
+
+  // The dirty info is not sorted when it is accumulated by several updates.
+  distributed::storage::DirtyInfo dirty_info = {850, 3, 850};
+  for (int row : dirty_info) {
+    (embedding_table.data())[row * emb_dim] = 2;
+  }
+  EXPECT_NO_THROW(embedding_table.Snapshot(dirty_info));
+  (embedding_table.data())[3 * emb_dim] = 3;
+  (embedding_table.data())[500 * emb_dim] = 3;
+  EXPECT_NO_THROW(embedding_table.PersistSnapshot());
+
+  EXPECT_NO_THROW(embedding_table.Restore());
+  EXPECT_EQ((embedding_table.data())[3 * emb_dim], 2);
+  EXPECT_EQ((embedding_table.data())[850 * emb_dim], 2);
+  EXPECT_EQ((embedding_table.data())[500 * emb_dim], 1);
+  EXPECT_EQ((embedding_table.data())[999 * emb_dim + 1], 1);
+}
 }  // namespace persistent
 }  // namespace distributed
 }  // namespace mindspore
@@ -21,11 +21,13 @@
 #include <string>
 #include <thread>
 #include <csignal>
+#include <vector>
 
 #include <gtest/gtest.h>
 #define private public
 #include "distributed/rpc/tcp/tcp_server.h"
 #include "distributed/rpc/tcp/tcp_client.h"
+#include "distributed/rpc/tcp/buffer_message.h"
 #include "common/common_test.h"
 
 namespace mindspore {
@@ -218,6 +220,170 @@ TEST_F(TCPTest, sendTwoMessages) {
   server->Finalize();
 }
 
+/// Feature: test sending the buffers of message without copying.
+/// Description: send a message with two buffers to the server which allocates the data buffer.
+/// Expectation: the buffers are received into the allocated data buffer and released on both sides.
+TEST_F(TCPTest, SendBufferMessage) {
+  Init();
+
+  // Start the tcp server which allocates the data buffer.
+  auto server_url = "127.0.0.1:8081";
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize(server_url);
+  ASSERT_TRUE(ret);
+
+  std::vector<char> recv_data;
+  std::atomic<size_t> free_num(0);
+  std::string recv_body;
+  server->SetMemoryCallback(
+    [&recv_data](size_t size) -> void * {
+      recv_data.resize(size);
+      return recv_data.data();
+    },
+    [&free_num](void *) { ++free_num; });
+  server->SetMessageHandler([&recv_body](const std::shared_ptr<MessageBase> &message) -> void {
+    auto buffer_message = std::dynamic_pointer_cast<BufferMessage>(message);
+    if (buffer_message != nullptr && buffer_message->buffers_size() == 8) {
+      recv_body = message->body;
+      IncrDataMsgNum(1);
+    }
+  });
+
+  // Start the tcp client.
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+
+  // Create the message with two buffers.
+  std::string buffer1 = "abcd";
+  std::string buffer2 = "efgh";
+  std::atomic<size_t> release_num(0);
+  auto message = std::make_unique<BufferMessage>();
+  message->name = "testname";
+  message->from = AID("client", "127.0.0.1:1234");
+  message->to = AID("server", server_url);
+  message->body = "body";
+  message->AddBuffer(const_cast<char *>(buffer1.data()), buffer1.size());
+  message->AddBuffer(const_cast<char *>(buffer2.data()), buffer2.size());
+  message->set_release_callback([&release_num]() { ++release_num; });
+
+  client->Connect(server_url);
+  client->Send(std::move(message));
+  WaitForDataMsg(1, 5);
+
+  EXPECT_EQ(1, GetDataMsgNum());
+  EXPECT_EQ("body", recv_body);
+  EXPECT_EQ("abcdefgh", std::string(recv_data.begin(), recv_data.end()));
+  // The buffers are released after the message is sent, and the data buffer is freed after the message is handled.
+  for (size_t i = 0; i < 50 && (release_num == 0 || free_num == 0); ++i) {
+    usleep(100000);
+  }
+  EXPECT_EQ(1, release_num);
+  EXPECT_EQ(1, free_num);
+
+  client->Disconnect(server_url);
+  client->Finalize();
+  server->Finalize();
+}
+
+/// Feature: test sending the buffers through the shared memory.
+/// Description: send the buffer messages to the server on the same host, the data is in the shared memory once the
+/// server attaches the ring advertised by the first message.
+/// Expectation: the data of all messages is received correctly in order.
+TEST_F(TCPTest, SendBufferMessageThroughSharedMemory) {
+  Init();
+  // The shared memory transport is opt-in.
+  (void)setenv("MS_DEV_SHM_TRANSPORT_SIZE", "64", 1);
+  const size_t kDataSize = 4 << 20;
+  const size_t kMsgNum = 32;
+
+  auto server_url = "127.0.0.1:8081";
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize(server_url);
+  ASSERT_TRUE(ret);
+  server->SetMemoryCallback([](size_t size) -> void * { return new char[size]; },
+                            [](void *data) { delete[] static_cast<char *>(data); });
+  std::atomic<size_t> error_num(0);
+  server->SetMessageHandler([&error_num, kDataSize](const std::shared_ptr<MessageBase> &message) -> void {
+    auto buffer_message = std::dynamic_pointer_cast<BufferMessage>(message);
+    char expected = static_cast<char>('a' + GetDataMsgNum() % 26);
+    if (buffer_message == nullptr || buffer_message->buffers_size() != kDataSize || message->body != "body" ||
+        std::string(static_cast<char *>(buffer_message->buffers()[0].first), kDataSize) !=
+          std::string(kDataSize, expected)) {
+      ++error_num;
+    }
+    IncrDataMsgNum(1);
+  });
+
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+  client->Connect(server_url);
+
+  std::vector<std::string> data;
+  for (size_t i = 0; i < kMsgNum; ++i) {
+    (void)data.emplace_back(kDataSize, static_cast<char>('a' + i % 26));
+  }
+  for (size_t i = 0; i < kMsgNum; ++i) {
+    auto message = std::make_unique<BufferMessage>();
+    message->name = "testname";
+    message->from = AID("client", "127.0.0.1:1234");
+    message->to = AID("server", server_url);
+    message->body = "body";
+    message->AddBuffer(const_cast<char *>(data[i].data()), kDataSize / 2);
+    message->AddBuffer(const_cast<char *>(data[i].data()) + kDataSize / 2, kDataSize / 2);
+    client->Send(std::move(message));
+    while (i >= GetDataMsgNum() + 4) {
+      std::this_thread::yield();
+    }
+  }
+  EXPECT_TRUE(WaitForDataMsg(kMsgNum, 10));
+  EXPECT_EQ(0, error_num);
+
+  client->Disconnect(server_url);
+  client->Finalize();
+  server->Finalize();
+  (void)unsetenv("MS_DEV_SHM_TRANSPORT_SIZE");
+}
+
+/// Feature: test sending the buffer message which can't be described by the message header.
+/// Description: send a message with more buffers than the limit, then send a valid message.
+/// Expectation: the invalid message is dropped and released before it is queued, and the valid message is received.
+TEST_F(TCPTest, DropInvalidBufferMessage) {
+  Init();
+
+  auto server_url = "127.0.0.1:8081";
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize(server_url);
+  ASSERT_TRUE(ret);
+  server->SetMessageHandler([](const std::shared_ptr<MessageBase> &message) -> void { IncrDataMsgNum(1); });
+
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+  client->Connect(server_url);
+
+  std::string buffer = "abcd";
+  std::atomic<size_t> release_num(0);
+  auto message = std::make_unique<BufferMessage>();
+  message->name = "testname";
+  message->from = AID("client", "127.0.0.1:1234");
+  message->to = AID("server", server_url);
+  for (size_t i = 0; i <= MAX_MSG_BUFFER_NUM; ++i) {
+    message->AddBuffer(const_cast<char *>(buffer.data()), buffer.size());
+  }
+  message->set_release_callback([&release_num]() { ++release_num; });
+  EXPECT_EQ(SENDMSG_DROPED, client->Send(std::move(message)));
+  EXPECT_EQ(1, release_num);
+
+  client->Send(CreateMessage(server_url, "127.0.0.1:1234"));
+  EXPECT_TRUE(WaitForDataMsg(1, 5));
+
+  client->Disconnect(server_url);
+  client->Finalize();
+  server->Finalize();
+}
+
 /// Feature: test start the tcp server with random port.
 /// Description: start a socket server without specified fixed port.
 /// Expectation: the server started successfully.
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/common_test.h"
+
+#include <memory>
+#include <string>
+
+#include "distributed/shared_memory/shared_memory_ring.h"
+
+namespace mindspore {
+namespace distributed {
+class TestSharedMemoryRing : public UT::Common {
+ public:
+  TestSharedMemoryRing() = default;
+  virtual ~TestSharedMemoryRing() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: test the shared memory ring.
+/// Description: write records into the ring and read them from the attached ring, wrapping around the end of the ring.
+/// Expectation: the records are read in order, and the write fails if the free space is not enough.
+TEST_F(TestSharedMemoryRing, test_write_and_read) {
+  const size_t kCapacity = 16;
+  auto writer = SharedMemoryRing::Create(kCapacity);
+  ASSERT_NE(writer, nullptr);
+  EXPECT_EQ(writer->capacity(), kCapacity);
+  EXPECT_FALSE(writer->attached());
+
+  auto reader = SharedMemoryRing::Attach(writer->shm_id(), writer->token());
+  ASSERT_NE(reader, nullptr);
+  EXPECT_TRUE(writer->attached());
+
+  std::string first = "0123456789";
+  std::string second = "abcdefgh";
+  std::string third = "ABCDEF";
+  ASSERT_TRUE(writer->Write({{first.data(), 4}, {first.data() + 4, first.size() - 4}}));
+  // Only 6 bytes are free in the ring.
+  EXPECT_FALSE(writer->Write({{second.data(), second.size()}}));
+
+  std::string data(first.size(), '\0');
+  ASSERT_TRUE(reader->Read(&data[0], data.size()));
+  EXPECT_EQ(data, first);
+  EXPECT_FALSE(reader->Read(&data[0], 1));
+
+  // The second record wraps around the end of the ring.
+  ASSERT_TRUE(writer->Write({{second.data(), second.size()}}));
+  ASSERT_TRUE(writer->Write({{third.data(), third.size()}}));
+  data.resize(second.size());
+  ASSERT_TRUE(reader->Read(&data[0], data.size()));
+  EXPECT_EQ(data, second);
+  data.resize(third.size());
+  ASSERT_TRUE(reader->Read(&data[0], data.size()));
+  EXPECT_EQ(data, third);
+}
+
+/// Feature: test the shared memory ring.
+/// Description: attach the ring with a wrong token, then with the right token twice.
+/// Expectation: the ring is untouched by the wrong token and only attached once.
+TEST_F(TestSharedMemoryRing, test_attach_with_token) {
+  const size_t kCapacity = 16;
+  auto writer = SharedMemoryRing::Create(kCapacity);
+  ASSERT_NE(writer, nullptr);
+
+  EXPECT_EQ(SharedMemoryRing::Attach(writer->shm_id(), writer->token() + 1), nullptr);
+  EXPECT_FALSE(writer->attached());
+
+  auto reader = SharedMemoryRing::Attach(writer->shm_id(), writer->token());
+  ASSERT_NE(reader, nullptr);
+  EXPECT_TRUE(writer->attached());
+  EXPECT_EQ(SharedMemoryRing::Attach(writer->shm_id(), writer->token()), nullptr);
+}
+}  // namespace distributed
+}  // namespace mindspore
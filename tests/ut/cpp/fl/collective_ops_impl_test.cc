@@ -0,0 +1,291 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#include "fl/server/collective_ops_impl.h"
+#undef private
+
+namespace mindspore {
+namespace fl {
+namespace server {
+namespace {
+constexpr auto kTestRecvTimeout = std::chrono::seconds(30);
+
+// The in-process network of the test channels. The messages from one rank to another are received in the order they
+// are sent, and the meta and size of them are checked by the receiver.
+class TestNetwork {
+ public:
+  void Send(uint32_t src_rank, uint32_t dst_rank, const std::string &phase, size_t chunk_index, size_t for_index,
+            const void *data, size_t size) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    // The federated learning server matches the messages by the meta, which must be unique.
+    if (!sent_keys_.emplace(src_rank, dst_rank, phase, chunk_index, for_index).second) {
+      failed_ = true;
+    }
+    Message message{phase, chunk_index, for_index,
+                    std::vector<unsigned char>(static_cast<const unsigned char *>(data),
+                                               static_cast<const unsigned char *>(data) + size)};
+    queues_[std::make_pair(src_rank, dst_rank)].push_back(std::move(message));
+    cv_.notify_all();
+  }
+
+  bool Recv(uint32_t src_rank, uint32_t dst_rank, const std::string &phase, size_t chunk_index, size_t for_index,
+            size_t expect_size, std::shared_ptr<std::vector<unsigned char>> *output) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    auto &queue = queues_[std::make_pair(src_rank, dst_rank)];
+    if (!cv_.wait_for(lock, kTestRecvTimeout, [&queue]() { return !queue.empty(); })) {
+      failed_ = true;
+      return false;
+    }
+    Message message = std::move(queue.front());
+    queue.pop_front();
+    if (message.phase != phase || message.chunk_index != chunk_index || message.for_index != for_index ||
+        message.data.size() != expect_size) {
+      failed_ = true;
+      return false;
+    }
+    *output = std::make_shared<std::vector<unsigned char>>(std::move(message.data));
+    return true;
+  }
+
+  // Whether any message is out of order, duplicated or left unreceived.
+  bool failed() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (const auto &queue : queues_) {
+      if (!queue.second.empty()) {
+        return true;
+      }
+    }
+    return failed_;
+  }
+
+ private:
+  struct Message {
+    std::string phase;
+    size_t chunk_index;
+    size_t for_index;
+    std::vector<unsigned char> data;
+  };
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::map<std::pair<uint32_t, uint32_t>, std::deque<Message>> queues_;
+  std::set<std::tuple<uint32_t, uint32_t, std::string, size_t, size_t>> sent_keys_;
+  bool failed_{false};
+};
+
+class TestChannel : public CollectiveChannel {
+ public:
+  TestChannel(TestNetwork *network, uint32_t rank_id) : network_(network), rank_id_(rank_id) {}
+  ~TestChannel() override = default;
+
+  void Send(uint32_t dst_rank, const char *phase, size_t chunk_index, size_t for_index, const void *data,
+            size_t size) override {
+    if (size == 0) {
+      return;
+    }
+    network_->Send(rank_id_, dst_rank, phase, chunk_index, for_index, data, size);
+  }
+
+  bool Recv(uint32_t src_rank, const char *phase, size_t chunk_index, size_t for_index, size_t expect_size,
+            std::shared_ptr<std::vector<unsigned char>> *output) override {
+    if (expect_size == 0) {
+      *output = std::make_shared<std::vector<unsigned char>>();
+      return true;
+    }
+    return network_->Recv(src_rank, rank_id_, phase, chunk_index, for_index, expect_size, output);
+  }
+
+  bool WaitAll() override { return true; }
+
+ private:
+  TestNetwork *network_;
+  uint32_t rank_id_;
+};
+
+using RankFunc = std::function<bool(CollectiveChannel *, const std::vector<uint32_t> &, size_t)>;
+
+// Run the function of each rank in a thread. The global ranks are in the reverse order of the positions.
+bool RunRanks(size_t rank_size, const RankFunc &func) {
+  std::vector<uint32_t> ranks;
+  for (size_t i = 0; i < rank_size; i++) {
+    ranks.push_back(static_cast<uint32_t>(rank_size - 1 - i));
+  }
+  TestNetwork network;
+  std::vector<char> results(rank_size, 0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < rank_size; i++) {
+    threads.emplace_back([&, i]() {
+      TestChannel channel(&network, ranks[i]);
+      results[i] = func(&channel, ranks, i) ? 1 : 0;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return !network.failed() && std::all_of(results.begin(), results.end(), [](char result) { return result == 1; });
+}
+
+float TestValue(size_t index, size_t i) { return static_cast<float>((index + 1) * (i % 7)); }
+}  // namespace
+
+class TestCollectiveOpsImpl : public UT::Common {
+ public:
+  TestCollectiveOpsImpl() = default;
+  virtual ~TestCollectiveOpsImpl() = default;
+
+  void SetUp() override {}
+  void TearDown() override { (void)unsetenv("MS_DEV_ALLREDUCE_ALGORITHM"); }
+};
+
+/// Feature: test the AllReduce algorithms of the collective communication.
+/// Description: run every AllReduce algorithm with the odd and even rank sizes and the data smaller than the rank size
+/// or split into multiple pipeline segments, the hierarchical one with two ranks per host.
+/// Expectation: the data of all the ranks is the sum, and the messages are received in the order they are sent.
+TEST_F(TestCollectiveOpsImpl, test_all_reduce_algorithms) {
+  auto &impl = CollectiveOpsImpl::GetInstance();
+  const size_t large_count = (static_cast<size_t>(1) << 18) * 2 + 5;
+  for (const char *algorithm :
+       {"", "ring", "pipelined_ring", "doubling", "halving", "reduce_broadcast", "hierarchical", "auto"}) {
+    (void)setenv("MS_DEV_ALLREDUCE_ALGORITHM", algorithm, 1);
+    for (size_t rank_size : {1, 2, 3, 4, 5, 7, 8}) {
+      std::vector<std::string> hosts;
+      for (size_t i = 0; i < rank_size; i++) {
+        hosts.push_back("127.0.0." + std::to_string(i / 2));
+      }
+      for (size_t count : {static_cast<size_t>(1), rank_size * 3 + 1, large_count}) {
+        std::vector<std::vector<float>> buffs(rank_size);
+        auto all_reduce = [&](CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index) {
+          auto &buff = buffs[index];
+          for (size_t i = 0; i < count; i++) {
+            buff.push_back(TestValue(index, i));
+          }
+          return impl.RunAllReduce<float>(channel, ranks, index, hosts, buff.data(), count);
+        };
+        bool ret = RunRanks(rank_size, all_reduce);
+        ASSERT_TRUE(ret) << "algorithm: " << algorithm << ", rank size: " << rank_size << ", count: " << count;
+        float rank_sum = static_cast<float>(rank_size * (rank_size + 1) / 2);
+        for (size_t index = 0; index < rank_size; index++) {
+          for (size_t i = 0; i < count; i++) {
+            ASSERT_EQ(buffs[index][i], rank_sum * (i % 7))
+              << "algorithm: " << algorithm << ", rank size: " << rank_size << ", count: " << count;
+          }
+        }
+      }
+    }
+  }
+}
+
+/// Feature: test the AllGather, ReduceScatter and AllToAll of the collective communication.
+/// Description: run them with the ring and the pipelined ring with the odd and even rank sizes.
+/// Expectation: every rank gets the chunks of the other ranks, or the sum of its chunk.
+TEST_F(TestCollectiveOpsImpl, test_gather_scatter_all_to_all) {
+  auto &impl = CollectiveOpsImpl::GetInstance();
+  for (const char *algorithm : {"ring", "pipelined_ring"}) {
+    (void)setenv("MS_DEV_ALLREDUCE_ALGORITHM", algorithm, 1);
+    for (size_t rank_size : {1, 2, 3, 5, 8}) {
+      for (size_t count : {static_cast<size_t>(1), static_cast<size_t>(300000)}) {
+        std::vector<std::vector<float>> gathered(rank_size, std::vector<float>(count * rank_size));
+        std::vector<std::vector<float>> scattered(rank_size, std::vector<float>(count));
+        std::vector<std::vector<float>> exchanged(rank_size, std::vector<float>(count * rank_size));
+        auto collective = [&](CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index) {
+          std::vector<float> send(count * rank_size);
+          for (size_t i = 0; i < send.size(); i++) {
+            send[i] = TestValue(index, i);
+          }
+          return impl.RunAllGather<float>(channel, ranks, index, send.data(), gathered[index].data(), count) &&
+                 impl.RunReduceScatter<float>(channel, ranks, index, send.data(), scattered[index].data(), count) &&
+                 impl.RunAllToAll<float>(channel, ranks, index, send.data(), exchanged[index].data(), count);
+        };
+        bool ret = RunRanks(rank_size, collective);
+        ASSERT_TRUE(ret) << "algorithm: " << algorithm << ", rank size: " << rank_size << ", count: " << count;
+        float rank_sum = static_cast<float>(rank_size * (rank_size + 1) / 2);
+        for (size_t index = 0; index < rank_size; index++) {
+          for (size_t src = 0; src < rank_size; src++) {
+            for (size_t i = 0; i < count; i++) {
+              ASSERT_EQ(gathered[index][src * count + i], TestValue(src, i));
+              ASSERT_EQ(exchanged[index][src * count + i], TestValue(src, index * count + i));
+            }
+          }
+          for (size_t i = 0; i < count; i++) {
+            ASSERT_EQ(scattered[index][i], rank_sum * ((index * count + i) % 7));
+          }
+        }
+      }
+    }
+  }
+}
+
+/// Feature: test the compressed AllReduce of the collective communication.
+/// Description: run the fp16 and int8 compressed AllReduce with the odd and even rank sizes and the data not divisible
+/// by the rank size, and check when the compression is used.
+/// Expectation: all the ranks get the same data close to the sum, and the compression is only used if it reduces the
+/// data size.
+TEST_F(TestCollectiveOpsImpl, test_compressed_all_reduce) {
+  auto &impl = CollectiveOpsImpl::GetInstance();
+  const size_t count = 4099;
+  for (const char *type : {"fp16", "int8"}) {
+    ps::GradientCompressionConfig config;
+    ASSERT_TRUE(ps::GradientCompressor::ParseConfig(type, &config));
+    EXPECT_FALSE(CollectiveOpsImpl::NeedCompressedAllReduce(config, count, 1));
+    EXPECT_FALSE(CollectiveOpsImpl::NeedCompressedAllReduce(config, 100, 2));
+    // The headers of the small chunks are larger than the saved data.
+    EXPECT_FALSE(CollectiveOpsImpl::NeedCompressedAllReduce(config, 2048, 512));
+    for (size_t rank_size : {2, 3, 5, 8}) {
+      ASSERT_TRUE(CollectiveOpsImpl::NeedCompressedAllReduce(config, count, rank_size));
+      std::vector<std::vector<float>> buffs(rank_size);
+      auto all_reduce = [&](CollectiveChannel *channel, const std::vector<uint32_t> &ranks, size_t index) {
+        auto &buff = buffs[index];
+        for (size_t i = 0; i < count; i++) {
+          buff.push_back(TestValue(index, i));
+        }
+        return impl.RunCompressedAllReduce(channel, ranks, index, config, buff.data(), count);
+      };
+      ASSERT_TRUE(RunRanks(rank_size, all_reduce)) << "type: " << type << ", rank size: " << rank_size;
+      // The int8 data is encoded twice, each with the error of half the scale.
+      float rank_sum = static_cast<float>(rank_size * (rank_size + 1) / 2);
+      float tolerance = config.type == ps::GradientCompressionType::kInt8 ? rank_sum * 6 / 127 : 0;
+      for (size_t index = 0; index < rank_size; index++) {
+        ASSERT_EQ(buffs[index], buffs[0]);
+      }
+      for (size_t i = 0; i < count; i++) {
+        ASSERT_NEAR(buffs[0][i], rank_sum * (i % 7), tolerance) << "type: " << type << ", rank size: " << rank_size;
+      }
+    }
+  }
+
+  ps::GradientCompressionConfig config;
+  EXPECT_FALSE(CollectiveOpsImpl::NeedCompressedAllReduce(config, count, 2));
+  ASSERT_TRUE(ps::GradientCompressor::ParseConfig("topk:0.01", &config));
+  EXPECT_FALSE(CollectiveOpsImpl::NeedCompressedAllReduce(config, count, 2));
+}
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
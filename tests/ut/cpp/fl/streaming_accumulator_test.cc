@@ -0,0 +1,77 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "fl/server/kernel/streaming_accumulator.h"
+
+namespace mindspore {
+namespace fl {
+namespace server {
+namespace kernel {
+class TestStreamingAccumulator : public UT::Common {
+ public:
+  TestStreamingAccumulator() = default;
+  virtual ~TestStreamingAccumulator() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: test the streaming accumulator of the federated average.
+/// Description: fold the updates of the clients in several threads, including the large updates split to the thread
+/// pool, and average the sum.
+/// Expectation: the sum equals the serial sum, and the update of the wrong size is rejected.
+TEST_F(TestStreamingAccumulator, test_concurrent_fold) {
+  for (size_t count : {static_cast<size_t>(100), kAccumulatorStripeCount * 3 + 7, kParallelFoldCount + 1}) {
+    std::vector<float> sum(count, 0);
+    StreamingAccumulator<float, size_t> accumulator;
+    accumulator.Init(sum.data(), count);
+
+    const size_t client_num = 8;
+    std::vector<std::vector<float>> updates(client_num, std::vector<float>(count));
+    for (size_t c = 0; c < client_num; c++) {
+      for (size_t i = 0; i < count; i++) {
+        updates[c][i] = static_cast<float>((c + 1) * (i % 7));
+      }
+    }
+    std::vector<std::thread> clients;
+    for (size_t c = 0; c < client_num; c++) {
+      clients.emplace_back([&, c]() { EXPECT_TRUE(accumulator.Fold(updates[c].data(), count, c + 1)); });
+    }
+    for (auto &client : clients) {
+      client.join();
+    }
+    EXPECT_FALSE(accumulator.Fold(updates[0].data(), count - 1, 1));
+    EXPECT_EQ(accumulator.update_num(), client_num);
+    // The weight sum is 1 + 2 + ... + 8, and each element is the weight sum times (i % 7).
+    ASSERT_EQ(accumulator.weight_sum(), static_cast<size_t>(36));
+    accumulator.Divide(accumulator.weight_sum());
+    for (size_t i = 0; i < count; i++) {
+      ASSERT_FLOAT_EQ(sum[i], static_cast<float>(i % 7));
+    }
+
+    accumulator.Reset();
+    EXPECT_EQ(accumulator.weight_sum(), static_cast<size_t>(0));
+    EXPECT_EQ(accumulator.update_num(), static_cast<size_t>(0));
+  }
+}
+}  // namespace kernel
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
@@ -0,0 +1,182 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "actor/mailbox.h"
+#include "async/async.h"
+
+namespace mindspore {
+namespace {
+class CountedMessage : public MessageBase {
+ public:
+  CountedMessage(int producer, int seq) : MessageBase(Type::KLOCAL), producer_(producer), seq_(seq) {}
+  ~CountedMessage() override = default;
+  int producer_;
+  int seq_;
+};
+
+// Enqueue num_msgs messages from each of num_producers threads while the consumer drains the mailbox, return the
+// number of messages received per second.
+double RunThroughput(MailBox *mailbox, int num_producers, int num_msgs) {
+  std::atomic<int> ready(0);
+  std::vector<std::thread> producers;
+  for (int p = 0; p < num_producers; p++) {
+    producers.emplace_back([mailbox, p, num_msgs, &ready]() {
+      ready++;
+      for (int i = 0; i < num_msgs; i++) {
+        (void)mailbox->EnqueueMessage(std::make_unique<CountedMessage>(p, i));
+      }
+    });
+  }
+  while (ready.load() < num_producers) {
+    std::this_thread::yield();
+  }
+  auto start = std::chrono::steady_clock::now();
+  int total = num_producers * num_msgs;
+  int received = 0;
+  std::vector<int> next_seq(num_producers, 0);
+  bool in_order = true;
+  auto check = [&next_seq, &in_order](const std::unique_ptr<MessageBase> &msg) {
+    auto counted = static_cast<CountedMessage *>(msg.get());
+    in_order = in_order && (counted->seq_ == next_seq[counted->producer_]);
+    next_seq[counted->producer_]++;
+  };
+  while (received < total) {
+    if (mailbox->TakeAllMsgsEachTime()) {
+      auto msgs = mailbox->GetMsgs();
+      if (msgs == nullptr) {
+        std::this_thread::yield();
+        continue;
+      }
+      for (auto &msg : *msgs) {
+        check(msg);
+        received++;
+      }
+      msgs->clear();
+    } else {
+      auto msg = mailbox->GetMsg();
+      if (msg == nullptr) {
+        std::this_thread::yield();
+        continue;
+      }
+      check(msg);
+      received++;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  EXPECT_TRUE(in_order);
+  double seconds = std::chrono::duration<double>(end - start).count();
+  return seconds > 0 ? total / seconds : 0;
+}
+}  // namespace
+
+class TestMailBox : public UT::Common {
+ public:
+  TestMailBox() = default;
+};
+
+/// Feature: LockFreeMailBox
+/// Description: Enqueue messages from one producer and drain them
+/// Expectation: Messages come out in the order they were enqueued and the mailbox is empty afterwards
+TEST_F(TestMailBox, LockFreeMailBoxFifo) {
+  LockFreeMailBox mailbox;
+  EXPECT_FALSE(mailbox.TakeAllMsgsEachTime());
+  EXPECT_EQ(mailbox.GetMsg(), nullptr);
+  constexpr int kNumMsgs = 100;
+  for (int i = 0; i < kNumMsgs; i++) {
+    (void)mailbox.EnqueueMessage(std::make_unique<CountedMessage>(0, i));
+    // drain while enqueueing, so the messages come from several batches
+    if (i % 10 == 9) {
+      auto msg = mailbox.GetMsg();
+      ASSERT_NE(msg, nullptr);
+      EXPECT_EQ(static_cast<CountedMessage *>(msg.get())->seq_, i / 10);
+    }
+  }
+  for (int i = kNumMsgs / 10; i < kNumMsgs; i++) {
+    auto msg = mailbox.GetMsg();
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(static_cast<CountedMessage *>(msg.get())->seq_, i);
+  }
+  EXPECT_EQ(mailbox.GetMsg(), nullptr);
+}
+
+/// Feature: LockFreeMailBox
+/// Description: Enqueue messages before and after the consumer releases the mailbox
+/// Expectation: The notify hook is only called by the first message after the mailbox is released
+TEST_F(TestMailBox, LockFreeMailBoxNotify) {
+  LockFreeMailBox mailbox;
+  int notified = 0;
+  mailbox.SetNotifyHook(std::make_unique<std::function<void()>>([&notified]() { notified++; }));
+  (void)mailbox.EnqueueMessage(std::make_unique<CountedMessage>(0, 0));
+  (void)mailbox.EnqueueMessage(std::make_unique<CountedMessage>(0, 1));
+  EXPECT_EQ(notified, 1);
+  EXPECT_NE(mailbox.GetMsg(), nullptr);
+  // the actor is still running, so no notification is needed
+  (void)mailbox.EnqueueMessage(std::make_unique<CountedMessage>(0, 2));
+  EXPECT_EQ(notified, 1);
+  EXPECT_NE(mailbox.GetMsg(), nullptr);
+  EXPECT_NE(mailbox.GetMsg(), nullptr);
+  EXPECT_EQ(mailbox.GetMsg(), nullptr);
+  (void)mailbox.EnqueueMessage(std::make_unique<CountedMessage>(0, 3));
+  EXPECT_EQ(notified, 2);
+  // the destructor frees the messages left in the mailbox
+}
+
+/// Feature: LockFreeMailBox
+/// Description: Enqueue messages from several producer threads while the consumer drains the mailbox
+/// Expectation: All messages are received, the messages of each producer in order
+TEST_F(TestMailBox, LockFreeMailBoxMultiProducer) {
+  LockFreeMailBox mailbox;
+  EXPECT_GT(RunThroughput(&mailbox, 4, 10000), 0);
+}
+
+/// Feature: MessageFreeList
+/// Description: Free a MessageAsync and allocate another one on the same thread
+/// Expectation: The memory of the freed message is reused
+TEST_F(TestMailBox, MessageAsyncFreeList) {
+  auto msg = new (std::nothrow) MessageAsync([](ActorBase *) {});
+  ASSERT_NE(msg, nullptr);
+  void *addr = msg;
+  delete static_cast<MessageBase *>(msg);
+  auto reused = new (std::nothrow) MessageAsync([](ActorBase *) {});
+  EXPECT_EQ(static_cast<void *>(reused), addr);
+  delete reused;
+}
+
+/// Feature: LockFreeMailBox
+/// Description: Microbenchmark of the message throughput of the locked and the lock free mailboxes
+/// Expectation: Both mailboxes deliver all messages, the throughput is logged
+TEST_F(TestMailBox, MailBoxThroughput) {
+  constexpr int kNumMsgs = 100000;
+  for (int num_producers : {1, 4}) {
+    NonblockingMailBox locked;
+    LockFreeMailBox lock_free;
+    double locked_rate = RunThroughput(&locked, num_producers, kNumMsgs);
+    double lock_free_rate = RunThroughput(&lock_free, num_producers, kNumMsgs);
+    MS_LOG(INFO) << "Mailbox throughput with " << num_producers << " producers, NonblockingMailBox: " << locked_rate
+                 << " msgs/s, LockFreeMailBox: " << lock_free_rate << " msgs/s.";
+  }
+}
+}  // namespace mindspore
@@ -0,0 +1,242 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "actor/actor.h"
+#include "actor/actormgr.h"
+#include "thread/actor_threadpool.h"
+#include "thread/work_stealing_deque.h"
+
+namespace mindspore {
+namespace {
+constexpr int kHeavyEvery = 8;
+constexpr size_t kMaxBenchmarkThreads = 16;
+
+// Busy loop standing in for a kernel, the result is returned so that it is not optimized away.
+uint64_t Spin(int iterations) {
+  uint64_t value = 1;
+  for (int i = 0; i < iterations; i++) {
+    value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+  }
+  return value;
+}
+
+// Every kHeavyEvery-th subtask costs 16 times as much as the others.
+int IrregularCost(int task_id, int unit) { return task_id % kHeavyEvery == 0 ? unit * 16 : unit; }
+
+struct LaunchContent {
+  std::vector<std::atomic_int> runs;
+  std::atomic<uint64_t> sink{0};
+  int unit;
+  explicit LaunchContent(int task_num, int unit_cost) : runs(task_num), unit(unit_cost) {}
+};
+
+int IrregularTask(void *content, int task_id, float, float) {
+  auto launch = static_cast<LaunchContent *>(content);
+  launch->runs[task_id]++;
+  launch->sink += Spin(IrregularCost(task_id, launch->unit));
+  return THREAD_OK;
+}
+
+// Time in ms of launching the irregular subtasks rounds times
+double LaunchIrregular(ThreadPool *pool, int task_num, int rounds, int unit) {
+  LaunchContent content(task_num, unit);
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    EXPECT_EQ(pool->ParallelLaunch(IrregularTask, &content, task_num), THREAD_OK);
+  }
+  auto end = std::chrono::steady_clock::now();
+  for (auto &runs : content.runs) {
+    EXPECT_EQ(runs.load(), rounds);
+  }
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// An actor doing irregular work for each message, then telling the sink
+class WorkActor : public ActorBase {
+ public:
+  WorkActor(const std::string &name, int cost, const AID &sink) : ActorBase(name), cost_(cost), sink_(sink) {}
+  ~WorkActor() override = default;
+
+ protected:
+  void HandleLocalMsg(const std::unique_ptr<MessageBase> &msg) override {
+    sum_ += Spin(cost_);
+    (void)Send(sink_, std::make_unique<MessageBase>("done", MessageBase::Type::KLOCAL));
+  }
+
+ private:
+  int cost_;
+  AID sink_;
+  uint64_t sum_{0};
+};
+
+class SinkActor : public ActorBase {
+ public:
+  explicit SinkActor(const std::string &name) : ActorBase(name) {}
+  ~SinkActor() override = default;
+  std::atomic_int received_{0};
+
+ protected:
+  void HandleLocalMsg(const std::unique_ptr<MessageBase> &msg) override { received_++; }
+};
+
+// Time in ms of fanning rounds messages out to num_actors actors with irregular work
+double RunActorFanOut(ActorThreadPool *pool, int num_actors, int rounds, int unit, const std::string &prefix) {
+  auto sink = std::make_shared<SinkActor>(prefix + "_sink");
+  sink->set_thread_pool(pool);
+  (void)ActorMgr::GetActorMgrRef()->Spawn(sink);
+  std::vector<std::shared_ptr<WorkActor>> actors;
+  for (int i = 0; i < num_actors; i++) {
+    auto actor = std::make_shared<WorkActor>(prefix + "_" + std::to_string(i), IrregularCost(i, unit), sink->GetAID());
+    actor->set_thread_pool(pool);
+    (void)ActorMgr::GetActorMgrRef()->Spawn(actor);
+    actors.push_back(actor);
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (auto &actor : actors) {
+      auto msg = std::make_unique<MessageBase>("work", MessageBase::Type::KLOCAL);
+      (void)ActorMgr::GetActorMgrRef()->Send(actor->GetAID(), std::move(msg));
+    }
+  }
+  while (sink->received_.load() < num_actors * rounds) {
+    std::this_thread::yield();
+  }
+  auto end = std::chrono::steady_clock::now();
+  for (auto &actor : actors) {
+    ActorMgr::GetActorMgrRef()->Terminate(actor->GetAID());
+  }
+  ActorMgr::GetActorMgrRef()->Terminate(sink->GetAID());
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// the pools cap the thread number to the core number
+std::vector<size_t> ThreadNums() {
+  size_t core_num = std::max(std::thread::hardware_concurrency(), 1U);
+  std::vector<size_t> nums;
+  for (size_t n = 1; n < core_num && n < kMaxBenchmarkThreads; n *= 2) {
+    nums.push_back(n);
+  }
+  nums.push_back(std::min(core_num, kMaxBenchmarkThreads));
+  return nums;
+}
+}  // namespace
+
+class TestThreadPool : public UT::Common {
+ public:
+  TestThreadPool() = default;
+};
+
+/// Feature: WorkStealingDeque
+/// Description: The owner pushes and pops while two thieves steal
+/// Expectation: Every element is taken exactly once
+TEST_F(TestThreadPool, WorkStealingDequeTakesEachOnce) {
+  constexpr int kNum = 100000;
+  WorkStealingDeque<int> deque;
+  ASSERT_TRUE(deque.Init(64));
+  std::vector<int> items(kNum);
+  std::vector<std::atomic_int> taken(kNum);
+  std::atomic_bool done{false};
+  auto thief = [&]() {
+    while (!done || !deque.Empty()) {
+      auto item = deque.Steal();
+      if (item != nullptr) {
+        taken[item - items.data()]++;
+      }
+    }
+  };
+  std::thread thief1(thief);
+  std::thread thief2(thief);
+  for (int i = 0; i < kNum; i++) {
+    while (!deque.Push(&items[i])) {
+      auto item = deque.Pop();
+      if (item != nullptr) {
+        taken[item - items.data()]++;
+      }
+    }
+    if (i % 3 == 0) {
+      auto item = deque.Pop();
+      if (item != nullptr) {
+        taken[item - items.data()]++;
+      }
+    }
+  }
+  done = true;
+  thief1.join();
+  thief2.join();
+  for (int i = 0; i < kNum; i++) {
+    ASSERT_EQ(taken[i].load(), 1) << "element " << i;
+  }
+}
+
+/// Feature: ThreadPool
+/// Description: Launch more subtasks of irregular cost than there are workers, including more subtasks than are kept
+/// in the task on the stack
+/// Expectation: Every subtask runs exactly once per launch
+TEST_F(TestThreadPool, ParallelLaunchRunsEveryTaskOnce) {
+  std::unique_ptr<ThreadPool> pool(ThreadPool::CreateThreadPool(4));
+  ASSERT_NE(pool, nullptr);
+  (void)LaunchIrregular(pool.get(), 37, 20, 100);
+  (void)LaunchIrregular(pool.get(), kMaxInlineSubTaskNum * 2 + 1, 20, 100);
+}
+
+/// Feature: ThreadPool
+/// Description: Launch from several threads at the same time, so that the launches compete for the workers
+/// Expectation: Every subtask of every launch runs exactly once
+TEST_F(TestThreadPool, ConcurrentParallelLaunch) {
+  std::unique_ptr<ThreadPool> pool(ThreadPool::CreateThreadPool(4));
+  ASSERT_NE(pool, nullptr);
+  std::vector<std::thread> launchers;
+  for (int i = 0; i < 4; i++) {
+    launchers.emplace_back([&pool, i]() { (void)LaunchIrregular(pool.get(), 8 + i * 5, 50, 100); });
+  }
+  for (auto &launcher : launchers) {
+    launcher.join();
+  }
+}
+
+/// Feature: ThreadPool
+/// Description: Scaling benchmark of ParallelLaunch with subtasks of irregular cost
+/// Expectation: All launches succeed, the time per thread number is logged
+TEST_F(TestThreadPool, ParallelLaunchScaling) {
+  for (auto thread_num : ThreadNums()) {
+    std::unique_ptr<ThreadPool> pool(ThreadPool::CreateThreadPool(thread_num));
+    ASSERT_NE(pool, nullptr);
+    double ms = LaunchIrregular(pool.get(), 64, 50, 2000);
+    MS_LOG(INFO) << "ParallelLaunch of 64 irregular subtasks x 50 with " << thread_num << " threads: " << ms << " ms.";
+  }
+}
+
+/// Feature: ActorThreadPool
+/// Description: Scaling benchmark of actors with irregular work fanned out from one sender
+/// Expectation: All messages are handled, the time per thread number is logged
+TEST_F(TestThreadPool, ActorFanOutScaling) {
+  for (auto thread_num : ThreadNums()) {
+    std::unique_ptr<ActorThreadPool> pool(ActorThreadPool::CreateThreadPool(thread_num));
+    ASSERT_NE(pool, nullptr);
+    double ms = RunActorFanOut(pool.get(), 64, 50, 2000, "fan_out_" + std::to_string(thread_num));
+    MS_LOG(INFO) << "Actor fan out to 64 irregular actors x 50 with " << thread_num << " threads: " << ms << " ms.";
+  }
+}
+}  // namespace mindspore
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "common/common_test.h"
+#include "backend/common/somas/somas_solver_search.h"
+
+namespace mindspore {
+namespace somas {
+namespace {
+constexpr size_t kTensorNum = 64;
+constexpr size_t kStepNum = 32;
+constexpr size_t kMaxTensorSize = 1024;
+constexpr size_t kContiguousInterval = 8;
+constexpr size_t kLifelongInterval = 16;
+constexpr int64_t kSearchTimeMs = 200;
+}  // namespace
+
+class TestSomasSolverSearch : public UT::Common {
+ public:
+  TestSomasSolverSearch() = default;
+
+  void SetUp() override {
+    std::mt19937 random(0);
+    std::uniform_int_distribution<size_t> size_dist(1, kMaxTensorSize);
+    std::uniform_int_distribution<size_t> step_dist(0, kStepNum - 1);
+    for (size_t i = 0; i < kTensorNum; ++i) {
+      auto start = step_dist(random);
+      auto end = step_dist(random);
+      if (start > end) {
+        std::swap(start, end);
+      }
+      (void)lifetimes_.emplace_back(start, end);
+      bool lifelong = (i % kLifelongInterval == kLifelongInterval - 1);
+      tensors_[i] = std::make_shared<SomasSolverTensorDesc>(i, size_dist(random), 0, lifelong);
+    }
+    // Every two tensors in the interval are contiguous, and they live together.
+    for (size_t i = 0; i + 1 < kTensorNum; i += kContiguousInterval) {
+      if (tensors_[i]->lifelong_ || tensors_[i + 1]->lifelong_) {
+        continue;
+      }
+      lifetimes_[i + 1] = lifetimes_[i];
+      tensors_[i]->right_ = tensors_[i + 1];
+      tensors_[i + 1]->left_ = tensors_[i];
+      (void)contiguous_pairs_.emplace_back(i, i + 1);
+    }
+    // The bit is true if the two tensors can share the memory.
+    for (size_t i = 0; i < kTensorNum; ++i) {
+      DynamicBitSet constraint(kTensorNum);
+      for (size_t j = 0; j < kTensorNum; ++j) {
+        if (!Conflict(i, j)) {
+          constraint.SetBitTrue(j);
+        }
+      }
+      (void)constraints_.emplace_back(std::move(constraint));
+    }
+  }
+
+  bool Conflict(size_t i, size_t j) const {
+    if (i == j) {
+      return false;
+    }
+    if (tensors_.at(i)->lifelong_ || tensors_.at(j)->lifelong_) {
+      return true;
+    }
+    return (lifetimes_[i].first <= lifetimes_[j].second) && (lifetimes_[j].first <= lifetimes_[i].second);
+  }
+
+  size_t TotalSize() const {
+    size_t total_size = 0;
+    for (const auto &tensor : tensors_) {
+      total_size += tensor.second->size_;
+    }
+    return total_size;
+  }
+
+  TensorsDescMap tensors_;
+  std::vector<DynamicBitSet> constraints_;
+  std::vector<std::pair<size_t, size_t>> lifetimes_;
+  std::vector<std::pair<size_t, size_t>> contiguous_pairs_;
+};
+
+/// Feature: somas search solver.
+/// Description: search the memory layout of tensors with random lifetimes, and the upper bound is no memory reuse.
+/// Expectation: the solved layout is smaller than the upper bound, the tensors with overlapping lifetimes don't
+/// overlap in memory, and the contiguous tensors are adjacent.
+TEST_F(TestSomasSolverSearch, test_solved_layout_has_no_overlap) {
+  auto upperbound = TotalSize();
+  SomasSolverSearch search_solver(tensors_, &constraints_);
+  auto total_size = search_solver.Search(upperbound, kSearchTimeMs);
+  ASSERT_LT(total_size, upperbound);
+
+  for (size_t i = 0; i < kTensorNum; ++i) {
+    const auto &tensor1 = tensors_[i];
+    ASSERT_LE(tensor1->offset_ + tensor1->size_, total_size);
+    for (size_t j = i + 1; j < kTensorNum; ++j) {
+      if (!Conflict(i, j)) {
+        continue;
+      }
+      const auto &tensor2 = tensors_[j];
+      bool disjoint = (tensor1->offset_ + tensor1->size_ <= tensor2->offset_) ||
+                      (tensor2->offset_ + tensor2->size_ <= tensor1->offset_);
+      ASSERT_TRUE(disjoint) << "tensor " << i << " [" << tensor1->offset_ << ", " << tensor1->size_ << "] overlaps "
+                            << "tensor " << j << " [" << tensor2->offset_ << ", " << tensor2->size_ << "]";
+    }
+  }
+  for (const auto &pair : contiguous_pairs_) {
+    const auto &left = tensors_[pair.first];
+    const auto &right = tensors_[pair.second];
+    ASSERT_EQ(left->offset_ + left->size_, right->offset_);
+  }
+}
+
+/// Feature: somas search solver.
+/// Description: search the memory layout with the time budget 0, which is the default.
+/// Expectation: the search is skipped and the upper bound is returned.
+TEST_F(TestSomasSolverSearch, test_search_disabled) {
+  auto upperbound = TotalSize();
+  SomasSolverSearch search_solver(tensors_, &constraints_);
+  ASSERT_EQ(search_solver.Search(upperbound, 0), upperbound);
+}
+}  // namespace somas
+}  // namespace mindspore
@@ -0,0 +1,214 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#include "ps/dynamic_embedding_table.h"
+#undef private
+
+namespace mindspore {
+namespace ps {
+class TestDynamicEmbeddingTable : public UT::Common {
+ public:
+  TestDynamicEmbeddingTable() = default;
+  virtual ~TestDynamicEmbeddingTable() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+namespace {
+// A sparse SGD optimizer with the inputs: var, lr, grad and indices.
+bool SparseSGD(const std::vector<AddressPtr> &inputs) {
+  auto var = reinterpret_cast<float *>(inputs[0]->addr);
+  float lr = *reinterpret_cast<float *>(inputs[1]->addr);
+  auto grad = reinterpret_cast<float *>(inputs[2]->addr);
+  auto indices = reinterpret_cast<int *>(inputs[3]->addr);
+  size_t indices_size = inputs[3]->size / sizeof(int);
+  size_t dim = inputs[2]->size / sizeof(float) / indices_size;
+  for (size_t i = 0; i < indices_size; i++) {
+    for (size_t j = 0; j < dim; j++) {
+      var[indices[i] * dim + j] -= lr * grad[i * dim + j];
+    }
+  }
+  return true;
+}
+}  // namespace
+
+/// Feature: test the dynamic embedding table of the parameter server.
+/// Description: look up the ids several times with the admission threshold 2, update them with a duplicate id and let
+/// them expire.
+/// Expectation: the ids are zero before admission, initialized on demand, updated by the optimizer and evicted by ttl.
+TEST_F(TestDynamicEmbeddingTable, test_admission_update_and_ttl) {
+  DynamicEmbeddingTableConfig config;
+  config.embedding_dim = 4;
+  config.capacity = 8;
+  config.admission_threshold = 2;
+  config.ttl_steps = 2;
+  config.initial_values = {1.0};
+  config.init_stddev = 0;
+  DynamicEmbeddingTable table(config);
+
+  std::vector<Key> ids = {1ULL << 40, 7};
+  std::vector<float> output(ids.size() * config.embedding_dim, -1);
+  table.Lookup(ids.data(), ids.size(), output.data());
+  EXPECT_EQ(output, std::vector<float>(output.size(), 0));
+  EXPECT_EQ(table.size(), 0);
+  table.Lookup(ids.data(), ids.size(), output.data());
+  EXPECT_EQ(output, std::vector<float>(output.size(), 1));
+  EXPECT_EQ(table.size(), 2);
+
+  // The gradient of the id without a row is dropped, and the ones of the same id are summed.
+  std::vector<Key> grad_ids = {7, 9, 7};
+  std::vector<float> grad(grad_ids.size() * config.embedding_dim, 1);
+  float lr = 0.25;
+  std::vector<AddressPtr> hyper_params = {std::make_shared<kernel::Address>(&lr, sizeof(float))};
+  size_t indices_num = 0;
+  auto optimizer = [&indices_num](const std::vector<AddressPtr> &inputs) {
+    indices_num = inputs[3]->size / sizeof(int);
+    return SparseSGD(inputs);
+  };
+  EXPECT_TRUE(table.ApplyGradients(grad_ids.data(), grad.data(), grad_ids.size(), hyper_params, optimizer));
+  EXPECT_EQ(indices_num, 1);
+  // A server gets the pushes without ids, which are skipped.
+  EXPECT_TRUE(table.ApplyGradients(nullptr, nullptr, 0, hyper_params, optimizer));
+  EXPECT_EQ(indices_num, 1);
+  table.Lookup(ids.data(), ids.size(), output.data());
+  EXPECT_EQ(output[0], 1);
+  EXPECT_EQ(output[config.embedding_dim], 0.5);
+  EXPECT_EQ(table.size(), 2);
+
+  // Id 7 is accessed in each step and kept, and the other one expires.
+  for (int step = 0; step < 3; step++) {
+    table.EndStep();
+    table.Lookup(ids.data() + 1, 1, output.data());
+  }
+  EXPECT_EQ(table.size(), 1);
+  EXPECT_EQ(output[0], 0.5);
+}
+
+/// Feature: test the dynamic embedding table of the parameter server.
+/// Description: look up more ids than the pending ids limit with the admission threshold 2 and ttl_steps 0, and end
+/// the steps without looking them up.
+/// Expectation: the new ids beyond the limit are not counted, the expired pending ids are dropped while the rows are
+/// kept, and the dropped ids are counted from the beginning again.
+TEST_F(TestDynamicEmbeddingTable, test_pending_ids_without_ttl) {
+  DynamicEmbeddingTableConfig config;
+  config.embedding_dim = 2;
+  config.capacity = 4;
+  config.admission_threshold = 2;
+  config.pending_ttl_steps = 2;
+  config.max_pending_ids = 3;
+  DynamicEmbeddingTable table(config);
+
+  std::vector<Key> ids = {1, 2, 3, 4};
+  std::vector<float> output(ids.size() * config.embedding_dim);
+  table.Lookup(ids.data(), ids.size(), output.data());
+  table.Lookup(ids.data() + 3, 1, output.data());
+  EXPECT_EQ(table.pending_ids_.size(), 3);
+  EXPECT_EQ(table.size(), 0);
+  table.Lookup(ids.data(), 1, output.data());
+  EXPECT_EQ(table.pending_ids_.size(), 2);
+  EXPECT_EQ(table.size(), 1);
+
+  for (int step = 0; step < 3; step++) {
+    table.EndStep();
+  }
+  EXPECT_TRUE(table.pending_ids_.empty());
+  EXPECT_EQ(table.size(), 1);
+  table.Lookup(ids.data() + 1, 3, output.data());
+  EXPECT_EQ(table.size(), 1);
+  table.Lookup(ids.data() + 1, 3, output.data());
+  EXPECT_EQ(table.size(), 4);
+  EXPECT_TRUE(table.pending_ids_.empty());
+
+  // The default pending ttl is used if ttl_steps is 0.
+  DynamicEmbeddingTableConfig default_config;
+  default_config.embedding_dim = 2;
+  default_config.capacity = 4;
+  DynamicEmbeddingTable default_table(default_config);
+  EXPECT_GT(default_table.config_.pending_ttl_steps, 0);
+  EXPECT_GT(default_table.config_.max_pending_ids, 0);
+}
+
+/// Feature: test the dynamic embedding table of the parameter server.
+/// Description: look up more ids than the capacity with a spill file, and update the spilled rows.
+/// Expectation: the cold rows are spilled to the file and loaded back with the embeddings and the optimizer states.
+TEST_F(TestDynamicEmbeddingTable, test_spill_to_file) {
+  DynamicEmbeddingTableConfig config;
+  config.embedding_dim = 3;
+  config.state_num = 2;
+  config.capacity = 4;
+  config.initial_values = {0, 0.1};
+  config.init_stddev = 0.1;
+  config.spill_dir = ".";
+  DynamicEmbeddingTable table(config);
+
+  const size_t id_num = 10;
+  std::vector<std::vector<float>> embeddings(id_num, std::vector<float>(config.embedding_dim));
+  for (Key id = 0; id < id_num; id++) {
+    table.Lookup(&id, 1, embeddings[id].data());
+  }
+  EXPECT_EQ(table.size(), id_num);
+  EXPECT_EQ(table.resident_size(), config.capacity);
+  EXPECT_EQ(table.spilled_size(), id_num - config.capacity);
+  EXPECT_NE(embeddings[0], embeddings[1]);
+
+  // The optimizer adds the gradient to the var and the state, and the rows of the spilled ids are loaded.
+  auto optimizer = [](const std::vector<AddressPtr> &inputs) {
+    auto var = reinterpret_cast<float *>(inputs[0]->addr);
+    auto accum = reinterpret_cast<float *>(inputs[1]->addr);
+    auto grad = reinterpret_cast<float *>(inputs[2]->addr);
+    auto indices = reinterpret_cast<int *>(inputs[3]->addr);
+    for (size_t i = 0; i < inputs[3]->size / sizeof(int); i++) {
+      for (size_t j = 0; j < 3; j++) {
+        var[indices[i] * 3 + j] += grad[i * 3 + j];
+        accum[indices[i] * 3 + j] += grad[i * 3 + j];
+      }
+    }
+    return true;
+  };
+  std::vector<Key> grad_ids = {0, 1};
+  std::vector<float> grad(grad_ids.size() * config.embedding_dim, 1);
+  EXPECT_TRUE(table.ApplyGradients(grad_ids.data(), grad.data(), grad_ids.size(), {}, optimizer));
+  for (Key id = 0; id < id_num; id++) {
+    std::vector<float> output(config.embedding_dim);
+    table.Lookup(&id, 1, output.data());
+    for (size_t j = 0; j < config.embedding_dim; j++) {
+      EXPECT_FLOAT_EQ(output[j], embeddings[id][j] + (id < grad_ids.size() ? 1 : 0));
+    }
+  }
+
+  // The state of the spilled row is kept: update id 0 again after it is spilled.
+  EXPECT_TRUE(table.ApplyGradients(grad_ids.data(), grad.data(), 1, {}, [](const std::vector<AddressPtr> &inputs) {
+    auto accum = reinterpret_cast<float *>(inputs[1]->addr);
+    auto indices = reinterpret_cast<int *>(inputs[3]->addr);
+    EXPECT_FLOAT_EQ(accum[indices[0] * 3], 1.1);
+    return true;
+  }));
+
+  // The ids of one request can not exceed the capacity.
+  std::vector<Key> ids(config.capacity + 1);
+  for (size_t i = 0; i < ids.size(); i++) {
+    ids[i] = 100 + i;
+  }
+  std::vector<float> output(ids.size() * config.embedding_dim);
+  EXPECT_ANY_THROW(table.Lookup(ids.data(), ids.size(), output.data()));
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,110 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/ps_cache/embedding_id_map.h"
+#include "ps/ps_cache/embedding_hash_map.h"
+
+namespace mindspore {
+namespace ps {
+class TestEmbeddingIdMap : public UT::Common {
+ public:
+  TestEmbeddingIdMap() = default;
+  virtual ~TestEmbeddingIdMap() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: test the id map of the embedding cache.
+/// Description: insert, erase and find random ids repeatedly, and compare the map with std::map.
+/// Expectation: the map always has the same items as std::map, and the batch lookup equals the single lookups.
+TEST_F(TestEmbeddingIdMap, test_insert_erase_and_find) {
+  const size_t capacity = 1000;
+  EmbeddingIdMap id_map(capacity);
+  std::map<int, int> expected;
+  std::mt19937 engine(0);
+  std::uniform_int_distribution<int> distribution(-3000, 3000);
+  for (int i = 0; i < 100000; i++) {
+    int id = distribution(engine);
+    if (expected.size() < capacity && expected.count(id) == 0) {
+      EXPECT_TRUE(id_map.Insert(id, i));
+      expected[id] = i;
+    } else {
+      EXPECT_EQ(id_map.Erase(id), expected.erase(id) == 1);
+    }
+    ASSERT_EQ(id_map.size(), expected.size());
+  }
+  EXPECT_FALSE(id_map.Insert(expected.begin()->first, -5));
+
+  std::vector<int> ids(6001);
+  for (size_t i = 0; i < ids.size(); i++) {
+    ids[i] = static_cast<int>(i) - 3000;
+  }
+  std::vector<int> indices(ids.size());
+  id_map.FindBatch(ids.data(), ids.size(), indices.data());
+  for (size_t i = 0; i < ids.size(); i++) {
+    auto iter = expected.find(ids[i]);
+    EXPECT_EQ(indices[i], iter == expected.end() ? -1 : iter->second);
+    EXPECT_EQ(id_map.Find(ids[i]), indices[i]);
+  }
+  size_t count = 0;
+  id_map.ForEach([&](int id, int index) {
+    EXPECT_EQ(expected[id], index);
+    count++;
+  });
+  EXPECT_EQ(count, expected.size());
+  id_map.Clear();
+  EXPECT_TRUE(id_map.empty());
+  EXPECT_EQ(id_map.Find(ids[0]), -1);
+}
+
+/// Feature: test the eviction policies of the embedding cache.
+/// Description: fill the cache, hit some ids in a later step, and insert a new id with the LFU policy.
+/// Expectation: the least frequently used expired id in the sampled positions is swapped out instead of the first one.
+TEST_F(TestEmbeddingIdMap, test_lfu_eviction) {
+  // The first and the last positions are reserved.
+  const size_t capacity = 6;
+  EmbeddingHashMap hash_map(0, capacity);
+  hash_map.set_eviction_policy(EvictionPolicy::kLFU);
+  std::vector<int> swap_out_index(capacity);
+  std::vector<int> swap_out_ids(capacity);
+  size_t swap_out_size = 0;
+  bool need_wait_graph = false;
+  for (int id = 0; id < 4; id++) {
+    EXPECT_EQ(hash_map.ParseData(id, swap_out_index.data(), swap_out_ids.data(), 1, 0, &swap_out_size,
+                                 &need_wait_graph),
+              id + 1);
+  }
+  // Id 0 and 2 are hit in the running step 2, and id 1 is hit again in step 1.
+  hash_map.set_hash_step(1, 2);
+  hash_map.set_hash_step(3, 2);
+  hash_map.set_hash_step(2, 1);
+  hash_map.Reset();
+  int index =
+    hash_map.ParseData(10, swap_out_index.data(), swap_out_ids.data(), 3, 2, &swap_out_size, &need_wait_graph);
+  EXPECT_EQ(index, 4);
+  EXPECT_EQ(swap_out_size, 1);
+  EXPECT_EQ(swap_out_ids[0], 3);
+  EXPECT_EQ(hash_map.hash_id_to_index().Find(10), 4);
+  EXPECT_EQ(hash_map.hash_id_to_index().Find(3), -1);
+  EXPECT_EQ(hash_map.hash_id_to_index().Find(1), 2);
+}
+}  // namespace ps
+}  // namespace mindspore
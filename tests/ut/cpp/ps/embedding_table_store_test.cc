@@ -0,0 +1,158 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/embedding_table_store.h"
+#include "ps/constants.h"
+#include "distributed/persistent/data.h"
+#include "utils/file_utils.h"
+
+namespace mindspore {
+namespace ps {
+class TestEmbeddingTableStore : public UT::Common {
+ public:
+  TestEmbeddingTableStore() = default;
+  virtual ~TestEmbeddingTableStore() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: test the embedding table store of the parameter server.
+/// Description: look up and update the rows of a table shard whose ids start from 100.
+/// Expectation: the rows of the shard are read and written, and the ids out of the shard are read as zero.
+TEST_F(TestEmbeddingTableStore, test_lookup_and_update) {
+  const size_t rows = 10;
+  const size_t dim = 3;
+  const size_t offset = 100;
+  std::vector<float> table(rows * dim);
+  for (size_t i = 0; i < table.size(); i++) {
+    table[i] = static_cast<float>(i);
+  }
+  EmbeddingTableStore store(table.data(), rows, dim, offset, 4);
+
+  std::vector<size_t> ids = {105, 1, 100, 105, 109};
+  std::vector<float> output(ids.size() * dim, -1);
+  store.Lookup(ids.data(), ids.size(), output.data());
+  for (size_t i = 0; i < ids.size(); i++) {
+    for (size_t j = 0; j < dim; j++) {
+      float expected = ids[i] < offset ? 0 : static_cast<float>((ids[i] - offset) * dim + j);
+      EXPECT_EQ(output[i * dim + j], expected);
+    }
+  }
+
+  // The later value of the duplicated id is kept.
+  std::vector<size_t> update_ids = {102, 102, 107};
+  std::vector<float> values = {1, 1, 1, 2, 2, 2, 3, 3, 3};
+  EXPECT_TRUE(store.Update(update_ids.data(), update_ids.size(), values.data()));
+  EXPECT_EQ(table[2 * dim], 2);
+  EXPECT_EQ(table[7 * dim + 2], 3);
+  std::vector<size_t> invalid_ids = {103, 110};
+  EXPECT_FALSE(store.Update(invalid_ids.data(), invalid_ids.size(), values.data()));
+  EXPECT_EQ(table[3 * dim], 3 * dim);
+}
+
+/// Feature: test the embedding table store of the parameter server.
+/// Description: look up the rows in several threads while another thread updates them.
+/// Expectation: every looked up row is either the old row or the new row as a whole.
+TEST_F(TestEmbeddingTableStore, test_concurrent_lookup_and_update) {
+  const size_t rows = 64;
+  const size_t dim = 256;
+  std::vector<float> table(rows * dim, 0);
+  EmbeddingTableStore store(table.data(), rows, dim, 0);
+  std::vector<size_t> ids(rows);
+  for (size_t i = 0; i < rows; i++) {
+    ids[i] = i;
+  }
+
+  std::thread writer([&]() {
+    for (int step = 1; step <= 50; step++) {
+      std::vector<float> values(rows * dim, static_cast<float>(step));
+      EXPECT_TRUE(store.Update(ids.data(), ids.size(), values.data()));
+    }
+  });
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.emplace_back([&]() {
+      std::vector<float> output(rows * dim);
+      for (int step = 0; step < 50; step++) {
+        store.Lookup(ids.data(), ids.size(), output.data());
+        for (size_t i = 0; i < rows; i++) {
+          for (size_t j = 1; j < dim; j++) {
+            ASSERT_EQ(output[i * dim + j], output[i * dim]);
+          }
+        }
+      }
+    });
+  }
+  writer.join();
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(table[0], 50);
+}
+
+/// Feature: test the embedding table store of the parameter server.
+/// Description: persist an embedding table shard, restore it to a new weight as the recovered server does, and create
+/// the store by the shape of the lookup kernel.
+/// Expectation: the rows looked up from the recovered table are the persisted ones.
+TEST_F(TestEmbeddingTableStore, test_lookup_after_recovery) {
+  const size_t rows = 100;
+  const size_t dim = 8;
+  const int64_t offset = 200;
+  auto shape = std::make_shared<std::vector<int>>(std::vector<int>{static_cast<int>(rows), static_cast<int>(dim)});
+  auto data = std::make_shared<std::vector<float>>(rows * dim);
+  for (size_t i = 0; i < data->size(); i++) {
+    (*data)[i] = static_cast<float>(i);
+  }
+
+  std::string storage_file_path = "./embedding_recovery_storage";
+  if (!distributed::storage::FileIOUtils::IsFileOrDirExist(storage_file_path)) {
+    distributed::storage::FileIOUtils::CreateDir(storage_file_path);
+  }
+  auto real_path = FileUtils::GetRealPath(storage_file_path.c_str());
+  ASSERT_TRUE(real_path.has_value());
+  std::map<std::string, std::string> config_map;
+  config_map[distributed::storage::kFileStoragePath] = real_path.value();
+  PersistentWeight weight(data, shape);
+  weight.Initialize(config_map);
+  weight.Persist(distributed::storage::DirtyInfo());
+
+  auto recovered = std::make_shared<PersistentWeight>(std::make_shared<std::vector<float>>(rows * dim, 0), shape);
+  recovered->Initialize(config_map);
+  recovered->Restore();
+  auto store = EmbeddingTableStore::Create(recovered->data(), {rows, dim}, offset);
+  ASSERT_NE(store, nullptr);
+  EXPECT_EQ(store->first_dim_size(), rows);
+  EXPECT_EQ(store->outer_dim_size(), dim);
+
+  std::vector<size_t> ids = {200, 299, 250, 10};
+  std::vector<float> output(ids.size() * dim, -1);
+  store->Lookup(ids.data(), ids.size(), output.data());
+  for (size_t i = 0; i < ids.size(); i++) {
+    for (size_t j = 0; j < dim; j++) {
+      float expected = ids[i] < static_cast<size_t>(offset) ? 0 : static_cast<float>((ids[i] - offset) * dim + j);
+      EXPECT_EQ(output[i * dim + j], expected);
+    }
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
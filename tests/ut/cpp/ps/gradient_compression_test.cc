@@ -0,0 +1,135 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#include "ps/gradient_compression.h"
+#undef private
+
+namespace mindspore {
+namespace ps {
+class TestGradientCompression : public UT::Common {
+ public:
+  TestGradientCompression() = default;
+  virtual ~TestGradientCompression() = default;
+
+  void SetUp() override {}
+  void TearDown() override { GradientCompressor::GetInstance().ClearResiduals(); }
+};
+
+/// Feature: test the config of the gradient compression.
+/// Description: parse the valid and invalid compression types.
+/// Expectation: the valid types are parsed, and the invalid ones are rejected.
+TEST_F(TestGradientCompression, test_parse_config) {
+  GradientCompressionConfig config;
+  EXPECT_TRUE(GradientCompressor::ParseConfig("int8", &config));
+  EXPECT_EQ(config.type, GradientCompressionType::kInt8);
+  EXPECT_TRUE(GradientCompressor::ParseConfig("topk:0.1", &config));
+  EXPECT_EQ(config.type, GradientCompressionType::kTopK);
+  EXPECT_FLOAT_EQ(config.topk_ratio, 0.1);
+  EXPECT_FALSE(GradientCompressor::ParseConfig("topk:2", &config));
+  EXPECT_FALSE(GradientCompressor::ParseConfig("int4", &config));
+  EXPECT_FALSE(GradientCompressor::NeedCompress(config, 1));
+}
+
+/// Feature: test the gradient compression.
+/// Description: compress a gradient with each type and decode it.
+/// Expectation: the size is as expected, and the decoded gradient plus the residual equals the original gradient.
+TEST_F(TestGradientCompression, test_compress_and_decompress) {
+  const size_t count = 4096;
+  std::vector<float> grad(count);
+  for (size_t i = 0; i < count; i++) {
+    grad[i] = std::sin(static_cast<float>(i)) * (i % 13);
+  }
+  auto &compressor = GradientCompressor::GetInstance();
+  for (const std::string &type : {"none", "fp16", "int8", "topk:0.01"}) {
+    GradientCompressionConfig config;
+    ASSERT_TRUE(GradientCompressor::ParseConfig(type, &config));
+    std::string encoded;
+    compressor.Compress(type, config, grad.data(), count, &encoded);
+    ASSERT_EQ(encoded.size(), GradientCompressor::CompressedSize(config, count));
+    std::vector<float> decoded(count, 0);
+    ASSERT_EQ(GradientCompressor::DecompressAdd(encoded.data(), encoded.size(), decoded.data(), count), encoded.size());
+
+    // The compression error is kept in the residual, so it is sent with a zero gradient in the next step.
+    std::vector<float> zeros(count, 0);
+    std::string residual;
+    compressor.Compress(type, {GradientCompressionType::kFloat16, 0}, zeros.data(), count, &residual);
+    (void)GradientCompressor::DecompressAdd(residual.data(), residual.size(), decoded.data(), count);
+    for (size_t i = 0; i < count; i++) {
+      EXPECT_NEAR(decoded[i], grad[i], 1e-2);
+    }
+  }
+  // The invalid data is rejected.
+  std::vector<float> decoded(count, 0);
+  EXPECT_EQ(GradientCompressor::DecompressAdd(grad.data(), 1, decoded.data(), count), 0);
+}
+
+/// Feature: test the error feedback of the gradient compression.
+/// Description: compress the gradients without the name, and the non-finite gradient with the name.
+/// Expectation: no residual is kept without the name, and the residual is reset after the non-finite gradient.
+TEST_F(TestGradientCompression, test_residual_reset) {
+  const size_t count = 2048;
+  std::vector<float> grad(count);
+  for (size_t i = 0; i < count; i++) {
+    grad[i] = std::cos(static_cast<float>(i)) * (i % 5);
+  }
+  auto &compressor = GradientCompressor::GetInstance();
+  GradientCompressionConfig config;
+  ASSERT_TRUE(GradientCompressor::ParseConfig("int8", &config));
+
+  // The same gradient is encoded the same without the name.
+  std::string first;
+  std::string second;
+  compressor.Compress("", config, grad.data(), count, &first);
+  compressor.Compress("", config, grad.data(), count, &second);
+  EXPECT_EQ(first, second);
+  EXPECT_TRUE(compressor.residuals_.empty());
+
+  // The NaN is not kept in the residual, so the next gradient is encoded as usual.
+  std::vector<float> overflow(grad);
+  overflow[1] = std::nanf("");
+  std::string encoded;
+  compressor.Compress("weight", config, overflow.data(), count, &encoded);
+  encoded.clear();
+  compressor.Compress("weight", config, grad.data(), count, &encoded);
+  EXPECT_EQ(encoded, first);
+
+  // The value out of the float16 range is not kept in the residual either.
+  ASSERT_TRUE(GradientCompressor::ParseConfig("fp16", &config));
+  std::vector<float> large(grad);
+  large[0] = 1e6;
+  first.clear();
+  compressor.Compress("", config, grad.data(), count, &first);
+  encoded.clear();
+  compressor.Compress("weight", config, large.data(), count, &encoded);
+  encoded.clear();
+  compressor.Compress("weight", config, grad.data(), count, &encoded);
+  EXPECT_EQ(encoded, first);
+
+  // The NaN is sent by the top-k compression.
+  ASSERT_TRUE(GradientCompressor::ParseConfig("topk:0.01", &config));
+  encoded.clear();
+  compressor.Compress("topk_weight", config, overflow.data(), count, &encoded);
+  std::vector<float> decoded(count, 0);
+  ASSERT_EQ(GradientCompressor::DecompressAdd(encoded.data(), encoded.size(), decoded.data(), count), encoded.size());
+  EXPECT_TRUE(std::isnan(decoded[1]));
+}
+}  // namespace ps
+}  // namespace mindspore
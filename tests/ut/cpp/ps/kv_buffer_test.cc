@@ -0,0 +1,73 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/kv_buffer.h"
+
+namespace mindspore {
+namespace ps {
+class TestKVBuffer : public UT::Common {
+ public:
+  TestKVBuffer() = default;
+  virtual ~TestKVBuffer() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: test the flat message of the push and pull.
+/// Description: write the keys, lengths, values and compressed data, and parse the message at an unaligned address.
+/// Expectation: the parsed arrays equal the written ones, and the truncated message is rejected.
+TEST_F(TestKVBuffer, test_write_and_parse) {
+  std::vector<float> values = {1.0, 2.0, 3.0, 4.0, 5.0};
+  std::string compressed = "abc";
+  KVBufferHeader header;
+  header.key_num = 2;
+  header.len_num = 2;
+  header.value_num = values.size();
+  header.compressed_size = compressed.size();
+  // Leave one byte before the message to test the unaligned data.
+  std::string data(KVBufferSize(header) + 1, '\0');
+  KVBufferWriter writer(header, &data[1]);
+  writer.AddKey(7);
+  writer.AddKey(9);
+  writer.AddLen(2);
+  writer.AddLen(3);
+  writer.AddValues(values.data(), 2);
+  writer.AddValues(values.data() + 2, 3);
+  writer.AddCompressed(compressed.data(), compressed.size());
+  EXPECT_ANY_THROW(writer.AddKey(1));
+
+  KVBufferReader reader;
+  ASSERT_TRUE(reader.Parse(data.data() + 1, data.size() - 1));
+  Keys keys;
+  Lengths lens;
+  Values parsed_values;
+  reader.GetKeys(&keys);
+  reader.GetLens(&lens);
+  reader.GetValues(&parsed_values);
+  EXPECT_EQ(keys, Keys({7, 9}));
+  EXPECT_EQ(lens, Lengths({2, 3}));
+  EXPECT_EQ(parsed_values, values);
+  EXPECT_EQ(std::string(reader.compressed_data(), reader.compressed_size()), compressed);
+
+  EXPECT_FALSE(reader.Parse(data.data() + 1, data.size() - 2));
+  EXPECT_FALSE(reader.Parse(data.data(), data.size()));
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,328 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/operator/ops.h"
+#include "runtime/device/kernel_info.h"
+#include "include/common/utils/utils.h"
+#include "plugin/device/cpu/hal/device/cpu_device_address.h"
+#define private public
+#define protected public
+#include "runtime/graph_scheduler/graph_capture.h"
+#include "runtime/graph_scheduler/device_tensor_store.h"
+#include "runtime/graph_scheduler/device_tensor_copy_store.h"
+#include "runtime/graph_scheduler/actor/output_actor.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace runtime {
+namespace {
+using kernel::AddressPtr;
+
+constexpr size_t kTensorSize = 8;
+constexpr size_t kTensorElementNum = 2;
+
+// The kernel mod which records the addresses of every launch and fills the output with the launch number.
+class TestKernelMod : public kernel::KernelMod {
+ public:
+  TestKernelMod() { SetOutputSizeList({kTensorSize}); }
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &,
+              const std::vector<AddressPtr> &outputs, void *) override {
+    std::vector<void *> input_addrs;
+    for (auto &input : inputs) {
+      input_addrs.emplace_back(input->addr);
+    }
+    launched_inputs_.emplace_back(input_addrs);
+    launched_outputs_.emplace_back(outputs[0]->addr);
+    auto output_data = static_cast<float *>(outputs[0]->addr);
+    std::fill(output_data, output_data + kTensorElementNum, static_cast<float>(launched_outputs_.size()));
+    return true;
+  }
+
+  std::vector<std::vector<void *>> launched_inputs_;
+  std::vector<void *> launched_outputs_;
+};
+
+class TestDeviceContext : public DeviceContext {
+ public:
+  TestDeviceContext() : DeviceContext({"CPU", 0}) {}
+  void Initialize() override {}
+  bool AllocateMemory(device::DeviceAddress *const &address, size_t size) const override {
+    address->set_ptr(malloc(size));
+    return address->GetPtr() != nullptr;
+  }
+  void FreeMemory(device::DeviceAddress *const &address) const override {
+    free(address->GetMutablePtr());
+    address->set_ptr(nullptr);
+  }
+  void *AllocateMemory(size_t size) const override { return malloc(size); }
+  void FreeMemory(void *const ptr) const override { free(ptr); }
+  device::DeviceAddressPtr CreateDeviceAddress(void *const device_ptr, size_t device_size, const std::string &format,
+                                               TypeId type_id) const override {
+    return std::make_shared<device::cpu::CPUDeviceAddress>(device_ptr, device_size, format, type_id);
+  }
+  device::DeviceAddressType GetDeviceAddressType() const override { return device::DeviceAddressType::kCPU; }
+  void SetOperatorInfo(const std::vector<CNodePtr> &) const override {}
+  void CreateKernel(const std::vector<CNodePtr> &) const override {}
+};
+
+// The output actor which records the graph outputs of the step.
+class TestOutputActor : public OutputActor {
+ public:
+  TestOutputActor() : OutputActor("TestOutputActor", 1, 1) {}
+  void RunOpData(OpData<DeviceTensor> *const input_data, OpContext<DeviceTensor> *const) override {
+    received_outputs_.emplace_back(input_data->data_);
+  }
+  void RunOpControl(AID *const, OpContext<DeviceTensor> *const) override { ++step_num_; }
+
+  std::vector<DeviceTensor *> received_outputs_;
+  size_t step_num_{0};
+};
+}  // namespace
+
+class GraphCaptureTest : public UT::Common {
+ public:
+  GraphCaptureTest() = default;
+
+  // Build the capture of graph: y = Add(Relu(x), w), where x is the graph input and w is the weight.
+  void SetUp() override {
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{2});
+    input_ = func_graph->add_parameter();
+    input_->set_abstract(abstract);
+    input_->set_kernel_info(std::make_shared<device::KernelInfo>());
+    AnfAlgo::SetOutputAddr(CreateDeviceTensor(), 0, input_.get());
+    weight_ = func_graph->add_parameter();
+    weight_->set_abstract(abstract);
+    auto weight_device_tensor = CreateDeviceTensor();
+    (void)device_context_.AllocateMemory(weight_device_tensor.get(), kTensorSize);
+    DeviceTensorStore::GetInstance().Insert(weight_.get(), weight_device_tensor);
+    weight_device_tensors_.emplace_back(weight_device_tensor);
+
+    relu_ = func_graph->NewCNode({NewValueNode(prim::kPrimRelu), input_});
+    add_ = func_graph->NewCNode({NewValueNode(prim::kPrimAdd), relu_, weight_});
+    for (auto &kernel : {relu_, add_}) {
+      kernel->set_abstract(abstract);
+      auto kernel_info = std::make_shared<device::KernelInfo>();
+      kernel_info->set_kernel_mod(std::make_shared<TestKernelMod>());
+      kernel->set_kernel_info(kernel_info);
+      AnfAlgo::SetOutputAddr(CreateDeviceTensor(), 0, kernel.get());
+    }
+
+    graph_capture_ = std::make_shared<GraphCapture>("TestGraphCapture", &device_context_, nullptr, &output_actor_);
+    CaptureKernel relu_kernel;
+    relu_kernel.kernel_ = relu_;
+    relu_kernel.kernel_mod_ = AnfAlgo::GetKernelMod(relu_);
+    CaptureTensorSource input_source;
+    input_source.data_position_ = 0;
+    relu_kernel.inputs_ = {input_source};
+    CaptureKernel add_kernel;
+    add_kernel.kernel_ = add_;
+    add_kernel.kernel_mod_ = AnfAlgo::GetKernelMod(add_);
+    add_kernel.inputs_ = {CaptureTensorSource{relu_, 0}, CaptureTensorSource{weight_, 0, SIZE_MAX, true}};
+    graph_capture_->kernels_ = {relu_kernel, add_kernel};
+    graph_capture_->data_nodes_ = {input_};
+    graph_capture_->input_positions_ = {{0}};
+    graph_capture_->outputs_ = {{0, CaptureTensorSource{add_, 0}}};
+  }
+
+  void TearDown() override {
+    graph_capture_->Release();
+    FreeGraphOutput();
+    for (auto &weight_device_tensor : weight_device_tensors_) {
+      device_context_.FreeMemory(weight_device_tensor.get());
+    }
+    DeviceTensorStore::GetInstance().Remove(weight_.get());
+  }
+
+  device::DeviceAddressPtr CreateDeviceTensor() {
+    return device_context_.CreateDeviceAddress(nullptr, kTensorSize, kOpFormat_DEFAULT, kNumberTypeFloat32);
+  }
+
+  std::vector<std::vector<TensorPtr>> CreateInputTensors(const ShapeVector &shape) {
+    auto input_tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, shape);
+    input_tensor->set_device_address(CreateDeviceTensor());
+    return {{input_tensor}};
+  }
+
+  std::string Replay(const std::vector<std::vector<TensorPtr>> &input_tensors) {
+    std::vector<Promise<int>> results(1);
+    OpContext<DeviceTensor> context;
+    context.sequential_num_ = 0;
+    context.results_ = &results;
+    graph_capture_->Replay(input_tensors, &context);
+    return context.error_info_;
+  }
+
+  // The memory of graph output is taken over by the output tensor after the step.
+  void FreeGraphOutput() {
+    auto device_tensor = AnfAlgo::GetMutableOutputAddr(add_, 0, false);
+    if (device_tensor->GetPtr() != nullptr) {
+      device_context_.FreeMemory(device_tensor.get());
+    }
+  }
+
+  TestKernelMod *GetKernelMod(const CNodePtr &kernel) {
+    return dynamic_cast<TestKernelMod *>(AnfAlgo::GetKernelMod(kernel));
+  }
+
+  TestDeviceContext device_context_;
+  TestOutputActor output_actor_;
+  ParameterPtr input_;
+  ParameterPtr weight_;
+  std::vector<device::DeviceAddressPtr> weight_device_tensors_;
+  CNodePtr relu_;
+  CNodePtr add_;
+  GraphCapturePtr graph_capture_;
+};
+
+/// Feature: graph capture.
+/// Description: record the first step and replay the second step.
+/// Expectation: the intermediate output is planned, the weight is fixed and the graph output is allocated every step.
+TEST_F(GraphCaptureTest, RecordAndReplay) {
+  auto input_tensors = CreateInputTensors({2});
+  EXPECT_TRUE(Replay(input_tensors).empty());
+  EXPECT_TRUE(graph_capture_->is_recorded());
+  EXPECT_EQ(graph_capture_->planned_device_tensors_.size(), 1);
+  EXPECT_EQ(graph_capture_->fixed_device_tensors_.size(), 1);
+  EXPECT_EQ(graph_capture_->output_device_tensors_.size(), 1);
+
+  auto input_device_tensor = AnfAlgo::GetMutableOutputAddr(input_, 0, false);
+  auto relu_output = AnfAlgo::GetMutableOutputAddr(relu_, 0, false);
+  auto add_output = AnfAlgo::GetMutableOutputAddr(add_, 0, false);
+  EXPECT_NE(input_device_tensor->GetPtr(), nullptr);
+  EXPECT_NE(relu_output->GetPtr(), nullptr);
+  ASSERT_EQ(output_actor_.received_outputs_.size(), 1);
+  EXPECT_EQ(output_actor_.received_outputs_[0], add_output.get());
+  EXPECT_EQ(output_actor_.step_num_, 1);
+  FreeGraphOutput();
+
+  EXPECT_TRUE(Replay(input_tensors).empty());
+  EXPECT_EQ(output_actor_.step_num_, 2);
+  auto relu_mod = GetKernelMod(relu_);
+  auto add_mod = GetKernelMod(add_);
+  ASSERT_EQ(relu_mod->launched_outputs_.size(), 2);
+  ASSERT_EQ(add_mod->launched_outputs_.size(), 2);
+  for (size_t i = 0; i < relu_mod->launched_outputs_.size(); ++i) {
+    EXPECT_EQ(relu_mod->launched_inputs_[i][0], input_device_tensor->GetPtr());
+    EXPECT_EQ(relu_mod->launched_outputs_[i], relu_output->GetPtr());
+    EXPECT_EQ(add_mod->launched_inputs_[i][0], relu_output->GetPtr());
+    EXPECT_EQ(add_mod->launched_inputs_[i][1], weight_device_tensors_[0]->GetPtr());
+  }
+  // The graph output of the second step is allocated again after it is taken over.
+  EXPECT_EQ(add_mod->launched_outputs_.back(), add_output->GetPtr());
+}
+
+/// Feature: graph capture.
+/// Description: run the step whose input shape is different from the recorded step.
+/// Expectation: the step falls back to the actors and the memory held by the capture is released.
+TEST_F(GraphCaptureTest, FallbackOnInputShapeChange) {
+  EXPECT_TRUE(Replay(CreateInputTensors({2})).empty());
+  FreeGraphOutput();
+  EXPECT_TRUE(graph_capture_->is_recorded());
+
+  std::vector<Promise<int>> results(1);
+  OpContext<DeviceTensor> context;
+  context.results_ = &results;
+  EXPECT_FALSE(graph_capture_->Run(CreateInputTensors({3}), &context));
+  EXPECT_FALSE(graph_capture_->is_recorded());
+  EXPECT_EQ(graph_capture_->planned_memory_, nullptr);
+  EXPECT_EQ(AnfAlgo::GetMutableOutputAddr(input_, 0, false)->GetPtr(), nullptr);
+  EXPECT_EQ(AnfAlgo::GetMutableOutputAddr(relu_, 0, false)->GetPtr(), nullptr);
+  EXPECT_EQ(GetKernelMod(relu_)->launched_outputs_.size(), 1);
+}
+
+/// Feature: graph capture.
+/// Description: the address of weight changes after the step is recorded.
+/// Expectation: the capture records again and the kernels launch with the new address of weight.
+TEST_F(GraphCaptureTest, RecordAgainOnFixedAddressChange) {
+  auto input_tensors = CreateInputTensors({2});
+  EXPECT_TRUE(Replay(input_tensors).empty());
+  FreeGraphOutput();
+  EXPECT_TRUE(graph_capture_->CheckFixedDeviceTensor());
+
+  auto new_weight_device_tensor = CreateDeviceTensor();
+  (void)device_context_.AllocateMemory(new_weight_device_tensor.get(), kTensorSize);
+  DeviceTensorStore::GetInstance().Insert(weight_.get(), new_weight_device_tensor);
+  weight_device_tensors_.emplace_back(new_weight_device_tensor);
+  EXPECT_FALSE(graph_capture_->CheckFixedDeviceTensor());
+
+  EXPECT_TRUE(Replay(input_tensors).empty());
+  EXPECT_TRUE(graph_capture_->is_recorded());
+  EXPECT_TRUE(graph_capture_->CheckFixedDeviceTensor());
+  auto add_mod = GetKernelMod(add_);
+  ASSERT_EQ(add_mod->launched_inputs_.size(), 2);
+  EXPECT_EQ(add_mod->launched_inputs_[0][1], weight_device_tensors_[0]->GetPtr());
+  EXPECT_EQ(add_mod->launched_inputs_[1][1], new_weight_device_tensor->GetPtr());
+  EXPECT_EQ(output_actor_.step_num_, 2);
+}
+
+/// Feature: graph capture.
+/// Description: capture the optimizer like kernel Assign(w, Relu(x)) whose ref input and output is the weight, and the
+/// weight has a copy in the device tensor copy store.
+/// Expectation: the weight is fixed, the ref kernel updates it in place every replayed step and the copy is refreshed.
+TEST_F(GraphCaptureTest, ReplayRefKernel) {
+  auto assign = input_->func_graph()->NewCNode({NewValueNode(prim::kPrimAssign), weight_, relu_});
+  assign->set_abstract(relu_->abstract());
+  auto kernel_info = std::make_shared<device::KernelInfo>();
+  kernel_info->set_kernel_mod(std::make_shared<TestKernelMod>());
+  assign->set_kernel_info(kernel_info);
+  AnfAlgo::SetOutputAddr(weight_device_tensors_[0], 0, assign.get());
+  CaptureKernel assign_kernel;
+  assign_kernel.kernel_ = assign;
+  assign_kernel.kernel_mod_ = AnfAlgo::GetKernelMod(assign);
+  assign_kernel.inputs_ = {CaptureTensorSource{weight_, 0, SIZE_MAX, true}, CaptureTensorSource{relu_, 0}};
+  assign_kernel.ref_input_indexes_ = {0};
+  assign_kernel.ref_output_indexes_ = {0};
+  (void)graph_capture_->kernels_.emplace_back(assign_kernel);
+
+  auto copy_device_tensor = CreateDeviceTensor();
+  (void)device_context_.AllocateMemory(copy_device_tensor.get(), kTensorSize);
+  weight_device_tensors_.emplace_back(copy_device_tensor);
+  DeviceTensorCopyStore::GetInstance().Insert(weight_device_tensors_[0].get(), copy_device_tensor.get());
+
+  auto input_tensors = CreateInputTensors({2});
+  EXPECT_TRUE(Replay(input_tensors).empty());
+  FreeGraphOutput();
+  EXPECT_TRUE(Replay(input_tensors).empty());
+  DeviceTensorCopyStore::GetInstance().Clear();
+
+  EXPECT_TRUE(graph_capture_->is_recorded());
+  EXPECT_EQ(graph_capture_->fixed_device_tensors_.size(), 1);
+  EXPECT_EQ(graph_capture_->kernels_.back().ref_device_tensors_.size(), 1);
+  EXPECT_EQ(output_actor_.step_num_, 2);
+  auto assign_mod = GetKernelMod(assign);
+  ASSERT_EQ(assign_mod->launched_outputs_.size(), 2);
+  for (size_t i = 0; i < assign_mod->launched_outputs_.size(); ++i) {
+    EXPECT_EQ(assign_mod->launched_inputs_[i][0], weight_device_tensors_[0]->GetPtr());
+    EXPECT_EQ(assign_mod->launched_outputs_[i], weight_device_tensors_[0]->GetPtr());
+  }
+  auto weight_data = static_cast<const float *>(weight_device_tensors_[0]->GetPtr());
+  auto copy_data = static_cast<const float *>(copy_device_tensor->GetPtr());
+  for (size_t i = 0; i < kTensorElementNum; ++i) {
+    EXPECT_EQ(weight_data[i], 2);
+    EXPECT_EQ(copy_data[i], 2);
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
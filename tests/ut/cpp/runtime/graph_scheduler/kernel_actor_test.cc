@@ -0,0 +1,203 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/operator/ops.h"
+#include "runtime/device/kernel_info.h"
+#include "include/common/utils/utils.h"
+#include "plugin/device/cpu/hal/device/cpu_device_address.h"
+#define private public
+#define protected public
+#include "runtime/graph_scheduler/actor/kernel_actor.h"
+#include "runtime/graph_scheduler/actor/memory_manager_actor.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace runtime {
+namespace {
+using kernel::AddressPtr;
+
+constexpr size_t kOutputSize = 8;
+
+class TestKernelMod : public kernel::KernelMod {
+ public:
+  TestKernelMod() { SetOutputSizeList({kOutputSize}); }
+  bool Launch(const std::vector<AddressPtr> &, const std::vector<AddressPtr> &, const std::vector<AddressPtr> &,
+              void *) override {
+    return true;
+  }
+};
+
+// The CPU device context which records the launched kernels and the freed memory, and fails the given kernel.
+class TestDeviceContext : public DeviceContext {
+ public:
+  TestDeviceContext() : DeviceContext({"CPU", 0}) {}
+  void Initialize() override {}
+  bool AllocateMemory(device::DeviceAddress *const &address, size_t size) const override {
+    address->set_ptr(malloc(size));
+    return address->GetPtr() != nullptr;
+  }
+  void FreeMemory(device::DeviceAddress *const &address) const override {
+    (void)freed_addresses_.insert(address);
+    free(address->GetMutablePtr());
+    address->set_ptr(nullptr);
+  }
+  void *AllocateMemory(size_t size) const override { return malloc(size); }
+  void FreeMemory(void *const ptr) const override { free(ptr); }
+  device::DeviceAddressPtr CreateDeviceAddress(void *const device_ptr, size_t device_size, const std::string &format,
+                                               TypeId type_id) const override {
+    return std::make_shared<device::cpu::CPUDeviceAddress>(device_ptr, device_size, format, type_id);
+  }
+  device::DeviceAddressType GetDeviceAddressType() const override { return device::DeviceAddressType::kCPU; }
+  void SetOperatorInfo(const std::vector<CNodePtr> &) const override {}
+  void CreateKernel(const std::vector<CNodePtr> &) const override {}
+  bool LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &, const std::vector<AddressPtr> &,
+                    const std::vector<AddressPtr> &, bool) const override {
+    launched_kernels_.emplace_back(kernel->fullname_with_scope());
+    return kernel->fullname_with_scope() != failed_kernel_;
+  }
+
+  std::string failed_kernel_;
+  mutable std::vector<std::string> launched_kernels_;
+  mutable std::set<device::DeviceAddress *> freed_addresses_;
+};
+}  // namespace
+
+class KernelActorTest : public UT::Common {
+ public:
+  KernelActorTest() = default;
+  void SetUp() override {
+    // The messages are called directly in the single thread execution.
+    ActorDispatcher::is_multi_thread_execution(false);
+    memory_manager_actor_ = std::make_shared<MemoryManagerActor>();
+    (void)ActorMgr::GetActorMgrRef()->Spawn(memory_manager_actor_, true);
+  }
+  void TearDown() override {
+    for (auto &output : outputs_) {
+      if (output->GetPtr() != nullptr) {
+        device_context_.FreeMemory(output.get());
+      }
+    }
+    for (auto &actor : actors_) {
+      ActorMgr::GetActorMgrRef()->RemoveActor(actor->GetAID().Name());
+    }
+    ActorMgr::GetActorMgrRef()->RemoveActor(memory_manager_actor_->GetAID().Name());
+    ActorDispatcher::is_multi_thread_execution(true);
+  }
+
+  // Build the kernel actors of a linear chain and fuse them into one inline chain, like the graph scheduler does.
+  void BuildInlineChain(const std::string &name, size_t actor_num) {
+    auto func_graph = std::make_shared<FuncGraph>();
+    AnfNodePtr input = nullptr;
+    for (size_t i = 0; i < actor_num; ++i) {
+      std::vector<AnfNodePtr> inputs{NewValueNode(prim::kPrimRelu)};
+      if (input != nullptr) {
+        inputs.emplace_back(input);
+      }
+      auto kernel = func_graph->NewCNode(inputs);
+      kernel->set_fullname_with_scope(name + "_kernel_" + std::to_string(i));
+      kernel->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{2}));
+      auto kernel_info = std::make_shared<device::KernelInfo>();
+      kernel_info->set_kernel_mod(std::make_shared<TestKernelMod>());
+      kernel->set_kernel_info(kernel_info);
+      auto output = device_context_.CreateDeviceAddress(nullptr, kOutputSize, kOpFormat_DEFAULT, kNumberTypeFloat32);
+      // The output is freed by the kernel and the next kernel.
+      output->set_original_ref_count(i + 1 < actor_num ? 2 : 1);
+      output->ResetRefCount();
+      AnfAlgo::SetOutputAddr(output, 0, kernel.get());
+      outputs_.emplace_back(output);
+      input = kernel;
+
+      auto actor = std::make_shared<KernelActor>(kernel->fullname_with_scope(), kernel, &device_context_,
+                                                 memory_manager_actor_->GetAID(), nullptr, nullptr,
+                                                 GraphExecutionStrategy::kPipeline, std::set<size_t>(),
+                                                 std::set<size_t>());
+      if (!actors_.empty()) {
+        actors_.back()->output_data_arrows_.emplace_back(std::make_shared<DataArrow>(0, actor->GetAID(), 0));
+        actor->input_datas_num_ = 1;
+      }
+      actors_.emplace_back(actor);
+    }
+
+    for (auto &actor : actors_) {
+      (void)ActorMgr::GetActorMgrRef()->Spawn(actor, true);
+    }
+    for (size_t i = 1; i < actors_.size(); ++i) {
+      actors_[i - 1]->inline_next_ = actors_[i].get();
+      actors_[0]->inline_actors_.emplace_back(actors_[i].get());
+    }
+  }
+
+  std::string RunHead() {
+    std::vector<Promise<int>> results(1);
+    OpContext<DeviceTensor> context;
+    context.sequential_num_ = 0;
+    context.results_ = &results;
+    actors_[0]->Run(&context);
+    return context.error_info_;
+  }
+
+  TestDeviceContext device_context_;
+  std::shared_ptr<MemoryManagerActor> memory_manager_actor_;
+  std::vector<KernelActorPtr> actors_;
+  std::vector<device::DeviceAddressPtr> outputs_;
+};
+
+/// Feature: inline chain of kernel actors.
+/// Description: run the head of a chain whose memory is allocated by the head at once.
+/// Expectation: the kernels launch in order in one call and all the memory of the chain is freed after running.
+TEST_F(KernelActorTest, RunInlineChain) {
+  const size_t actor_num = 4;
+  BuildInlineChain("RunInlineChain", actor_num);
+  EXPECT_TRUE(RunHead().empty());
+
+  ASSERT_EQ(device_context_.launched_kernels_.size(), actor_num);
+  for (size_t i = 0; i < actor_num; ++i) {
+    EXPECT_EQ(device_context_.launched_kernels_[i], "RunInlineChain_kernel_" + std::to_string(i));
+    EXPECT_EQ(outputs_[i]->GetPtr(), nullptr);
+    EXPECT_EQ(outputs_[i]->ref_count(), outputs_[i]->original_ref_count());
+  }
+  for (size_t i = 1; i < actor_num; ++i) {
+    EXPECT_TRUE(actors_[i]->input_op_datas_.empty());
+  }
+}
+
+/// Feature: inline chain of kernel actors.
+/// Description: the kernel in the middle of chain fails to launch.
+/// Expectation: the chain stops at the failed kernel, and the memory allocated for the actors after it is freed.
+TEST_F(KernelActorTest, RunInlineChainFailed) {
+  const size_t actor_num = 4;
+  const size_t failed_index = 1;
+  BuildInlineChain("RunInlineChainFailed", actor_num);
+  device_context_.failed_kernel_ = "RunInlineChainFailed_kernel_" + std::to_string(failed_index);
+  EXPECT_FALSE(RunHead().empty());
+
+  ASSERT_EQ(device_context_.launched_kernels_.size(), failed_index + 1);
+  EXPECT_EQ(device_context_.launched_kernels_.back(), device_context_.failed_kernel_);
+  for (size_t i = failed_index + 1; i < actor_num; ++i) {
+    EXPECT_EQ(outputs_[i]->GetPtr(), nullptr);
+    EXPECT_EQ(device_context_.freed_addresses_.count(outputs_[i].get()), 1);
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+#define private public
+#include "runtime/graph_scheduler/actor/actor_common.h"
+#undef private
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr size_t kKernelThreadNum = 8;
+constexpr size_t kTaskNum = 16;
+}  // namespace
+
+class KernelThreadPartitionTest : public UT::Common {
+ public:
+  KernelThreadPartitionTest() = default;
+
+  void TearDown() override {
+    KernelThreadPartition::launching_cost_ = 0;
+    KernelThreadPartition::reserved_thread_num_ = 0;
+    KernelThreadPartition::kernel_cost_ = 0;
+  }
+
+  // Launch the kernel of the cost in the current thread, as the launch guard does.
+  void LaunchKernel(size_t cost) {
+    KernelThreadPartition::launching_cost_ += cost;
+    KernelThreadPartition::kernel_cost_ = cost;
+  }
+};
+
+/// Feature: the partition of kernel threads among the concurrently launched CPU kernels.
+/// Description: the thread group out of the kernel launch.
+/// Expectation: the task num is not limited.
+TEST_F(KernelThreadPartitionTest, NotLimitedOutOfKernelLaunch) {
+  KernelThreadPartition::ThreadGroup thread_group(kKernelThreadNum);
+  ASSERT_EQ(thread_group.Limit(kTaskNum), kTaskNum);
+  ASSERT_EQ(KernelThreadPartition::reserved_thread_num_, 0);
+}
+
+/// Feature: the partition of kernel threads among the concurrently launched CPU kernels.
+/// Description: three kernels launch in parallel one after another when the previous ones are still running.
+/// Expectation: each parallel launch takes its share of the idle kernel threads, the reserved threads never exceed
+/// the kernel threads, and they are returned after the launch.
+TEST_F(KernelThreadPartitionTest, GroupsNotExceedKernelThreads) {
+  // The kernel launching alone takes all the kernel threads.
+  LaunchKernel(100);
+  KernelThreadPartition::ThreadGroup first_group(kKernelThreadNum);
+  ASSERT_EQ(first_group.Limit(kTaskNum), kKernelThreadNum);
+
+  // The kernel launched later runs in the current thread until the kernel threads are returned.
+  std::thread second_kernel([this]() {
+    LaunchKernel(100);
+    KernelThreadPartition::ThreadGroup second_group(kKernelThreadNum);
+    ASSERT_EQ(second_group.Limit(kTaskNum), 1);
+    ASSERT_EQ(KernelThreadPartition::reserved_thread_num_, kKernelThreadNum);
+  });
+  second_kernel.join();
+  ASSERT_EQ(KernelThreadPartition::reserved_thread_num_, kKernelThreadNum);
+}
+
+/// Feature: the partition of kernel threads among the concurrently launched CPU kernels.
+/// Description: two kernels of the cost 3 : 1 launch in parallel at the same time.
+/// Expectation: the kernel threads are split by the cost.
+TEST_F(KernelThreadPartitionTest, SplitByCost) {
+  KernelThreadPartition::launching_cost_ = 400;
+  KernelThreadPartition::kernel_cost_ = 300;
+  {
+    KernelThreadPartition::ThreadGroup first_group(kKernelThreadNum);
+    ASSERT_EQ(first_group.Limit(kTaskNum), 6);
+    std::thread second_kernel([]() {
+      KernelThreadPartition::kernel_cost_ = 100;
+      KernelThreadPartition::ThreadGroup second_group(kKernelThreadNum);
+      ASSERT_EQ(second_group.Limit(kTaskNum), 2);
+      ASSERT_EQ(KernelThreadPartition::reserved_thread_num_, kKernelThreadNum);
+    });
+    second_kernel.join();
+  }
+  ASSERT_EQ(KernelThreadPartition::reserved_thread_num_, 0);
+}
+
+/// Feature: the partition of kernel threads among the concurrently launched CPU kernels.
+/// Description: launch the tasks in parallel when all the kernel threads are reserved by the other kernels.
+/// Expectation: all the tasks run in the current thread.
+TEST_F(KernelThreadPartitionTest, ParallelLaunchTasksLimited) {
+  auto thread_pool = kernel::GetActorMgrInnerThreadPool();
+  ASSERT_NE(thread_pool, nullptr);
+  LaunchKernel(100);
+  KernelThreadPartition::launching_cost_ = 200;
+  KernelThreadPartition::reserved_thread_num_ = thread_pool->GetKernelThreadNum();
+
+  std::mutex mutex;
+  std::set<std::thread::id> thread_ids;
+  size_t executed_num = 0;
+  std::vector<common::Task> tasks;
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    (void)tasks.emplace_back([&mutex, &thread_ids, &executed_num]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      (void)thread_ids.insert(std::this_thread::get_id());
+      ++executed_num;
+      return common::SUCCESS;
+    });
+  }
+  kernel::ParallelLaunch(tasks);
+  ASSERT_EQ(executed_num, kTaskNum);
+  ASSERT_EQ(thread_ids.size(), 1);
+  ASSERT_EQ(thread_ids.count(std::this_thread::get_id()), 1);
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,128 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#include "runtime/op_builder/op_lazy_builder.h"
+#undef private
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr size_t kTaskNum = 64;
+constexpr size_t kWaitTimeoutMs = 10000;
+}  // namespace
+
+class OpLazyBuilderTest : public UT::Common {
+ public:
+  OpLazyBuilderTest() : builder_(OpLazyBuilder::GetInstance()) {}
+
+  void SetUp() override {
+    builder_.async_launch_ = true;
+    builder_.stop_ = false;
+  }
+
+  void TearDown() override {
+    builder_.Finalize();
+    builder_.Reset();
+    builder_.async_launch_ = false;
+    builder_.stop_ = false;
+  }
+
+  // The callback executes the tasks one by one with the backend locked for each task, as the backend does.
+  void RegisterTasks(size_t task_num, size_t failed_task = SIZE_MAX) {
+    remaining_tasks_ = task_num;
+    builder_.Register([this, task_num, failed_task]() {
+      while (true) {
+        auto lock = builder_.LockBackend();
+        if (remaining_tasks_ == 0) {
+          break;
+        }
+        if (task_num - remaining_tasks_ == failed_task) {
+          throw std::runtime_error("Task failed.");
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        --remaining_tasks_;
+        (void)executed_threads_.emplace_back(std::this_thread::get_id());
+      }
+    });
+  }
+
+  bool WaitAsyncException() {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kWaitTimeoutMs);
+    while (std::chrono::steady_clock::now() < deadline) {
+      {
+        std::lock_guard<std::mutex> lock(builder_.async_mutex_);
+        if (builder_.async_exception_ != nullptr) {
+          return true;
+        }
+      }
+      std::this_thread::yield();
+    }
+    return false;
+  }
+
+  OpLazyBuilder &builder_;
+  size_t remaining_tasks_{0};
+  std::vector<std::thread::id> executed_threads_;
+};
+
+/// Feature: the async launch of op tasks in PyNative.
+/// Description: execute the tasks in the async thread and sync them in the current thread at once.
+/// Expectation: the sync waits for the task executing in the async thread, and all the tasks are executed once.
+TEST_F(OpLazyBuilderTest, SyncAfterAsync) {
+  RegisterTasks(kTaskNum);
+  builder_.ExecuteRemainingTasksAsync();
+  builder_.ExecuteRemainingTasks();
+  ASSERT_EQ(remaining_tasks_, 0);
+  ASSERT_EQ(executed_threads_.size(), kTaskNum);
+
+  builder_.Finalize();
+  ASSERT_FALSE(builder_.async_thread_.joinable());
+  // The tasks are executed in the current thread after the async thread is finalized.
+  RegisterTasks(1);
+  builder_.ExecuteRemainingTasksAsync();
+  ASSERT_EQ(remaining_tasks_, 0);
+  ASSERT_EQ(executed_threads_.back(), std::this_thread::get_id());
+}
+
+/// Feature: the async launch of op tasks in PyNative.
+/// Description: a task fails in the async thread, then sync the tasks in the current thread.
+/// Expectation: the builder is not reset in the async thread, and the exception is thrown by the sync which resets
+/// the builder.
+TEST_F(OpLazyBuilderTest, SyncAfterAsyncFailed) {
+  RegisterTasks(kTaskNum, kTaskNum / 2);
+  builder_.ExecuteRemainingTasksAsync();
+  ASSERT_TRUE(WaitAsyncException());
+  ASSERT_TRUE(builder_.registered());
+  ASSERT_EQ(remaining_tasks_, kTaskNum - kTaskNum / 2);
+
+  ASSERT_THROW(builder_.ExecuteRemainingTasks(), std::runtime_error);
+  ASSERT_FALSE(builder_.registered());
+  ASSERT_TRUE(builder_.QueueEmpty());
+  // The builder works again after the reset.
+  RegisterTasks(1);
+  builder_.ExecuteRemainingTasks();
+  ASSERT_EQ(remaining_tasks_, 0);
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,165 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+
+import pytest
+import numpy as np
+import mindspore.dataset as ds
+
+
+# generates 1 column [0], [0, 1], ..., [0, ..., n-1]
+def generate_sequential(n):
+    for i in range(n):
+        yield (np.array([j for j in range(i + 1)]),)
+
+
+# generates 1 column with lengths cycling through 1..period
+def generate_cyclic(n, period):
+    for i in range(n):
+        yield (np.array([1 for _ in range(i % period + 1)]),)
+
+
+def test_batch_by_tokens_invalid_input():
+    """
+    Feature: BatchByTokens op
+    Description: Test invalid arguments of batch_by_tokens
+    Expectation: Error is raised as expected
+    """
+    dataset = ds.GeneratorDataset((lambda: generate_sequential(10)), ["col1"])
+
+    with pytest.raises(TypeError) as info:
+        _ = dataset.batch_by_tokens([1], 16)
+    assert "Argument column_names[0] with value 1 is not of type [<class 'str'>]" in str(info.value)
+
+    with pytest.raises(ValueError) as info:
+        _ = dataset.batch_by_tokens(["col1"], 0)
+    assert "max_tokens" in str(info.value)
+
+    with pytest.raises(ValueError) as info:
+        _ = dataset.batch_by_tokens(["col1"], 16, lookahead_size=0)
+    assert "lookahead_size" in str(info.value)
+
+    with pytest.raises(TypeError) as info:
+        _ = dataset.batch_by_tokens(["col1"], 16, element_length_function="")
+    assert "element_length_function object is not callable" in str(info.value)
+
+    with pytest.raises(TypeError) as info:
+        _ = dataset.batch_by_tokens(["col1"], 16, drop_remainder="")
+    assert "drop_remainder" in str(info.value)
+
+
+def test_batch_by_tokens_budget():
+    """
+    Feature: BatchByTokens op
+    Description: Test that every batch stays within the token budget and no row is lost
+    Expectation: Padded size of each batch <= max_tokens, all rows are output once
+    """
+    max_tokens = 32
+    dataset = ds.GeneratorDataset((lambda: generate_cyclic(200, 16)), ["col1"])
+    dataset = dataset.batch_by_tokens(["col1"], max_tokens, lookahead_size=40)
+
+    num_rows = 0
+    real_tokens = 0
+    for data in dataset.create_dict_iterator(num_epochs=1, output_numpy=True):
+        batch = data["col1"]
+        assert batch.shape[0] * batch.shape[1] <= max_tokens
+        num_rows += batch.shape[0]
+        real_tokens += int(np.sum(batch))
+    assert num_rows == 200
+    assert real_tokens == sum(i % 16 + 1 for i in range(200))
+
+
+def test_batch_by_tokens_minimizes_padding():
+    """
+    Feature: BatchByTokens op
+    Description: Test that rows of the same length are batched together within the lookahead window
+    Expectation: No padding is needed when the window holds whole groups of equal lengths
+    """
+
+    # lengths cycle through 1, 2, 4, 8 so that every group of 16 rows of equal length fills whole batches
+    def generate_powers_of_two(n):
+        for i in range(n):
+            yield (np.array([1 for _ in range(2 ** (i % 4))]),)
+
+    dataset = ds.GeneratorDataset((lambda: generate_powers_of_two(64)), ["col1"])
+    dataset = dataset.batch_by_tokens(["col1"], 16, lookahead_size=64)
+
+    for data in dataset.create_dict_iterator(num_epochs=1, output_numpy=True):
+        assert np.all(data["col1"] == 1)
+
+
+def test_batch_by_tokens_oversized_row():
+    """
+    Feature: BatchByTokens op
+    Description: Test a row longer than max_tokens
+    Expectation: The row is output in a batch on its own
+    """
+    dataset = ds.GeneratorDataset((lambda: generate_sequential(10)), ["col1"])
+    dataset = dataset.batch_by_tokens(["col1"], 4, lookahead_size=10)
+
+    shapes = [data["col1"].shape for data in dataset.create_dict_iterator(num_epochs=1, output_numpy=True)]
+    assert shapes[-1] == (1, 10)
+    assert sum(shape[0] for shape in shapes) == 10
+
+
+def test_batch_by_tokens_drop_remainder():
+    """
+    Feature: BatchByTokens op
+    Description: Test drop_remainder drops the last open batch of each epoch but keeps an exactly full one
+    Expectation: Only full batches are output
+    """
+    dataset = ds.GeneratorDataset((lambda: generate_cyclic(10, 1)), ["col1"])
+    dataset = dataset.batch_by_tokens(["col1"], 4, lookahead_size=100, drop_remainder=True)
+
+    shapes = [data["col1"].shape for data in dataset.create_dict_iterator(num_epochs=1, output_numpy=True)]
+    assert shapes == [(4, 1), (4, 1)]
+
+    # The last batch which exactly fills the budget is not a remainder.
+    dataset = ds.GeneratorDataset((lambda: generate_cyclic(8, 1)), ["col1"])
+    dataset = dataset.batch_by_tokens(["col1"], 4, lookahead_size=100, drop_remainder=True)
+
+    shapes = [data["col1"].shape for data in dataset.create_dict_iterator(num_epochs=1, output_numpy=True)]
+    assert shapes == [(4, 1), (4, 1)]
+
+
+def test_batch_by_tokens_length_function_and_pad_info():
+    """
+    Feature: BatchByTokens op
+    Description: Test element_length_function together with pad_info on a multi column dataset
+    Expectation: Columns are padded with the given value and batched within the budget
+    """
+
+    def generate_2_columns(n):
+        for i in range(n):
+            yield (np.array([i]), np.array([j for j in range(i % 5 + 1)]))
+
+    dataset = ds.GeneratorDataset((lambda: generate_2_columns(20)), ["col1", "col2"])
+    dataset = dataset.batch_by_tokens(["col1", "col2"], 10, lookahead_size=20,
+                                      element_length_function=(lambda col1, col2: len(col2)),
+                                      pad_info={"col2": ([None], -1)})
+
+    num_rows = 0
+    for data in dataset.create_dict_iterator(num_epochs=1, output_numpy=True):
+        assert data["col2"].shape[0] * data["col2"].shape[1] <= 10
+        num_rows += data["col1"].shape[0]
+    assert num_rows == 20
+
+
+if __name__ == '__main__':
+    test_batch_by_tokens_invalid_input()
+    test_batch_by_tokens_budget()
+    test_batch_by_tokens_minimizes_padding()
+    test_batch_by_tokens_oversized_row()
+    test_batch_by_tokens_drop_remainder()
+    test_batch_by_tokens_length_function_and_pad_info()
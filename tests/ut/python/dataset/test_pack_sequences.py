@@ -0,0 +1,183 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+
+import pytest
+import numpy as np
+import mindspore.dataset as ds
+
+
+# generates 2 columns, an id and the tokens [1, 2, ..., i % period + 1]
+def generate_sequences(n, period, dtype=np.int32):
+    for i in range(n):
+        yield (np.array([i]), np.array([j + 1 for j in range(i % period + 1)], dtype=dtype))
+
+
+def test_pack_sequences_invalid_input():
+    """
+    Feature: PackSequences op
+    Description: Test invalid arguments of pack_sequences
+    Expectation: Error is raised as expected
+    """
+    dataset = ds.GeneratorDataset((lambda: generate_sequences(10, 4)), ["id", "text"])
+
+    with pytest.raises(TypeError) as info:
+        _ = dataset.pack_sequences(1, 16)
+    assert "column_name" in str(info.value)
+
+    with pytest.raises(ValueError) as info:
+        _ = dataset.pack_sequences("text", 0)
+    assert "seq_length" in str(info.value)
+
+    with pytest.raises(ValueError) as info:
+        _ = dataset.pack_sequences("text", 16, window_size=0)
+    assert "window_size" in str(info.value)
+
+    with pytest.raises(TypeError) as info:
+        _ = dataset.pack_sequences("text", 16, pad_value=0.5)
+    assert "pad_value" in str(info.value)
+
+
+def test_pack_sequences_basic():
+    """
+    Feature: PackSequences op
+    Description: Test that all tokens are packed into fixed-length rows with segment and position ids
+    Expectation: Every sample can be recovered from its segment, positions restart at every sample
+    """
+    seq_length = 16
+    dataset = ds.GeneratorDataset((lambda: generate_sequences(100, 8)), ["id", "text"])
+    dataset = dataset.pack_sequences("text", seq_length, window_size=30, pad_value=-1)
+
+    num_samples = 0
+    num_tokens = 0
+    for data in dataset.create_dict_iterator(num_epochs=1, output_numpy=True):
+        assert sorted(data.keys()) == ["position_ids", "segment_ids", "text"]
+        tokens, segment_ids, position_ids = data["text"], data["segment_ids"], data["position_ids"]
+        assert tokens.shape == (seq_length,)
+        assert tokens.dtype == np.int32
+        assert np.all(tokens[segment_ids == 0] == -1)
+        for segment in range(1, int(np.max(segment_ids)) + 1):
+            sample = tokens[segment_ids == segment]
+            np.testing.assert_array_equal(sample, np.arange(1, len(sample) + 1))
+            np.testing.assert_array_equal(position_ids[segment_ids == segment], np.arange(len(sample)))
+            num_samples += 1
+            num_tokens += len(sample)
+    assert num_samples == 100
+    assert num_tokens == sum(i % 8 + 1 for i in range(100))
+
+
+def test_pack_sequences_first_fit_decreasing():
+    """
+    Feature: PackSequences op
+    Description: Test that samples which fit together exactly fill the rows
+    Expectation: No padding when sample lengths sum up to whole rows within the window
+    """
+    # lengths 6, 2, 5, 3, 4, 4 pair up into rows of 8 tokens
+    lengths = [6, 2, 5, 3, 4, 4]
+
+    def generator():
+        for length in lengths:
+            yield (np.ones(length, dtype=np.int64),)
+
+    dataset = ds.GeneratorDataset(generator, ["text"])
+    dataset = dataset.pack_sequences("text", 8, window_size=6)
+
+    rows = [data["segment_ids"] for data in dataset.create_dict_iterator(num_epochs=1, output_numpy=True)]
+    assert len(rows) == 3
+    for segment_ids in rows:
+        assert np.all(segment_ids > 0)
+
+
+def test_pack_sequences_truncate():
+    """
+    Feature: PackSequences op
+    Description: Test a sample longer than seq_length
+    Expectation: The sample is truncated to seq_length
+    """
+    def generator():
+        yield (np.arange(20, dtype=np.int32),)
+
+    dataset = ds.GeneratorDataset(generator, ["text"])
+    dataset = dataset.pack_sequences("text", 8)
+
+    rows = [data["text"] for data in dataset.create_dict_iterator(num_epochs=1, output_numpy=True)]
+    assert len(rows) == 1
+    np.testing.assert_array_equal(rows[0], np.arange(8))
+
+
+def test_pack_sequences_batch():
+    """
+    Feature: PackSequences op
+    Description: Test batching packed rows
+    Expectation: Batches are dense without further padding
+    """
+    dataset = ds.GeneratorDataset((lambda: generate_sequences(64, 4)), ["id", "text"])
+    dataset = dataset.pack_sequences("text", 10, window_size=64)
+    dataset = dataset.batch(4, drop_remainder=True)
+
+    for data in dataset.create_dict_iterator(num_epochs=1, output_numpy=True):
+        assert data["text"].shape == (4, 10)
+        assert data["segment_ids"].shape == (4, 10)
+        assert data["position_ids"].shape == (4, 10)
+
+
+def test_pack_sequences_invalid_data():
+    """
+    Feature: PackSequences op
+    Description: Test packing a column that is not a 1-D integer tensor
+    Expectation: RuntimeError is raised
+    """
+    def generator():
+        yield (np.ones(4, dtype=np.float32),)
+
+    dataset = ds.GeneratorDataset(generator, ["text"])
+    dataset = dataset.pack_sequences("text", 8)
+
+    with pytest.raises(RuntimeError) as info:
+        for _ in dataset.create_dict_iterator(num_epochs=1):
+            pass
+    assert "1-D integer tensor" in str(info.value)
+
+
+def test_pack_sequences_invalid_pad_value():
+    """
+    Feature: PackSequences op
+    Description: Test a pad_value which does not fit in the type of the column
+    Expectation: RuntimeError is raised instead of wrapping the pad_value
+    """
+    def generator():
+        yield (np.ones(4, dtype=np.uint8),)
+
+    dataset = ds.GeneratorDataset(generator, ["text"])
+    dataset = dataset.pack_sequences("text", 8, pad_value=-1)
+
+    with pytest.raises(RuntimeError) as info:
+        for _ in dataset.create_dict_iterator(num_epochs=1):
+            pass
+    assert "pad_value" in str(info.value)
+
+    dataset = ds.GeneratorDataset(generator, ["text"])
+    dataset = dataset.pack_sequences("text", 8, pad_value=255)
+    rows = [data["text"] for data in dataset.create_dict_iterator(num_epochs=1, output_numpy=True)]
+    np.testing.assert_array_equal(rows[0], [1, 1, 1, 1, 255, 255, 255, 255])
+
+
+if __name__ == '__main__':
+    test_pack_sequences_invalid_input()
+    test_pack_sequences_basic()
+    test_pack_sequences_first_fit_decreasing()
+    test_pack_sequences_truncate()
+    test_pack_sequences_batch()
+    test_pack_sequences_invalid_data()
+    test_pack_sequences_invalid_pad_value()
@@ -17,6 +17,7 @@ Testing profiling support in DE
 """
 import json
 import os
+import time
 import numpy as np
 import pytest
 import mindspore.common.dtype as mstype
@@ -613,3 +614,80 @@ class TestMinddataProfilingManager:
 
         # Confirm dataset iterator file content
         self.confirm_dataset_iterator_file(dataset_iterator_file, 20)
+
+    def test_profiling_device_queue_cpu(self, tmp_path):
+        """
+        Feature: MindData Profiling Support
+        Description: Test the device queue profiling of a pipeline sent to the CPU device
+        Expectation: The batch time, pipeline time and connector depth are recorded for every batch
+        """
+        source = [(np.array([x]),) for x in range(64)]
+        data1 = ds.GeneratorDataset(source, ["data"])
+        data1 = data1.batch(8)
+        data1 = data1.to_device()
+        data1.send(num_epochs=1)
+        # Wait for all the batches to be sent
+        time.sleep(2)
+
+        # Stop MindData Profiling and save output files to tmp_path
+        self.md_profiler.stop()
+        self.md_profiler.save(str(tmp_path))
+
+        device_queue_file = str(tmp_path) + "/device_queue_profiling_1.txt"
+        with open(device_queue_file) as f:
+            records = [[int(value) for value in line.split()] for line in f]
+        # Each batch has the push, batch and pipeline time and the connector depth
+        assert len(records) == 4 * 8
+        connector_depths = [record for record in records if record[0] == 1]
+        assert [record[2] for record in connector_depths] == list(range(1, 9))
+        for record in connector_depths:
+            assert 0 <= record[3] <= record[1]
+
+    def test_profiling_op_latency(self, tmp_path):
+        """
+        Feature: MindData Profiling Support
+        Description: Test op latency histograms and timeline of a pipeline with Map and Batch
+        Expectation: Wait and compute latency is recorded per worker, every TensorOp of Map is recorded
+                     and the timeline is a valid Chrome trace
+        """
+        source = [(np.array([x]),) for x in range(64)]
+        data1 = ds.GeneratorDataset(source, ["data"])
+        data1 = data1.map(operations=[C.TypeCast(mstype.int32), C.Fill(1)], input_columns=["data"],
+                          num_parallel_workers=2)
+        data1 = data1.batch(8, num_parallel_workers=2)
+
+        num_iter = 0
+        for _ in data1.create_dict_iterator(num_epochs=1):
+            num_iter += 1
+        assert num_iter == 8
+
+        # Stop MindData Profiling and save output files to tmp_path
+        self.md_profiler.stop()
+        self.md_profiler.save(str(tmp_path))
+
+        op_latency_file = str(tmp_path) + "/dataset_op_latency_1.json"
+        timeline_file = str(tmp_path) + "/dataset_timeline_1.json"
+
+        with open(op_latency_file) as f:
+            data = json.load(f)
+            entries = data["op_latency"]
+            stages = {}
+            for entry in entries:
+                assert entry["p50_us"] <= entry["p99_us"] <= entry["max_us"]
+                assert sum(entry["buckets"]) == entry["count"]
+                key = (entry["op_name"], entry["stage"])
+                stages[key] = stages.get(key, 0) + entry["count"]
+            assert stages[("MapOp", "compute")] == 64
+            assert stages[("MapOp", "wait")] == 64
+            assert stages[("MapOp", "TypeCastOp")] == 64
+            assert stages[("MapOp", "FillOp")] == 64
+            assert stages[("BatchOp", "compute")] == 8
+            assert stages[("BatchOp", "wait")] == 8
+
+        with open(timeline_file) as f:
+            data = json.load(f)
+            events = [event for event in data["traceEvents"] if event["ph"] == "X"]
+            assert len(events) == sum(entry["count"] for entry in entries)
+            for event in events:
+                assert event["dur"] >= 0
+                assert event["cat"] in ["wait", "compute", "tensor_op"]